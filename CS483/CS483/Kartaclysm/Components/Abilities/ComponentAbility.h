@@ -24,7 +24,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_Ability"; }
+		static const char* StaticFamilyID()						{ return "GOC_Ability"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 
 		// Destruction.
 		virtual ~ComponentAbility() {};
@@ -37,6 +38,10 @@ namespace Kartaclysm
 		virtual void Activate() = 0;
 		virtual void AICheckCondition(HeatStroke::Component* p_pAIDriver) = 0;
 
+		// Snapshots. Cooldowns and charges live in ComponentAbilityConditions, so
+		// only abilities keeping their own state need to save any.
+		virtual bool IsSnapshottable() const override { return true; }
+
 		// Accessor
 		const std::string& GetPlayerIdentifier() const { return m_strPlayerX; }
 
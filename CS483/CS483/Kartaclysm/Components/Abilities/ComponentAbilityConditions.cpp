@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentAbilityConditions.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -103,6 +104,21 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentAbilityConditions::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fCurrentCooldown);
+		p_mSnapshot.Write(m_iCurrentCharges);
+		p_mSnapshot.Write(m_bSpecial);
+	}
+
+	void ComponentAbilityConditions::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_fCurrentCooldown);
+		p_mSnapshot.Read(m_iCurrentCharges);
+		p_mSnapshot.Read(m_bSpecial);
+		m_bSendEvent = true;
+	}
+
 	bool ComponentAbilityConditions::CanActivate() const
 	{
 		// Assume the ability can be activated, and only return false if a condition is broke
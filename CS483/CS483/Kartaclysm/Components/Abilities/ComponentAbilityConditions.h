@@ -24,7 +24,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_AbilityConditions"; }
+		static const char* StaticFamilyID()						{ return "GOC_AbilityConditions"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_AbilityConditions"; }
 
 		// Destruction.
@@ -41,6 +42,11 @@ namespace Kartaclysm
 		virtual void Init() override;
 		virtual void Update(const float p_fDelta) override;
 
+		// Snapshots. Restoring sends the HUD event again, so the HUD catches up.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		// Returns if the ability meets all conditions to be activated
 		virtual bool CanActivate() const;
 
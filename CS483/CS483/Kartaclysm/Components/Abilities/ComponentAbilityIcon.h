@@ -22,7 +22,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_AbilityIcon"; }
+		static const char* StaticFamilyID()						{ return "GOC_AbilityIcon"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_AbilityIcon"; }
 
 		// Destruction.
@@ -39,6 +40,9 @@ namespace Kartaclysm
 		virtual void Init() override;
 		virtual void Update(const float p_fDelta) override {}
 
+		// Snapshots. The icon's materials are sent to the HUD once, from Init().
+		virtual bool IsSnapshottable() const override { return true; }
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
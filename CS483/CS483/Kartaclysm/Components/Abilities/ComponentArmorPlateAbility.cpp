@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentArmorPlateAbility.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -71,6 +72,16 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentArmorPlateAbility::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_bSentImmuneEvent);
+	}
+
+	void ComponentArmorPlateAbility::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_bSentImmuneEvent);
+	}
+
 	void ComponentArmorPlateAbility::Activate()
 	{
 		m_bSentImmuneEvent = true;
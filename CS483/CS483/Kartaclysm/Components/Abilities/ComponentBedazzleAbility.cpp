@@ -82,6 +82,10 @@ namespace Kartaclysm
 		{
 			pAIDriver->RegisterComponentAbility(this);
 		}
+
+		// Parse the blast now rather than the first time the ability is used, and
+		// keep spent ones around for reuse since they're fired all race long
+		GetGameObject()->GetManager()->EnableRecycling(m_strBlastXML, 8);
 	}
 
 	void ComponentBedazzleAbility::Activate()
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentMaintainAbility.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -87,6 +88,16 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentMaintainAbility::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iCurrentCharges);
+	}
+
+	void ComponentMaintainAbility::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_iCurrentCharges);
+	}
+
 	void ComponentMaintainAbility::Activate()
 	{
 		if (m_pConditions->CanActivate())
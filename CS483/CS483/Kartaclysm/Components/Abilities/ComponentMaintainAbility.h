@@ -44,6 +44,10 @@ namespace Kartaclysm
 		virtual void Activate() override;
 		virtual void AICheckCondition(HeatStroke::Component* p_pAIDriver) override;
 
+		// Snapshots.
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentRainAbility.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -17,7 +18,8 @@ namespace Kartaclysm
 		ComponentAbility(p_pGameObject),
 		m_iPreviousPosition(-1),
 		m_fPower(p_fPower),
-		m_fDuration(p_fDuration)
+		m_fDuration(p_fDuration),
+		m_mStandings()
 	{
 		// Listen to other players passing
 		m_pPassedDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentRainAbility::PassedCallback, this, std::placeholders::_1));
@@ -62,6 +64,16 @@ namespace Kartaclysm
 			);
 	}
 
+	void ComponentRainAbility::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iPreviousPosition);
+	}
+
+	void ComponentRainAbility::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_iPreviousPosition);
+	}
+
 	void ComponentRainAbility::Init()
 	{
 		// Find ability conditions component
@@ -73,13 +85,11 @@ namespace Kartaclysm
 	{
 		if (m_pConditions->CanActivate())
 		{
-			int iPosition;
-			p_pEvent->GetRequiredIntParameter(m_strPlayerX, iPosition);
+			int iPosition = m_mStandings.FindPlace(p_pEvent, m_strPlayerX);
 
 			if (iPosition < m_iPreviousPosition && m_pConditions->CanActivate())
 			{
-				std::string strTarget;
-				p_pEvent->GetRequiredStringParameter(std::to_string(iPosition + 1), strTarget);
+				std::string strTarget = m_mStandings.GetRacerAt(p_pEvent, iPosition + 1);
 
 				// TODO: Triggering event is not sent if passing by a player who is not on the same lap
 				// TODO: Check distance for 'nearby' criteria?
@@ -14,6 +14,7 @@
 #include <string>
 
 #include "ComponentAbility.h"
+#include "RaceStandings.h"
 
 namespace Kartaclysm
 {
@@ -43,6 +44,10 @@ namespace Kartaclysm
 		virtual void Activate() override {}
 		virtual void AICheckCondition(HeatStroke::Component* p_pAIDriver) override {}
 
+		// Snapshots.
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -75,6 +80,7 @@ namespace Kartaclysm
 
 		// Delegate function to register with EventManager for player passing
 		std::function<void(const HeatStroke::Event*)>* m_pPassedDelegate;
+		RaceStandings m_mStandings;
 	};
 }
 
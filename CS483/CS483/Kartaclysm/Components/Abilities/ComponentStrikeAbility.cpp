@@ -82,6 +82,10 @@ namespace Kartaclysm
 		{
 			pAIDriver->RegisterComponentAbility(this);
 		}
+
+		// Parse the projectile now rather than the first time the ability is used, and
+		// keep spent ones around for reuse since they're fired all race long
+		GetGameObject()->GetManager()->EnableRecycling(m_strProjectileXML, 8);
 	}
 
 	void ComponentStrikeAbility::Activate()
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentTinkerAbility.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -92,6 +93,16 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentTinkerAbility::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iCurrentCharges);
+	}
+
+	void ComponentTinkerAbility::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_iCurrentCharges);
+	}
+
 	void ComponentTinkerAbility::Activate()
 	{
 		if (m_pConditions->CanActivate())
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentAIDriver.h"
+#include "SceneSnapshot.h"
 
 #include <gtx/vector_angle.hpp>
 
@@ -30,6 +31,7 @@ namespace Kartaclysm
 
 		m_fAngleToNextNode = 0.0f;
 		m_fDistanceToNextNode = 0.0f;
+		m_bReachedNode = false;
 	}
 
 	ComponentAIDriver::~ComponentAIDriver()
@@ -50,11 +52,27 @@ namespace Kartaclysm
 	}
 
 	void ComponentAIDriver::Update(const float p_fDelta)
+	{
+		// Picking the next node's target draws on rand(), so it stays on the main thread
+		if (m_bReachedNode)
+		{
+			NextNode();
+			m_bReachedNode = false;
+		}
+
+		// Use abilites
+		for (unsigned int i = 0; i < m_vAbilities.size(); i++)
+		{
+			m_vAbilities.at(i)->AICheckCondition(this);
+		}
+	}
+
+	void ComponentAIDriver::ParallelUpdate(const float p_fDelta)
 	{
 		float x = m_pGameObject->GetTransform().GetTranslation().x;
 		float z = m_pGameObject->GetTransform().GetTranslation().z;
 
-		ComponentKartController* pKartController = static_cast<ComponentKartController*>(m_pGameObject->GetComponent("GOC_KartController"));
+		ComponentKartController* pKartController = m_pGameObject->GetComponent<ComponentKartController>();
 		assert(pKartController != nullptr);
 
 		// Update "inputs"
@@ -69,7 +87,7 @@ namespace Kartaclysm
 		float fAngleFromInitialPos = fabsf(glm::orientedAngle(vPosDelta, m_vInitialNodeDir, glm::vec3(0.0f, 1.0f, 0.0f)));
 		if (m_fDistanceToNextNode <= m_sCurrentNode.radius || fAngleFromInitialPos >= 1.57f)
 		{
-			NextNode();
+			m_bReachedNode = true;
 		}
 
 		// Stop accelerating if you need to make a very tight turn
@@ -124,19 +142,45 @@ namespace Kartaclysm
 				m_iSlide = 0;
 			}
 		}
+	}
 
-		// Use abilites
-		for (unsigned int i = 0; i < m_vAbilities.size(); i++)
-		{
-			m_vAbilities.at(i)->AICheckCondition(this);
-		}
+	void ComponentAIDriver::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_sCurrentNode);
+		p_mSnapshot.Write(m_fXTarget);
+		p_mSnapshot.Write(m_fZTarget);
+		p_mSnapshot.Write(m_vInitialNodeDir);
+		p_mSnapshot.Write(m_iAccelerate);
+		p_mSnapshot.Write(m_iBrake);
+		p_mSnapshot.Write(m_fTurn);
+		p_mSnapshot.Write(m_iSlide);
+		p_mSnapshot.Write(m_iSlideDir);
+		p_mSnapshot.Write(m_fAngleToNextNode);
+		p_mSnapshot.Write(m_fDistanceToNextNode);
+		p_mSnapshot.Write(m_bReachedNode);
+	}
+
+	void ComponentAIDriver::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_sCurrentNode);
+		p_mSnapshot.Read(m_fXTarget);
+		p_mSnapshot.Read(m_fZTarget);
+		p_mSnapshot.Read(m_vInitialNodeDir);
+		p_mSnapshot.Read(m_iAccelerate);
+		p_mSnapshot.Read(m_iBrake);
+		p_mSnapshot.Read(m_fTurn);
+		p_mSnapshot.Read(m_iSlide);
+		p_mSnapshot.Read(m_iSlideDir);
+		p_mSnapshot.Read(m_fAngleToNextNode);
+		p_mSnapshot.Read(m_fDistanceToNextNode);
+		p_mSnapshot.Read(m_bReachedNode);
 	}
 
 	int ComponentAIDriver::CurrentPosition()
 	{
 		int iPosition = 0;
 
-		ComponentRacer* pRacer = static_cast<ComponentRacer*>(m_pGameObject->GetComponent("GOC_Racer"));
+		ComponentRacer* pRacer = m_pGameObject->GetComponent<ComponentRacer>();
 		if (pRacer != nullptr)
 		{
 			iPosition = pRacer->GetCurrentPosition();
@@ -149,7 +193,7 @@ namespace Kartaclysm
 	{
 		bool bWheelie = false;
 
-		ComponentKartController* pKartController = static_cast<ComponentKartController*>(m_pGameObject->GetComponent("GOC_KartController"));
+		ComponentKartController* pKartController = m_pGameObject->GetComponent<ComponentKartController>();
 		if (pKartController != nullptr)
 		{
 			bWheelie = pKartController->IsInWheelie();
@@ -170,10 +214,10 @@ namespace Kartaclysm
 		float xx;
 		float zz;
 
-		std::vector<HeatStroke::GameObject*> vRacers = GetGameObject()->GetManager()->GetGameObjectsByTag("Racer");
+		const std::vector<HeatStroke::GameObject*>& vRacers = GetGameObject()->GetManager()->GetGameObjectsWithTag("Racer");
 		for (unsigned int i = 0; i < vRacers.size(); i++)
 		{
-			if (vRacers.at(i)->GetGUID().compare(GetGameObject()->GetGUID()) != 0)
+			if (vRacers.at(i) != GetGameObject())
 			{
 				xx = vRacers.at(i)->GetTransform().GetTranslation().x;
 				zz = vRacers.at(i)->GetTransform().GetTranslation().z;
@@ -205,11 +249,11 @@ namespace Kartaclysm
 
 	void ComponentAIDriver::NextNode()
 	{
-		ComponentKartController* kartController = static_cast<ComponentKartController*>(m_pGameObject->GetComponent("GOC_KartController"));
+		ComponentKartController* kartController = m_pGameObject->GetComponent<ComponentKartController>();
 		if (kartController != nullptr && !kartController->IsAirborne()) // Check if airborne so that jumps don't fuck up the pathing
 		{
 			HeatStroke::GameObject* pTrack = m_pGameObject->GetManager()->GetGameObject("Track");
-			ComponentTrack* pTrackComponent = static_cast<ComponentTrack*>(pTrack->GetComponent("GOC_Track"));
+			ComponentTrack* pTrackComponent = pTrack->GetComponent<ComponentTrack>();
 
 			SetNode(pTrackComponent->GetNextNode(m_sCurrentNode.index));
 		}
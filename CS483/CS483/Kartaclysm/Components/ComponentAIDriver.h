@@ -12,6 +12,7 @@
 
 #include "Common.h"
 #include "Component.h"
+#include "ComponentPool.h"
 #include "ComponentTrack.h"
 #include "GameObject.h"
 
@@ -19,10 +20,11 @@
 
 namespace Kartaclysm
 {
-	class ComponentAIDriver : public HeatStroke::Component
+	class ComponentAIDriver : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentAIDriver>
 	{
 	public:
-		virtual const std::string FamilyID() const override		{ return "GOC_AIDriver"; }
+		static const char* StaticFamilyID()						{ return "GOC_AIDriver"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_AIDriver"; }
 
 		// Destruction.
@@ -39,6 +41,16 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Steering is worked out in parallel; moving on to the next node and using
+		// abilities happen in Update().
+		virtual bool HasParallelUpdate() const override { return true; }
+		virtual void ParallelUpdate(const float p_fDelta) override;
+
+		// Snapshots. The abilities register themselves once, so they aren't kept.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		void QueryPlayerMovement(
 			const int p_iPlayerNum,
 			int& p_iAccelerate,
@@ -82,6 +94,7 @@ namespace Kartaclysm
 
 		float m_fAngleToNextNode;
 		float m_fDistanceToNextNode;
+		bool m_bReachedNode;
 	};
 }
 
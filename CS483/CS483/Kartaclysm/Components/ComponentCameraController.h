@@ -20,7 +20,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_CameraController"; }
+		static const char* StaticFamilyID()						{ return "GOC_CameraController"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_CameraController"; }
 
 		// Destruction.
@@ -37,6 +38,9 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Snapshots. The camera is placed behind its kart every Update().
+		virtual bool IsSnapshottable() const override { return true; }
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -6,6 +6,7 @@
 //------------------------------------------------------------------------
 
 #include "ComponentEffect.h"
+#include "SceneSnapshot.h"
 
 #include "ComponentParticleEffect.h"
 
@@ -19,6 +20,7 @@ namespace Kartaclysm
 		Component(p_pGameObject),
 		m_pGameObject(p_pGameObject),
 		m_fDuration(p_fDuration),
+		m_fStartDuration(p_fDuration),
 		m_bStarted(false),
 		m_strEffectId(p_strEffectId)
 	{
@@ -49,6 +51,24 @@ namespace Kartaclysm
 			);
 	}
 
+	void ComponentEffect::Reactivate()
+	{
+		m_fDuration = m_fStartDuration;
+		m_bStarted = false;
+	}
+
+	void ComponentEffect::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fDuration);
+		p_mSnapshot.Write(m_bStarted);
+	}
+
+	void ComponentEffect::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_fDuration);
+		p_mSnapshot.Read(m_bStarted);
+	}
+
 	void ComponentEffect::Update(const float p_fDelta)
 	{
 		m_fDuration -= p_fDelta;
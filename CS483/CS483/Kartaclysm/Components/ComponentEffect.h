@@ -22,7 +22,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_Effect"; }
+		static const char* StaticFamilyID()						{ return "GOC_Effect"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_Effect"; }
 
 		// Destruction.
@@ -39,6 +40,15 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Recycling.
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Reactivate() override;
+
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		void SetDuration(float p_fDuration) { m_fDuration = p_fDuration; }
 
 	protected:
@@ -56,6 +66,7 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		HeatStroke::GameObject* m_pGameObject;
 		float m_fDuration;
+		float m_fStartDuration;
 		bool m_bStarted;
 		std::string m_strEffectId;
 	};
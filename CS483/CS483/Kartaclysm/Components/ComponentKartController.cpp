@@ -7,6 +7,7 @@
 
 #include "ComponentKartController.h"
 #include "ComponentParticleEffect.h"
+#include "SceneSnapshot.h"
 
 #include "ComponentAIDriver.h"
 
@@ -91,10 +92,22 @@ namespace Kartaclysm
 		m_fSlowPower(1.0f),
 		m_fSpinFactor(0.0f),
 		m_bOffroad(false),
-		m_fOffroadRumble(0.0f)
+		m_fOffroadRumble(0.0f),
+		m_uiObject1HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object1Handle")),
+		m_uiObject2HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object2Handle")),
+		m_uiContactPointXID(HeatStroke::EventTypeRegistry::InternParameter("ContactPointX")),
+		m_uiContactPointYID(HeatStroke::EventTypeRegistry::InternParameter("ContactPointY")),
+		m_uiContactPointZID(HeatStroke::EventTypeRegistry::InternParameter("ContactPointZ")),
+		m_uiPassedThroughID(HeatStroke::EventTypeRegistry::InternParameter("PassedThrough")),
+		m_uiImpactXID(HeatStroke::EventTypeRegistry::InternParameter("ImpactX")),
+		m_uiImpactYID(HeatStroke::EventTypeRegistry::InternParameter("ImpactY")),
+		m_uiImpactZID(HeatStroke::EventTypeRegistry::InternParameter("ImpactZ"))
 	{
 		m_pCollisionDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentKartController::HandleCollisionEvent, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+
+		m_pCollisionStayDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentKartController::HandleCollisionStayEvent, this, std::placeholders::_1));
+		HeatStroke::EventManager::Instance()->AddListener("CollisionStay", m_pGameObject, m_pCollisionStayDelegate);
 
 		m_pAbilityDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentKartController::HandleAbilityEvent, this, std::placeholders::_1));
 		HeatStroke::EventManager::Instance()->AddListener("AbilityUse", m_pAbilityDelegate);
@@ -105,17 +118,21 @@ namespace Kartaclysm
 		m_pOutsideForce = glm::vec3();
 
 		HeatStroke::GameObject* pTrack = m_pGameObject->GetManager()->GetGameObject("Track");
-		m_pTrackComponent = static_cast<ComponentTrack*>(pTrack->GetComponent("GOC_Track"));
+		m_pTrackComponent = pTrack->GetComponent<ComponentTrack>();
 
 		UpdateStats(m_iMaxSpeedCoreStat, m_iAccelerationCoreStat, m_iHandlingCoreStat, m_iDurabilityCoreStat);
 	}
 
 	ComponentKartController::~ComponentKartController()
 	{
-		HeatStroke::EventManager::Instance()->RemoveListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 		delete m_pCollisionDelegate;
 		m_pCollisionDelegate = nullptr;
 
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionStay", m_pGameObject, m_pCollisionStayDelegate);
+		delete m_pCollisionStayDelegate;
+		m_pCollisionStayDelegate = nullptr;
+
 		HeatStroke::EventManager::Instance()->RemoveListener("AbilityUse", m_pAbilityDelegate);
 		delete m_pAbilityDelegate;
 		m_pAbilityDelegate = nullptr;
@@ -145,7 +162,7 @@ namespace Kartaclysm
 		if (m_bAI)
 		{
 			// add ComponentAIDriver to game object if not already present
-			ComponentAIDriver* pAIDriverComponent = static_cast<ComponentAIDriver*>(m_pGameObject->GetComponent("GOC_AIDriver"));
+			ComponentAIDriver* pAIDriverComponent = m_pGameObject->GetComponent<ComponentAIDriver>();
 			if (pAIDriverComponent == nullptr)
 			{
 				Component* pAIDriverComponent = ComponentAIDriver::CreateComponent(m_pGameObject, nullptr, nullptr);
@@ -211,6 +228,158 @@ namespace Kartaclysm
 		m_fDurabilityStat = 1.0f - (0.12f * p_iDurability);
 	}
 
+	void ComponentKartController::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.WriteString(m_strHitCallback);
+		p_mSnapshot.Write(m_bAI);
+		p_mSnapshot.Write(m_bDisabled);
+		p_mSnapshot.Write(m_pOutsideForce);
+
+		p_mSnapshot.Write(m_iMaxSpeedCoreStat);
+		p_mSnapshot.Write(m_iAccelerationCoreStat);
+		p_mSnapshot.Write(m_iHandlingCoreStat);
+		p_mSnapshot.Write(m_iDurabilityCoreStat);
+		p_mSnapshot.Write(m_iMaxSpeedCoreStatMod);
+		p_mSnapshot.Write(m_iAccelerationCoreStatMod);
+		p_mSnapshot.Write(m_iHandlingCoreStatMod);
+		p_mSnapshot.Write(m_iDurabilityCoreStatMod);
+
+		p_mSnapshot.Write(m_fHeightAboveGroundStat);
+		p_mSnapshot.Write(m_fStickyHeightStat);
+		p_mSnapshot.Write(m_fMaxSpeedStat);
+		p_mSnapshot.Write(m_fMaxReverseSpeedStat);
+		p_mSnapshot.Write(m_fAccelerationStat);
+		p_mSnapshot.Write(m_fReverseAccelerationStat);
+		p_mSnapshot.Write(m_fAccelerationFrictionStat);
+		p_mSnapshot.Write(m_fSpeedWhileTurningStat);
+		p_mSnapshot.Write(m_fSpeedWhileSlidingMinStat);
+		p_mSnapshot.Write(m_fSpeedWhileSlidingMaxStat);
+		p_mSnapshot.Write(m_fMaxTurnStat);
+		p_mSnapshot.Write(m_fTurnAccelerationStat);
+		p_mSnapshot.Write(m_fHopInitialSpeedStat);
+		p_mSnapshot.Write(m_fGravityAccelerationStat);
+		p_mSnapshot.Write(m_fSlideModifierStat);
+		p_mSnapshot.Write(m_fSlideMaxTurnModifierStat);
+		p_mSnapshot.Write(m_fTurnAtMaxSpeedStat);
+		p_mSnapshot.Write(m_fPeakTurnRatio);
+		p_mSnapshot.Write(m_fSwerveTurnModifier);
+		p_mSnapshot.Write(m_fSwerveAccelerationStat);
+		p_mSnapshot.Write(m_fWallBumpStat);
+		p_mSnapshot.Write(m_fWallSlowdownStat);
+		p_mSnapshot.Write(m_fOutsideForceAccelerationStat);
+		p_mSnapshot.Write(m_fSlideChargeAccelerationStat);
+		p_mSnapshot.Write(m_fSlideChargeMaxStat);
+		p_mSnapshot.Write(m_fSlideChargeThreshold);
+		p_mSnapshot.Write(m_fWheelieTurnModStat);
+		p_mSnapshot.Write(m_fWheelieSpeedModStat);
+		p_mSnapshot.Write(m_fDurabilityStat);
+		p_mSnapshot.Write(m_fSpinSpeedStat);
+		p_mSnapshot.Write(m_fKartCollisionStat);
+		p_mSnapshot.Write(m_fOffroadFactorStat);
+		p_mSnapshot.Write(m_fOffroadRumbleFactor);
+		p_mSnapshot.Write(m_fAIRubberBandingFactorFirst);
+		p_mSnapshot.Write(m_fAIRubberBandingFactorLast);
+		p_mSnapshot.Write(m_fJumpBoostStat);
+		p_mSnapshot.Write(m_fWheelieOffsetStat);
+
+		p_mSnapshot.Write(m_fGroundHeight);
+		p_mSnapshot.Write(m_fPreviousHeight);
+		p_mSnapshot.Write(m_fSpeed);
+		p_mSnapshot.Write(m_fDirection);
+		p_mSnapshot.Write(m_fTurnSpeed);
+		p_mSnapshot.Write(m_bAirborne);
+		p_mSnapshot.Write(m_fVerticalSpeed);
+		p_mSnapshot.Write(m_bSliding);
+		p_mSnapshot.Write(m_iSlideDirection);
+		p_mSnapshot.Write(m_bSlideParticle);
+		p_mSnapshot.Write(m_fSwerve);
+		p_mSnapshot.Write(m_fSlideCharge);
+		p_mSnapshot.Write(m_bWheelie);
+		p_mSnapshot.Write(m_fSpinout);
+		p_mSnapshot.Write(m_fTurnLock);
+		p_mSnapshot.Write(m_fSlowDuration);
+		p_mSnapshot.Write(m_fSlowPower);
+		p_mSnapshot.Write(m_fSpinFactor);
+		p_mSnapshot.Write(m_bOffroad);
+		p_mSnapshot.Write(m_fOffroadRumble);
+	}
+
+	void ComponentKartController::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.ReadString(m_strHitCallback);
+		p_mSnapshot.Read(m_bAI);
+		p_mSnapshot.Read(m_bDisabled);
+		p_mSnapshot.Read(m_pOutsideForce);
+
+		p_mSnapshot.Read(m_iMaxSpeedCoreStat);
+		p_mSnapshot.Read(m_iAccelerationCoreStat);
+		p_mSnapshot.Read(m_iHandlingCoreStat);
+		p_mSnapshot.Read(m_iDurabilityCoreStat);
+		p_mSnapshot.Read(m_iMaxSpeedCoreStatMod);
+		p_mSnapshot.Read(m_iAccelerationCoreStatMod);
+		p_mSnapshot.Read(m_iHandlingCoreStatMod);
+		p_mSnapshot.Read(m_iDurabilityCoreStatMod);
+
+		p_mSnapshot.Read(m_fHeightAboveGroundStat);
+		p_mSnapshot.Read(m_fStickyHeightStat);
+		p_mSnapshot.Read(m_fMaxSpeedStat);
+		p_mSnapshot.Read(m_fMaxReverseSpeedStat);
+		p_mSnapshot.Read(m_fAccelerationStat);
+		p_mSnapshot.Read(m_fReverseAccelerationStat);
+		p_mSnapshot.Read(m_fAccelerationFrictionStat);
+		p_mSnapshot.Read(m_fSpeedWhileTurningStat);
+		p_mSnapshot.Read(m_fSpeedWhileSlidingMinStat);
+		p_mSnapshot.Read(m_fSpeedWhileSlidingMaxStat);
+		p_mSnapshot.Read(m_fMaxTurnStat);
+		p_mSnapshot.Read(m_fTurnAccelerationStat);
+		p_mSnapshot.Read(m_fHopInitialSpeedStat);
+		p_mSnapshot.Read(m_fGravityAccelerationStat);
+		p_mSnapshot.Read(m_fSlideModifierStat);
+		p_mSnapshot.Read(m_fSlideMaxTurnModifierStat);
+		p_mSnapshot.Read(m_fTurnAtMaxSpeedStat);
+		p_mSnapshot.Read(m_fPeakTurnRatio);
+		p_mSnapshot.Read(m_fSwerveTurnModifier);
+		p_mSnapshot.Read(m_fSwerveAccelerationStat);
+		p_mSnapshot.Read(m_fWallBumpStat);
+		p_mSnapshot.Read(m_fWallSlowdownStat);
+		p_mSnapshot.Read(m_fOutsideForceAccelerationStat);
+		p_mSnapshot.Read(m_fSlideChargeAccelerationStat);
+		p_mSnapshot.Read(m_fSlideChargeMaxStat);
+		p_mSnapshot.Read(m_fSlideChargeThreshold);
+		p_mSnapshot.Read(m_fWheelieTurnModStat);
+		p_mSnapshot.Read(m_fWheelieSpeedModStat);
+		p_mSnapshot.Read(m_fDurabilityStat);
+		p_mSnapshot.Read(m_fSpinSpeedStat);
+		p_mSnapshot.Read(m_fKartCollisionStat);
+		p_mSnapshot.Read(m_fOffroadFactorStat);
+		p_mSnapshot.Read(m_fOffroadRumbleFactor);
+		p_mSnapshot.Read(m_fAIRubberBandingFactorFirst);
+		p_mSnapshot.Read(m_fAIRubberBandingFactorLast);
+		p_mSnapshot.Read(m_fJumpBoostStat);
+		p_mSnapshot.Read(m_fWheelieOffsetStat);
+
+		p_mSnapshot.Read(m_fGroundHeight);
+		p_mSnapshot.Read(m_fPreviousHeight);
+		p_mSnapshot.Read(m_fSpeed);
+		p_mSnapshot.Read(m_fDirection);
+		p_mSnapshot.Read(m_fTurnSpeed);
+		p_mSnapshot.Read(m_bAirborne);
+		p_mSnapshot.Read(m_fVerticalSpeed);
+		p_mSnapshot.Read(m_bSliding);
+		p_mSnapshot.Read(m_iSlideDirection);
+		p_mSnapshot.Read(m_bSlideParticle);
+		p_mSnapshot.Read(m_fSwerve);
+		p_mSnapshot.Read(m_fSlideCharge);
+		p_mSnapshot.Read(m_bWheelie);
+		p_mSnapshot.Read(m_fSpinout);
+		p_mSnapshot.Read(m_fTurnLock);
+		p_mSnapshot.Read(m_fSlowDuration);
+		p_mSnapshot.Read(m_fSlowPower);
+		p_mSnapshot.Read(m_fSpinFactor);
+		p_mSnapshot.Read(m_bOffroad);
+		p_mSnapshot.Read(m_fOffroadRumble);
+	}
+
 	void ComponentKartController::Update(const float p_fDelta)
 	{
 		// Manually query for user input
@@ -225,7 +394,7 @@ namespace Kartaclysm
 			}
 			else
 			{
-				ComponentAIDriver* aiDriver = static_cast<ComponentAIDriver*>(m_pGameObject->GetComponent("GOC_AIDriver"));
+				ComponentAIDriver* aiDriver = m_pGameObject->GetComponent<ComponentAIDriver>();
 				if (aiDriver != nullptr)
 				{
 					aiDriver->QueryPlayerMovement(m_iPlayerNum, iAccelerate, iBrake, iSlide, fTurn);
@@ -264,7 +433,8 @@ namespace Kartaclysm
 				m_fSlowPower = 1.0f;
 
 				// Remove the HUD element
-				HeatStroke::Event* pEvent = new HeatStroke::Event(m_pGameObject->GetGUID() + "_HUD_Slow");
+				HeatStroke::Event* pEvent = new HeatStroke::Event("HUD_Slow");
+				pEvent->SetTarget(m_pGameObject);
 				pEvent->SetIntParameter("Display", 0);
 				HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
 			}
@@ -330,7 +500,7 @@ namespace Kartaclysm
 		// ...And from AI rubber banding
 		if (m_bAI)
 		{
-			ComponentRacer* pRacer = (ComponentRacer*)m_pGameObject->GetComponent("GOC_Racer");
+			ComponentRacer* pRacer = m_pGameObject->GetComponent<ComponentRacer>();
 			if (pRacer != nullptr)
 			{
 				int iPosition = pRacer->GetCurrentPosition();
@@ -572,7 +742,7 @@ namespace Kartaclysm
 		// Particles
 		if (m_bSliding && !m_bSlideParticle)
 		{
-			HeatStroke::ComponentParticleEffect* pComponentParticleEffect = (HeatStroke::ComponentParticleEffect*)m_pGameObject->GetComponent("GOC_ParticleEffect");
+			HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 			if (pComponentParticleEffect)
 			{
 				if (m_iSlideDirection > 0)
@@ -597,7 +767,7 @@ namespace Kartaclysm
 		}
 		else if (!m_bSliding && m_bSlideParticle)
 		{
-			HeatStroke::ComponentParticleEffect* pComponentParticleEffect = (HeatStroke::ComponentParticleEffect*)m_pGameObject->GetComponent("GOC_ParticleEffect");
+			HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 			if (pComponentParticleEffect)
 			{
 				HeatStroke::Effect* pSwerveLeftEffect = pComponentParticleEffect->GetEffect("swerve_left");
@@ -634,7 +804,7 @@ namespace Kartaclysm
 			m_pGameObject->GetTransform().SetRotation(glm::quat(glm::vec3(m_fOffroadRumble, m_fDirection + GetRotationMod(), 0.0f)));
 		}
 
-		ComponentRacer* pRacer = static_cast<ComponentRacer*>(m_pGameObject->GetComponent("GOC_Racer"));
+		ComponentRacer* pRacer = m_pGameObject->GetComponent<ComponentRacer>();
 		if (pRacer != nullptr)
 		{
 			if (m_bWheelie)
@@ -655,7 +825,7 @@ namespace Kartaclysm
 
 	void ComponentKartController::UpdateOffroadParticle()
 	{
-		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = static_cast<HeatStroke::ComponentParticleEffect*>(m_pGameObject->GetComponent("GOC_ParticleEffect"));
+		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 		if (pComponentParticleEffect)
 		{
 			HeatStroke::Effect* pBoostParticleEffect = pComponentParticleEffect->GetEffect("offroad");
@@ -675,7 +845,7 @@ namespace Kartaclysm
 
 	void ComponentKartController::RaceFinishParticles()
 	{
-		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = static_cast<HeatStroke::ComponentParticleEffect*>(m_pGameObject->GetComponent("GOC_ParticleEffect"));
+		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 		if (pComponentParticleEffect)
 		{
 			HeatStroke::Effect* pFinishParticleEffect = pComponentParticleEffect->GetEffect("race_finish");
@@ -696,7 +866,7 @@ namespace Kartaclysm
 		float extra = (m_fMaxSpeedStat * m_fSpeedScale * p_fPower) - m_fSpeed;
 		m_fSpeed = fmaxf(m_fSpeed, m_fSpeed + (extra * (m_fSpeed / (m_fMaxSpeedStat * m_fSpeedScale))));
 
-		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = (HeatStroke::ComponentParticleEffect*)m_pGameObject->GetComponent("GOC_ParticleEffect");
+		HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 		if (pComponentParticleEffect)
 		{
 			HeatStroke::Effect* pBoostParticleEffect = pComponentParticleEffect->GetEffect("boost");
@@ -765,80 +935,110 @@ namespace Kartaclysm
 
 	void ComponentKartController::HandleCollisionEvent(const HeatStroke::Event* p_pEvent)
 	{
-		std::string guid1;
-		std::string guid2;
-		p_pEvent->GetRequiredGameObjectParameter("Object1GUID", guid1);
-		p_pEvent->GetRequiredGameObjectParameter("Object2GUID", guid2);
-
-		HeatStroke::GameObject* pOther = nullptr;
-		if (guid1.compare(m_pGameObject->GetGUID()) == 0)
-		{
-			pOther = m_pGameObject->GetManager()->GetGameObject(guid2);
-		}
-		else if (guid2.compare(m_pGameObject->GetGUID()) == 0)
+		HeatStroke::GameObject* pOther = GetCollisionPartner(p_pEvent);
+		if (pOther != nullptr)
 		{
-			pOther = m_pGameObject->GetManager()->GetGameObject(guid1);
+			glm::vec3 contactPoint;
+			const glm::vec3 difference = ResolveCollision(p_pEvent, pOther, contactPoint);
+
+			std::string otherColliderID = pOther->GetComponent<HeatStroke::ComponentCollider>()->ComponentID();
+			if (otherColliderID.compare("GOC_WallCollider") == 0)
+			{
+				// Wall Collision
+				glm::vec3 velocity = glm::vec3(sinf(m_fDirection), 0.0f, cosf(m_fDirection));
+				float dotProduct = glm::dot(velocity, glm::normalize(contactPoint - m_pGameObject->GetTransform().GetTranslation()));
+
+				m_pOutsideForce = glm::normalize(difference) * m_fWallBumpStat * ((m_fSpeed / m_fSpeedScale) / m_fMaxSpeedStat) * dotProduct;
+				m_pOutsideForce = m_pOutsideForce * glm::vec3(1.0f, 0.0f, 1.0f); // Extra check to make sure there's no vertical speed
+				m_fSpeed *= m_fWallSlowdownStat;
+			}
+			else
+			{
+				// Kart Collision
+				m_pOutsideForce = glm::normalize(difference) * m_fKartCollisionStat;
+				m_fSpeed *= m_fWallSlowdownStat;
+			}
 		}
+	}
 
+	void ComponentKartController::HandleCollisionStayEvent(const HeatStroke::Event* p_pEvent)
+	{
+		// Grinding along a wall or another kart: keep out of it, but the bump and
+		// the slowdown only happen when first hitting it.
+		HeatStroke::GameObject* pOther = GetCollisionPartner(p_pEvent);
 		if (pOther != nullptr)
 		{
-			HeatStroke::ComponentCollider* pOtherCollider = static_cast<HeatStroke::ComponentCollider*>(pOther->GetComponent("GOC_Collider"));
-			if (pOtherCollider->HasPhysics())
-			{
-				glm::vec3 contactPoint = glm::vec3();
-				p_pEvent->GetRequiredFloatParameter("ContactPointX", contactPoint.x);
-				p_pEvent->GetRequiredFloatParameter("ContactPointY", contactPoint.y);
-				p_pEvent->GetRequiredFloatParameter("ContactPointZ", contactPoint.z);
-				int passedThroughInt;
-				p_pEvent->GetOptionalIntParameter("PassedThrough", passedThroughInt, 0);
-				bool passedThrough = (passedThroughInt != 0); // I know
-
-				HeatStroke::ComponentSphereCollider* collider = static_cast<HeatStroke::ComponentSphereCollider*>(m_pGameObject->GetComponent("GOC_Collider"));
+			glm::vec3 contactPoint;
+			ResolveCollision(p_pEvent, pOther, contactPoint);
+		}
+	}
 
-				std::string otherColliderID = pOtherCollider->ComponentID();
-				if (otherColliderID.compare("GOC_WallCollider") == 0)
-				{
-					// Wall Collision
-					glm::vec3 difference = m_pGameObject->GetTransform().GetTranslation() - contactPoint;
-					float distance = abs(collider->GetRadius() - glm::length(difference));
+	HeatStroke::GameObject* ComponentKartController::GetCollisionPartner(const HeatStroke::Event* p_pEvent)
+	{
+		int iHandle1;
+		int iHandle2;
+		p_pEvent->GetRequiredIntParameter(m_uiObject1HandleID, iHandle1);
+		p_pEvent->GetRequiredIntParameter(m_uiObject2HandleID, iHandle2);
+		HeatStroke::GameObjectHandle handle1(static_cast<unsigned int>(iHandle1));
+		HeatStroke::GameObjectHandle handle2(static_cast<unsigned int>(iHandle2));
 
-					difference = glm::normalize(difference) * fmaxf(distance, 0.0000001f);
-					m_pGameObject->GetTransform().Translate(difference);
+		HeatStroke::GameObject* pOther = nullptr;
+		if (handle1 == m_pGameObject->GetHandle())
+		{
+			pOther = m_pGameObject->GetManager()->GetGameObject(handle2);
+		}
+		else if (handle2 == m_pGameObject->GetHandle())
+		{
+			pOther = m_pGameObject->GetManager()->GetGameObject(handle1);
+		}
 
-					glm::vec3 velocity = glm::vec3(sinf(m_fDirection), 0.0f, cosf(m_fDirection));
-					float dotProduct = glm::dot(velocity, glm::normalize(contactPoint - m_pGameObject->GetTransform().GetTranslation()));
+		// Only colliders with physics push the kart around
+		if (pOther != nullptr && !pOther->GetComponent<HeatStroke::ComponentCollider>()->HasPhysics())
+		{
+			pOther = nullptr;
+		}
+		return pOther;
+	}
 
-					m_pOutsideForce = glm::normalize(difference) * m_fWallBumpStat * ((m_fSpeed / m_fSpeedScale) / m_fMaxSpeedStat) * dotProduct;
-					m_pOutsideForce = m_pOutsideForce * glm::vec3(1.0f, 0.0f, 1.0f); // Extra check to make sure there's no vertical speed
-					m_fSpeed *= m_fWallSlowdownStat;
-				}
-				else
-				{
-					// Kart Collision
-					glm::vec3 difference = m_pGameObject->GetTransform().GetTranslation() - pOther->GetTransform().GetTranslation();
-					float distance = abs(collider->GetRadius() - glm::length(difference));
+	glm::vec3 ComponentKartController::ResolveCollision(const HeatStroke::Event* p_pEvent, HeatStroke::GameObject* p_pOther, glm::vec3& p_vContactPoint)
+	{
+		p_pEvent->GetRequiredFloatParameter(m_uiContactPointXID, p_vContactPoint.x);
+		p_pEvent->GetRequiredFloatParameter(m_uiContactPointYID, p_vContactPoint.y);
+		p_pEvent->GetRequiredFloatParameter(m_uiContactPointZID, p_vContactPoint.z);
+		int passedThroughInt;
+		p_pEvent->GetOptionalIntParameter(m_uiPassedThroughID, passedThroughInt, 0);
+		bool passedThrough = (passedThroughInt != 0); // I know
 
-					difference = glm::normalize(difference) * fmaxf(distance, 0.0000001f);
-					m_pGameObject->GetTransform().Translate(difference);
+		HeatStroke::ComponentSphereCollider* collider = m_pGameObject->GetComponent<HeatStroke::ComponentSphereCollider>();
 
-					m_pOutsideForce = glm::normalize(difference) * m_fKartCollisionStat;
-					m_fSpeed *= m_fWallSlowdownStat;
-				}
+		if (passedThrough)
+		{
+			// Went through the wall this frame, so go back to where we first
+			// touched it, and get pushed off it from there
+			glm::vec3 impact;
+			p_pEvent->GetRequiredFloatParameter(m_uiImpactXID, impact.x);
+			p_pEvent->GetRequiredFloatParameter(m_uiImpactYID, impact.y);
+			p_pEvent->GetRequiredFloatParameter(m_uiImpactZID, impact.z);
+			m_pGameObject->GetTransform().SetTranslation(impact);
+		}
 
-				if (passedThrough)
-				{
-					// Again, not sure which is the right one, will depend on what order Update()s happen
-					if (m_pGameObject->GetTransform().GetTranslation() == collider->GetPosition())
-					{
-						m_pGameObject->GetTransform().SetTranslation(collider->GetPreviousPosition());
-					}
-					else
-					{
-						m_pGameObject->GetTransform().SetTranslation(collider->GetPosition());
-					}
-				}
-			}
+		// Push out of whatever we hit, away from the wall's contact point or the
+		// other kart's centre
+		glm::vec3 difference;
+		std::string otherColliderID = p_pOther->GetComponent<HeatStroke::ComponentCollider>()->ComponentID();
+		if (otherColliderID.compare("GOC_WallCollider") == 0)
+		{
+			difference = m_pGameObject->GetTransform().GetTranslation() - p_vContactPoint;
+		}
+		else
+		{
+			difference = m_pGameObject->GetTransform().GetTranslation() - p_pOther->GetTransform().GetTranslation();
 		}
+		float distance = abs(collider->GetRadius() - glm::length(difference));
+
+		difference = glm::normalize(difference) * fmaxf(distance, 0.0000001f);
+		m_pGameObject->GetTransform().Translate(difference);
+		return difference;
 	}
 
 	void ComponentKartController::HandleAbilityEvent(const HeatStroke::Event* p_pEvent)
@@ -885,14 +1085,15 @@ namespace Kartaclysm
 			else if (ability.compare("Rain") == 0)
 			{
 				// Send event for HUD
-				HeatStroke::Event* pEvent = new HeatStroke::Event(target + "_HUD_Slow");
+				HeatStroke::Event* pEvent = new HeatStroke::Event("HUD_Slow");
+				pEvent->SetTarget(m_pGameObject);
 				pEvent->SetIntParameter("Display", 1);
 				HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
 
 				HeatStroke::AudioPlayer::Instance()->PlaySoundEffect("Assets/Sounds/cleopapa_make_it_rain.flac");
 				Slow(power, duration);
 
-				HeatStroke::ComponentParticleEffect* pComponentParticleEffect = (HeatStroke::ComponentParticleEffect*)m_pGameObject->GetComponent("GOC_ParticleEffect");
+				HeatStroke::ComponentParticleEffect* pComponentParticleEffect = m_pGameObject->GetComponent<HeatStroke::ComponentParticleEffect>();
 				if (pComponentParticleEffect)
 				{
 					HeatStroke::Effect* pMakeItRainParticleEffect = pComponentParticleEffect->GetEffect("make_it_rain");
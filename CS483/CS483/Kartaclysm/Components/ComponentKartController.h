@@ -12,6 +12,7 @@
 
 #include "Common.h"
 #include "Component.h"
+#include "ComponentPool.h"
 #include "GameObject.h"
 #include "EventManager.h"
 #include "PlayerInputMapping.h"
@@ -23,13 +24,14 @@ namespace Kartaclysm
 {
 	class ComponentTrack; // forward declaration necessary for the code to compile, seems good
 	
-	class ComponentKartController : public HeatStroke::Component
+	class ComponentKartController : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentKartController>
 	{
 	public:
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_KartController"; }
+		static const char* StaticFamilyID()						{ return "GOC_KartController"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_KartController"; }
 
 		// Destruction.
@@ -46,6 +48,12 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Snapshots, for restarting a race. Stats are kept too, as the kart's stats and
+		// driver's stat mods are applied after creation.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		// Used in determining camera position
 		glm::quat GetRotationMinusSwerve();
 
@@ -84,6 +92,9 @@ namespace Kartaclysm
 		void UpdateTransform(float p_fHeightMod, float p_fDelta);
 
 		void HandleCollisionEvent(const HeatStroke::Event* p_pEvent);
+		void HandleCollisionStayEvent(const HeatStroke::Event* p_pEvent);
+		HeatStroke::GameObject* GetCollisionPartner(const HeatStroke::Event* p_pEvent);
+		glm::vec3 ResolveCollision(const HeatStroke::Event* p_pEvent, HeatStroke::GameObject* p_pOther, glm::vec3& p_vContactPoint);
 		void HandleAbilityEvent(const HeatStroke::Event* p_pEvent);
 		void HandleCountdownEvent(const HeatStroke::Event* p_pEvent);
 
@@ -195,8 +206,20 @@ namespace Kartaclysm
 
 	private:
 		std::function<void(const HeatStroke::Event*)>* m_pCollisionDelegate;
+		std::function<void(const HeatStroke::Event*)>* m_pCollisionStayDelegate;
 		std::function<void(const HeatStroke::Event*)>* m_pAbilityDelegate;
 		std::function<void(const HeatStroke::Event*)>* m_pCountdownDelegate;
+
+		// Collision parameter names, interned once as CollisionStay is read every frame.
+		HeatStroke::EventParameterID m_uiObject1HandleID;
+		HeatStroke::EventParameterID m_uiObject2HandleID;
+		HeatStroke::EventParameterID m_uiContactPointXID;
+		HeatStroke::EventParameterID m_uiContactPointYID;
+		HeatStroke::EventParameterID m_uiContactPointZID;
+		HeatStroke::EventParameterID m_uiPassedThroughID;
+		HeatStroke::EventParameterID m_uiImpactXID;
+		HeatStroke::EventParameterID m_uiImpactYID;
+		HeatStroke::EventParameterID m_uiImpactZID;
 	};
 }
 
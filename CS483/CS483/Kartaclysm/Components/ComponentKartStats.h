@@ -18,7 +18,8 @@ namespace Kartaclysm
 	class ComponentKartStats : public HeatStroke::Component
 	{
 	public:
-		virtual const std::string FamilyID() const override { return "GOC_KartStats"; }
+		static const char* StaticFamilyID() { return "GOC_KartStats"; }
+		virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override { return "GOC_KartStats"; }
 
 		// Destruction.
@@ -35,6 +36,9 @@ namespace Kartaclysm
 		virtual void Init() override;
 		virtual void Update(const float p_fDelta) override {};
 
+		// Snapshots. The stats are handed to the kart controller, which keeps them.
+		virtual bool IsSnapshottable() const override { return true; }
+
 		int GetMaxSpeed() { return m_iMaxSpeedStat; }
 		int GetAcceleration() { return m_iAccelerationStat; }
 		int GetHandling() { return m_iHandlingStat; }
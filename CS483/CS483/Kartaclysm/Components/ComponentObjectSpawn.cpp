@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentObjectSpawn.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -18,6 +19,11 @@ namespace Kartaclysm
 		m_strObjectXML(p_strObjectXML),
 		m_bCreated(false)
 	{
+		if (m_strObjectXML != "")
+		{
+			// Spawned once per spawner, so recycle them along with the spawners
+			GetGameObject()->GetManager()->EnableRecycling(m_strObjectXML, 8);
+		}
 	}
 
 	ComponentObjectSpawn::~ComponentObjectSpawn()
@@ -38,6 +44,16 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentObjectSpawn::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_bCreated);
+	}
+
+	void ComponentObjectSpawn::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_bCreated);
+	}
+
 	HeatStroke::Component* ComponentObjectSpawn::CreateComponent(
 		HeatStroke::GameObject* p_pGameObject,
 		tinyxml2::XMLNode* p_pBaseNode,
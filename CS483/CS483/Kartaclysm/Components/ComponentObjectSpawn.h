@@ -21,7 +21,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_ObjectSpawn"; }
+		static const char* StaticFamilyID()						{ return "GOC_ObjectSpawn"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_ObjectSpawn"; }
 
 		// Destruction.
@@ -38,6 +39,15 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Recycling.
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Reactivate() override { m_bCreated = false; }
+
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentProjectile.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -20,21 +21,27 @@ namespace Kartaclysm
 		m_strOnHitEvent(""),
 		m_bFriendlyFire(p_bFriendlyFire),
 		m_strBlastXML(p_strBlastXML),
-		m_pSelfDestructDelegate(nullptr)
+		m_strDefaultBlastXML(p_strBlastXML),
+		m_pSelfDestructDelegate(nullptr),
+		m_uiObject1HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object1Handle")),
+		m_uiObject2HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object2Handle"))
 	{
 		m_pCollisionDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentProjectile::HandleCollisionEvent, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 
 		if (m_strBlastXML != "")
 		{
 			m_pSelfDestructDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentProjectile::HandleSelfDestructEvent, this, std::placeholders::_1));
 			HeatStroke::EventManager::Instance()->AddListener(GetGameObject()->GetGUID() + "_SelfDestruct", m_pSelfDestructDelegate);
+
+			// One blast per projectile, so the blasts are recycled the same way
+			GetGameObject()->GetManager()->EnableRecycling(m_strBlastXML, 8);
 		}
 	}
 
 	ComponentProjectile::~ComponentProjectile()
 	{
-		HeatStroke::EventManager::Instance()->RemoveListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 		delete m_pCollisionDelegate;
 		m_pCollisionDelegate = nullptr;
 
@@ -46,6 +53,46 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentProjectile::Deactivate()
+	{
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+
+		if (m_pSelfDestructDelegate != nullptr)
+		{
+			HeatStroke::EventManager::Instance()->RemoveListener(GetGameObject()->GetGUID() + "_SelfDestruct", m_pSelfDestructDelegate);
+		}
+	}
+
+	void ComponentProjectile::Reactivate()
+	{
+		// Originator and on-hit event are set again by whoever spawned us
+		m_strOriginator = "";
+		m_strOnHitEvent = "";
+		m_strBlastXML = m_strDefaultBlastXML;
+
+		HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+
+		// The GameObject has a new GUID by now
+		if (m_pSelfDestructDelegate != nullptr)
+		{
+			HeatStroke::EventManager::Instance()->AddListener(GetGameObject()->GetGUID() + "_SelfDestruct", m_pSelfDestructDelegate);
+		}
+	}
+
+	void ComponentProjectile::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.WriteString(m_strOriginator);
+		p_mSnapshot.WriteString(m_strOnHitEvent);
+		p_mSnapshot.WriteString(m_strBlastXML);
+	}
+
+	void ComponentProjectile::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.ReadString(m_strOriginator);
+		p_mSnapshot.ReadString(m_strOnHitEvent);
+		p_mSnapshot.ReadString(m_strBlastXML);
+	}
+
 	HeatStroke::Component* ComponentProjectile::CreateComponent(
 		HeatStroke::GameObject* p_pGameObject,
 		tinyxml2::XMLNode* p_pBaseNode,
@@ -75,18 +122,20 @@ namespace Kartaclysm
 
 	void ComponentProjectile::HandleCollisionEvent(const HeatStroke::Event* p_pEvent)
 	{
-		std::string guid1, guid2;
-		p_pEvent->GetRequiredGameObjectParameter("Object1GUID", guid1);
-		p_pEvent->GetRequiredGameObjectParameter("Object2GUID", guid2);
+		int iHandle1, iHandle2;
+		p_pEvent->GetRequiredIntParameter(m_uiObject1HandleID, iHandle1);
+		p_pEvent->GetRequiredIntParameter(m_uiObject2HandleID, iHandle2);
+		HeatStroke::GameObjectHandle mHandle1(static_cast<unsigned int>(iHandle1));
+		HeatStroke::GameObjectHandle mHandle2(static_cast<unsigned int>(iHandle2));
 
 		HeatStroke::GameObject* pOther = nullptr;
-		if (guid1.compare(m_pGameObject->GetGUID()) == 0)
+		if (mHandle1 == m_pGameObject->GetHandle())
 		{
-			pOther = GetGameObject()->GetManager()->GetGameObject(guid2);
+			pOther = GetGameObject()->GetManager()->GetGameObject(mHandle2);
 		}
-		else if (guid2.compare(m_pGameObject->GetGUID()) == 0)
+		else if (mHandle2 == m_pGameObject->GetHandle())
 		{
-			pOther = GetGameObject()->GetManager()->GetGameObject(guid1);
+			pOther = GetGameObject()->GetManager()->GetGameObject(mHandle1);
 		}
 
 		if (pOther != nullptr)
@@ -11,18 +11,20 @@
 #include <tinyxml2.h>
 
 #include "Component.h"
+#include "ComponentPool.h"
 #include "GameObject.h"
 #include "EventManager.h"
 
 namespace Kartaclysm
 {
-	class ComponentProjectile : public HeatStroke::Component
+	class ComponentProjectile : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentProjectile>
 	{
 	public:
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_Projectile"; }
+		static const char* StaticFamilyID()						{ return "GOC_Projectile"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_Projectile"; }
 
 		// Destruction.
@@ -39,6 +41,16 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override {}
 
+		// Recycling.
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Deactivate() override;
+		virtual void Reactivate() override;
+
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		// Set projectile information
 		void SetOriginator(const std::string& p_strOriginator) { m_strOriginator = p_strOriginator; }
 		void SetOnHitEvent(const std::string& p_strOnHitEvent) { m_strOnHitEvent = p_strOnHitEvent; }
@@ -70,12 +82,17 @@ namespace Kartaclysm
 		std::string m_strOriginator;
 		std::string m_strOnHitEvent;
 		std::string m_strBlastXML;
+		std::string m_strDefaultBlastXML;
 		
 		bool m_bFriendlyFire;
 
 	private:
 		std::function<void(const HeatStroke::Event*)>* m_pCollisionDelegate;
 		std::function<void(const HeatStroke::Event*)>* m_pSelfDestructDelegate;
+
+		// Collision parameter names, interned once.
+		HeatStroke::EventParameterID m_uiObject1HandleID;
+		HeatStroke::EventParameterID m_uiObject2HandleID;
 	};
 }
 
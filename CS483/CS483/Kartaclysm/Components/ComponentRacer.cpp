@@ -7,6 +7,7 @@
 
 #include "ComponentRacer.h"
 #include "ComponentTrack.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -22,7 +23,8 @@ namespace Kartaclysm
 		m_iCurrentTrackPieceForDistanceCheck(0),
 		m_bHasFinishedRace(false),
 		m_bHumanPlayer(true),
-		m_vLapTimes()
+		m_vLapTimes(),
+		m_mStandings()
 	{
 		m_pLapCompleteDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentRacer::FinishLap, this, std::placeholders::_1));
 		HeatStroke::EventManager::Instance()->AddListener("RacerCompletedLap", m_pLapCompleteDelegate);
@@ -61,6 +63,30 @@ namespace Kartaclysm
 	{
 	}
 
+	void ComponentRacer::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iCurrentTrackPiece);
+		p_mSnapshot.Write(m_iCurrentTrackPieceForDistanceCheck);
+		p_mSnapshot.Write(m_iFurthestTrackPiece);
+		p_mSnapshot.Write(m_iCurrentLap);
+		p_mSnapshot.Write(m_iCurrentPosition);
+		p_mSnapshot.Write(m_bHasFinishedRace);
+		p_mSnapshot.Write(m_bHumanPlayer);
+		p_mSnapshot.WriteVector(m_vLapTimes);
+	}
+
+	void ComponentRacer::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_iCurrentTrackPiece);
+		p_mSnapshot.Read(m_iCurrentTrackPieceForDistanceCheck);
+		p_mSnapshot.Read(m_iFurthestTrackPiece);
+		p_mSnapshot.Read(m_iCurrentLap);
+		p_mSnapshot.Read(m_iCurrentPosition);
+		p_mSnapshot.Read(m_bHasFinishedRace);
+		p_mSnapshot.Read(m_bHumanPlayer);
+		p_mSnapshot.ReadVector(m_vLapTimes);
+	}
+
 	void ComponentRacer::FinishLap(const HeatStroke::Event* p_pEvent)
 	{
 		std::string strRacerId = "";
@@ -100,7 +126,7 @@ namespace Kartaclysm
 		if (strRacerId == GetGameObject()->GetGUID())
 		{
 			m_bHasFinishedRace = true;
-			ComponentKartController* pKartController = static_cast<ComponentKartController*>(m_pGameObject->GetComponent("GOC_KartController"));
+			ComponentKartController* pKartController = m_pGameObject->GetComponent<ComponentKartController>();
 			pKartController->SetAI(true);
 			pKartController->RaceFinishParticles();
 		}
@@ -108,15 +134,16 @@ namespace Kartaclysm
 
 	void ComponentRacer::PositionCallback(const HeatStroke::Event* p_pEvent)
 	{
-		int iPosition;
-		p_pEvent->GetRequiredIntParameter(m_pGameObject->GetGUID(), iPosition);
+		int iPosition = m_mStandings.FindPlace(p_pEvent, m_pGameObject->GetGUID());
+		assert(iPosition >= 0 && "Racer Missing From Standings");
 
 		m_iCurrentPosition = iPosition + 1;
 	}
 
 	void ComponentRacer::SendHudLapEvent(const int p_iTotalLaps, const float p_fLapTime)
 	{
-		HeatStroke::Event* pEvent = new HeatStroke::Event(GetGameObject()->GetGUID() + "_HUD_Lap");
+		HeatStroke::Event* pEvent = new HeatStroke::Event("HUD_Lap");
+		pEvent->SetTarget(GetGameObject());
 		pEvent->SetIntParameter("Current", m_iCurrentLap);
 		pEvent->SetIntParameter("Total", p_iTotalLaps);
 		pEvent->SetFloatParameter("LapTime", p_fLapTime);
@@ -128,7 +155,7 @@ namespace Kartaclysm
 		m_iCurrentTrackPiece = p_iNewTrackPiece;
 
 		HeatStroke::GameObject* pTrackObject = m_pGameObject->GetManager()->GetGameObject("Track");
-		ComponentTrack* pTrack = static_cast<ComponentTrack*>(pTrackObject->GetComponent("GOC_Track"));
+		ComponentTrack* pTrack = pTrackObject->GetComponent<ComponentTrack>();
 		
 		if (pTrack == nullptr || !pTrack->IsUnderJump(p_iNewTrackPiece))
 		{
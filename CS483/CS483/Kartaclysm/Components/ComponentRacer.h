@@ -11,15 +11,18 @@
 #include <tinyxml2.h>
 
 #include "Component.h"
+#include "ComponentPool.h"
 #include "ComponentKartController.h"
 #include "EventManager.h"
+#include "RaceStandings.h"
 
 namespace Kartaclysm
 {
-	class ComponentRacer : public HeatStroke::Component
+	class ComponentRacer : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentRacer>
 	{
 	public:
-		virtual const std::string FamilyID() const override {return "GOC_Racer";}
+		static const char* StaticFamilyID() { return "GOC_Racer"; }
+		virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override {return "GOC_Racer";}
 
 		// Destruction.
@@ -36,6 +39,11 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Snapshots. The kart and driver are children, so they stay put.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		HeatStroke::GameObject* GetKart() {return m_pKart;}
 		void SetKart(HeatStroke::GameObject* p_pKart) { m_pKart = p_pKart; }
 		HeatStroke::GameObject* GetDriver() {return m_pDriver;}
@@ -79,6 +87,7 @@ namespace Kartaclysm
 		bool m_bHasFinishedRace;
 		bool m_bHumanPlayer;
 		std::vector<float> m_vLapTimes;
+		RaceStandings m_mStandings;
 	};
 }
 
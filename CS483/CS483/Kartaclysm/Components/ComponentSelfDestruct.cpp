@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentSelfDestruct.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -17,14 +18,17 @@ namespace Kartaclysm
 		Component(p_pGameObject),
 		m_pGameObject(p_pGameObject),
 		m_fTimer(p_fTimer),
+		m_fStartTimer(p_fTimer),
 		m_vCollisionTags(p_vCollisionTags),
 		m_bDestroy(false),
-		m_pCollisionDelegate(nullptr)
+		m_pCollisionDelegate(nullptr),
+		m_uiObject1HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object1Handle")),
+		m_uiObject2HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object2Handle"))
 	{
 		if (!m_vCollisionTags.empty())
 		{
 			m_pCollisionDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentSelfDestruct::HandleCollisionEvent, this, std::placeholders::_1));
-			HeatStroke::EventManager::Instance()->AddListener("Collision", m_pCollisionDelegate);
+			HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 		}
 	}
 
@@ -32,12 +36,43 @@ namespace Kartaclysm
 	{
 		if (m_pCollisionDelegate != nullptr)
 		{
-			HeatStroke::EventManager::Instance()->RemoveListener("Collision", m_pCollisionDelegate);
+			HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 			delete m_pCollisionDelegate;
 			m_pCollisionDelegate = nullptr;
 		}
 	}
 
+	void ComponentSelfDestruct::Deactivate()
+	{
+		if (m_pCollisionDelegate != nullptr)
+		{
+			HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+		}
+	}
+
+	void ComponentSelfDestruct::Reactivate()
+	{
+		m_fTimer = m_fStartTimer;
+		m_bDestroy = false;
+
+		if (m_pCollisionDelegate != nullptr)
+		{
+			HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+		}
+	}
+
+	void ComponentSelfDestruct::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_bDestroy);
+		p_mSnapshot.Write(m_fTimer);
+	}
+
+	void ComponentSelfDestruct::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_bDestroy);
+		p_mSnapshot.Read(m_fTimer);
+	}
+
 	HeatStroke::Component* ComponentSelfDestruct::CreateComponent(
 		HeatStroke::GameObject* p_pGameObject,
 		tinyxml2::XMLNode* p_pBaseNode,
@@ -87,18 +122,20 @@ namespace Kartaclysm
 
 	void ComponentSelfDestruct::HandleCollisionEvent(const HeatStroke::Event* p_pEvent)
 	{
-		std::string strGUID1, strGUID2;
-		p_pEvent->GetRequiredGameObjectParameter("Object1GUID", strGUID1);
-		p_pEvent->GetRequiredGameObjectParameter("Object2GUID", strGUID2);
+		int iHandle1, iHandle2;
+		p_pEvent->GetRequiredIntParameter(m_uiObject1HandleID, iHandle1);
+		p_pEvent->GetRequiredIntParameter(m_uiObject2HandleID, iHandle2);
+		HeatStroke::GameObjectHandle mHandle1(static_cast<unsigned int>(iHandle1));
+		HeatStroke::GameObjectHandle mHandle2(static_cast<unsigned int>(iHandle2));
 
 		HeatStroke::GameObject* pOther = nullptr;
-		if (strGUID1.compare(m_pGameObject->GetGUID()) == 0)
+		if (mHandle1 == m_pGameObject->GetHandle())
 		{
-			pOther = m_pGameObject->GetManager()->GetGameObject(strGUID2);
+			pOther = m_pGameObject->GetManager()->GetGameObject(mHandle2);
 		}
-		else if (strGUID2.compare(m_pGameObject->GetGUID()) == 0)
+		else if (mHandle2 == m_pGameObject->GetHandle())
 		{
-			pOther = m_pGameObject->GetManager()->GetGameObject(strGUID1);
+			pOther = m_pGameObject->GetManager()->GetGameObject(mHandle1);
 		}
 
 		if (pOther != nullptr)
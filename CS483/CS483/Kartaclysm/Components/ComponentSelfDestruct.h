@@ -24,7 +24,8 @@ namespace Kartaclysm
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_SelfDestruct"; }
+		static const char* StaticFamilyID()						{ return "GOC_SelfDestruct"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_SelfDestruct"; }
 
 		// Destruction.
@@ -41,6 +42,16 @@ namespace Kartaclysm
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Recycling.
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Deactivate() override;
+		virtual void Reactivate() override;
+
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -67,10 +78,15 @@ namespace Kartaclysm
 
 		bool m_bDestroy;
 		float m_fTimer;
+		float m_fStartTimer;
 		std::vector<std::string> m_vCollisionTags;
 
 	private:
 		std::function<void(const HeatStroke::Event*)>* m_pCollisionDelegate;
+
+		// Collision parameter names, interned once.
+		HeatStroke::EventParameterID m_uiObject1HandleID;
+		HeatStroke::EventParameterID m_uiObject2HandleID;
 	};
 }
 
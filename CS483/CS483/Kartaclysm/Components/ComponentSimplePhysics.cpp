@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentSimplePhysics.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -31,12 +32,18 @@ namespace Kartaclysm
 		m_fDirection(0.0f),
 		m_bAirborne(true),
 		m_fVerticalSpeed(p_fVerticalSpeed),
+		m_fStartSpeed(p_fSpeed),
+		m_fStartVerticalSpeed(p_fVerticalSpeed),
 		m_pOutsideForce(glm::vec3()),
 
-		m_sPreviousWallCollision("")
+		m_sPreviousWallCollision(""),
+		m_uiObject1HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object1Handle")),
+		m_uiObject2HandleID(HeatStroke::EventTypeRegistry::InternParameter("Object2Handle")),
+		m_uiNormalXID(HeatStroke::EventTypeRegistry::InternParameter("NormalX")),
+		m_uiNormalZID(HeatStroke::EventTypeRegistry::InternParameter("NormalZ"))
 	{
 		m_pCollisionDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentSimplePhysics::HandleCollisionEvent, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 
 		if (p_fVerticalSpeed > 0.0f)
 		{
@@ -48,7 +55,7 @@ namespace Kartaclysm
 
 	ComponentSimplePhysics::~ComponentSimplePhysics()
 	{
-		HeatStroke::EventManager::Instance()->RemoveListener("Collision", m_pCollisionDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
 		delete m_pCollisionDelegate;
 		m_pCollisionDelegate = nullptr;
 
@@ -93,7 +100,55 @@ namespace Kartaclysm
 		HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
 	}
 
-	void ComponentSimplePhysics::Update(const float p_fDelta)
+	void ComponentSimplePhysics::Deactivate()
+	{
+		HeatStroke::EventManager::Instance()->RemoveListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+
+		HeatStroke::Event* pEvent = new HeatStroke::Event("TrackHeightRegister");
+		pEvent->SetGameObjectParameter("Unregister", GetGameObject()->GetGUID());
+		HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
+	}
+
+	void ComponentSimplePhysics::Reactivate()
+	{
+		m_fGroundHeight = m_fHeightAboveGroundStat;
+		m_fSpeed = m_fStartSpeed;
+		m_fDirection = 0.0f;
+		m_bAirborne = true;
+		m_fVerticalSpeed = m_fStartVerticalSpeed;
+		m_pOutsideForce = glm::vec3();
+		m_sPreviousWallCollision = "";
+		m_fPreviousHeight = m_pGameObject->GetTransform().GetTranslation().y;
+
+		// Init() registers for track height again under the new GUID
+		HeatStroke::EventManager::Instance()->AddListener("CollisionEnter", m_pGameObject, m_pCollisionDelegate);
+	}
+
+	void ComponentSimplePhysics::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_pOutsideForce);
+		p_mSnapshot.Write(m_fGroundHeight);
+		p_mSnapshot.Write(m_fPreviousHeight);
+		p_mSnapshot.Write(m_fSpeed);
+		p_mSnapshot.Write(m_fDirection);
+		p_mSnapshot.Write(m_bAirborne);
+		p_mSnapshot.Write(m_fVerticalSpeed);
+		p_mSnapshot.WriteString(m_sPreviousWallCollision);
+	}
+
+	void ComponentSimplePhysics::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_pOutsideForce);
+		p_mSnapshot.Read(m_fGroundHeight);
+		p_mSnapshot.Read(m_fPreviousHeight);
+		p_mSnapshot.Read(m_fSpeed);
+		p_mSnapshot.Read(m_fDirection);
+		p_mSnapshot.Read(m_bAirborne);
+		p_mSnapshot.Read(m_fVerticalSpeed);
+		p_mSnapshot.ReadString(m_sPreviousWallCollision);
+	}
+
+	void ComponentSimplePhysics::ParallelUpdate(const float p_fDelta)
 	{
 		// Speeding up & slowing down
 		UpdateSpeed(p_fDelta);
@@ -165,40 +220,37 @@ namespace Kartaclysm
 
 	void ComponentSimplePhysics::HandleCollisionEvent(const HeatStroke::Event* p_pEvent)
 	{
-		std::string guid1, guid2;
-		p_pEvent->GetRequiredGameObjectParameter("Object1GUID", guid1);
-		p_pEvent->GetRequiredGameObjectParameter("Object2GUID", guid2);
+		int iHandle1, iHandle2;
+		p_pEvent->GetRequiredIntParameter(m_uiObject1HandleID, iHandle1);
+		p_pEvent->GetRequiredIntParameter(m_uiObject2HandleID, iHandle2);
+		HeatStroke::GameObjectHandle mHandle1(static_cast<unsigned int>(iHandle1));
+		HeatStroke::GameObjectHandle mHandle2(static_cast<unsigned int>(iHandle2));
+
+		HeatStroke::GameObject* pOther = nullptr;
+		if (mHandle1 == m_pGameObject->GetHandle())
+		{
+			pOther = m_pGameObject->GetManager()->GetGameObject(mHandle2);
+		}
+		else if (mHandle2 == m_pGameObject->GetHandle())
+		{
+			pOther = m_pGameObject->GetManager()->GetGameObject(mHandle1);
+		}
 
-		if (guid1.compare(m_pGameObject->GetGUID()) == 0 || guid2.compare(m_pGameObject->GetGUID()) == 0)
+		if (pOther != nullptr)
 		{
-			std::string other;
-			if (guid1.compare(m_pGameObject->GetGUID()) == 0)
-			{
-				other = guid2;
-			}
-			else
-			{
-				other = guid1;
-			}
-			
 			// Wall collisions
-			if (m_pGameObject->GetManager()->GetGameObject(other)->HasTag("Wall") && other.compare(m_sPreviousWallCollision) != 0)
+			if (pOther->HasTag("Wall") && pOther->GetGUID().compare(m_sPreviousWallCollision) != 0)
 			{
-				m_sPreviousWallCollision = other;
-
-				int xAligned;
-				int zAligned;
-				p_pEvent->GetOptionalIntParameter("XAligned", xAligned, 0);
-				p_pEvent->GetOptionalIntParameter("ZAligned", zAligned, 0);
-
-				if (xAligned == 1)
-				{
-					m_fDirection = -m_fDirection;
-				}
-				else if (zAligned == 1)
-				{
-					m_fDirection = 3.141592f - m_fDirection;
-				}
+				m_sPreviousWallCollision = pOther->GetGUID();
+
+				// Bounce off, reflecting the direction about the wall's normal
+				glm::vec3 normal = glm::vec3();
+				p_pEvent->GetRequiredFloatParameter(m_uiNormalXID, normal.x);
+				p_pEvent->GetRequiredFloatParameter(m_uiNormalZID, normal.z);
+
+				glm::vec3 velocity = glm::vec3(sinf(m_fDirection), 0.0f, cosf(m_fDirection));
+				velocity = velocity - normal * (2.0f * glm::dot(velocity, normal));
+				m_fDirection = atan2f(velocity.x, velocity.z);
 			}
 		}
 	}
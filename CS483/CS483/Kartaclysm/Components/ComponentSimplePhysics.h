@@ -11,18 +11,20 @@
 #include <tinyxml2.h>
 
 #include "Component.h"
+#include "ComponentPool.h"
 #include "GameObject.h"
 #include "EventManager.h"
 
 namespace Kartaclysm
 {
-	class ComponentSimplePhysics : public HeatStroke::Component
+	class ComponentSimplePhysics : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentSimplePhysics>
 	{
 	public:
 		//--------------------------------------------------------------------------
 		// Public methods
 		//--------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override		{ return "GOC_SimplePhysics"; }
+		static const char* StaticFamilyID()						{ return "GOC_SimplePhysics"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_SimplePhysics"; }
 
 		// Destruction.
@@ -37,7 +39,21 @@ namespace Kartaclysm
 
 		// Game Loop methods.
 		virtual void Init() override;
-		virtual void Update(const float p_fDelta) override;
+		virtual void Update(const float p_fDelta) override {}
+
+		// Only moves its own GameObject, so it all happens in parallel.
+		virtual bool HasParallelUpdate() const override { return true; }
+		virtual void ParallelUpdate(const float p_fDelta) override;
+
+		// Recycling.
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Deactivate() override;
+		virtual void Reactivate() override;
+
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
 
 		void SetTrackHeight(float p_fTrackHeight) { m_fGroundHeight = p_fTrackHeight; /*m_fPreviousHeight = p_fTrackHeight;*/}
 		void UpdateTrackHeight(float p_fTrackHeight) { m_fGroundHeight = p_fTrackHeight; }
@@ -93,10 +109,20 @@ namespace Kartaclysm
 		bool m_bAirborne;
 		float m_fVerticalSpeed;
 
+		// As created, for Reactivate().
+		float m_fStartSpeed;
+		float m_fStartVerticalSpeed;
+
 		std::string m_sPreviousWallCollision;
 
 	private:
 		std::function<void(const HeatStroke::Event*)>* m_pCollisionDelegate;
+
+		// Collision parameter names, interned once.
+		HeatStroke::EventParameterID m_uiObject1HandleID;
+		HeatStroke::EventParameterID m_uiObject2HandleID;
+		HeatStroke::EventParameterID m_uiNormalXID;
+		HeatStroke::EventParameterID m_uiNormalZID;
 	};
 }
 
@@ -2,6 +2,8 @@
 
 #include "ComponentTrackPiece.h"
 #include "ComponentAIDriver.h"
+#include "SceneSnapshot.h"
+#include "CollisionManager.h"
 
 namespace Kartaclysm
 {
@@ -17,10 +19,19 @@ namespace Kartaclysm
 		m_vNodeTriggers(p_vNodeTriggers),
 		m_iLeadHumanPosition(0),
 		m_iRearHumanPosition(0),
-		m_bHumanPositionsDirty(true)
+		m_bHumanPositionsDirty(true),
+		m_uiRacerTrackPieceUpdatedEventID(HeatStroke::EventTypeRegistry::Intern("RacerTrackPieceUpdated")),
+		m_uiHudWrongWayEventID(HeatStroke::EventTypeRegistry::Intern("HUD_WrongWay")),
+		m_mStandings(),
+		m_uiRacerHandleID(HeatStroke::EventTypeRegistry::InternParameter("racerHandle")),
+		m_uiTrackPieceHandleID(HeatStroke::EventTypeRegistry::InternParameter("TrackPieceHandle")),
+		m_uiDisplayID(HeatStroke::EventTypeRegistry::InternParameter("Display")),
+		m_vTrackPieceVersions(),
+		m_mRacerContacts(),
+		m_mPhysicsObjectContacts()
 	{
 		m_pRacerTrackPieceUpdatedDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentTrack::OnRacerTrackPieceCollision, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener("RacerTrackPieceUpdated", m_pRacerTrackPieceUpdatedDelegate);
+		HeatStroke::EventManager::Instance()->AddListener(m_uiRacerTrackPieceUpdatedEventID, m_pRacerTrackPieceUpdatedDelegate);
 
 		m_pRegisterDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentTrack::RegisterForTrackHeight, this, std::placeholders::_1));
 		HeatStroke::EventManager::Instance()->AddListener("TrackHeightRegister", m_pRegisterDelegate);
@@ -30,7 +41,7 @@ namespace Kartaclysm
 	{
 		HeatStroke::AudioPlayer::Instance()->StopSoundEffect("Assets/Sounds/drive_on_grass.flac");
 
-		HeatStroke::EventManager::Instance()->RemoveListener("RacerTrackPieceUpdated", m_pRacerTrackPieceUpdatedDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener(m_uiRacerTrackPieceUpdatedEventID, m_pRacerTrackPieceUpdatedDelegate);
 		delete m_pRacerTrackPieceUpdatedDelegate;
 
 		HeatStroke::EventManager::Instance()->RemoveListener("TrackHeightRegister", m_pRegisterDelegate);
@@ -51,25 +62,20 @@ namespace Kartaclysm
 	void ComponentTrack::Init()
 	{
 		// generate list of track pieces
-		for (HeatStroke::GameObject* pChildGameObject : m_pGameObject->GetChildren())
+		for (HeatStroke::GameObject* pChildGameObject : m_pGameObject->GetChildrenWithTag("Trackpiece"))
 		{
-			for (const std::string& strTag : pChildGameObject->GetTagList())
+			// Deal with underjump shenanigans
+			ComponentTrackPiece* pPiece = pChildGameObject->GetComponent<ComponentTrackPiece>();
+			if (pPiece != nullptr && pPiece->IsUnderJump())
 			{
-				if (strcmp(strTag.c_str(), "Trackpiece") == 0)
-				{
-					// Deal with underjump shenanigans
-					ComponentTrackPiece* pPiece = static_cast<ComponentTrackPiece*>(pChildGameObject->GetComponent("GOC_TrackPiece"));
-					if (pPiece != nullptr && pPiece->IsUnderJump())
-					{
-						m_vUnderTrackPieces.push_back(m_vTrackPieces.size());
-					}
-
-					// Add to the list
-					m_vTrackPieces.push_back(pChildGameObject);
-					break;
-				}
+				m_vUnderTrackPieces.push_back(m_vTrackPieces.size());
 			}
+
+			// Add to the list
+			m_vTrackPieces.push_back(pChildGameObject);
 		}
+
+		m_vTrackPieceVersions.assign(m_vTrackPieces.size(), 0);
 	}
 
 	void ComponentTrack::Update(const float p_fDelta)
@@ -79,41 +85,45 @@ namespace Kartaclysm
 		// Assume false before this is re-flagged during this update loop by "RacerTrackPieceUpdated" events.
 		m_bRacerIsOffroad = false;
 
-		// Iterate through track pieces to find which karts are located on them
-		std::vector<bool> racersOnTrackPieces(m_vRacers.size(), false);
+		// The pieces don't normally move, but if one has, every object is tested again.
+		bool bTrackMoved = false;
 		for (unsigned int i = 0; i < m_vTrackPieces.size(); ++i)
 		{
-			ComponentTrackPiece* trackComponent = (ComponentTrackPiece*)m_vTrackPieces[i]->GetComponent("GOC_TrackPiece");
-
-			if (trackComponent != nullptr)
+			if (m_vTrackPieces[i]->GetTransform().HasChangedSince(m_vTrackPieceVersions[i]))
 			{
-				// racer collision
-				for (unsigned int j = 0; j < m_vRacers.size(); ++j)
-				{
-					HeatStroke::GameObject* pRacerObject = m_vRacers[j]->GetGameObject();
+				bTrackMoved = true;
+			}
+		}
 
-					if (trackComponent->CheckInBounds(pRacerObject->GetTransform().GetTranslation()))
-					{
-						HeatStroke::Event* pEvent = new HeatStroke::Event("RacerTrackPieceUpdated");
-						pEvent->SetStringParameter("racerId", pRacerObject->GetGUID());
-						pEvent->SetStringParameter("TrackPieceId", m_vTrackPieces[i]->GetGUID());
-						HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
-						racersOnTrackPieces[j] = true;
-					}
-				}
+		// Find which track pieces the karts are located on
+		std::vector<bool> racersOnTrackPieces(m_vRacers.size(), false);
+		for (unsigned int j = 0; j < m_vRacers.size(); ++j)
+		{
+			HeatStroke::GameObject* pRacerObject = m_vRacers[j]->GetGameObject();
+			const std::vector<unsigned int>& vTrackPieces = FindTrackPieces(pRacerObject, m_mRacerContacts[pRacerObject->GetHandle().GetValue()], bTrackMoved);
 
-				// physics object heights
-				auto it = m_vPhysicsObjects.begin(), end = m_vPhysicsObjects.end();
-				for (; it != end; it++)
-				{
-					HeatStroke::GameObject* pPhysicsObject = it->second->GetGameObject();
+			// Sent every frame, moved or not, as the racer's state is worked out afresh from them.
+			for (unsigned int i = 0; i < vTrackPieces.size(); ++i)
+			{
+				HeatStroke::Event* pEvent = new (HeatStroke::EL_Frame) HeatStroke::Event(m_uiRacerTrackPieceUpdatedEventID);
+				pEvent->SetIntParameter(m_uiRacerHandleID, static_cast<int>(pRacerObject->GetHandle().GetValue()));
+				pEvent->SetIntParameter(m_uiTrackPieceHandleID, static_cast<int>(m_vTrackPieces[vTrackPieces[i]]->GetHandle().GetValue()));
+				HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
+				racersOnTrackPieces[j] = true;
+			}
+		}
 
-					if (trackComponent->CheckInBounds(pPhysicsObject->GetTransform().GetTranslation()))
-					{
-						ComponentTrackPiece* trackPiece = static_cast<ComponentTrackPiece*>(m_vTrackPieces[i]->GetComponent("GOC_TrackPiece"));
-						it->second->UpdateTrackHeight(trackPiece->HeightAtPosition(pPhysicsObject->GetTransform().GetTranslation()));
-					}
-				}
+		// physics object heights, from the last piece each is on
+		auto it = m_vPhysicsObjects.begin(), end = m_vPhysicsObjects.end();
+		for (; it != end; it++)
+		{
+			HeatStroke::GameObject* pPhysicsObject = it->second->GetGameObject();
+			const std::vector<unsigned int>& vTrackPieces = FindTrackPieces(pPhysicsObject, m_mPhysicsObjectContacts[it->first], bTrackMoved);
+
+			if (!vTrackPieces.empty())
+			{
+				ComponentTrackPiece* trackPiece = m_vTrackPieces[vTrackPieces.back()]->GetComponent<ComponentTrackPiece>();
+				it->second->UpdateTrackHeight(trackPiece->HeightAtPosition(pPhysicsObject->GetTransform().GetTranslation()));
 			}
 		}
 
@@ -153,7 +163,8 @@ namespace Kartaclysm
 		m_vRacers.push_back(p_pRacer);
 
 		// Queue HUD event for beginning lap count
-		HeatStroke::Event* pEvent = new HeatStroke::Event(p_pRacer->GetGameObject()->GetGUID() + "_HUD_Lap");
+		HeatStroke::Event* pEvent = new HeatStroke::Event("HUD_Lap");
+		pEvent->SetTarget(p_pRacer->GetGameObject());
 		pEvent->SetIntParameter("Current", 1);
 		pEvent->SetIntParameter("Total", m_iLapsToFinishTrack);
 		pEvent->SetFloatParameter("LapTime", 0.0f);
@@ -172,14 +183,22 @@ namespace Kartaclysm
 	void ComponentTrack::OnRacerTrackPieceCollision(const HeatStroke::Event* p_pEvent)
 	{
 		// parse event data
-		std::string strRacerId = "";
-		std::string strTrackPieceId = "";
-		p_pEvent->GetRequiredStringParameter("racerId", strRacerId);
-		p_pEvent->GetRequiredStringParameter("TrackPieceId", strTrackPieceId);
+		int iRacerHandle = 0;
+		int iTrackPieceHandle = 0;
+		p_pEvent->GetRequiredIntParameter(m_uiRacerHandleID, iRacerHandle);
+		p_pEvent->GetRequiredIntParameter(m_uiTrackPieceHandleID, iTrackPieceHandle);
 
 		// get racer and track piece
-		int iRacerIndex = GetRacerIndex(strRacerId);
-		unsigned int iTrackPieceIndex = GetTrackPieceIndex(strTrackPieceId);
+		HeatStroke::GameObjectManager* pManager = m_pGameObject->GetManager();
+		HeatStroke::GameObject* pRacerObject = pManager->GetGameObject(HeatStroke::GameObjectHandle(static_cast<unsigned int>(iRacerHandle)));
+		HeatStroke::GameObject* pTrackPieceObject = pManager->GetGameObject(HeatStroke::GameObjectHandle(static_cast<unsigned int>(iTrackPieceHandle)));
+		if (pRacerObject == nullptr || pTrackPieceObject == nullptr)
+		{
+			return;
+		}
+
+		int iRacerIndex = GetRacerIndex(pRacerObject);
+		unsigned int iTrackPieceIndex = GetTrackPieceIndex(pTrackPieceObject);
 		if (iTrackPieceIndex == UINT_MAX || iTrackPieceIndex >= m_vTrackPieces.size() || iRacerIndex < 0)
 		{
 			return;
@@ -208,8 +227,8 @@ namespace Kartaclysm
 		m_vRacers[iRacerIndex]->SetCurrentTrackPiece(iTrackPieceIndex);
 
 		// update track height for racer + offroad
-		ComponentKartController* kartController = (ComponentKartController*)m_vRacers[iRacerIndex]->GetGameObject()->GetComponent("GOC_KartController");
-		ComponentTrackPiece* trackPiece = (ComponentTrackPiece*)m_pGameObject->GetManager()->GetGameObject(strTrackPieceId)->GetComponent("GOC_TrackPiece");
+		ComponentKartController* kartController = m_vRacers[iRacerIndex]->GetGameObject()->GetComponent<ComponentKartController>();
+		ComponentTrackPiece* trackPiece = pTrackPieceObject->GetComponent<ComponentTrackPiece>();
 		if (kartController != nullptr && trackPiece != nullptr)
 		{
 			glm::vec3 pos = kartController->GetGameObject()->GetTransform().GetTranslation();
@@ -222,7 +241,7 @@ namespace Kartaclysm
 			}
 
 			// Dealing with triggered AI nodes
-			ComponentAIDriver* aiDriver = static_cast<ComponentAIDriver*>(m_vRacers[iRacerIndex]->GetGameObject()->GetComponent("GOC_AIDriver"));
+			ComponentAIDriver* aiDriver = m_vRacers[iRacerIndex]->GetGameObject()->GetComponent<ComponentAIDriver>();
 			if (aiDriver != nullptr)
 			{
 				//if (!kartController->IsAirborne()) // This doesn't work because IsAirborne won't have updated yet
@@ -230,7 +249,7 @@ namespace Kartaclysm
 				{
 					for (unsigned int i = 0; i < m_vNodeTriggers.size(); i++)
 					{
-						if (strTrackPieceId.compare(m_vNodeTriggers[i].trackPieceIndex) == 0)
+						if (pTrackPieceObject->GetGUID().compare(m_vNodeTriggers[i].trackPieceIndex) == 0)
 						{
 							aiDriver->SetNode(m_vNodeTriggers[i].node);
 						}
@@ -240,6 +259,45 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentTrack::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fRaceTime);
+		p_mSnapshot.Write(m_bRacerIsOffroad);
+		p_mSnapshot.Write(m_iLeadHumanPosition);
+		p_mSnapshot.Write(m_iRearHumanPosition);
+		p_mSnapshot.Write(m_bHumanPositionsDirty);
+
+		std::vector<unsigned int> vRacerHandles;
+		for (unsigned int i = 0; i < m_vRacers.size(); ++i)
+		{
+			vRacerHandles.push_back(m_vRacers[i]->GetGameObject()->GetHandle().GetValue());
+		}
+		p_mSnapshot.WriteVector(vRacerHandles);
+	}
+
+	void ComponentTrack::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		p_mSnapshot.Read(m_fRaceTime);
+		p_mSnapshot.Read(m_bRacerIsOffroad);
+		p_mSnapshot.Read(m_iLeadHumanPosition);
+		p_mSnapshot.Read(m_iRearHumanPosition);
+		p_mSnapshot.Read(m_bHumanPositionsDirty);
+
+		std::vector<unsigned int> vRacerHandles;
+		p_mSnapshot.ReadVector(vRacerHandles);
+
+		m_vRacers.clear();
+		for (unsigned int i = 0; i < vRacerHandles.size(); ++i)
+		{
+			HeatStroke::GameObject* pRacer = m_pGameObject->GetManager()->GetGameObject(HeatStroke::GameObjectHandle(vRacerHandles[i]));
+			m_vRacers.push_back(pRacer->GetComponent<ComponentRacer>());
+		}
+
+		// Restored objects may be back where they were without their versions having moved.
+		m_mRacerContacts.clear();
+		m_mPhysicsObjectContacts.clear();
+	}
+
 	void ComponentTrack::RegisterForTrackHeight(const HeatStroke::Event* p_pEvent)
 	{
 		std::string strRegister, strUnregister;
@@ -249,21 +307,41 @@ namespace Kartaclysm
 		if (strRegister != "")
 		{
 			HeatStroke::GameObject* pGO = GetGameObject()->GetManager()->GetGameObject(strRegister);
-			ComponentSimplePhysics* pPhysics = static_cast<ComponentSimplePhysics*>(pGO->GetComponent("GOC_SimplePhysics"));
+			ComponentSimplePhysics* pPhysics = pGO->GetComponent<ComponentSimplePhysics>();
 			m_vPhysicsObjects[strRegister] = pPhysics;
 		}
 		else if (strUnregister != "")
 		{
-			m_vPhysicsObjects.erase(m_vPhysicsObjects.find(strUnregister));
+			m_vPhysicsObjects.erase(strUnregister);
+			m_mPhysicsObjectContacts.erase(strUnregister);
+		}
+	}
+
+	const std::vector<unsigned int>& ComponentTrack::FindTrackPieces(const HeatStroke::GameObject* p_pObject, TrackPieceContacts& p_mContacts, const bool p_bTrackMoved)
+	{
+		const bool bMoved = p_pObject->GetTransform().HasChangedSince(p_mContacts.uiTransformVersion);
+		if (bMoved || p_bTrackMoved)
+		{
+			p_mContacts.vTrackPieces.clear();
+
+			const glm::vec3& vPosition = p_pObject->GetTransform().GetTranslation();
+			for (unsigned int i = 0; i < m_vTrackPieces.size(); ++i)
+			{
+				ComponentTrackPiece* trackComponent = m_vTrackPieces[i]->GetComponent<ComponentTrackPiece>();
+				if (trackComponent != nullptr && trackComponent->CheckInBounds(vPosition))
+				{
+					p_mContacts.vTrackPieces.push_back(i);
+				}
+			}
 		}
+		return p_mContacts.vTrackPieces;
 	}
 
-	int ComponentTrack::GetTrackPieceIndex(const std::string& p_strTrackPieceId)
+	int ComponentTrack::GetTrackPieceIndex(const HeatStroke::GameObject* p_pTrackPiece)
 	{
-		const char* strTrackPieceId = p_strTrackPieceId.c_str();
 		for (unsigned int i = 0; i < m_vTrackPieces.size(); ++i)
 		{
-			if (strcmp(strTrackPieceId, m_vTrackPieces[i]->GetGUID().c_str()) == 0)
+			if (m_vTrackPieces[i] == p_pTrackPiece)
 			{
 				return i;
 			}
@@ -278,12 +356,11 @@ namespace Kartaclysm
 		return iNextTrackPieceIndex >= m_vTrackPieces.size() ? 0 : iNextTrackPieceIndex;
 	}
 
-	int ComponentTrack::GetRacerIndex(const std::string& p_strRacerId)
+	int ComponentTrack::GetRacerIndex(const HeatStroke::GameObject* p_pRacer)
 	{
-		const char* strRacerId = p_strRacerId.c_str();
 		for (unsigned int i = 0; i < m_vRacers.size(); ++i)
 		{
-			if (strcmp(strRacerId, m_vRacers[i]->GetGameObject()->GetGUID().c_str()) == 0)
+			if (m_vRacers[i]->GetGameObject() == p_pRacer)
 			{
 				return i;
 			}
@@ -391,7 +468,8 @@ namespace Kartaclysm
 		HeatStroke::GameObject* pRacerGameObject = p_pRacer->GetGameObject();
 		glm::vec3 vResetPosition = m_vTrackPieces[p_pRacer->GetFurthestTrackPiece()]->GetTransform().GetTranslation();
 		p_pRacer->GetGameObject()->GetTransform().SetTranslation(vResetPosition);
-		static_cast<ComponentKartController*>(pRacerGameObject->GetComponent("GOC_KartController"))->SetSpeed(0.0f);
+		HeatStroke::CollisionManager::Instance()->ResetSweep(pRacerGameObject->GetGUID());
+		pRacerGameObject->GetComponent<ComponentKartController>()->SetSpeed(0.0f);
 	}
 
 	// TODO: move to component of racer object once that is created
@@ -402,16 +480,19 @@ namespace Kartaclysm
 			glm::vec3 trackForwardDirection = DetermineTrackForwardDirection(pRacer->GetCurrentTrackPiece());
 			glm::vec3 racerForwardDirection = DetermineRacerForwardDirection(pRacer->GetGameObject()->GetGUID());
 
-			HeatStroke::Event* pEvent = new HeatStroke::Event(pRacer->GetGameObject()->GetGUID() + "_HUD_WrongWay");
+			HeatStroke::Event* pEvent = new HeatStroke::Event(m_uiHudWrongWayEventID);
+			pEvent->SetTarget(pRacer->GetGameObject());
 			if (glm::dot(trackForwardDirection, racerForwardDirection) < 0.0f)
 			{
-				pEvent->SetIntParameter("Display", 1);
+				pEvent->SetIntParameter(m_uiDisplayID, 1);
 			}
 			else
 			{
-				pEvent->SetIntParameter("Display", 0);
+				pEvent->SetIntParameter(m_uiDisplayID, 0);
 			}
-			HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
+
+			// Sent every frame, but the HUD only needs to hear when it flips.
+			HeatStroke::EventManager::Instance()->QueueEvent(pEvent, HeatStroke::QM_LatestIfChanged);
 		}
 	}
 
@@ -469,7 +550,7 @@ namespace Kartaclysm
 				glm::vec3 vRacerPositionA = p_pRacerA->GetGameObject()->GetTransform().GetTranslation();
 				glm::vec3 vRacerPositionB = p_pRacerB->GetGameObject()->GetTransform().GetTranslation();
 
-				ComponentTrackPiece* pTrackComponent = static_cast<ComponentTrackPiece*>(m_vTrackPieces[iCurrentTrackPieceA]->GetComponent("GOC_TrackPiece"));
+				ComponentTrackPiece* pTrackComponent = m_vTrackPieces[iCurrentTrackPieceA]->GetComponent<ComponentTrackPiece>();
 				return pTrackComponent->IsAhead(vRacerPositionA, vRacerPositionB);
 			}
 		}
@@ -515,11 +596,10 @@ namespace Kartaclysm
 	void ComponentTrack::TriggerRaceStandingsUpdateEvent()
 	{
 		HeatStroke::Event* pEvent = new HeatStroke::Event("RaceStandingsUpdate");
+		m_mStandings.SetRacerCount(pEvent, m_vRacers.size());
 		for (unsigned int i = 0; i < m_vRacers.size(); ++i)
 		{
-			std::string strGUID = m_vRacers[i]->GetGameObject()->GetGUID();
-			pEvent->SetIntParameter(strGUID, i);
-			pEvent->SetStringParameter(std::to_string(i), strGUID);
+			m_mStandings.SetRacerAt(pEvent, i, m_vRacers[i]->GetGameObject()->GetGUID());
 		}
 		HeatStroke::EventManager::Instance()->TriggerEvent(pEvent);
 	}
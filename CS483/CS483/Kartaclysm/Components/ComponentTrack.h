@@ -12,6 +12,7 @@
 #include "ComponentKartController.h"
 #include "ComponentRacer.h"
 #include "ComponentSimplePhysics.h"
+#include "RaceStandings.h"
 #include "Component.h"
 #include "GameObject.h"
 #include "EventManager.h"
@@ -38,7 +39,8 @@ namespace Kartaclysm
 				std::string trackPieceIndex;
 			};
 
-			virtual const std::string FamilyID() const override { return "GOC_Track"; }
+			static const char* StaticFamilyID() { return "GOC_Track"; }
+			virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 			virtual const std::string ComponentID() const override { return "GOC_Track"; }
 
 			static HeatStroke::Component* CreateComponent(
@@ -49,6 +51,12 @@ namespace Kartaclysm
 			virtual void Init() override;
 			virtual void Update(const float p_fDelta) override;
 
+			// Snapshots. Racers are kept in standings order, by handle. Physics objects
+			// register and unregister themselves as they come and go.
+			virtual bool IsSnapshottable() const override { return true; }
+			virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+			virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 			void RegisterRacer(HeatStroke::GameObject* p_pRacer) { RegisterRacer(dynamic_cast<ComponentRacer*>(p_pRacer->GetComponent("GOC_Racer"))); }
 			void RegisterRacer(ComponentRacer* p_pRacer);
 			void RegisterAIRacer(HeatStroke::GameObject* p_pRacer) { RegisterAIRacer(dynamic_cast<ComponentRacer*>(p_pRacer->GetComponent("GOC_Racer"))); }
@@ -86,10 +94,35 @@ namespace Kartaclysm
 			std::map<std::string, ComponentSimplePhysics*> m_vPhysicsObjects;
 			std::function<void(const HeatStroke::Event*)>* m_pRacerTrackPieceUpdatedDelegate;
 			std::function<void(const HeatStroke::Event*)>* m_pRegisterDelegate;
+			HeatStroke::EventTypeID m_uiRacerTrackPieceUpdatedEventID;
+			HeatStroke::EventTypeID m_uiHudWrongWayEventID;
+			RaceStandings m_mStandings;
+
+			// Parameter names of the events sent for every racer every frame.
+			HeatStroke::EventParameterID m_uiRacerHandleID;
+			HeatStroke::EventParameterID m_uiTrackPieceHandleID;
+			HeatStroke::EventParameterID m_uiDisplayID;
+
+			// The pieces an object was on when last tested, and its transform's version
+			// then. An object that hasn't moved since, on a track that hasn't either, is
+			// still on the same pieces, so only objects that moved are tested again.
+			struct TrackPieceContacts
+			{
+				TrackPieceContacts() : uiTransformVersion(0), vTrackPieces() {}
+
+				unsigned int uiTransformVersion;
+				std::vector<unsigned int> vTrackPieces;
+			};
+
+			std::vector<unsigned int> m_vTrackPieceVersions;
+			std::map<unsigned int, TrackPieceContacts> m_mRacerContacts;			// By racer handle.
+			std::map<std::string, TrackPieceContacts> m_mPhysicsObjectContacts;	// By GUID, as m_vPhysicsObjects.
+
+			const std::vector<unsigned int>& FindTrackPieces(const HeatStroke::GameObject* p_pObject, TrackPieceContacts& p_mContacts, const bool p_bTrackMoved);
 
-			int GetTrackPieceIndex(const std::string& p_strTrackPieceId);
+			int GetTrackPieceIndex(const HeatStroke::GameObject* p_pTrackPiece);
 			int GetNextTrackPieceIndex(int p_iCurrentTrackPieceIndex) const;
-			int GetRacerIndex(const std::string& p_strRacerId);
+			int GetRacerIndex(const HeatStroke::GameObject* p_pRacer);
 
 			void UpdateRacerPositions();
 			void ResetRacerPosition(ComponentRacer* p_pRacer);
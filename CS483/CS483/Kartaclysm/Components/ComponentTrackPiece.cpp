@@ -27,7 +27,13 @@ namespace Kartaclysm
 		m_vPivotAxis(p_vPivotAxis),
 		m_vOffroadSquares(p_vOffroadSquares),
 		m_vOffroadTriangles(p_vOffroadTriangles),
-		m_bIsUnderJump(p_bIsUnderJump)
+		m_bIsUnderJump(p_bIsUnderJump),
+		m_uiTransformVersion(0),
+		m_vOrigin(),
+		m_qRotation(),
+		m_vPlane(),
+		m_vPivot(),
+		m_vWorldPivotAxis()
 	{
 	}
 
@@ -151,7 +157,8 @@ namespace Kartaclysm
 	{
 		float xMin, xMax, zMin, zMax;
 
-		glm::vec3 origin = m_pGameObject->GetTransform().GetTranslation();
+		UpdateCachedTransform();
+		const glm::vec3& origin = m_vOrigin;
 		xMin = origin.x - (m_fWidthX / 2.0f);
 		xMax = origin.x + (m_fWidthX / 2.0f);
 		zMin = origin.z - (m_fWidthZ / 2.0f);
@@ -169,7 +176,8 @@ namespace Kartaclysm
 
 	float ComponentTrackPiece::HeightAtPosition(glm::vec3 p_pPosition)
 	{
-		float baseHeight = m_pGameObject->GetTransform().GetTranslation().y;
+		UpdateCachedTransform();
+		float baseHeight = m_vOrigin.y;
 
 		if (m_eHeightFunction == Flat)
 		{
@@ -177,8 +185,8 @@ namespace Kartaclysm
 		}
 
 		glm::vec3 checkPosition = p_pPosition;
-		checkPosition = checkPosition - m_pGameObject->GetTransform().GetTranslation();
-		checkPosition = checkPosition * -m_pGameObject->GetTransform().GetRotation();
+		checkPosition = checkPosition - m_vOrigin;
+		checkPosition = checkPosition * -m_qRotation;
 
 		float progress = 1.0f - ((checkPosition.x / m_fWidthX) + 0.5f);
 		
@@ -207,9 +215,10 @@ namespace Kartaclysm
 
 	bool ComponentTrackPiece::IsOffroadAtPosition(const glm::vec3 &p_pPosition)
 	{
+		UpdateCachedTransform();
 		glm::vec3 checkPosition = p_pPosition;
-		checkPosition = checkPosition - m_pGameObject->GetTransform().GetTranslation();
-		checkPosition = checkPosition * -m_pGameObject->GetTransform().GetRotation();
+		checkPosition = checkPosition - m_vOrigin;
+		checkPosition = checkPosition * -m_qRotation;
 
 		float x = (checkPosition.x / m_fWidthX) * 2.0f;
 		float z = (checkPosition.z / m_fWidthZ) * 2.0f;
@@ -276,29 +285,49 @@ namespace Kartaclysm
 
 	bool ComponentTrackPiece::IsAheadOnStraight(const glm::vec3& p_vFirstRacerPosition, const glm::vec3& p_vSecondRacerPosition) const
 	{
-		glm::vec4 vPlane = CalculatePlane();
+		UpdateCachedTransform();
 
-		float fFirstRacerDistance = GetDistanceToPlane(vPlane, p_vFirstRacerPosition);
-		float fSecondRacerDistance = GetDistanceToPlane(vPlane, p_vSecondRacerPosition);
+		float fFirstRacerDistance = GetDistanceToPlane(m_vPlane, p_vFirstRacerPosition);
+		float fSecondRacerDistance = GetDistanceToPlane(m_vPlane, p_vSecondRacerPosition);
 
 		return fFirstRacerDistance <= fSecondRacerDistance;
 	}
 
 	bool ComponentTrackPiece::IsAheadOnTurn(const glm::vec3& p_vFirstRacerPosition, const glm::vec3& p_vSecondRacerPosition) const
 	{
-		glm::vec3 vPivot = CalculatePivot();
-		glm::vec3 vPivotAxis = CalculatePivotAxis();
+		UpdateCachedTransform();
 
-		glm::vec3 v1 = glm::normalize(p_vFirstRacerPosition - vPivot);
-		glm::vec3 v2 = glm::normalize(p_vSecondRacerPosition - vPivot);
+		glm::vec3 v1 = glm::normalize(p_vFirstRacerPosition - m_vPivot);
+		glm::vec3 v2 = glm::normalize(p_vSecondRacerPosition - m_vPivot);
 
-		return glm::dot(vPivotAxis, v1) <= glm::dot(vPivotAxis, v2);
+		return glm::dot(m_vWorldPivotAxis, v1) <= glm::dot(m_vWorldPivotAxis, v2);
+	}
+
+	void ComponentTrackPiece::UpdateCachedTransform() const
+	{
+		const HeatStroke::HierarchicalTransform& trackTransform = m_pGameObject->GetTransform();
+		if (!trackTransform.HasChangedSince(m_uiTransformVersion))
+		{
+			return;
+		}
+
+		m_vOrigin = trackTransform.GetTranslation();
+		m_qRotation = trackTransform.GetRotation();
+
+		if (m_ePositionFunction == Straight)
+		{
+			m_vPlane = CalculatePlane();
+		}
+		else if (m_ePositionFunction == Turn)
+		{
+			m_vPivot = CalculatePivot();
+			m_vWorldPivotAxis = CalculatePivotAxis();
+		}
 	}
 
-	//TODO would be great to calculate this once and store it for all future uses
 	glm::vec4 ComponentTrackPiece::CalculatePlane() const
 	{
-		HeatStroke::HierarchicalTransform trackTransform = m_pGameObject->GetTransform();
+		const HeatStroke::HierarchicalTransform& trackTransform = m_pGameObject->GetTransform();
 		glm::quat qTrackRotation = trackTransform.GetRotation();
 		qTrackRotation.y *= -1.0f;
 		glm::vec3 vNormal = glm::vec3(1.0f, 0.0f, 0.0f) * qTrackRotation;
@@ -312,19 +341,17 @@ namespace Kartaclysm
 			(sqrt(pow(p_vPlane.x, 2) + pow(p_vPlane.y, 2) + pow(p_vPlane.z, 2)));
 	}
 
-	//TODO would be great to calculate this once and store it for all future uses
 	glm::vec3 ComponentTrackPiece::CalculatePivot() const
 	{
-		HeatStroke::HierarchicalTransform trackTransform = m_pGameObject->GetTransform();
+		const HeatStroke::HierarchicalTransform& trackTransform = m_pGameObject->GetTransform();
 		glm::quat qTrackRotation = trackTransform.GetRotation();
 		qTrackRotation.y *= -1.0f;
 		return trackTransform.GetTranslation() + (m_vPivotPosition * qTrackRotation);
 	}
 
-	//TODO would be great to calculate this once and store it for all future uses
 	glm::vec3 ComponentTrackPiece::CalculatePivotAxis() const
 	{
-		HeatStroke::HierarchicalTransform trackTransform = m_pGameObject->GetTransform();
+		const HeatStroke::HierarchicalTransform& trackTransform = m_pGameObject->GetTransform();
 		glm::quat qTrackRotation = trackTransform.GetRotation();
 		qTrackRotation.y *= -1.0f;
 		return glm::normalize(m_vPivotAxis * qTrackRotation);
@@ -11,6 +11,7 @@
 
 #include "Common.h"
 #include "Component.h"
+#include "ComponentPool.h"
 #include "GameObject.h"
 
 namespace Kartaclysm
@@ -49,12 +50,13 @@ namespace Kartaclysm
 		float z3;
 	};
 
-	class ComponentTrackPiece : public HeatStroke::Component
+	class ComponentTrackPiece : public HeatStroke::Component, public HeatStroke::PooledComponent<ComponentTrackPiece>
 	{
 		public:
 			~ComponentTrackPiece();
 
-			virtual const std::string FamilyID() const override { return "GOC_TrackPiece"; }
+			static const char* StaticFamilyID() { return "GOC_TrackPiece"; }
+			virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 			virtual const std::string ComponentID() const override { return "GOC_TrackPiece"; }
 
 			static HeatStroke::Component* CreateComponent(
@@ -65,6 +67,8 @@ namespace Kartaclysm
 			virtual void Init() override;
 			virtual void Update(const float p_fDelta) override;
 
+			virtual bool IsSnapshottable() const override { return true; }
+
 			bool CheckInBounds(glm::vec3 p_pPosition);
 			float HeightAtPosition(glm::vec3 p_pPosition);
 			bool IsOffroadAtPosition(const glm::vec3 &p_pPosition);
@@ -108,6 +112,8 @@ namespace Kartaclysm
 			glm::vec3 CalculatePivot() const;
 			glm::vec3 CalculatePivotAxis() const;
 
+			void UpdateCachedTransform() const;
+
 			static PositionFunction ParsePositionFunction(const tinyxml2::XMLNode* p_pNode);
 			static glm::vec3 ParsePivotPosition(const tinyxml2::XMLNode* p_pNode);
 			static glm::vec3 ParsePivotAxis(const tinyxml2::XMLNode* p_pNode);
@@ -117,6 +123,15 @@ namespace Kartaclysm
 
 			bool m_bIsUnderJump;
 
+			// World-space values worked out from the transform, redone only when it has
+			// changed, which for a track piece is normally just the once.
+			mutable unsigned int m_uiTransformVersion;
+			mutable glm::vec3 m_vOrigin;
+			mutable glm::quat m_qRotation;
+			mutable glm::vec4 m_vPlane;
+			mutable glm::vec3 m_vPivot;
+			mutable glm::vec3 m_vWorldPivotAxis;
+
 			bool PointInTriangle(const glm::vec2 &p, const glm::vec2 &p0, const glm::vec2 &p1, const glm::vec2 &p2);
 	};
 }
@@ -38,6 +38,9 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override {}
 		virtual void SyncTransform() override;
 
+		// Snapshots. The ability conditions resend their HUD event when restored.
+		virtual bool IsSnapshottable() const override { return true; }
+
 	protected:
 
 		//--------------------------------------------------------------------------
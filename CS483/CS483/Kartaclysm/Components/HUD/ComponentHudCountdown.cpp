@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentHudCountdown.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -47,9 +48,36 @@ namespace Kartaclysm
 		{
 			m_fDisplayRaceStartTimer -= p_fDelta;
 
+			// Hidden rather than destroyed, so that the race can be restarted from a snapshot
 			if (m_fDisplayRaceStartTimer <= 0.0f)
 			{
-				GetGameObject()->GetManager()->DestroyGameObject(GetGameObject());
+				m_TextBox.SetText("");
+			}
+		}
+	}
+
+	void ComponentHudCountdown::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fDisplayRaceStartTimer);
+		p_mSnapshot.WriteString(m_TextBox.GetText());
+	}
+
+	void ComponentHudCountdown::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		std::string strText;
+		p_mSnapshot.Read(m_fDisplayRaceStartTimer);
+		p_mSnapshot.ReadString(strText);
+
+		if (strText != m_TextBox.GetText())
+		{
+			m_TextBox.SetText(strText);
+			if (m_fDisplayRaceStartTimer > 0.0f)
+			{
+				m_TextBox.SetColour(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));	// green
+			}
+			else if (!strText.empty())
+			{
+				SetCountdownColour(atoi(strText.c_str()));
 			}
 		}
 	}
@@ -123,14 +151,19 @@ namespace Kartaclysm
 		GetGameObject()->GetTransform().SetTransform(m_OriginalTransform *
 			glm::scale(glm::vec3(fScale, fScale, 1.0f)));
 
-		switch (iCountdown)
+		SetCountdownColour(iCountdown);
+	}
+
+	void ComponentHudCountdown::SetCountdownColour(const int p_iCountdown)
+	{
+		switch (p_iCountdown)
 		{
 		case 3:	 m_TextBox.SetColour(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)); break;		// red
 		case 2:	 m_TextBox.SetColour(glm::vec4(1.0f, 0.5f, 0.0f, 1.0f)); break;		// orange
 		case 1:	 m_TextBox.SetColour(glm::vec4(1.0f, 1.0f, 0.0f, 1.0f)); break;		// yellow
 		default: 
 #ifdef _DEBUG
-			printf("Countdown: %i\n", iCountdown);
+			printf("Countdown: %i\n", p_iCountdown);
 			assert(false && "Should not have a countdown value outside the range of [1,3]");
 #endif
 			break;
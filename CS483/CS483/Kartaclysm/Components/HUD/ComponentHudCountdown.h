@@ -40,6 +40,11 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override;
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -51,6 +56,7 @@ namespace Kartaclysm
 
 		virtual void CountdownCallback(const HeatStroke::Event* p_pEvent);
 		virtual void SetCountdownMessage(const float p_fCountdown);
+		virtual void SetCountdownColour(const int p_iCountdown);
 		virtual void DisplayRaceStartMessage();
 
 		static void ParseNode(
@@ -11,7 +11,9 @@ namespace Kartaclysm
 {
 	ComponentHudFps::ComponentHudFps(
 		HeatStroke::GameObject* p_pGameObject,
-		const std::string& p_strFontFilePath
+		const std::string& p_strFontFilePath,
+		unsigned int p_uiProfilerTypes,
+		const std::string& p_strProfilerCSVFile
 		) :
 		ComponentRenderable(p_pGameObject),
 		m_pFont(HeatStroke::FontManager::Instance()->GetOrCreateFont(p_strFontFilePath)),
@@ -19,14 +21,28 @@ namespace Kartaclysm
 		m_fFPS(0.0f),
 		m_iFrameCounter(0),
 		m_fTimeSinceLastShown(0.0f),
-		m_lFrameSpeeds(std::vector<float>(90))
+		m_lFrameSpeeds(std::vector<float>(90)),
+		m_uiProfilerTypes(p_uiProfilerTypes),
+		m_strProfilerCSVFile(p_strProfilerCSVFile),
+		m_mProfilerTextBox(m_pFont, "", 400.0f, 400.0f)
 	{
 		HeatStroke::SceneManager::Instance()->AddTextBox(&m_mTextBox);
+
+		if (m_uiProfilerTypes > 0)
+		{
+			m_mProfilerTextBox.SetAlignment(HeatStroke::TextBox::H_ALIGN_LEFT, HeatStroke::TextBox::V_ALIGN_TOP);
+			HeatStroke::SceneManager::Instance()->AddTextBox(&m_mProfilerTextBox);
+		}
 	}
 
 	ComponentHudFps::~ComponentHudFps()
 	{
 		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_mTextBox);
+
+		if (m_uiProfilerTypes > 0)
+		{
+			HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_mProfilerTextBox);
+		}
 	}
 
 	HeatStroke::Component* ComponentHudFps::CreateComponent(
@@ -39,16 +55,18 @@ namespace Kartaclysm
 
 		// The values we need to fill by the end of parsing.
 		std::string strFontFilePath("");
+		unsigned int uiProfilerTypes = 0;
+		std::string strProfilerCSVFile("");
 
 		// Parse the elements of the base node.
 		if (p_pBaseNode != nullptr)
 		{
-			ParseNode(p_pBaseNode, strFontFilePath);
+			ParseNode(p_pBaseNode, strFontFilePath, uiProfilerTypes, strProfilerCSVFile);
 		}
 		// Then override with the Override node.
 		if (p_pOverrideNode != nullptr)
 		{
-			ParseNode(p_pBaseNode, strFontFilePath);
+			ParseNode(p_pBaseNode, strFontFilePath, uiProfilerTypes, strProfilerCSVFile);
 		}
 
 		// Check that we got everything we needed.
@@ -57,10 +75,27 @@ namespace Kartaclysm
 		// Now we can create and return the Component.
 		return new ComponentHudFps(
 			p_pGameObject,
-			strFontFilePath
+			strFontFilePath,
+			uiProfilerTypes,
+			strProfilerCSVFile
 			);
 	}
 
+	void ComponentHudFps::Init()
+	{
+		HeatStroke::ComponentProfiler& mProfiler = GetGameObject()->GetManager()->GetProfiler();
+		if (m_uiProfilerTypes > 0)
+		{
+			mProfiler.SetEnabled(true);
+		}
+
+		// A restarted race keeps writing to the same file
+		if (!m_strProfilerCSVFile.empty() && !mProfiler.IsWritingCSV())
+		{
+			mProfiler.StartCSV(m_strProfilerCSVFile);
+		}
+	}
+
 	void ComponentHudFps::Update(const float p_fDelta)
 	{
 		// calculate FPS using a simple moving average (SMA) algorithm
@@ -79,17 +114,44 @@ namespace Kartaclysm
 			stream << std::fixed << std::setprecision(2) << m_fFPS / m_lFrameSpeeds.size();
 			m_mTextBox.SetText(stream.str());
 			m_fTimeSinceLastShown = 0.0f;
+
+			if (m_uiProfilerTypes > 0)
+			{
+				ShowProfiler();
+			}
+		}
+	}
+
+	void ComponentHudFps::ShowProfiler()
+	{
+		const std::vector<HeatStroke::ComponentProfiler::FrameStats>& vLastFrame = GetGameObject()->GetManager()->GetProfiler().GetLastFrameStats();
+
+		std::stringstream stream;
+		stream << std::fixed << std::setprecision(2);
+		for (unsigned int i = 0; i < vLastFrame.size() && i < m_uiProfilerTypes; ++i)
+		{
+			stream << HeatStroke::ComponentProfiler::GetTypeName(vLastFrame[i].uiTypeID) << " "
+				<< vLastFrame[i].dTotalTime * 1000.0 << "ms x" << vLastFrame[i].uiCalls << "\n";
 		}
+		m_mProfilerTextBox.SetText(stream.str());
 	}
 
 	void ComponentHudFps::SyncTransform()
 	{
 		m_mTextBox.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
+
+		if (m_uiProfilerTypes > 0)
+		{
+			m_mProfilerTextBox.SetTransform(this->GetGameObject()->GetTransform().GetTransform() *
+				glm::translate(glm::vec3(0.0f, -24.0f, 0.0f)));
+		}
 	}
 
 	void ComponentHudFps::ParseNode(
 		tinyxml2::XMLNode* p_pNode,
-		std::string& p_strFontFilePath)
+		std::string& p_strFontFilePath,
+		unsigned int& p_uiProfilerTypes,
+		std::string& p_strProfilerCSVFile)
 	{
 		assert(p_pNode != nullptr);
 		assert(strcmp(p_pNode->Value(), "GOC_HUD_Fps") == 0);
@@ -104,6 +166,14 @@ namespace Kartaclysm
 			{
 				HeatStroke::EasyXML::GetRequiredStringAttribute(pChildElement, "path", p_strFontFilePath);
 			}
+			else if (strcmp(szNodeName, "Profiler") == 0)
+			{
+				HeatStroke::EasyXML::GetRequiredUIntAttribute(pChildElement, "types", p_uiProfilerTypes);
+				if (pChildElement->Attribute("csv") != nullptr)
+				{
+					HeatStroke::EasyXML::GetRequiredStringAttribute(pChildElement, "csv", p_strProfilerCSVFile);
+				}
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -37,22 +37,31 @@ namespace Kartaclysm
 			tinyxml2::XMLNode* p_pOverrideNode
 			);
 
-		virtual void Init() override {}
+		virtual void Init() override;
 		virtual void Update(const float p_fDelta) override;
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
 		//--------------------------------------------------------------------------
 		ComponentHudFps(
 			HeatStroke::GameObject* p_pGameObject,
-			const std::string& p_strFontFilePath
+			const std::string& p_strFontFilePath,
+			unsigned int p_uiProfilerTypes,
+			const std::string& p_strProfilerCSVFile
 			);
 
+		virtual void ShowProfiler();
+
 		static void ParseNode(
 			tinyxml2::XMLNode* p_pNode,
-			std::string& p_strFontFilePath
+			std::string& p_strFontFilePath,
+			unsigned int& p_uiProfilerTypes,
+			std::string& p_strProfilerCSVFile
 			);
 
 		//--------------------------------------------------------------------------
@@ -66,6 +75,12 @@ namespace Kartaclysm
 
 		HeatStroke::Font* m_pFont;
 		HeatStroke::TextBox m_mTextBox;
+
+		// With <Profiler types="N"/>, the N component types that took longest last
+		// frame are listed under the FPS. csv="file" also writes every frame out.
+		unsigned int m_uiProfilerTypes;
+		std::string m_strProfilerCSVFile;
+		HeatStroke::TextBox m_mProfilerTextBox;
 	};
 }
 
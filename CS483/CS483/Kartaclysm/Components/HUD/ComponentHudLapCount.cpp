@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentHudLapCount.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -18,6 +19,7 @@ namespace Kartaclysm
 		m_pFont(HeatStroke::FontManager::Instance()->GetOrCreateFont(p_strFontFilePath)),
 		m_mLabelTextBox(m_pFont, "LAP"),
 		m_mLapTextBox(m_pFont, "GO!"),
+		m_pRacer(nullptr),
 		m_fLabelOffset(p_fLabelOffset)
 	{
 		m_mLabelTextBox.SetColour(glm::vec4(1.0, 0.5, 0.0, 1.0)); // orange
@@ -30,7 +32,7 @@ namespace Kartaclysm
 		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_mLabelTextBox);
 		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_mLapTextBox);
 
-		HeatStroke::EventManager::Instance()->RemoveListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener("HUD_Lap", m_pRacer, m_pDelegate);
 		delete m_pDelegate;
 		m_pDelegate = nullptr;
 	}
@@ -72,12 +74,14 @@ namespace Kartaclysm
 
 	void ComponentHudLapCount::Init()
 	{
-		// event name follows "Player0_HUD_Lap" format
+		// HUD root follows "Player0_HUD" format, named after its racer
 		assert(GetGameObject()->GetParent() != nullptr && "HUD hierarchy error");
-		m_strEventName = GetGameObject()->GetParent()->GetGUID() + "_Lap";
+		const std::string& strHudGUID = GetGameObject()->GetParent()->GetGUID();
+		m_pRacer = GetGameObject()->GetManager()->GetGameObject(strHudGUID.substr(0, strHudGUID.rfind("_HUD")));
+		assert(m_pRacer != nullptr && "HUD has no racer");
 
 		m_pDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentHudLapCount::LapCountCallback, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->AddListener("HUD_Lap", m_pRacer, m_pDelegate);
 	}
 
 	void ComponentHudLapCount::SyncTransform()
@@ -87,6 +91,24 @@ namespace Kartaclysm
 		m_mLapTextBox.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
 	};
 
+	void ComponentHudLapCount::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iLap);
+		p_mSnapshot.WriteString(m_mLapTextBox.GetText());
+	}
+
+	void ComponentHudLapCount::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		std::string strLapText;
+		p_mSnapshot.Read(m_iLap);
+		p_mSnapshot.ReadString(strLapText);
+
+		if (strLapText != m_mLapTextBox.GetText())
+		{
+			m_mLapTextBox.SetText(strLapText);
+		}
+	}
+
 	void ComponentHudLapCount::LapCountCallback(const HeatStroke::Event* p_pEvent)
 	{
 		int iCurrent, iTotal;
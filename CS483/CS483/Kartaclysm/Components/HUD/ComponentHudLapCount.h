@@ -38,6 +38,11 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override {}
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 
 		//--------------------------------------------------------------------------
@@ -70,7 +75,8 @@ namespace Kartaclysm
 		HeatStroke::TextBox m_mLabelTextBox;
 		HeatStroke::TextBox m_mLapTextBox;
 
-		std::string m_strEventName;
+		// The racer this HUD belongs to, which HUD_Lap events are targeted at.
+		HeatStroke::GameObject* m_pRacer;
 
 		int m_iLap;
 		float m_fLabelOffset;
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentHudPopup.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -19,6 +20,7 @@ namespace Kartaclysm
 		ComponentRenderable(p_pGameObject),
 		m_mSprite(p_strMTLFileName, p_strMaterialName),
 		m_strEventName(p_strEventName),
+		m_pRacer(nullptr),
 		m_bDisplaying(false),
 		m_fDelay(p_fDelay),
 		m_fWaitingToRender(0.0f)
@@ -29,7 +31,7 @@ namespace Kartaclysm
 	{
 		HeatStroke::SceneManager::Instance()->RemoveSpriteInstance(&m_mSprite);
 
-		HeatStroke::EventManager::Instance()->RemoveListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener(m_strEventName, m_pRacer, m_pDelegate);
 		delete m_pDelegate;
 		m_pDelegate = nullptr;
 	}
@@ -76,15 +78,14 @@ namespace Kartaclysm
 
 	void ComponentHudPopup::Init()
 	{
-		// Replace generic "PlayerX" found in XML to the proper player number ("Player0" as example)
-		std::size_t find = m_strEventName.find("PlayerX");
-		if (find != std::string::npos)
-		{
-			m_strEventName.replace(find, find + 8, GetGameObject()->GetParent()->GetGUID().substr(0, 8));
-		}
+		// HUD root follows "Player0_HUD" format, named after its racer
+		assert(GetGameObject()->GetParent() != nullptr && "HUD hierarchy error");
+		const std::string& strHudGUID = GetGameObject()->GetParent()->GetGUID();
+		m_pRacer = GetGameObject()->GetManager()->GetGameObject(strHudGUID.substr(0, strHudGUID.rfind("_HUD")));
+		assert(m_pRacer != nullptr && "HUD has no racer");
 
 		m_pDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentHudPopup::ToggleCallback, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->AddListener(m_strEventName, m_pRacer, m_pDelegate);
 	}
 
 	void ComponentHudPopup::Update(const float p_fDelta)
@@ -106,6 +107,29 @@ namespace Kartaclysm
 		m_mSprite.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
 	}
 
+	void ComponentHudPopup::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fWaitingToRender);
+		p_mSnapshot.Write(m_bDisplaying);
+	}
+
+	void ComponentHudPopup::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		const bool bWasShown = (m_bDisplaying && m_fWaitingToRender >= m_fDelay);
+		p_mSnapshot.Read(m_fWaitingToRender);
+		p_mSnapshot.Read(m_bDisplaying);
+		const bool bShown = (m_bDisplaying && m_fWaitingToRender >= m_fDelay);
+
+		if (bWasShown && !bShown)
+		{
+			HeatStroke::SceneManager::Instance()->RemoveSpriteInstance(&m_mSprite);
+		}
+		else if (!bWasShown && bShown)
+		{
+			HeatStroke::SceneManager::Instance()->AddSpriteInstance(&m_mSprite);
+		}
+	}
+
 	void ComponentHudPopup::ToggleCallback(const HeatStroke::Event* p_pEvent)
 	{
 		int iDisplay;
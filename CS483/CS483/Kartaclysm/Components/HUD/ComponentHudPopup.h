@@ -36,6 +36,11 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override;
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		//--------------------------------------------------------------------------
 		// Protected methods
@@ -66,6 +71,9 @@ namespace Kartaclysm
 		HeatStroke::SpriteInstance m_mSprite;
 		std::string m_strEventName;
 
+		// The racer this HUD belongs to, which the popup's events are targeted at.
+		HeatStroke::GameObject* m_pRacer;
+
 		float m_fDelay;
 		float m_fWaitingToRender;
 		bool m_bDisplaying;
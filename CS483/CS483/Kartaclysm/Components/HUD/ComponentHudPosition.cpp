@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentHudPosition.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -17,7 +18,8 @@ namespace Kartaclysm
 		m_strPositionFilePrefix(p_strPositionFilePrefix),
 		m_mSprite(m_strPositionFilePrefix + "position_1.mtl", "position_1"),
 		m_strPlayerX(GetGameObject()->GetParent()->GetGUID().substr(0, GetGameObject()->GetParent()->GetGUID().find('_'))),
-		m_iCurrentPosition(0)
+		m_iCurrentPosition(0),
+		m_mStandings()
 	{
 		m_mSprite.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
 		HeatStroke::SceneManager::Instance()->AddSpriteInstance(&m_mSprite);
@@ -77,18 +79,39 @@ namespace Kartaclysm
 
 	void ComponentHudPosition::PositionCallback(const HeatStroke::Event* p_pEvent)
 	{
-		int iPosition;
-		p_pEvent->GetRequiredIntParameter(m_strPlayerX, iPosition);
+		int iPosition = m_mStandings.FindPlace(p_pEvent, m_strPlayerX);
 
 		if (m_iCurrentPosition != ++iPosition)
 		{
 			m_iCurrentPosition = iPosition;
-			std::string strPosition = "position_" + std::to_string(iPosition);
+			ShowPosition(iPosition);
+		}
+	}
+
+	void ComponentHudPosition::ShowPosition(const int p_iPosition)
+	{
+		// No position has been sent before the first standings update, which shows as first
+		std::string strPosition = "position_" + std::to_string(p_iPosition > 0 ? p_iPosition : 1);
 
-			HeatStroke::SceneManager::Instance()->RemoveSpriteInstance(&m_mSprite);
-			m_mSprite = HeatStroke::SpriteInstance(m_strPositionFilePrefix + strPosition + ".mtl", strPosition);
-			m_mSprite.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
-			HeatStroke::SceneManager::Instance()->AddSpriteInstance(&m_mSprite);
+		HeatStroke::SceneManager::Instance()->RemoveSpriteInstance(&m_mSprite);
+		m_mSprite = HeatStroke::SpriteInstance(m_strPositionFilePrefix + strPosition + ".mtl", strPosition);
+		m_mSprite.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
+		HeatStroke::SceneManager::Instance()->AddSpriteInstance(&m_mSprite);
+	}
+
+	void ComponentHudPosition::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_iCurrentPosition);
+	}
+
+	void ComponentHudPosition::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		const int iShownPosition = (m_iCurrentPosition > 0 ? m_iCurrentPosition : 1);
+		p_mSnapshot.Read(m_iCurrentPosition);
+
+		if ((m_iCurrentPosition > 0 ? m_iCurrentPosition : 1) != iShownPosition)
+		{
+			ShowPosition(m_iCurrentPosition);
 		}
 	}
 
@@ -14,6 +14,7 @@
 #include "SceneManager.h"
 #include "EventManager.h"
 #include "Sprite.h"
+#include "RaceStandings.h"
 
 namespace Kartaclysm
 {
@@ -37,6 +38,11 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override {}
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 
 		//--------------------------------------------------------------------------
@@ -53,6 +59,7 @@ namespace Kartaclysm
 			);
 
 		virtual void PositionCallback(const HeatStroke::Event* p_pEvent);
+		virtual void ShowPosition(const int p_iPosition);
 
 		static void ParseNode(
 			tinyxml2::XMLNode* p_pNode,
@@ -70,6 +77,7 @@ namespace Kartaclysm
 		HeatStroke::SpriteInstance m_mSprite;
 
 		std::function<void(const HeatStroke::Event*)>* m_pDelegate;
+		RaceStandings m_mStandings;
 	};
 }
 
@@ -1,10 +1,12 @@
 #include "ComponentHudRaceResults.h"
+#include "SceneSnapshot.h"
 
 Kartaclysm::ComponentHudRaceResults::ComponentHudRaceResults(HeatStroke::GameObject* p_pGameObject, const std::string& p_strFontFilePath)
 	:
 	ComponentRenderable(p_pGameObject),
 	m_pFont(HeatStroke::FontManager::Instance()->GetOrCreateFont(p_strFontFilePath)),
-	m_TextBox(m_pFont, "")
+	m_TextBox(m_pFont, ""),
+	m_bShowing(false)
 {
 	std::string strParentGuid = p_pGameObject->GetParent()->GetGUID();
 	int iRacerGuidEndIndex = strParentGuid.find("_HUD");
@@ -49,6 +51,35 @@ void Kartaclysm::ComponentHudRaceResults::SyncTransform()
 	m_TextBox.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
 }
 
+void Kartaclysm::ComponentHudRaceResults::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+{
+	p_mSnapshot.WriteString(m_TextBox.GetText());
+	p_mSnapshot.Write(m_bShowing);
+}
+
+void Kartaclysm::ComponentHudRaceResults::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+{
+	const bool bWasShowing = m_bShowing;
+
+	std::string strText;
+	p_mSnapshot.ReadString(strText);
+	p_mSnapshot.Read(m_bShowing);
+
+	if (strText != m_TextBox.GetText())
+	{
+		m_TextBox.SetText(strText);
+	}
+
+	if (bWasShowing && !m_bShowing)
+	{
+		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_TextBox);
+	}
+	else if (!bWasShowing && m_bShowing)
+	{
+		HeatStroke::SceneManager::Instance()->AddTextBox(&m_TextBox);
+	}
+}
+
 void Kartaclysm::ComponentHudRaceResults::RaceFinishedCallback(const HeatStroke::Event * p_pEvent)
 {
 	std::string strRacerId = "";
@@ -62,6 +93,7 @@ void Kartaclysm::ComponentHudRaceResults::RaceFinishedCallback(const HeatStroke:
 
 	if (std::strcmp(strRacerId.c_str(), m_strRacerId.c_str()) == 0)
 	{
+		m_bShowing = true;
 		HeatStroke::SceneManager::Instance()->AddTextBox(&m_TextBox);
 	}
 }
\ No newline at end of file
@@ -31,6 +31,11 @@ namespace Kartaclysm
 			virtual void Update(const float p_fDelta) override;
 			virtual void SyncTransform() override;
 
+			// Snapshots.
+			virtual bool IsSnapshottable() const override { return true; }
+			virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+			virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 		protected:
 			ComponentHudRaceResults(
 				HeatStroke::GameObject* p_pGameObject,
@@ -41,6 +46,7 @@ namespace Kartaclysm
 			HeatStroke::Font* m_pFont;
 			HeatStroke::TextBox m_TextBox;
 			std::string m_strRacerId;
+			bool m_bShowing;
 			std::function<void(const HeatStroke::Event*)>* m_pRaceFinishedDelegate;
 
 			void RaceFinishedCallback(const HeatStroke::Event* p_pEvent);
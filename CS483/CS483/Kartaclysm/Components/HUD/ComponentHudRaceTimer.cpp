@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------
 
 #include "ComponentHudRaceTimer.h"
+#include "SceneSnapshot.h"
 
 namespace Kartaclysm
 {
@@ -18,6 +19,7 @@ namespace Kartaclysm
 		m_pFont(HeatStroke::FontManager::Instance()->GetOrCreateFont(p_strFontFilePath)),
 		m_LabelTextBox(m_pFont, "TIME"),
 		m_TimerTextBox(m_pFont, "00:00"),
+		m_pRacer(nullptr),
 		m_fTime(-3.0f), // beginning countdown
 		m_fLapDisplayTimer(0.0f)
 	{
@@ -35,7 +37,7 @@ namespace Kartaclysm
 		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_LabelTextBox);
 		HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_TimerTextBox);
 
-		HeatStroke::EventManager::Instance()->RemoveListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->RemoveListener("HUD_Lap", m_pRacer, m_pDelegate);
 		delete m_pDelegate;
 		m_pDelegate = nullptr;
 	}
@@ -100,12 +102,14 @@ namespace Kartaclysm
 
 	void ComponentHudRaceTimer::Init()
 	{
-		// event name follows "Player0_HUD_Lap" format
+		// HUD root follows "Player0_HUD" format, named after its racer
 		assert(GetGameObject()->GetParent() != nullptr && "HUD hierarchy error");
-		m_strEventName = GetGameObject()->GetParent()->GetGUID() + "_Lap";
+		const std::string& strHudGUID = GetGameObject()->GetParent()->GetGUID();
+		m_pRacer = GetGameObject()->GetManager()->GetGameObject(strHudGUID.substr(0, strHudGUID.rfind("_HUD")));
+		assert(m_pRacer != nullptr && "HUD has no racer");
 
 		m_pDelegate = new std::function<void(const HeatStroke::Event*)>(std::bind(&ComponentHudRaceTimer::LapCountCallback, this, std::placeholders::_1));
-		HeatStroke::EventManager::Instance()->AddListener(m_strEventName, m_pDelegate);
+		HeatStroke::EventManager::Instance()->AddListener("HUD_Lap", m_pRacer, m_pDelegate);
 	}
 
 	void ComponentHudRaceTimer::SyncTransform()
@@ -121,6 +125,40 @@ namespace Kartaclysm
 		}
 	}
 
+	void ComponentHudRaceTimer::SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const
+	{
+		p_mSnapshot.Write(m_fTime);
+		p_mSnapshot.Write(m_fLapDisplayTimer);
+		p_mSnapshot.WriteString(m_TimerTextBox.GetText());
+	}
+
+	void ComponentHudRaceTimer::RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot)
+	{
+		const bool bWasFlashing = (m_fLapDisplayTimer > 0.0f);
+
+		std::string strTimerText;
+		p_mSnapshot.Read(m_fTime);
+		p_mSnapshot.Read(m_fLapDisplayTimer);
+		p_mSnapshot.ReadString(strTimerText);
+
+		// The label is hidden while a lap time flashes
+		if (bWasFlashing && m_fLapDisplayTimer <= 0.0f)
+		{
+			DisableLapFlash();
+		}
+		else if (!bWasFlashing && m_fLapDisplayTimer > 0.0f)
+		{
+			HeatStroke::SceneManager::Instance()->RemoveTextBox(&m_LabelTextBox);
+		}
+
+		if (m_fLapDisplayTimer > 0.0f)
+		{
+			FlashLapTimer(m_fLapDisplayTimer, 0.5f);
+		}
+
+		m_TimerTextBox.SetText(strTimerText);
+	}
+
 	void ComponentHudRaceTimer::LapCountCallback(const HeatStroke::Event* p_pEvent)
 	{
 		float fLapTime;
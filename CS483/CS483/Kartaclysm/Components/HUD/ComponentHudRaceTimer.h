@@ -39,6 +39,11 @@ namespace Kartaclysm
 		virtual void Update(const float p_fDelta) override;
 		virtual void SyncTransform() override;
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(HeatStroke::SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(HeatStroke::SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 
 		//--------------------------------------------------------------------------
@@ -73,7 +78,8 @@ namespace Kartaclysm
 		HeatStroke::TextBox m_LabelTextBox;
 		HeatStroke::TextBox m_TimerTextBox;
 
-		std::string m_strEventName;
+		// The racer this HUD belongs to, which HUD_Lap events are targeted at.
+		HeatStroke::GameObject* m_pRacer;
 
 		float m_fTime;
 		float m_fLapDisplayTimer;
@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------
+// RaceStandings
+//
+// Reads and writes the parameters of the RaceStandingsUpdate event.
+//------------------------------------------------------------------------
+
+#include "RaceStandings.h"
+
+namespace Kartaclysm
+{
+	RaceStandings::RaceStandings()
+		:
+		m_uiRacerCountID(HeatStroke::EventTypeRegistry::InternParameter("RacerCount")),
+		m_vPlaceIDs()
+	{
+	}
+
+	void RaceStandings::SetRacerCount(HeatStroke::Event* p_pEvent, const unsigned int p_uiCount)
+	{
+		p_pEvent->SetIntParameter(m_uiRacerCountID, static_cast<int>(p_uiCount));
+	}
+
+	void RaceStandings::SetRacerAt(HeatStroke::Event* p_pEvent, const unsigned int p_uiPlace, const std::string& p_strGUID)
+	{
+		p_pEvent->SetStringParameter(GetPlaceID(p_uiPlace), p_strGUID);
+	}
+
+	int RaceStandings::FindPlace(const HeatStroke::Event* p_pEvent, const std::string& p_strGUID)
+	{
+		int iCount;
+		p_pEvent->GetRequiredIntParameter(m_uiRacerCountID, iCount);
+
+		std::string strGUID;
+		for (int i = 0; i < iCount; ++i)
+		{
+			p_pEvent->GetRequiredStringParameter(GetPlaceID(i), strGUID);
+			if (strGUID == p_strGUID)
+			{
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	std::string RaceStandings::GetRacerAt(const HeatStroke::Event* p_pEvent, const unsigned int p_uiPlace)
+	{
+		std::string strGUID;
+		p_pEvent->GetRequiredStringParameter(GetPlaceID(p_uiPlace), strGUID);
+		return strGUID;
+	}
+
+	HeatStroke::EventParameterID RaceStandings::GetPlaceID(const unsigned int p_uiPlace)
+	{
+		while (m_vPlaceIDs.size() <= p_uiPlace)
+		{
+			m_vPlaceIDs.push_back(HeatStroke::EventTypeRegistry::InternParameter("Standing" + std::to_string(m_vPlaceIDs.size())));
+		}
+		return m_vPlaceIDs[p_uiPlace];
+	}
+}
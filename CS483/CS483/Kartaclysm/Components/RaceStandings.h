@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------
+// RaceStandings
+//
+// Reads and writes the parameters of the RaceStandingsUpdate event: the
+// number of racers under "RacerCount", and each racer's GUID by place,
+// from first, under "Standing0", "Standing1" and so on. The names are the
+// same whichever racers are in the race, so restarting or respawning
+// doesn't add to the interned parameter names.
+//------------------------------------------------------------------------
+
+#ifndef RACE_STANDINGS_H
+#define RACE_STANDINGS_H
+
+#include <string>
+#include <vector>
+
+#include "Event.h"
+
+namespace Kartaclysm
+{
+	class RaceStandings
+	{
+	public:
+		RaceStandings();
+
+		void SetRacerCount(HeatStroke::Event* p_pEvent, const unsigned int p_uiCount);
+		void SetRacerAt(HeatStroke::Event* p_pEvent, const unsigned int p_uiPlace, const std::string& p_strGUID);
+
+		// The place of p_strGUID in p_pEvent, 0 being first, or -1 if it isn't there.
+		int FindPlace(const HeatStroke::Event* p_pEvent, const std::string& p_strGUID);
+
+		// The GUID of the racer at p_uiPlace in p_pEvent, which must have that many racers.
+		std::string GetRacerAt(const HeatStroke::Event* p_pEvent, const unsigned int p_uiPlace);
+
+	private:
+		HeatStroke::EventParameterID m_uiRacerCountID;
+
+		// Interned on first use, so each place's name is only looked up once.
+		std::vector<HeatStroke::EventParameterID> m_vPlaceIDs;
+
+		HeatStroke::EventParameterID GetPlaceID(const unsigned int p_uiPlace);
+	};
+}
+
+#endif
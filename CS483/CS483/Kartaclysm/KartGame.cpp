@@ -7,6 +7,7 @@
 
 #include "KartGame.h"
 #include "EventManager.h"
+#include "JobSystem.h"
 
 #include "ComponentKartController.h"
 #include "ComponentCameraController.h"
@@ -25,6 +26,7 @@ bool Kartaclysm::KartGame::Init()
 
 	// Initialize singletons
 	HeatStroke::EventManager::CreateInstance();
+	HeatStroke::JobSystem::CreateInstance();
 	HeatStroke::ModelManager::CreateInstance();
 	HeatStroke::SpriteManager::CreateInstance();
 	HeatStroke::FontManager::CreateInstance();
@@ -107,5 +109,6 @@ void Kartaclysm::KartGame::Shutdown()
 	HeatStroke::SpriteManager::DestroyInstance();
 	HeatStroke::ModelManager::DestroyInstance();
 	HeatStroke::CollisionManager::DestroyInstance();
+	HeatStroke::JobSystem::DestroyInstance();
 	HeatStroke::MySQLConnector::DestroyInstance();
 }
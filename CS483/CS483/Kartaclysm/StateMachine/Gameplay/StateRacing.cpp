@@ -19,13 +19,17 @@ Kartaclysm::StateRacing::StateRacing()
 	m_pRaceFinishedDelegate(nullptr),
 	m_pRaceRestartDelegate(nullptr),
 	m_pPauseDelegate(nullptr),
+	m_pLoader(nullptr),
+	m_fLoadBudget(0.008f),
+	m_iLoadingPercent(0),
 	m_uiNumAIRacers(0),
 	m_uiNumHumanRacers(0),
 	m_uiNumRacers(0),
 	m_uiLapsNeeded(0),
 	m_bRaceEndCountdown(false),
 	m_fTimeRemaining(-1.0f),
-	m_fMaxTimeUntilDNF(20.0f)
+	m_fMaxTimeUntilDNF(20.0f),
+	m_mRaceStartSnapshot()
 {
 }
 
@@ -110,13 +114,30 @@ void Kartaclysm::StateRacing::Enter(const std::map<std::string, std::string>& p_
 
 	m_pGameObjectManager->RegisterComponentFactory("GOC_Effect", ComponentEffect::CreateComponent);
 	m_pGameObjectManager->RegisterComponentFactory("GOC_ObjectSpawn", ComponentObjectSpawn::CreateComponent);
+
+	// Update component families as systems, so the race runs in a fixed order no matter
+	// how GUIDs sort: input is mapped before this state updates, then AI and abilities
+	// decide what each kart does, karts and other objects move, the track works out
+	// where everyone is, and the HUD shows the result. Unlisted families run last.
+	std::vector<std::string> vSystemOrder;
+	vSystemOrder.push_back("GOC_AIDriver");
+	vSystemOrder.push_back("GOC_AbilityConditions");
+	vSystemOrder.push_back("GOC_Ability");
+	vSystemOrder.push_back("GOC_KartController");
+	vSystemOrder.push_back("GOC_SimplePhysics");
+	vSystemOrder.push_back("GOC_Projectile");
+	vSystemOrder.push_back("GOC_Collider");
+	vSystemOrder.push_back("GOC_Track");
+	vSystemOrder.push_back("GOC_TrackPiece");
+	vSystemOrder.push_back("GOC_Racer");
+	vSystemOrder.push_back("GOC_Renderable");
+	m_pGameObjectManager->SetSystemOrder(vSystemOrder);
+	m_pGameObjectManager->SetUpdateMode(HeatStroke::UM_Systems);
 	
-	// Store passed context parameters and begin race
+	// Store passed context parameters and load the race, which begins once loading finishes
 	m_mContextParams = p_mContextParameters;
 	SendRaceInfoEvent();
-	BeginRace();
-
-	HeatStroke::AudioPlayer::Instance()->PlaySoundEffect("Assets/Sounds/engine.flac", true);
+	StartLoading();
 
 	// I have to do this horrible spaghetti crap because game object manager isn't a SINGLETON
 	HeatStroke::CollisionManager::Instance()->SetGameObjectManager(m_pGameObjectManager);
@@ -133,13 +154,78 @@ void Kartaclysm::StateRacing::SendRaceInfoEvent()
 	HeatStroke::EventManager::Instance()->QueueEvent(pEvent);
 }
 
-void Kartaclysm::StateRacing::BeginRace()
+void Kartaclysm::StateRacing::StartLoading()
 {
-	m_bRaceEndCountdown = false;
-	m_fTimeRemaining = -1.0f;
-	m_vRaceResults.clear();
-	m_sUnfinishedRacers.clear();
+	m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Menus/loading_screen.xml", "LoadingScreen");
+	m_iLoadingPercent = 0;
+
+	// Everything BeginRace() creates. Files these refer to, and the models they use, are found as they load.
+	m_pLoader = new HeatStroke::AsyncLoader();
+	m_pLoader->AddGameObjectFile("CS483/CS483/Kartaclysm/Data/Lights/light.xml");
+	m_pLoader->AddGameObjectFile(m_mContextParams.at("TrackDefinitionFile"));
 
+	m_uiNumHumanRacers = atoi(m_mContextParams.at("NumHumanRacers").c_str());
+	for (unsigned int i = 0; i < m_uiNumHumanRacers; i++)
+	{
+		std::string strPlayerX = "Player" + std::to_string(i);
+
+		m_pLoader->AddGameObjectFile("CS483/CS483/Kartaclysm/Data/Racer/racer.xml");
+		std::string strHUDFile = GetHUDDefinitionFile(strPlayerX);
+		if (!strHUDFile.empty())
+		{
+			m_pLoader->AddGameObjectFile(strHUDFile);
+		}
+		m_pLoader->AddGameObjectFile(m_mContextParams.at(strPlayerX + "_KartDefinitionFile"));
+		m_pLoader->AddGameObjectFile(m_mContextParams.at(strPlayerX + "_DriverDefinitionFile"));
+		m_pLoader->AddGameObjectFile(m_mContextParams.at(strPlayerX + "_CameraDefinitionFile"));
+	}
+
+	m_uiNumAIRacers = atoi(m_mContextParams.at("NumAIRacers").c_str());
+	for (unsigned int i = 0; i < m_uiNumAIRacers; ++i)
+	{
+		std::string strAIRacer = "AI_racer" + std::to_string(i);
+
+		m_pLoader->AddGameObjectFile("CS483/CS483/Kartaclysm/Data/Racer/racer_ai.xml");
+		m_pLoader->AddGameObjectFile(m_mContextParams.at(strAIRacer + "_KartDefinitionFile"));
+		m_pLoader->AddGameObjectFile(m_mContextParams.at(strAIRacer + "_DriverDefinitionFile"));
+	}
+
+	m_pLoader->Start();
+}
+
+void Kartaclysm::StateRacing::UpdateLoading()
+{
+	// Hand over what the loader has read, leaving the rest of the frame for the loading screen
+	m_pLoader->Update(m_pGameObjectManager, m_fLoadBudget);
+
+	int iLoadingPercent = static_cast<int>(m_pLoader->GetProgress() * 100.0f);
+	if (iLoadingPercent != m_iLoadingPercent)
+	{
+		m_iLoadingPercent = iLoadingPercent;
+
+		HeatStroke::GameObject* pProgress = m_pGameObjectManager->GetGameObject("LoadingProgress");
+		if (pProgress != nullptr)
+		{
+			if (HeatStroke::ComponentTextBox* pProgressText = dynamic_cast<HeatStroke::ComponentTextBox*>(pProgress->GetComponent("GOC_Renderable")))
+			{
+				pProgressText->SetMessage("Loading... " + std::to_string(m_iLoadingPercent) + "%");
+			}
+		}
+	}
+
+	if (m_pLoader->IsFinished())
+	{
+		delete m_pLoader;
+		m_pLoader = nullptr;
+
+		// Builds the race from the loaded files, clearing away the loading screen
+		BeginRace();
+		HeatStroke::AudioPlayer::Instance()->PlaySoundEffect("Assets/Sounds/engine.flac", true);
+	}
+}
+
+void Kartaclysm::StateRacing::BeginRace()
+{
 	// Destroy game objects in case we are restarting the race
 	m_pGameObjectManager->DestroyAllGameObjects();
 
@@ -180,9 +266,46 @@ void Kartaclysm::StateRacing::BeginRace()
 		pRacer->GetTransform().Translate(glm::vec3((iStartPosition % 2 == 0 ? -0.5f : 0.5f), 0.0f, -0.5f * iStartPosition));
 	}
 
+	// Keep the race as it stands for restarts, which rebuild it instead if anything here can't be snapshotted.
+	m_pGameObjectManager->CaptureSnapshot(m_mRaceStartSnapshot);
+
+	StartRace();
+}
+
+void Kartaclysm::StateRacing::RestartRace(const HeatStroke::Event* p_pEvent)
+{
+	if (m_pGameObjectManager->RestoreSnapshot(m_mRaceStartSnapshot))
+	{
+		// Everything jumped back to the start line, not through the walls, and
+		// whatever was touching before the restart isn't any more
+		HeatStroke::CollisionManager::Instance()->ResetAllSweeps();
+		HeatStroke::CollisionManager::Instance()->ResetContacts();
+		StartRace();
+	}
+	else
+	{
+		BeginRace();
+	}
+}
+
+void Kartaclysm::StateRacing::StartRace()
+{
+	m_bRaceEndCountdown = false;
+	m_fTimeRemaining = -1.0f;
+	m_vRaceResults.clear();
+
+	m_sUnfinishedRacers.clear();
+	const std::vector<HeatStroke::GameObject*>& vRacers = m_pGameObjectManager->GetGameObjectsWithTag("Racer");
+	for (unsigned int i = 0; i < vRacers.size(); ++i)
+	{
+		m_sUnfinishedRacers.insert(vRacers[i]->GetGUID());
+	}
+
 	m_uiNumRacers = m_uiNumHumanRacers + m_uiNumAIRacers;
 
 	// Set inital position sprites on racer HUDs
+	HeatStroke::GameObject* pTrack = m_pGameObjectManager->GetGameObject("Track");
+	ComponentTrack* pTrackComponent = static_cast<ComponentTrack*>(pTrack->GetComponent("GOC_Track"));
 	pTrackComponent->TriggerRaceStandingsUpdateEvent();
 
 	if (PlayerInputMapping::Instance()->SetSplitscreenPlayers(m_uiNumHumanRacers))
@@ -227,7 +350,6 @@ HeatStroke::GameObject* Kartaclysm::StateRacing::GenerateRacer
 	pRacerComponent->SetKart(pKart);
 	pRacerComponent->SetDriver(pDriver);
 
-	m_sUnfinishedRacers.insert(pRacer->GetGUID());
 	return pRacer;
 }
 
@@ -254,63 +376,72 @@ HeatStroke::GameObject* Kartaclysm::StateRacing::GenerateAIRacer(
 		kartController->SetAI(true);
 	}
 
-	m_sUnfinishedRacers.insert(pRacer->GetGUID());
 	return pRacer;
 }
 
 void Kartaclysm::StateRacing::CreateHUDForRacer(const std::string& p_strGuid)
+{
+	std::string strHUDFile = GetHUDDefinitionFile(p_strGuid);
+	if (!strHUDFile.empty())
+	{
+		m_pGameObjectManager->CreateGameObject(strHUDFile, p_strGuid + "_HUD");
+	}
+}
+
+std::string Kartaclysm::StateRacing::GetHUDDefinitionFile(const std::string& p_strGuid) const
 {
 	switch (m_uiNumHumanRacers)
 	{
 	case 1:
-		m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_full.xml", p_strGuid + "_HUD");
-		break;
+		return "CS483/CS483/Kartaclysm/Data/Racer/hud_full.xml";
 	case 2:
 		if (p_strGuid == "Player0")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_top.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_top.xml";
 		}
 		else if (p_strGuid == "Player1")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_bottom.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_bottom.xml";
 		}
 		break;
 	case 3:
 		if (p_strGuid == "Player0")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_top_left.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_top_left.xml";
 		}
 		else if (p_strGuid == "Player1")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_top_right.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_top_right.xml";
 		}
 		else if (p_strGuid == "Player2")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_left.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_left.xml";
 		}
 		break;
 	case 4:
 		if (p_strGuid == "Player0")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_top_left.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_top_left.xml";
 		}
 		else if (p_strGuid == "Player1")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_top_right.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_top_right.xml";
 		}
 		else if (p_strGuid == "Player2")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_left.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_left.xml";
 		}
 		else if (p_strGuid == "Player3")
 		{
-			m_pGameObjectManager->CreateGameObject("CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_right.xml", p_strGuid + "_HUD");
+			return "CS483/CS483/Kartaclysm/Data/Racer/hud_bottom_right.xml";
 		}
 		break;
 	default:
 		assert(false && "Unknown number of players.");
 		break;
 	}
+
+	return "";
 }
 
 void Kartaclysm::StateRacing::Suspend(const int p_iNewState)
@@ -334,6 +465,12 @@ void Kartaclysm::StateRacing::Update(const float p_fDelta)
 	assert(m_pGameObjectManager != nullptr);
 	m_pGameObjectManager->Update(p_fDelta);
 
+	if (m_pLoader != nullptr)
+	{
+		UpdateLoading();
+		return;
+	}
+
 	if (m_bRaceEndCountdown)
 	{
 		m_fTimeRemaining -= p_fDelta;
@@ -358,6 +495,13 @@ void Kartaclysm::StateRacing::Exit()
 
 	PlayerInputMapping::Instance()->DisableRaceMode();
 
+	// Stops the loader thread if we're leaving before the race has loaded
+	if (m_pLoader != nullptr)
+	{
+		delete m_pLoader;
+		m_pLoader = nullptr;
+	}
+
 	if (m_pPauseDelegate != nullptr)
 	{
 		HeatStroke::EventManager::Instance()->RemoveListener("Pause", m_pPauseDelegate);
@@ -392,12 +536,19 @@ void Kartaclysm::StateRacing::Exit()
 		delete m_pGameObjectManager;
 		m_pGameObjectManager = nullptr;
 	}
+	m_mRaceStartSnapshot.Clear();
 
 	HeatStroke::AudioPlayer::Instance()->StopSoundEffect("Assets/Sounds/engine.flac");
 }
 
 void Kartaclysm::StateRacing::PauseGame(const HeatStroke::Event* p_pEvent)
 {
+	// Nothing to pause until the race has loaded
+	if (m_pLoader != nullptr)
+	{
+		return;
+	}
+
 	// Get the player who paused the game
 	int iPlayer = 0;
 	p_pEvent->GetOptionalIntParameter("Player", iPlayer, iPlayer);
@@ -61,6 +61,7 @@
 #include "EventManager.h"
 #include "PlayerInputMapping.h"
 #include "AudioPlayer.h"
+#include "AsyncLoader.h"
 
 #include "ComponentRacer.h"
 
@@ -98,6 +99,11 @@ namespace Kartaclysm
 		std::function<void(const HeatStroke::Event*)>* m_pRaceFinishedDelegate;
 		std::function<void(const HeatStroke::Event*)>* m_pRaceRestartDelegate;
 
+		// Loads the race's files while the loading screen shows; null once it's done.
+		HeatStroke::AsyncLoader* m_pLoader;
+		float m_fLoadBudget;
+		int m_iLoadingPercent;
+
 		std::map<std::string, std::string> m_mContextParams;
 		unsigned int m_uiNumAIRacers;
 		unsigned int m_uiNumHumanRacers;
@@ -107,10 +113,17 @@ namespace Kartaclysm
 		float m_fTimeRemaining;
 		float m_fMaxTimeUntilDNF;
 
+		// The race as BeginRace() built it, which RestartRace() puts back instead of rebuilding.
+		HeatStroke::SceneSnapshot m_mRaceStartSnapshot;
+
 		void CreateHUDForRacer(const std::string& p_strGuid);
+		std::string GetHUDDefinitionFile(const std::string& p_strGuid) const;
 
 		void SendRaceInfoEvent();
+		void StartLoading();
+		void UpdateLoading();
 		void BeginRace();
+		void StartRace();
 		HeatStroke::GameObject* GenerateRacer(
 			const std::string& p_strKartDefinitionFile, 
 			const std::string& p_strDriverDefinitionFile, 
@@ -126,7 +139,7 @@ namespace Kartaclysm
 		void PauseGame(const HeatStroke::Event* p_pEvent);
 		void RacerFinishedRace(const HeatStroke::Event* p_pEvent);
 		void FinishRace(const HeatStroke::Event* p_pEvent);
-		void RestartRace(const HeatStroke::Event* p_pEvent) { BeginRace(); }
+		void RestartRace(const HeatStroke::Event* p_pEvent);
 
 		std::map<std::string, std::string> GenerateRaceResults();
 		void GetDriverAndKartNames(ComponentRacer* p_pRacerComponent, std::string& p_strDriver, std::string& p_strKart) const;
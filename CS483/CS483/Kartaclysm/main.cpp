@@ -6,10 +6,38 @@
 //------------------------------------------------------------------------
 
 #include <cstdlib>
+#include <cstring>
 #include "KartGame.h"
+#include "SIMDMath.h"
+#include "Broadphase.h"
+#include "EventManager.h"
 
 int main(int argc, char* argv[])
 {
+	HeatStroke::SIMDMath::Init();
+
+	// "-benchmark-simd" times the SIMD math kernels against glm, "-benchmark-broadphase"
+	// the collision broadphases against each other, and "-benchmark-events" event
+	// dispatch, instead of starting the game.
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp(argv[i], "-benchmark-simd") == 0)
+		{
+			HeatStroke::SIMDMath::RunBenchmark(10000, 500);
+			return 0;
+		}
+		else if (strcmp(argv[i], "-benchmark-broadphase") == 0)
+		{
+			HeatStroke::Broadphase::RunBenchmark();
+			return 0;
+		}
+		else if (strcmp(argv[i], "-benchmark-events") == 0)
+		{
+			HeatStroke::EventManager::RunBenchmark(1000000);
+			return 0;
+		}
+	}
+
 	Kartaclysm::KartGame *game = new Kartaclysm::KartGame();
 	return game->Run("Kartaclysm");
-}
\ No newline at end of file
+}
@@ -0,0 +1,325 @@
+//==================================================================================
+// JobSystem
+//
+// A pool of worker threads which run batches of a parallel loop alongside the
+// thread that started it.
+//
+// Each thread, the one that started the loop included, has its own queue of
+// batches. A thread takes work from the back of its own queue and, once that is
+// empty, steals from the front of the others', so a thread which draws cheap
+// batches helps out with the expensive ones instead of sitting idle. The caller
+// of ParallelFor() works through batches too, and only returns once all of its
+// batches have finished.
+//==================================================================================
+
+#include "JobSystem.h"
+
+namespace HeatStroke
+{
+	// Static singleton instance
+	JobSystem* JobSystem::s_pJobSystemInstance = nullptr;
+
+	//------------------------------------------------------------------------------
+	// Method:    CreateInstance
+	// Parameters: const unsigned int p_uiWorkerCount - The number of worker threads
+	//		to start, or DEFAULT_WORKER_COUNT for one per spare hardware thread.
+	// Returns:   void
+	//
+	// Creates the singleton instance.
+	//------------------------------------------------------------------------------
+	void JobSystem::CreateInstance(const unsigned int p_uiWorkerCount /*= DEFAULT_WORKER_COUNT*/)
+	{
+		assert(s_pJobSystemInstance == nullptr);
+
+		unsigned int uiWorkerCount = p_uiWorkerCount;
+		if (uiWorkerCount == DEFAULT_WORKER_COUNT)
+		{
+			// hardware_concurrency() may return 0 if it can't tell.
+			const unsigned int uiHardwareThreads = std::thread::hardware_concurrency();
+			uiWorkerCount = (uiHardwareThreads > 1 ? uiHardwareThreads - 1 : 0);
+		}
+
+		s_pJobSystemInstance = new JobSystem(uiWorkerCount);
+	}
+
+	//------------------------------------------------------------------------------
+	// Method:    DestroyInstance
+	// Returns:   void
+	//
+	// Destroys the singleton instance, once its workers have finished.
+	//------------------------------------------------------------------------------
+	void JobSystem::DestroyInstance()
+	{
+		assert(s_pJobSystemInstance != nullptr);
+		delete s_pJobSystemInstance;
+		s_pJobSystemInstance = nullptr;
+	}
+
+	//------------------------------------------------------------------------------
+	// Method:    Instance
+	// Returns:   JobSystem*
+	//
+	// Access to singleton instance.
+	//------------------------------------------------------------------------------
+	JobSystem* JobSystem::Instance()
+	{
+		assert(s_pJobSystemInstance != nullptr);
+		return s_pJobSystemInstance;
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::JobSystem
+	// Parameters:
+	//	const unsigned int p_uiWorkerCount - The number of worker threads to start.
+	//------------------------------------------------------------------------------
+	JobSystem::JobSystem(const unsigned int p_uiWorkerCount) :
+		m_vQueues(),
+		m_vWorkers(),
+		m_vWorkerIDs(),
+		m_iQueuedJobs(0),
+		m_iRunningLoops(0),
+		m_mSleepMutex(),
+		m_mWakeCondition(),
+		m_bShuttingDown(false)
+	{
+		for (unsigned int i = 0; i <= p_uiWorkerCount; ++i)
+		{
+			m_vQueues.push_back(new WorkQueue());
+		}
+
+		// The workers only look their queues up by thread ID once they've been given
+		// a job, which is after this has returned.
+		for (unsigned int i = 0; i < p_uiWorkerCount; ++i)
+		{
+			m_vWorkers.push_back(std::thread(&JobSystem::WorkerLoop, this, i + 1));
+			m_vWorkerIDs.push_back(m_vWorkers.back().get_id());
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::~JobSystem
+	//
+	// Wakes the workers to tell them to finish, and waits for them to do so.
+	//------------------------------------------------------------------------------
+	JobSystem::~JobSystem()
+	{
+		assert(!IsRunningJobs() && "JobSystem Destroyed While Running Jobs");
+
+		{
+			std::lock_guard<std::mutex> mLock(m_mSleepMutex);
+			m_bShuttingDown = true;
+		}
+		m_mWakeCondition.notify_all();
+
+		for (unsigned int i = 0; i < m_vWorkers.size(); ++i)
+		{
+			m_vWorkers[i].join();
+		}
+
+		for (unsigned int i = 0; i < m_vQueues.size(); ++i)
+		{
+			delete m_vQueues[i];
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::ParallelFor
+	// Parameters:
+	//	const unsigned int p_uiCount - The number of iterations.
+	//	const unsigned int p_uiBatchSize - The most iterations to run in one batch,
+	//		or 0 to choose.
+	//	const RangeJob& p_Job - Runs a batch of iterations.
+	//
+	// Deals the batches out round the queues, starting with the caller's, wakes the
+	// workers, then runs and steals batches until every one of them has finished.
+	//------------------------------------------------------------------------------
+	void JobSystem::ParallelFor(const unsigned int p_uiCount, const unsigned int p_uiBatchSize, const RangeJob& p_Job)
+	{
+		if (p_uiCount == 0)
+		{
+			return;
+		}
+
+		const unsigned int uiThreads = m_vQueues.size();
+		unsigned int uiBatchSize = p_uiBatchSize;
+		if (uiBatchSize == 0)
+		{
+			uiBatchSize = p_uiCount / (uiThreads * BATCHES_PER_THREAD);
+			if (uiBatchSize == 0)
+			{
+				uiBatchSize = 1;
+			}
+		}
+
+		// Not worth handing out.
+		if (m_vWorkers.empty() || p_uiCount <= uiBatchSize)
+		{
+			m_iRunningLoops.fetch_add(1, std::memory_order_relaxed);
+			p_Job(0, p_uiCount);
+			m_iRunningLoops.fetch_sub(1, std::memory_order_relaxed);
+			return;
+		}
+
+		m_iRunningLoops.fetch_add(1, std::memory_order_relaxed);
+
+		const unsigned int uiBatches = (p_uiCount + uiBatchSize - 1) / uiBatchSize;
+		std::atomic<unsigned int> uiRemaining(uiBatches);
+		const unsigned int uiQueueIndex = GetQueueIndex();
+
+		// Counted first, so the count never drops below zero as batches are taken.
+		m_iQueuedJobs.fetch_add(static_cast<int>(uiBatches), std::memory_order_release);
+
+		for (unsigned int i = 0; i < uiBatches; ++i)
+		{
+			Job mJob;
+			mJob.pFunction = &p_Job;
+			mJob.uiBegin = i * uiBatchSize;
+			mJob.uiEnd = (mJob.uiBegin + uiBatchSize < p_uiCount ? mJob.uiBegin + uiBatchSize : p_uiCount);
+			mJob.pRemaining = &uiRemaining;
+
+			WorkQueue* pQueue = m_vQueues[(uiQueueIndex + i) % uiThreads];
+			std::lock_guard<std::mutex> mLock(pQueue->mMutex);
+			pQueue->dJobs.push_back(mJob);
+		}
+
+		{
+			// Taking the lock means no worker can be between checking for work and
+			// going to sleep, so none of them miss the notification.
+			std::lock_guard<std::mutex> mLock(m_mSleepMutex);
+		}
+		m_mWakeCondition.notify_all();
+
+		while (uiRemaining.load(std::memory_order_acquire) > 0)
+		{
+			if (!TryRunJob(uiQueueIndex))
+			{
+				// The last batches are running on other threads.
+				std::this_thread::yield();
+			}
+		}
+
+		m_iRunningLoops.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::WorkerLoop
+	// Parameters:
+	//	const unsigned int p_uiQueueIndex - The worker's own queue.
+	//
+	// Runs jobs while there are any to be found, and sleeps while there are none,
+	// until the JobSystem is destroyed.
+	//------------------------------------------------------------------------------
+	void JobSystem::WorkerLoop(const unsigned int p_uiQueueIndex)
+	{
+		for (;;)
+		{
+			if (TryRunJob(p_uiQueueIndex))
+			{
+				continue;
+			}
+
+			std::unique_lock<std::mutex> mLock(m_mSleepMutex);
+			m_mWakeCondition.wait(mLock, [this]() { return m_bShuttingDown || m_iQueuedJobs.load(std::memory_order_acquire) > 0; });
+			if (m_bShuttingDown)
+			{
+				return;
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::GetQueueIndex
+	// Returns: unsigned int - The calling thread's queue.
+	//------------------------------------------------------------------------------
+	unsigned int JobSystem::GetQueueIndex() const
+	{
+		const std::thread::id mThreadID = std::this_thread::get_id();
+		for (unsigned int i = 0; i < m_vWorkerIDs.size(); ++i)
+		{
+			if (m_vWorkerIDs[i] == mThreadID)
+			{
+				return i + 1;
+			}
+		}
+
+		return 0;
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::TryRunJob
+	// Parameters:
+	//	const unsigned int p_uiQueueIndex - The calling thread's queue.
+	// Returns: bool - False if there were no jobs to run.
+	//
+	// Runs a job from the thread's own queue, or failing that one stolen from
+	// another thread's queue.
+	//------------------------------------------------------------------------------
+	bool JobSystem::TryRunJob(const unsigned int p_uiQueueIndex)
+	{
+		Job mJob;
+		if (!PopJob(p_uiQueueIndex, mJob) && !StealJob(p_uiQueueIndex, mJob))
+		{
+			return false;
+		}
+
+		(*mJob.pFunction)(mJob.uiBegin, mJob.uiEnd);
+
+		// Once this reaches zero the caller of ParallelFor() may return, taking the
+		// counter and function with it, so neither is touched after this.
+		mJob.pRemaining->fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::PopJob
+	// Parameters:
+	//	const unsigned int p_uiQueueIndex - The calling thread's queue.
+	//	Job& p_mJobOut - Receives the job.
+	// Returns: bool - False if the queue was empty.
+	//
+	// Takes the newest job from the thread's own queue.
+	//------------------------------------------------------------------------------
+	bool JobSystem::PopJob(const unsigned int p_uiQueueIndex, Job& p_mJobOut)
+	{
+		WorkQueue* pQueue = m_vQueues[p_uiQueueIndex];
+		std::lock_guard<std::mutex> mLock(pQueue->mMutex);
+		if (pQueue->dJobs.empty())
+		{
+			return false;
+		}
+
+		p_mJobOut = pQueue->dJobs.back();
+		pQueue->dJobs.pop_back();
+		m_iQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------
+	// JobSystem::StealJob
+	// Parameters:
+	//	const unsigned int p_uiQueueIndex - The calling thread's queue.
+	//	Job& p_mJobOut - Receives the job.
+	// Returns: bool - False if every other queue was empty.
+	//
+	// Takes the oldest job from the first other queue that has one, starting with
+	// the next queue along so that thieves spread out.
+	//------------------------------------------------------------------------------
+	bool JobSystem::StealJob(const unsigned int p_uiQueueIndex, Job& p_mJobOut)
+	{
+		const unsigned int uiThreads = m_vQueues.size();
+		for (unsigned int i = 1; i < uiThreads; ++i)
+		{
+			WorkQueue* pQueue = m_vQueues[(p_uiQueueIndex + i) % uiThreads];
+			std::lock_guard<std::mutex> mLock(pQueue->mMutex);
+			if (!pQueue->dJobs.empty())
+			{
+				p_mJobOut = pQueue->dJobs.front();
+				pQueue->dJobs.pop_front();
+				m_iQueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+
+		return false;
+	}
+}
@@ -0,0 +1,123 @@
+//==================================================================================
+// JobSystem
+//
+// A pool of worker threads which run batches of a parallel loop alongside the
+// thread that started it.
+//
+// Each thread, the one that started the loop included, has its own queue of
+// batches. A thread takes work from the back of its own queue and, once that is
+// empty, steals from the front of the others', so a thread which draws cheap
+// batches helps out with the expensive ones instead of sitting idle. The caller
+// of ParallelFor() works through batches too, and only returns once all of its
+// batches have finished.
+//
+// Jobs must not create or destroy GameObjects, or dispatch events. Results that
+// other objects need should be picked up on the main thread afterwards, or handed
+// over with EventManager::PostEvent().
+//==================================================================================
+
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	class JobSystem
+	{
+	public:
+		//-----------------------------------------------------------------------------
+		// Public types
+		//-----------------------------------------------------------------------------
+		// One batch of a parallel loop: runs the iterations in [p_uiBegin, p_uiEnd).
+		typedef std::function<void(const unsigned int p_uiBegin, const unsigned int p_uiEnd)> RangeJob;
+
+		//-----------------------------------------------------------------------------
+		// Public Interface
+		//-----------------------------------------------------------------------------
+		// Singleton methods. With no worker count given, one worker is started for
+		// each hardware thread besides the calling one.
+		static void CreateInstance(const unsigned int p_uiWorkerCount = DEFAULT_WORKER_COUNT);
+		static void DestroyInstance();
+		static JobSystem* Instance();
+
+		// Runs p_Job over [0, p_uiCount) in batches of up to p_uiBatchSize iterations,
+		// across the workers and the calling thread, and returns once every batch is
+		// done. With a batch size of 0, one is chosen that gives each thread a few
+		// batches to balance out uneven iterations. May be called from inside a job.
+		void ParallelFor(const unsigned int p_uiCount, const unsigned int p_uiBatchSize, const RangeJob& p_Job);
+
+		unsigned int GetWorkerCount() const { return m_vWorkers.size(); }
+
+		// True while any ParallelFor() is running, for asserting that code which
+		// mustn't run inside a job isn't.
+		bool IsRunningJobs() const { return m_iRunningLoops.load(std::memory_order_relaxed) > 0; }
+
+	private:
+		//-----------------------------------------------------------------------------
+		// Private types
+		//-----------------------------------------------------------------------------
+		struct Job
+		{
+			const RangeJob* pFunction;
+			unsigned int uiBegin;
+			unsigned int uiEnd;
+			std::atomic<unsigned int>* pRemaining;
+		};
+
+		struct WorkQueue
+		{
+			std::mutex mMutex;
+			std::deque<Job> dJobs;
+		};
+
+		static const unsigned int DEFAULT_WORKER_COUNT = 0xFFFFFFFF;
+
+		// Batches each thread should get from a loop with no batch size given.
+		static const unsigned int BATCHES_PER_THREAD = 4;
+
+		//-----------------------------------------------------------------------------
+		// Private members
+		//-----------------------------------------------------------------------------
+		static JobSystem* s_pJobSystemInstance;
+
+		// Queue 0 belongs to the thread that created the JobSystem and to any other
+		// thread outside the pool; queue i + 1 belongs to worker i.
+		std::vector<WorkQueue*> m_vQueues;
+		std::vector<std::thread> m_vWorkers;
+		std::vector<std::thread::id> m_vWorkerIDs;
+
+		// Batches waiting in any queue. Idle workers sleep until this is non-zero.
+		std::atomic<int> m_iQueuedJobs;
+		std::atomic<int> m_iRunningLoops;
+		std::mutex m_mSleepMutex;
+		std::condition_variable m_mWakeCondition;
+		bool m_bShuttingDown;
+
+		//-----------------------------------------------------------------------------
+		// Private methods
+		//-----------------------------------------------------------------------------
+		JobSystem(const unsigned int p_uiWorkerCount);
+		~JobSystem();
+
+		// JobSystems shouldn't be copied.
+		JobSystem(const JobSystem&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+
+		void WorkerLoop(const unsigned int p_uiQueueIndex);
+		unsigned int GetQueueIndex() const;
+
+		bool TryRunJob(const unsigned int p_uiQueueIndex);
+		bool PopJob(const unsigned int p_uiQueueIndex, Job& p_mJobOut);
+		bool StealJob(const unsigned int p_uiQueueIndex, Job& p_mJobOut);
+	};
+}
+
+#endif // JOB_SYSTEM_H
@@ -0,0 +1,658 @@
+//==================================================================================
+// SIMDMath
+//
+// SSE2 and AVX versions of the matrix operations the engine runs most often:
+// mat4 products, quaternion to mat4, and the inverse-transpose used for normals.
+// The fastest version the CPU supports is picked at startup.
+//==================================================================================
+
+#include "SIMDMath.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <assert.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define SIMD_MATH_X86
+	#include <immintrin.h>
+
+	// MSVC allows any intrinsic in any function. GCC and Clang only allow those
+	// of the instruction sets a function is compiled for.
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define SIMD_MATH_SSE2
+		#define SIMD_MATH_AVX
+	#else
+		#include <cpuid.h>
+		#define SIMD_MATH_SSE2 __attribute__((target("sse2")))
+		#define SIMD_MATH_AVX __attribute__((target("avx")))
+	#endif
+#endif
+
+namespace HeatStroke
+{
+	namespace SIMDMath
+	{
+		//------------------------------------------------------------------------------
+		// Scalar (glm) kernels
+		//------------------------------------------------------------------------------
+		static void ScalarMultiply(const glm::mat4& p_mA, const glm::mat4& p_mB, glm::mat4& p_mOut)
+		{
+			p_mOut = p_mA * p_mB;
+		}
+
+		static void ScalarInverseTranspose(const glm::mat4& p_mTransform, glm::mat3& p_mOut)
+		{
+			p_mOut = glm::transpose(glm::inverse(glm::mat3(p_mTransform)));
+		}
+
+		static void ScalarMultiplyBatch(const glm::mat4* p_pA, const glm::mat4* p_pB, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				p_pOut[i] = p_pA[i] * p_pB[i];
+			}
+		}
+
+		static void ScalarQuatToMat4Batch(const glm::quat* p_pRotations, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				p_pOut[i] = glm::mat4_cast(p_pRotations[i]);
+			}
+		}
+
+		static void ScalarInverseTransposeBatch(const glm::mat4* p_pTransforms, glm::mat3* p_pOut, const unsigned int p_uiCount)
+		{
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				p_pOut[i] = glm::transpose(glm::inverse(glm::mat3(p_pTransforms[i])));
+			}
+		}
+
+#ifdef SIMD_MATH_X86
+		//------------------------------------------------------------------------------
+		// SSE2 kernels
+		//
+		// glm matrices are column major with no padding, so a mat4 column is four
+		// consecutive floats and a mat3 is nine. Nothing is assumed about alignment.
+		//------------------------------------------------------------------------------
+		#define SIMD_SPLAT(v, i) _mm_shuffle_ps((v), (v), _MM_SHUFFLE(i, i, i, i))
+
+		// One column of A * B, summed in the same order as glm so the result matches.
+		SIMD_MATH_SSE2 static inline __m128 SSE2Column(const __m128 p_vA0, const __m128 p_vA1, const __m128 p_vA2, const __m128 p_vA3, const __m128 p_vB)
+		{
+			__m128 vResult = _mm_add_ps(_mm_mul_ps(p_vA0, SIMD_SPLAT(p_vB, 0)), _mm_mul_ps(p_vA1, SIMD_SPLAT(p_vB, 1)));
+			vResult = _mm_add_ps(vResult, _mm_mul_ps(p_vA2, SIMD_SPLAT(p_vB, 2)));
+			return _mm_add_ps(vResult, _mm_mul_ps(p_vA3, SIMD_SPLAT(p_vB, 3)));
+		}
+
+		// The cross product of the xyz parts. w is garbage.
+		SIMD_MATH_SSE2 static inline __m128 SSE2Cross(const __m128 p_vU, const __m128 p_vV)
+		{
+			const __m128 vUYZX = _mm_shuffle_ps(p_vU, p_vU, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 vUZXY = _mm_shuffle_ps(p_vU, p_vU, _MM_SHUFFLE(3, 1, 0, 2));
+			const __m128 vVYZX = _mm_shuffle_ps(p_vV, p_vV, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m128 vVZXY = _mm_shuffle_ps(p_vV, p_vV, _MM_SHUFFLE(3, 1, 0, 2));
+			return _mm_sub_ps(_mm_mul_ps(vUYZX, vVZXY), _mm_mul_ps(vUZXY, vVYZX));
+		}
+
+		// Writes three columns to a mat3. The last column is written as three floats
+		// so nothing past the end of the matrix is touched.
+		SIMD_MATH_SSE2 static inline void SSE2StoreMat3(glm::mat3& p_mOut, const __m128 p_vC0, const __m128 p_vC1, const __m128 p_vC2)
+		{
+			_mm_storeu_ps(&p_mOut[0][0], p_vC0);
+			_mm_storeu_ps(&p_mOut[1][0], p_vC1);
+			_mm_storel_pi(reinterpret_cast<__m64*>(&p_mOut[2][0]), p_vC2);
+			_mm_store_ss(&p_mOut[2][2], _mm_movehl_ps(p_vC2, p_vC2));
+		}
+
+		// The inverse-transpose of the upper 3x3 whose columns are A, B and C. Its
+		// columns are the cross products B x C, C x A and A x B over the determinant.
+		SIMD_MATH_SSE2 static inline void SSE2InverseTransposeColumns(const __m128 p_vA, const __m128 p_vB, const __m128 p_vC, glm::mat3& p_mOut)
+		{
+			const __m128 vBC = SSE2Cross(p_vB, p_vC);
+			const __m128 vCA = SSE2Cross(p_vC, p_vA);
+			const __m128 vAB = SSE2Cross(p_vA, p_vB);
+
+			const __m128 vProduct = _mm_mul_ps(p_vA, vBC);
+			const __m128 vDeterminant = _mm_add_ps(_mm_add_ps(SIMD_SPLAT(vProduct, 0), SIMD_SPLAT(vProduct, 1)), SIMD_SPLAT(vProduct, 2));
+			const __m128 vOneOverDeterminant = _mm_div_ps(_mm_set1_ps(1.0f), vDeterminant);
+
+			SSE2StoreMat3(p_mOut, _mm_mul_ps(vBC, vOneOverDeterminant), _mm_mul_ps(vCA, vOneOverDeterminant), _mm_mul_ps(vAB, vOneOverDeterminant));
+		}
+
+		// Transposes the per-quaternion values of one rotation column for four
+		// quaternions and writes them to those quaternions' matrices.
+		SIMD_MATH_SSE2 static inline void SSE2StoreRotationColumn(glm::mat4* p_pOut, const unsigned int p_uiColumn, __m128 p_vX, __m128 p_vY, __m128 p_vZ)
+		{
+			__m128 vW = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(p_vX, p_vY, p_vZ, vW);
+			_mm_storeu_ps(&p_pOut[0][p_uiColumn][0], p_vX);
+			_mm_storeu_ps(&p_pOut[1][p_uiColumn][0], p_vY);
+			_mm_storeu_ps(&p_pOut[2][p_uiColumn][0], p_vZ);
+			_mm_storeu_ps(&p_pOut[3][p_uiColumn][0], vW);
+		}
+
+		// Whether glm stores a quat as x, y, z, w, which depends on its version and
+		// configuration. If so, quaternions can be loaded whole and transposed.
+		static bool IsQuatXYZW()
+		{
+			const glm::quat qProbe;
+			const float* pProbe = reinterpret_cast<const float*>(&qProbe);
+			return sizeof(glm::quat) == 4 * sizeof(float) &&
+				&qProbe.x == pProbe && &qProbe.y == pProbe + 1 && &qProbe.z == pProbe + 2 && &qProbe.w == pProbe + 3;
+		}
+
+		// Set once by Init(), before any thread can call the kernels.
+		static bool s_bQuatXYZW = false;
+
+		// Loads four quaternions one component per register.
+		SIMD_MATH_SSE2 static inline void SSE2LoadQuats(const glm::quat* p_pRotations, __m128& p_vX, __m128& p_vY, __m128& p_vZ, __m128& p_vW)
+		{
+			const glm::quat* q = p_pRotations;
+			if (s_bQuatXYZW)
+			{
+				p_vX = _mm_loadu_ps(&q[0].x);
+				p_vY = _mm_loadu_ps(&q[1].x);
+				p_vZ = _mm_loadu_ps(&q[2].x);
+				p_vW = _mm_loadu_ps(&q[3].x);
+				_MM_TRANSPOSE4_PS(p_vX, p_vY, p_vZ, p_vW);
+			}
+			else
+			{
+				p_vX = _mm_set_ps(q[3].x, q[2].x, q[1].x, q[0].x);
+				p_vY = _mm_set_ps(q[3].y, q[2].y, q[1].y, q[0].y);
+				p_vZ = _mm_set_ps(q[3].z, q[2].z, q[1].z, q[0].z);
+				p_vW = _mm_set_ps(q[3].w, q[2].w, q[1].w, q[0].w);
+			}
+		}
+
+		// glm::mat4_cast() for four quaternions held one component per register,
+		// with the same arithmetic so the result matches.
+		SIMD_MATH_SSE2 static inline void SSE2QuatToMat4x4(const __m128 p_vX, const __m128 p_vY, const __m128 p_vZ, const __m128 p_vW, glm::mat4* p_pOut)
+		{
+			const __m128 vOne = _mm_set1_ps(1.0f);
+			const __m128 vTwo = _mm_set1_ps(2.0f);
+
+			const __m128 vXX = _mm_mul_ps(p_vX, p_vX);
+			const __m128 vYY = _mm_mul_ps(p_vY, p_vY);
+			const __m128 vZZ = _mm_mul_ps(p_vZ, p_vZ);
+			const __m128 vXZ = _mm_mul_ps(p_vX, p_vZ);
+			const __m128 vXY = _mm_mul_ps(p_vX, p_vY);
+			const __m128 vYZ = _mm_mul_ps(p_vY, p_vZ);
+			const __m128 vWX = _mm_mul_ps(p_vW, p_vX);
+			const __m128 vWY = _mm_mul_ps(p_vW, p_vY);
+			const __m128 vWZ = _mm_mul_ps(p_vW, p_vZ);
+
+			SSE2StoreRotationColumn(p_pOut, 0,
+				_mm_sub_ps(vOne, _mm_mul_ps(vTwo, _mm_add_ps(vYY, vZZ))),
+				_mm_mul_ps(vTwo, _mm_add_ps(vXY, vWZ)),
+				_mm_mul_ps(vTwo, _mm_sub_ps(vXZ, vWY)));
+			SSE2StoreRotationColumn(p_pOut, 1,
+				_mm_mul_ps(vTwo, _mm_sub_ps(vXY, vWZ)),
+				_mm_sub_ps(vOne, _mm_mul_ps(vTwo, _mm_add_ps(vXX, vZZ))),
+				_mm_mul_ps(vTwo, _mm_add_ps(vYZ, vWX)));
+			SSE2StoreRotationColumn(p_pOut, 2,
+				_mm_mul_ps(vTwo, _mm_add_ps(vXZ, vWY)),
+				_mm_mul_ps(vTwo, _mm_sub_ps(vYZ, vWX)),
+				_mm_sub_ps(vOne, _mm_mul_ps(vTwo, _mm_add_ps(vXX, vYY))));
+
+			const __m128 vTranslation = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+			for (unsigned int i = 0; i < 4; ++i)
+			{
+				_mm_storeu_ps(&p_pOut[i][3][0], vTranslation);
+			}
+		}
+
+		SIMD_MATH_SSE2 static void SSE2Multiply(const glm::mat4& p_mA, const glm::mat4& p_mB, glm::mat4& p_mOut)
+		{
+			const __m128 vA0 = _mm_loadu_ps(&p_mA[0][0]);
+			const __m128 vA1 = _mm_loadu_ps(&p_mA[1][0]);
+			const __m128 vA2 = _mm_loadu_ps(&p_mA[2][0]);
+			const __m128 vA3 = _mm_loadu_ps(&p_mA[3][0]);
+
+			// Every column is worked out before any is written, in case p_mOut is an input.
+			const __m128 vC0 = SSE2Column(vA0, vA1, vA2, vA3, _mm_loadu_ps(&p_mB[0][0]));
+			const __m128 vC1 = SSE2Column(vA0, vA1, vA2, vA3, _mm_loadu_ps(&p_mB[1][0]));
+			const __m128 vC2 = SSE2Column(vA0, vA1, vA2, vA3, _mm_loadu_ps(&p_mB[2][0]));
+			const __m128 vC3 = SSE2Column(vA0, vA1, vA2, vA3, _mm_loadu_ps(&p_mB[3][0]));
+
+			_mm_storeu_ps(&p_mOut[0][0], vC0);
+			_mm_storeu_ps(&p_mOut[1][0], vC1);
+			_mm_storeu_ps(&p_mOut[2][0], vC2);
+			_mm_storeu_ps(&p_mOut[3][0], vC3);
+		}
+
+		SIMD_MATH_SSE2 static void SSE2InverseTranspose(const glm::mat4& p_mTransform, glm::mat3& p_mOut)
+		{
+			SSE2InverseTransposeColumns(_mm_loadu_ps(&p_mTransform[0][0]), _mm_loadu_ps(&p_mTransform[1][0]), _mm_loadu_ps(&p_mTransform[2][0]), p_mOut);
+		}
+
+		SIMD_MATH_SSE2 static void SSE2MultiplyBatch(const glm::mat4* p_pA, const glm::mat4* p_pB, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				SSE2Multiply(p_pA[i], p_pB[i], p_pOut[i]);
+			}
+		}
+
+		SIMD_MATH_SSE2 static void SSE2QuatToMat4Batch(const glm::quat* p_pRotations, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			unsigned int i = 0;
+			for (; i + 4 <= p_uiCount; i += 4)
+			{
+				__m128 vX, vY, vZ, vW;
+				SSE2LoadQuats(p_pRotations + i, vX, vY, vZ, vW);
+				SSE2QuatToMat4x4(vX, vY, vZ, vW, p_pOut + i);
+			}
+			ScalarQuatToMat4Batch(p_pRotations + i, p_pOut + i, p_uiCount - i);
+		}
+
+		SIMD_MATH_SSE2 static void SSE2InverseTransposeBatch(const glm::mat4* p_pTransforms, glm::mat3* p_pOut, const unsigned int p_uiCount)
+		{
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				SSE2InverseTranspose(p_pTransforms[i], p_pOut[i]);
+			}
+		}
+
+		#undef SIMD_SPLAT
+
+		//------------------------------------------------------------------------------
+		// AVX kernels
+		//
+		// A register holds the same column of two matrices, one per 128-bit lane, so
+		// the in-lane shuffles work as they do for SSE2. Each kernel ends with
+		// _mm256_zeroupper() to avoid the penalty for mixing in SSE code afterwards.
+		//
+		// Quaternion conversion has no AVX kernel. It is limited by writing out the
+		// matrices, and eight at a time measured no faster than SSE2's four.
+		//------------------------------------------------------------------------------
+		#define SIMD_SPLAT256(v, i) _mm256_shuffle_ps((v), (v), _MM_SHUFFLE(i, i, i, i))
+
+		SIMD_MATH_AVX static inline __m256 AVXLoadPair(const float* p_pLow, const float* p_pHigh)
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p_pLow)), _mm_loadu_ps(p_pHigh), 1);
+		}
+
+		SIMD_MATH_AVX static inline __m256 AVXColumn(const __m256 p_vA0, const __m256 p_vA1, const __m256 p_vA2, const __m256 p_vA3, const __m256 p_vB)
+		{
+			__m256 vResult = _mm256_add_ps(_mm256_mul_ps(p_vA0, SIMD_SPLAT256(p_vB, 0)), _mm256_mul_ps(p_vA1, SIMD_SPLAT256(p_vB, 1)));
+			vResult = _mm256_add_ps(vResult, _mm256_mul_ps(p_vA2, SIMD_SPLAT256(p_vB, 2)));
+			return _mm256_add_ps(vResult, _mm256_mul_ps(p_vA3, SIMD_SPLAT256(p_vB, 3)));
+		}
+
+		SIMD_MATH_AVX static inline __m256 AVXCross(const __m256 p_vU, const __m256 p_vV)
+		{
+			const __m256 vUYZX = _mm256_shuffle_ps(p_vU, p_vU, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m256 vUZXY = _mm256_shuffle_ps(p_vU, p_vU, _MM_SHUFFLE(3, 1, 0, 2));
+			const __m256 vVYZX = _mm256_shuffle_ps(p_vV, p_vV, _MM_SHUFFLE(3, 0, 2, 1));
+			const __m256 vVZXY = _mm256_shuffle_ps(p_vV, p_vV, _MM_SHUFFLE(3, 1, 0, 2));
+			return _mm256_sub_ps(_mm256_mul_ps(vUYZX, vVZXY), _mm256_mul_ps(vUZXY, vVYZX));
+		}
+
+		SIMD_MATH_AVX static void AVXMultiply(const glm::mat4& p_mA, const glm::mat4& p_mB, glm::mat4& p_mOut)
+		{
+			// A single product gains nothing from the wider registers.
+			SSE2Multiply(p_mA, p_mB, p_mOut);
+		}
+
+		SIMD_MATH_AVX static void AVXInverseTranspose(const glm::mat4& p_mTransform, glm::mat3& p_mOut)
+		{
+			SSE2InverseTranspose(p_mTransform, p_mOut);
+		}
+
+		SIMD_MATH_AVX static void AVXMultiplyBatch(const glm::mat4* p_pA, const glm::mat4* p_pB, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			unsigned int i = 0;
+			for (; i + 2 <= p_uiCount; i += 2)
+			{
+				const __m256 vA0 = AVXLoadPair(&p_pA[i][0][0], &p_pA[i + 1][0][0]);
+				const __m256 vA1 = AVXLoadPair(&p_pA[i][1][0], &p_pA[i + 1][1][0]);
+				const __m256 vA2 = AVXLoadPair(&p_pA[i][2][0], &p_pA[i + 1][2][0]);
+				const __m256 vA3 = AVXLoadPair(&p_pA[i][3][0], &p_pA[i + 1][3][0]);
+
+				__m256 avColumns[4];
+				for (unsigned int c = 0; c < 4; ++c)
+				{
+					avColumns[c] = AVXColumn(vA0, vA1, vA2, vA3, AVXLoadPair(&p_pB[i][c][0], &p_pB[i + 1][c][0]));
+				}
+
+				for (unsigned int c = 0; c < 4; ++c)
+				{
+					_mm_storeu_ps(&p_pOut[i][c][0], _mm256_castps256_ps128(avColumns[c]));
+					_mm_storeu_ps(&p_pOut[i + 1][c][0], _mm256_extractf128_ps(avColumns[c], 1));
+				}
+			}
+			_mm256_zeroupper();
+
+			if (i < p_uiCount)
+			{
+				SSE2Multiply(p_pA[i], p_pB[i], p_pOut[i]);
+			}
+		}
+
+		SIMD_MATH_AVX static void AVXInverseTransposeBatch(const glm::mat4* p_pTransforms, glm::mat3* p_pOut, const unsigned int p_uiCount)
+		{
+			const __m256 vOne = _mm256_set1_ps(1.0f);
+
+			unsigned int i = 0;
+			for (; i + 2 <= p_uiCount; i += 2)
+			{
+				const __m256 vA = AVXLoadPair(&p_pTransforms[i][0][0], &p_pTransforms[i + 1][0][0]);
+				const __m256 vB = AVXLoadPair(&p_pTransforms[i][1][0], &p_pTransforms[i + 1][1][0]);
+				const __m256 vC = AVXLoadPair(&p_pTransforms[i][2][0], &p_pTransforms[i + 1][2][0]);
+
+				const __m256 vBC = AVXCross(vB, vC);
+				const __m256 vCA = AVXCross(vC, vA);
+				const __m256 vAB = AVXCross(vA, vB);
+
+				// Same order of operations as SSE2, so the two levels agree exactly.
+				const __m256 vProduct = _mm256_mul_ps(vA, vBC);
+				const __m256 vDeterminant = _mm256_add_ps(_mm256_add_ps(SIMD_SPLAT256(vProduct, 0), SIMD_SPLAT256(vProduct, 1)), SIMD_SPLAT256(vProduct, 2));
+				const __m256 vOneOverDeterminant = _mm256_div_ps(vOne, vDeterminant);
+
+				const __m256 vC0 = _mm256_mul_ps(vBC, vOneOverDeterminant);
+				const __m256 vC1 = _mm256_mul_ps(vCA, vOneOverDeterminant);
+				const __m256 vC2 = _mm256_mul_ps(vAB, vOneOverDeterminant);
+
+				SSE2StoreMat3(p_pOut[i], _mm256_castps256_ps128(vC0), _mm256_castps256_ps128(vC1), _mm256_castps256_ps128(vC2));
+				SSE2StoreMat3(p_pOut[i + 1], _mm256_extractf128_ps(vC0, 1), _mm256_extractf128_ps(vC1, 1), _mm256_extractf128_ps(vC2, 1));
+			}
+			_mm256_zeroupper();
+
+			if (i < p_uiCount)
+			{
+				SSE2InverseTranspose(p_pTransforms[i], p_pOut[i]);
+			}
+		}
+
+		#undef SIMD_SPLAT256
+#endif // SIMD_MATH_X86
+
+		//------------------------------------------------------------------------------
+		// Dispatch
+		//------------------------------------------------------------------------------
+		struct Kernels
+		{
+			void (*Multiply)(const glm::mat4&, const glm::mat4&, glm::mat4&);
+			void (*InverseTranspose)(const glm::mat4&, glm::mat3&);
+			void (*MultiplyBatch)(const glm::mat4*, const glm::mat4*, glm::mat4*, const unsigned int);
+			void (*QuatToMat4Batch)(const glm::quat*, glm::mat4*, const unsigned int);
+			void (*InverseTransposeBatch)(const glm::mat4*, glm::mat3*, const unsigned int);
+		};
+
+		static const Kernels s_aKernels[SL_Count] =
+		{
+			{ ScalarMultiply, ScalarInverseTranspose, ScalarMultiplyBatch, ScalarQuatToMat4Batch, ScalarInverseTransposeBatch },
+#ifdef SIMD_MATH_X86
+			{ SSE2Multiply, SSE2InverseTranspose, SSE2MultiplyBatch, SSE2QuatToMat4Batch, SSE2InverseTransposeBatch },
+			{ AVXMultiply, AVXInverseTranspose, AVXMultiplyBatch, SSE2QuatToMat4Batch, AVXInverseTransposeBatch }
+#else
+			{ ScalarMultiply, ScalarInverseTranspose, ScalarMultiplyBatch, ScalarQuatToMat4Batch, ScalarInverseTransposeBatch },
+			{ ScalarMultiply, ScalarInverseTranspose, ScalarMultiplyBatch, ScalarQuatToMat4Batch, ScalarInverseTransposeBatch }
+#endif
+		};
+
+		// Scalar until Init() picks the level, so anything that runs before it
+		// still gets correct results.
+		static Level s_eSupportedLevel = SL_Scalar;
+		static Level s_eLevel = SL_Scalar;
+		static const Kernels* s_pKernels = &s_aKernels[SL_Scalar];
+
+		//------------------------------------------------------------------------------
+		// Method:    DetectLevel
+		// Returns:   Level
+		//
+		// Asks the CPU which instruction sets it has. AVX also needs the OS to save
+		// the upper halves of the registers on a context switch, which it reports
+		// through XCR0.
+		//------------------------------------------------------------------------------
+		static Level DetectLevel()
+		{
+#ifdef SIMD_MATH_X86
+			unsigned int uiECX = 0, uiEDX = 0;
+	#ifdef _MSC_VER
+			int aiInfo[4];
+			__cpuid(aiInfo, 1);
+			uiECX = static_cast<unsigned int>(aiInfo[2]);
+			uiEDX = static_cast<unsigned int>(aiInfo[3]);
+	#else
+			unsigned int uiEAX = 0, uiEBX = 0;
+			if (__get_cpuid(1, &uiEAX, &uiEBX, &uiECX, &uiEDX) == 0)
+			{
+				return SL_Scalar;
+			}
+	#endif
+
+			if ((uiEDX & (1u << 26)) == 0)
+			{
+				return SL_Scalar;
+			}
+
+			const bool bOSXSave = (uiECX & (1u << 27)) != 0;
+			const bool bAVX = (uiECX & (1u << 28)) != 0;
+			if (bOSXSave && bAVX)
+			{
+	#ifdef _MSC_VER
+				const unsigned long long ullXCR0 = _xgetbv(0);
+	#else
+				unsigned int uiLow = 0, uiHigh = 0;
+				__asm__ __volatile__("xgetbv" : "=a"(uiLow), "=d"(uiHigh) : "c"(0));
+				const unsigned long long ullXCR0 = (static_cast<unsigned long long>(uiHigh) << 32) | uiLow;
+	#endif
+				// Bit 1 is the SSE state, bit 2 the AVX state.
+				if ((ullXCR0 & 0x6) == 0x6)
+				{
+					return SL_AVX;
+				}
+			}
+
+			return SL_SSE2;
+#else
+			return SL_Scalar;
+#endif
+		}
+
+		void Init()
+		{
+			s_bQuatXYZW = IsQuatXYZW();
+			s_eSupportedLevel = DetectLevel();
+			SetLevel(s_eSupportedLevel);
+		}
+
+		Level GetSupportedLevel()
+		{
+			return s_eSupportedLevel;
+		}
+
+		Level GetLevel()
+		{
+			return s_eLevel;
+		}
+
+		const char* GetLevelName(const Level p_eLevel)
+		{
+			switch (p_eLevel)
+			{
+			case SL_Scalar:	return "glm";
+			case SL_SSE2:	return "SSE2";
+			case SL_AVX:	return "AVX";
+			default:		return "Unknown";
+			}
+		}
+
+		void SetLevel(const Level p_eLevel)
+		{
+			assert(p_eLevel >= SL_Scalar && p_eLevel < SL_Count);
+			s_eLevel = std::min(p_eLevel, GetSupportedLevel());
+			s_pKernels = &s_aKernels[s_eLevel];
+		}
+
+		void Multiply(const glm::mat4& p_mA, const glm::mat4& p_mB, glm::mat4& p_mOut)
+		{
+			s_pKernels->Multiply(p_mA, p_mB, p_mOut);
+		}
+
+		void QuatToMat4(const glm::quat& p_qRotation, glm::mat4& p_mOut)
+		{
+			// One quaternion doesn't fill a register, so there's no faster way than
+			// glm's. The batch version is where the SIMD levels help.
+			p_mOut = glm::mat4_cast(p_qRotation);
+		}
+
+		void InverseTranspose(const glm::mat4& p_mTransform, glm::mat3& p_mOut)
+		{
+			s_pKernels->InverseTranspose(p_mTransform, p_mOut);
+		}
+
+		void MultiplyBatch(const glm::mat4* p_pA, const glm::mat4* p_pB, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			s_pKernels->MultiplyBatch(p_pA, p_pB, p_pOut, p_uiCount);
+		}
+
+		void QuatToMat4Batch(const glm::quat* p_pRotations, glm::mat4* p_pOut, const unsigned int p_uiCount)
+		{
+			s_pKernels->QuatToMat4Batch(p_pRotations, p_pOut, p_uiCount);
+		}
+
+		void InverseTransposeBatch(const glm::mat4* p_pTransforms, glm::mat3* p_pOut, const unsigned int p_uiCount)
+		{
+			s_pKernels->InverseTransposeBatch(p_pTransforms, p_pOut, p_uiCount);
+		}
+
+		//------------------------------------------------------------------------------
+		// Benchmark
+		//------------------------------------------------------------------------------
+		template <typename Matrix>
+		static float MaxDifference(const std::vector<Matrix>& p_vA, const std::vector<Matrix>& p_vB)
+		{
+			float fMax = 0.0f;
+			for (unsigned int i = 0; i < p_vA.size(); ++i)
+			{
+				const float* pA = &p_vA[i][0][0];
+				const float* pB = &p_vB[i][0][0];
+				for (unsigned int j = 0; j < sizeof(Matrix) / sizeof(float); ++j)
+				{
+					fMax = std::max(fMax, std::fabs(pA[j] - pB[j]));
+				}
+			}
+			return fMax;
+		}
+
+		// Runs p_Operation p_uiIterations times and returns the seconds taken.
+		template <typename Operation>
+		static double Time(const unsigned int p_uiIterations, Operation p_Operation)
+		{
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			for (unsigned int i = 0; i < p_uiIterations; ++i)
+			{
+				p_Operation();
+			}
+			return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+
+		static void PrintResult(const char* p_strOperation, const Level p_eLevel, const unsigned int p_uiOperations, const double p_dSeconds, const double p_dScalarSeconds, const float p_fMaxDifference)
+		{
+			printf("%-18s %-6s %10.2f %8.2fx %12g\n",
+				p_strOperation,
+				GetLevelName(p_eLevel),
+				p_uiOperations / p_dSeconds / 1000000.0,
+				p_dScalarSeconds / p_dSeconds,
+				p_fMaxDifference);
+		}
+
+		void RunBenchmark(const unsigned int p_uiCount, const unsigned int p_uiIterations)
+		{
+			assert(p_uiCount > 0 && p_uiIterations > 0);
+
+			// Random affine transforms, like the ones the engine builds, with scales
+			// kept away from zero so every matrix can be inverted.
+			std::mt19937 rng(483);
+			std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+			std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+			std::vector<glm::quat> vRotations(p_uiCount);
+			std::vector<glm::mat4> vA(p_uiCount), vB(p_uiCount);
+			for (unsigned int i = 0; i < p_uiCount; ++i)
+			{
+				vRotations[i] = glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng) + 1.5f));
+
+				for (unsigned int m = 0; m < 2; ++m)
+				{
+					glm::mat4 mTransform = glm::mat4_cast(glm::normalize(glm::quat(unit(rng), unit(rng), unit(rng), unit(rng) + 1.5f)));
+					mTransform[0] *= scale(rng);
+					mTransform[1] *= scale(rng);
+					mTransform[2] *= scale(rng);
+					mTransform[3] = glm::vec4(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f, 1.0f);
+					(m == 0 ? vA[i] : vB[i]) = mTransform;
+				}
+			}
+
+			// glm's results, to compare the other levels against.
+			std::vector<glm::mat4> vExpectedProducts(p_uiCount), vExpectedRotations(p_uiCount);
+			std::vector<glm::mat3> vExpectedInverseTransposes(p_uiCount);
+			ScalarMultiplyBatch(vA.data(), vB.data(), vExpectedProducts.data(), p_uiCount);
+			ScalarQuatToMat4Batch(vRotations.data(), vExpectedRotations.data(), p_uiCount);
+			ScalarInverseTransposeBatch(vA.data(), vExpectedInverseTransposes.data(), p_uiCount);
+
+			std::vector<glm::mat4> vProducts(p_uiCount), vRotationMatrices(p_uiCount);
+			std::vector<glm::mat3> vInverseTransposes(p_uiCount);
+
+			const Level eOriginalLevel = GetLevel();
+			const unsigned int uiOperations = p_uiCount * p_uiIterations;
+			double adScalarSeconds[3] = { 0.0, 0.0, 0.0 };
+
+			// What a call site gets without SIMDMath: glm's product, inlined.
+			const double dInlineMultiply = Time(p_uiIterations, [&]()
+			{
+				for (unsigned int i = 0; i < p_uiCount; ++i)
+				{
+					vProducts[i] = vA[i] * vB[i];
+				}
+			});
+
+			printf("SIMDMath benchmark: %u matrices x %u iterations, CPU supports %s\n", p_uiCount, p_uiIterations, GetLevelName(GetSupportedLevel()));
+			printf("%-18s %-6s %10s %9s %12s\n", "Operation", "Level", "M ops/s", "Speedup", "Max diff");
+
+			for (int iLevel = SL_Scalar; iLevel <= GetSupportedLevel(); ++iLevel)
+			{
+				const Level eLevel = static_cast<Level>(iLevel);
+				SetLevel(eLevel);
+
+				const double dMultiply = Time(p_uiIterations, [&]() { MultiplyBatch(vA.data(), vB.data(), vProducts.data(), p_uiCount); });
+				const double dQuat = Time(p_uiIterations, [&]() { QuatToMat4Batch(vRotations.data(), vRotationMatrices.data(), p_uiCount); });
+				const double dInverse = Time(p_uiIterations, [&]() { InverseTransposeBatch(vA.data(), vInverseTransposes.data(), p_uiCount); });
+				const float fMultiplyDifference = MaxDifference(vProducts, vExpectedProducts);
+
+				const double dSingleMultiply = Time(p_uiIterations, [&]()
+				{
+					for (unsigned int i = 0; i < p_uiCount; ++i)
+					{
+						Multiply(vA[i], vB[i], vProducts[i]);
+					}
+				});
+				const float fSingleMultiplyDifference = MaxDifference(vProducts, vExpectedProducts);
+
+				if (eLevel == SL_Scalar)
+				{
+					adScalarSeconds[0] = dMultiply;
+					adScalarSeconds[1] = dQuat;
+					adScalarSeconds[2] = dInverse;
+				}
+
+				PrintResult("mat4 * mat4", eLevel, uiOperations, dMultiply, adScalarSeconds[0], fMultiplyDifference);
+				PrintResult("quat -> mat4", eLevel, uiOperations, dQuat, adScalarSeconds[1], MaxDifference(vRotationMatrices, vExpectedRotations));
+				PrintResult("inverse-transpose", eLevel, uiOperations, dInverse, adScalarSeconds[2], MaxDifference(vInverseTransposes, vExpectedInverseTransposes));
+				PrintResult("single mat4 * mat4", eLevel, uiOperations, dSingleMultiply, dInlineMultiply, fSingleMultiplyDifference);
+			}
+
+			SetLevel(eOriginalLevel);
+		}
+	}
+}
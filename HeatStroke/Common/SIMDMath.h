@@ -0,0 +1,78 @@
+//==================================================================================
+// SIMDMath
+//
+// SSE2 and AVX versions of the matrix operations the engine runs most often:
+// mat4 products, quaternion to mat4, and the inverse-transpose used for normals.
+// The fastest version the CPU supports is picked at startup.
+//
+// Results match glm's to the last bit, except the inverse-transpose, which is
+// built from cofactors rather than through glm::inverse() and so can differ in
+// rounding. The batch versions are where the wider registers pay off. AVX handles
+// two matrices at once. Quaternions are converted four at a time at both levels.
+//
+// The single-matrix versions go through the same table of kernels as the batches,
+// so the call can't be inlined. For one product at a time, glm's inline operator
+// is no slower, and the engine's per-object transform code uses that. SceneManager
+// uses the batches for every model's normal and world-view-projection transforms.
+//==================================================================================
+
+#ifndef SIMD_MATH_H
+#define SIMD_MATH_H
+
+#include <glm.hpp>
+#include <gtc/quaternion.hpp>
+
+namespace HeatStroke
+{
+	namespace SIMDMath
+	{
+		// Instruction sets, from slowest to fastest.
+		enum Level
+		{
+			SL_Scalar = 0,		// Plain glm.
+			SL_SSE2,
+			SL_AVX,
+
+			SL_Count
+		};
+
+		// Asks the CPU which levels it supports and picks the best one. Call it once
+		// from main(), before any other thread starts; until then everything runs
+		// at SL_Scalar.
+		void Init();
+
+		// The best level the CPU and OS support, and the level in use.
+		Level GetSupportedLevel();
+		Level GetLevel();
+		const char* GetLevelName(const Level p_eLevel);
+
+		// Picks a level, for comparing them. Levels the CPU can't run are lowered
+		// to the supported one. Not thread safe, so call it while nothing else is
+		// using these functions.
+		void SetLevel(const Level p_eLevel);
+
+		// p_mOut = p_mA * p_mB. p_mOut may be either input.
+		void Multiply(const glm::mat4& p_mA, const glm::mat4& p_mB, glm::mat4& p_mOut);
+
+		// p_mOut = glm::mat4_cast(p_qRotation).
+		void QuatToMat4(const glm::quat& p_qRotation, glm::mat4& p_mOut);
+
+		// p_mOut = glm::transpose(glm::inverse(glm::mat3(p_mTransform))).
+		void InverseTranspose(const glm::mat4& p_mTransform, glm::mat3& p_mOut);
+
+		// The same over arrays of p_uiCount. Outputs must not overlap the inputs,
+		// except that p_pOut may be p_pA or p_pB in MultiplyBatch().
+		void MultiplyBatch(const glm::mat4* p_pA, const glm::mat4* p_pB, glm::mat4* p_pOut, const unsigned int p_uiCount);
+		void QuatToMat4Batch(const glm::quat* p_pRotations, glm::mat4* p_pOut, const unsigned int p_uiCount);
+		void InverseTransposeBatch(const glm::mat4* p_pTransforms, glm::mat3* p_pOut, const unsigned int p_uiCount);
+
+		// Times each batch operation on p_uiCount random inputs, p_uiIterations
+		// times over, for glm and for each supported level, and Multiply() called
+		// once per matrix against glm's inline product. Prints the throughput, the
+		// speedup over glm and the largest difference from glm's results to stdout.
+		// Leaves the level as it was.
+		void RunBenchmark(const unsigned int p_uiCount, const unsigned int p_uiIterations);
+	}
+}
+
+#endif // SIMD_MATH_H
@@ -0,0 +1,334 @@
+//==================================================================================
+// AsyncLoader
+//
+// Loads GameObject definition files, and the models they use, on a background
+// thread so that a loading screen can keep drawing in the meantime.
+//==================================================================================
+
+#include "AsyncLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// AsyncLoader::AsyncLoader
+	//------------------------------------------------------------------------------
+	AsyncLoader::AsyncLoader() :
+		m_vGameObjectFiles(),
+		m_vModelFiles(),
+		m_sKnownGameObjectFiles(),
+		m_sKnownModelFiles(),
+		m_mLoaderThread(),
+		m_bCancelled(false),
+		m_mMutex(),
+		m_dLoadedFiles(),
+		m_uiFilesFound(0),
+		m_bLoaderThreadDone(false),
+		m_uiFilesHandedOver(0),
+		m_fProgress(0.0f)
+	{
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::~AsyncLoader
+	//
+	// Tells the loader thread to stop after the file it's on, waits for it, and
+	// throws away whatever it loaded that wasn't handed over.
+	//------------------------------------------------------------------------------
+	AsyncLoader::~AsyncLoader()
+	{
+		m_bCancelled.store(true);
+		if (m_mLoaderThread.joinable())
+		{
+			m_mLoaderThread.join();
+		}
+
+		std::deque<LoadedFile>::iterator it = m_dLoadedFiles.begin(), end = m_dLoadedFiles.end();
+		for (; it != end; ++it)
+		{
+			DiscardLoadedFile(*it);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::AddGameObjectFile
+	// Parameters:
+	//	const std::string& p_strGameObjectDefinitionFile - A definition file to load.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::AddGameObjectFile(const std::string& p_strGameObjectDefinitionFile)
+	{
+		assert(!m_mLoaderThread.joinable() && "AsyncLoader Files Added After Start");
+
+		if (m_sKnownGameObjectFiles.insert(p_strGameObjectDefinitionFile).second)
+		{
+			m_vGameObjectFiles.push_back(p_strGameObjectDefinitionFile);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::AddModelFile
+	// Parameters:
+	//	const std::string& p_strOBJFileName - A model to load.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::AddModelFile(const std::string& p_strOBJFileName)
+	{
+		assert(!m_mLoaderThread.joinable() && "AsyncLoader Files Added After Start");
+
+		if (m_sKnownModelFiles.insert(p_strOBJFileName).second)
+		{
+			m_vModelFiles.push_back(p_strOBJFileName);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::Start
+	//
+	// Drops the models that are already loaded, then starts the loader thread on the
+	// rest.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::Start()
+	{
+		assert(!m_mLoaderThread.joinable() && "AsyncLoader Started Twice");
+
+		std::set<std::string> sLoadedModels;
+		ModelManager::Instance()->GetLoadedModelNames(sLoadedModels);
+
+		std::vector<std::string> vModelFiles;
+		std::vector<std::string>::const_iterator it = m_vModelFiles.begin(), end = m_vModelFiles.end();
+		for (; it != end; ++it)
+		{
+			if (sLoadedModels.find(*it) == sLoadedModels.end())
+			{
+				vModelFiles.push_back(*it);
+			}
+		}
+		m_vModelFiles.swap(vModelFiles);
+
+		// Loaded models stay known, so that the loader thread skips them too.
+		m_sKnownModelFiles.insert(sLoadedModels.begin(), sLoadedModels.end());
+
+		m_uiFilesFound = m_vGameObjectFiles.size() + m_vModelFiles.size();
+		m_mLoaderThread = std::thread(&AsyncLoader::LoaderThread, this);
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::Update
+	// Parameters:
+	//	GameObjectManager* p_pGameObjectManager - Receives the definition files.
+	//	const float p_fBudget - Roughly how long to spend, in seconds.
+	//
+	// Finishes loading the files the loader thread has read, in the order it read
+	// them, then updates the progress.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::Update(GameObjectManager* p_pGameObjectManager, const float p_fBudget)
+	{
+		assert(p_pGameObjectManager != nullptr);
+
+		const std::chrono::high_resolution_clock::time_point mStart = std::chrono::high_resolution_clock::now();
+		const std::chrono::duration<float> mBudget(p_fBudget);
+
+		do
+		{
+			LoadedFile mLoadedFile;
+			{
+				std::lock_guard<std::mutex> mLock(m_mMutex);
+				if (m_dLoadedFiles.empty())
+				{
+					break;
+				}
+
+				mLoadedFile = m_dLoadedFiles.front();
+				m_dLoadedFiles.pop_front();
+			}
+
+			if (mLoadedFile.eType == LT_GameObject)
+			{
+				p_pGameObjectManager->PreloadGameObject(mLoadedFile.strFile, mLoadedFile.pDocument);
+			}
+			else
+			{
+				ModelManager::Instance()->CreateModel(mLoadedFile.strFile, *mLoadedFile.pModelData);
+				delete mLoadedFile.pModelData;
+			}
+
+			++m_uiFilesHandedOver;
+		}
+		while (std::chrono::high_resolution_clock::now() - mStart < mBudget);
+
+		unsigned int uiFilesFound = 0;
+		bool bFinished = false;
+		{
+			std::lock_guard<std::mutex> mLock(m_mMutex);
+			uiFilesFound = m_uiFilesFound;
+			bFinished = (m_bLoaderThreadDone && m_dLoadedFiles.empty());
+		}
+
+		const float fProgress = (bFinished || uiFilesFound == 0 ? 1.0f : static_cast<float>(m_uiFilesHandedOver) / static_cast<float>(uiFilesFound));
+		m_fProgress = std::max(m_fProgress, fProgress);
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::IsFinished
+	// Returns: bool - True once the loader thread is done and everything it loaded
+	//		has been handed over.
+	//------------------------------------------------------------------------------
+	bool AsyncLoader::IsFinished() const
+	{
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		return m_bLoaderThreadDone && m_dLoadedFiles.empty();
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::LoaderThread
+	//
+	// Reads the definition files first, since they name more models, then the
+	// models.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::LoaderThread()
+	{
+		std::set<std::string> sRead;
+		for (unsigned int i = 0; i < m_vGameObjectFiles.size() && !m_bCancelled.load(); ++i)
+		{
+			LoadGameObjectFile(m_vGameObjectFiles[i], sRead);
+		}
+
+		for (unsigned int i = 0; i < m_vModelFiles.size() && !m_bCancelled.load(); ++i)
+		{
+			LoadedFile mLoadedFile;
+			mLoadedFile.eType = LT_Model;
+			mLoadedFile.strFile = m_vModelFiles[i];
+			mLoadedFile.pDocument = nullptr;
+			mLoadedFile.pModelData = new ModelData();
+			Model::LoadModelData(m_vModelFiles[i], *mLoadedFile.pModelData);
+			QueueLoadedFile(mLoadedFile);
+		}
+
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		m_bLoaderThreadDone = true;
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::LoadGameObjectFile
+	// Parameters:
+	//	const std::string& p_strGameObjectDefinitionFile - The file to read.
+	//	std::set<std::string>& p_sRead - The files read so far.
+	//
+	// Reads a definition file, and the files it refers to before it.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::LoadGameObjectFile(const std::string& p_strGameObjectDefinitionFile, std::set<std::string>& p_sRead)
+	{
+		if (!p_sRead.insert(p_strGameObjectDefinitionFile).second)
+		{
+			return;
+		}
+
+		tinyxml2::XMLDocument* pDocument = new tinyxml2::XMLDocument();
+		tinyxml2::XMLError err = pDocument->LoadFile(p_strGameObjectDefinitionFile.c_str());
+#if _DEBUG
+		assert(err == tinyxml2::XML_NO_ERROR);
+#endif
+
+		std::vector<std::string> vDefinitionFiles;
+		FindReferences(pDocument->FirstChildElement("GameObject"), vDefinitionFiles);
+
+		std::vector<std::string>::const_iterator it = vDefinitionFiles.begin(), end = vDefinitionFiles.end();
+		for (; it != end && !m_bCancelled.load(); ++it)
+		{
+			LoadGameObjectFile(*it, p_sRead);
+		}
+
+		LoadedFile mLoadedFile;
+		mLoadedFile.eType = LT_GameObject;
+		mLoadedFile.strFile = p_strGameObjectDefinitionFile;
+		mLoadedFile.pDocument = pDocument;
+		mLoadedFile.pModelData = nullptr;
+		QueueLoadedFile(mLoadedFile);
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::FindReferences
+	// Parameters:
+	//	tinyxml2::XMLElement* p_pElement - The element to search, with its children.
+	//	std::vector<std::string>& p_vDefinitionFiles - Receives the definition files
+	//		referred to.
+	//
+	// Finds the definition files and models an element refers to. Models not seen
+	// before are queued for loading after the definition files.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::FindReferences(tinyxml2::XMLElement* p_pElement, std::vector<std::string>& p_vDefinitionFiles)
+	{
+		if (p_pElement == nullptr)
+		{
+			return;
+		}
+
+		const char* szDefinitionFile = p_pElement->Attribute("definition");
+		if (szDefinitionFile != nullptr && strcmp(p_pElement->Value(), "GameObject") == 0)
+		{
+			p_vDefinitionFiles.push_back(szDefinitionFile);
+			if (m_sKnownGameObjectFiles.insert(szDefinitionFile).second)
+			{
+				FoundFile();
+			}
+		}
+
+		if (strcmp(p_pElement->Value(), "GOC_3DModel") == 0)
+		{
+			tinyxml2::XMLElement* pOBJFileElement = p_pElement->FirstChildElement("OBJFileName");
+			const char* szOBJFileName = (pOBJFileElement != nullptr ? pOBJFileElement->Attribute("path") : nullptr);
+			if (szOBJFileName != nullptr && m_sKnownModelFiles.insert(szOBJFileName).second)
+			{
+				m_vModelFiles.push_back(szOBJFileName);
+				FoundFile();
+			}
+		}
+
+		for (tinyxml2::XMLElement* pChildElement = p_pElement->FirstChildElement();
+			 pChildElement != nullptr;
+			 pChildElement = pChildElement->NextSiblingElement())
+		{
+			FindReferences(pChildElement, p_vDefinitionFiles);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::FoundFile
+	//
+	// Counts a file found by the loader thread towards the progress.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::FoundFile()
+	{
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		++m_uiFilesFound;
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::QueueLoadedFile
+	// Parameters:
+	//	const LoadedFile& p_mLoadedFile - A file the loader thread has read.
+	//
+	// Queues a file to be handed over on the main thread.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::QueueLoadedFile(const LoadedFile& p_mLoadedFile)
+	{
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		m_dLoadedFiles.push_back(p_mLoadedFile);
+	}
+
+	//------------------------------------------------------------------------------
+	// AsyncLoader::DiscardLoadedFile
+	// Parameters:
+	//	LoadedFile& p_mLoadedFile - A file that will never be handed over.
+	//------------------------------------------------------------------------------
+	void AsyncLoader::DiscardLoadedFile(LoadedFile& p_mLoadedFile)
+	{
+		delete p_mLoadedFile.pDocument;
+		p_mLoadedFile.pDocument = nullptr;
+
+		delete p_mLoadedFile.pModelData;
+		p_mLoadedFile.pModelData = nullptr;
+	}
+}
@@ -0,0 +1,121 @@
+//==================================================================================
+// AsyncLoader
+//
+// Loads GameObject definition files, and the models they use, on a background
+// thread so that a loading screen can keep drawing in the meantime.
+//
+// The loader thread reads and parses the XML, follows "definition" attributes to
+// the files they name, and reads the OBJ, MTL and texture files behind every
+// GOC_3DModel it comes across. Anything that needs GL or a GameObjectManager is
+// left for Update() to finish on the main thread, a few files each frame within a
+// time budget. Definition files are handed over after the files they refer to, so
+// none of them are read again on the main thread.
+//==================================================================================
+
+#ifndef ASYNC_LOADER_H
+#define ASYNC_LOADER_H
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "GameObjectManager.h"
+#include "ModelManager.h"
+
+namespace HeatStroke
+{
+	class AsyncLoader
+	{
+	public:
+		//-----------------------------------------------------------------------------
+		// Public Interface
+		//-----------------------------------------------------------------------------
+		AsyncLoader();
+
+		// Stops the loader thread, throwing away anything not yet handed over.
+		~AsyncLoader();
+
+		// The files to load, which must all be added before Start().
+		void AddGameObjectFile(const std::string& p_strGameObjectDefinitionFile);
+		void AddModelFile(const std::string& p_strOBJFileName);
+
+		// Starts the loader thread. Models the ModelManager already has are skipped.
+		void Start();
+
+		// Hands loaded files over to p_pGameObjectManager and the ModelManager until
+		// p_fBudget seconds have passed. At least one file is handed over if any are
+		// ready, however long it takes.
+		void Update(GameObjectManager* p_pGameObjectManager, const float p_fBudget);
+
+		// How much of the loading has been handed over, from 0 to 1. Files are found
+		// as the ones referring to them are read, so this may hold still for a while,
+		// but never goes backwards.
+		float GetProgress() const { return m_fProgress; }
+
+		// True once everything has been loaded and handed over.
+		bool IsFinished() const;
+
+	private:
+		//-----------------------------------------------------------------------------
+		// Private types
+		//-----------------------------------------------------------------------------
+		enum LoadedType
+		{
+			LT_GameObject,
+			LT_Model
+		};
+
+		// A file read by the loader thread, waiting to be handed over.
+		struct LoadedFile
+		{
+			LoadedType eType;
+			std::string strFile;
+			tinyxml2::XMLDocument* pDocument;
+			ModelData* pModelData;
+		};
+
+		//-----------------------------------------------------------------------------
+		// Private members
+		//-----------------------------------------------------------------------------
+		// The files to load. Filled in on the main thread before Start(); after it, only
+		// the loader thread touches them, adding files as it finds them.
+		std::vector<std::string> m_vGameObjectFiles;
+		std::vector<std::string> m_vModelFiles;
+		std::set<std::string> m_sKnownGameObjectFiles;
+		std::set<std::string> m_sKnownModelFiles;
+
+		std::thread m_mLoaderThread;
+		std::atomic<bool> m_bCancelled;
+
+		// Guarded by m_mMutex.
+		mutable std::mutex m_mMutex;
+		std::deque<LoadedFile> m_dLoadedFiles;
+		unsigned int m_uiFilesFound;
+		bool m_bLoaderThreadDone;
+
+		// Main thread only.
+		unsigned int m_uiFilesHandedOver;
+		float m_fProgress;
+
+		//-----------------------------------------------------------------------------
+		// Private methods
+		//-----------------------------------------------------------------------------
+		// AsyncLoaders shouldn't be copied.
+		AsyncLoader(const AsyncLoader&) = delete;
+		AsyncLoader& operator=(const AsyncLoader&) = delete;
+
+		void LoaderThread();
+		void LoadGameObjectFile(const std::string& p_strGameObjectDefinitionFile, std::set<std::string>& p_sRead);
+		void FindReferences(tinyxml2::XMLElement* p_pElement, std::vector<std::string>& p_vDefinitionFiles);
+		void FoundFile();
+		void QueueLoadedFile(const LoadedFile& p_mLoadedFile);
+
+		static void DiscardLoadedFile(LoadedFile& p_mLoadedFile);
+	};
+}
+
+#endif // ASYNC_LOADER_H
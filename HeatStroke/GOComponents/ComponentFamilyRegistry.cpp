@@ -0,0 +1,18 @@
+//------------------------------------------------------------------------
+// ComponentFamilyRegistry
+//	
+// Interns component family strings ("GOC_Renderable", ...) into dense
+// integer IDs, so a GameObject can keep its components in a small array
+// indexed by family instead of a map keyed by string.
+//------------------------------------------------------------------------
+
+#include "ComponentFamilyRegistry.h"
+
+namespace HeatStroke
+{
+	StringInterner& ComponentFamilyRegistry::GetFamilies()
+	{
+		static StringInterner s_mFamilies;
+		return s_mFamilies;
+	}
+}
@@ -0,0 +1,60 @@
+//------------------------------------------------------------------------
+// ComponentFamilyRegistry
+//	
+// Interns component family strings ("GOC_Renderable", ...) into dense
+// integer IDs, so a GameObject can keep its components in a small array
+// indexed by family instead of a map keyed by string.
+//
+// Component classes that define a family expose it statically through
+// StaticFamilyID(), which lets GetID<T>() work out T's family ID once,
+// during static initialization, rather than on every lookup.
+//------------------------------------------------------------------------
+
+#ifndef COMPONENTFAMILYREGISTRY_H
+#define COMPONENTFAMILYREGISTRY_H
+
+#include "StringInterner.h"
+
+namespace HeatStroke
+{
+	// Compact identifier for a component family string.
+	typedef unsigned int ComponentFamilyID;
+
+	class ComponentFamilyRegistry
+	{
+	public:
+		// Returns the ID for p_strFamilyID, registering it if it hasn't been seen before.
+		static ComponentFamilyID Intern(const std::string& p_strFamilyID)		{ return GetFamilies().Intern(p_strFamilyID); }
+
+		// Returns the string that was interned to produce p_uiFamilyID.
+		static const std::string& GetName(const ComponentFamilyID p_uiFamilyID)	{ return GetFamilies().GetName(p_uiFamilyID); }
+
+		// The number of families interned so far. All valid IDs are below this value.
+		static unsigned int GetCount()											{ return GetFamilies().GetCount(); }
+
+		// The family ID of component class T, which must have a StaticFamilyID().
+		template<typename T>
+		static ComponentFamilyID GetID()										{ return FamilyOf<T>::s_uiID; }
+
+	private:
+		// One static per component class, initialized before main() so lookups
+		// never have to check whether it has been set yet.
+		template<typename T>
+		struct FamilyOf
+		{
+			static const ComponentFamilyID s_uiID;
+		};
+
+		// Function-local static so that families may be interned from static
+		// initializers in other translation units regardless of initialization order.
+		static StringInterner& GetFamilies();
+
+		// Only static methods, never instantiated.
+		ComponentFamilyRegistry() = delete;
+	};
+
+	template<typename T>
+	const ComponentFamilyID ComponentFamilyRegistry::FamilyOf<T>::s_uiID = ComponentFamilyRegistry::Intern(T::StaticFamilyID());
+}
+
+#endif // COMPONENTFAMILYREGISTRY_H
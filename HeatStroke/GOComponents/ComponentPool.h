@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------
+// ComponentPool
+//	
+// Per-type block allocator for components. A component class opts in by
+// also deriving from PooledComponent<itself>, which routes its new and
+// delete through ComponentPool<T>. Instances of the class are then carved
+// out of chunks of contiguous blocks instead of being scattered across the
+// heap, so the GameObjectManager's per-family update lists walk memory
+// roughly in order.
+//
+// Classes derived from a pooled class are larger than its blocks, so they
+// quietly fall back to the heap unless they opt in themselves.
+//
+// Components are only created and destroyed on the main thread, so the
+// pool is not locked.
+//------------------------------------------------------------------------
+
+#ifndef COMPONENTPOOL_H
+#define COMPONENTPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace HeatStroke
+{
+	template<typename T>
+	class ComponentPool
+	{
+	public:
+		// Returns memory for an object of p_uiSize bytes.
+		static void* Allocate(const std::size_t p_uiSize)					{ return Instance().AllocateBlock(p_uiSize); }
+
+		// Returns memory obtained from Allocate().
+		static void Free(void* p_pMemory, const std::size_t p_uiSize)		{ Instance().FreeBlock(p_pMemory, p_uiSize); }
+
+		// Number of blocks ever created. This should level off during play.
+		static unsigned int GetCapacity()									{ return Instance().m_uiCapacity; }
+
+	private:
+		//---------------------------------------------------------------------
+		// Private types
+		//---------------------------------------------------------------------
+		// Free blocks are linked through their own first bytes.
+		struct PoolBlock
+		{
+			PoolBlock* pNext;
+		};
+
+		// Number of blocks allocated at a time when the pool runs dry.
+		static const unsigned int CHUNK_BLOCKS = 32;
+
+		// What ::operator new guarantees for the chunks, and so for every block.
+		static const std::size_t ALIGNMENT = std::alignment_of<std::max_align_t>::value;
+
+		//---------------------------------------------------------------------
+		// Private members
+		//---------------------------------------------------------------------
+		// sizeof(T) rounded up to keep every block aligned.
+		const std::size_t m_uiBlockSize;
+
+		std::vector<char*> m_vChunks;
+		PoolBlock* m_pFreeList;
+		unsigned int m_uiCapacity;
+
+		//---------------------------------------------------------------------
+		// Private methods
+		//---------------------------------------------------------------------
+		// Function-local static, so the pool exists before the first component
+		// of its type no matter which translation unit creates it.
+		static ComponentPool& Instance()
+		{
+			static ComponentPool s_mPool;
+			return s_mPool;
+		}
+
+		ComponentPool()
+			:
+			m_uiBlockSize(((sizeof(T) > sizeof(PoolBlock) ? sizeof(T) : sizeof(PoolBlock)) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT),
+			m_vChunks(),
+			m_pFreeList(nullptr),
+			m_uiCapacity(0)
+		{
+		}
+
+		~ComponentPool()
+		{
+			std::vector<char*>::iterator it = m_vChunks.begin(), end = m_vChunks.end();
+			for (; it != end; ++it)
+			{
+				::operator delete(*it);
+			}
+		}
+
+		// ComponentPools shouldn't be copied.
+		ComponentPool(const ComponentPool&) = delete;
+		ComponentPool& operator=(const ComponentPool&) = delete;
+
+		void* AllocateBlock(const std::size_t p_uiSize)
+		{
+			if (p_uiSize > m_uiBlockSize)
+			{
+				return ::operator new(p_uiSize);
+			}
+
+			if (m_pFreeList == nullptr)
+			{
+				Grow();
+			}
+
+			PoolBlock* pBlock = m_pFreeList;
+			m_pFreeList = pBlock->pNext;
+			return pBlock;
+		}
+
+		void FreeBlock(void* p_pMemory, const std::size_t p_uiSize)
+		{
+			if (p_pMemory == nullptr)
+			{
+				return;
+			}
+
+			if (p_uiSize > m_uiBlockSize)
+			{
+				::operator delete(p_pMemory);
+				return;
+			}
+
+			PoolBlock* pBlock = static_cast<PoolBlock*>(p_pMemory);
+			pBlock->pNext = m_pFreeList;
+			m_pFreeList = pBlock;
+		}
+
+		// Adds a chunk of blocks, linked so they are handed out in address order.
+		void Grow()
+		{
+			char* pChunk = static_cast<char*>(::operator new(m_uiBlockSize * CHUNK_BLOCKS));
+			m_vChunks.push_back(pChunk);
+
+			for (unsigned int i = CHUNK_BLOCKS; i > 0; --i)
+			{
+				PoolBlock* pBlock = reinterpret_cast<PoolBlock*>(pChunk + (i - 1) * m_uiBlockSize);
+				pBlock->pNext = m_pFreeList;
+				m_pFreeList = pBlock;
+			}
+			m_uiCapacity += CHUNK_BLOCKS;
+		}
+	};
+
+	// Mix-in giving component class T pooled storage:
+	//	class ComponentTrackPiece : public Component, public PooledComponent<ComponentTrackPiece>
+	template<typename T>
+	class PooledComponent
+	{
+	public:
+		static void* operator new(std::size_t p_uiSize)						{ return ComponentPool<T>::Allocate(p_uiSize); }
+		static void operator delete(void* p_pMemory, std::size_t p_uiSize)	{ ComponentPool<T>::Free(p_pMemory, p_uiSize); }
+	};
+}
+
+#endif // COMPONENTPOOL_H
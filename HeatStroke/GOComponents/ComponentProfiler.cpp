@@ -0,0 +1,256 @@
+//==================================================================================
+// ComponentProfiler
+//
+// Optional instrumentation for GameObjectManager. While enabled it times every
+// component's Update(), ParallelUpdate() and PreRender(), and totals the time and
+// calls by ComponentID() for each frame, so the most expensive component types can
+// be shown on screen or written out, a row per type per frame, as CSV.
+//==================================================================================
+
+#include "ComponentProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::ComponentProfiler
+	//------------------------------------------------------------------------------
+	ComponentProfiler::ComponentProfiler() :
+		m_bEnabled(false),
+		m_vTypeStats(),
+		m_vCurrentFrame(),
+		m_vFrameTypes(),
+		m_vLastFrame(),
+		m_dLastFrameTime(0.0),
+		m_mCSVFile(),
+		m_uiFrame(0)
+	{
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::Reset
+	//
+	// Clears all statistics gathered so far. Any CSV in progress carries on.
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::Reset()
+	{
+		m_vTypeStats.clear();
+		m_vCurrentFrame.clear();
+		m_vFrameTypes.clear();
+		m_vLastFrame.clear();
+		m_dLastFrameTime = 0.0;
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::GetTypeStats
+	// Parameters:
+	//	const unsigned int p_uiTypeID - The component type to get the statistics of.
+	// Returns: const TypeStats& - The statistics, all zero if it was never timed.
+	//------------------------------------------------------------------------------
+	const ComponentProfiler::TypeStats& ComponentProfiler::GetTypeStats(const unsigned int p_uiTypeID) const
+	{
+		static const TypeStats s_mEmptyStats = TypeStats();
+		return (p_uiTypeID < m_vTypeStats.size() ? m_vTypeStats[p_uiTypeID] : s_mEmptyStats);
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::PrintSummary
+	// Parameters:
+	//	const unsigned int p_uiMaxTypes - How many component types to list.
+	//
+	// Prints the component types with the most total time to stdout, along with
+	// their share of the last frame.
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::PrintSummary(const unsigned int p_uiMaxTypes) const
+	{
+		std::vector<unsigned int> vTypes;
+		for (unsigned int i = 0; i < m_vTypeStats.size(); ++i)
+		{
+			if (m_vTypeStats[i].uiCalls > 0)
+			{
+				vTypes.push_back(i);
+			}
+		}
+
+		std::sort(vTypes.begin(), vTypes.end(), [this](unsigned int a, unsigned int b)
+		{
+			return m_vTypeStats[a].dTotalTime > m_vTypeStats[b].dTotalTime;
+		});
+
+		std::vector<double> vLastFrameTimes(m_vTypeStats.size(), 0.0);
+		std::vector<FrameStats>::const_iterator it = m_vLastFrame.begin(), end = m_vLastFrame.end();
+		for (; it != end; ++it)
+		{
+			vLastFrameTimes[it->uiTypeID] = it->dTotalTime;
+		}
+
+		printf("ComponentProfiler: last frame %.3f ms in components\n", m_dLastFrameTime * 1000.0);
+		printf("%-32s %10s %12s %12s %12s\n", "Component", "Calls", "Total (ms)", "Max (ms)", "Frame (ms)");
+
+		const unsigned int uiCount = std::min(p_uiMaxTypes, static_cast<unsigned int>(vTypes.size()));
+		for (unsigned int i = 0; i < uiCount; ++i)
+		{
+			const TypeStats& mStats = m_vTypeStats[vTypes[i]];
+			printf("%-32s %10u %12.3f %12.3f %12.3f\n",
+				GetTypeName(vTypes[i]).c_str(),
+				mStats.uiCalls,
+				mStats.dTotalTime * 1000.0,
+				mStats.dMaxFrameTime * 1000.0,
+				vLastFrameTimes[vTypes[i]] * 1000.0);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::StartCSV
+	// Parameters:
+	//	const std::string& p_strFileName - Where to write the frames.
+	// Returns: bool - Whether the file was opened.
+	//------------------------------------------------------------------------------
+	bool ComponentProfiler::StartCSV(const std::string& p_strFileName)
+	{
+		StopCSV();
+
+		m_mCSVFile.open(p_strFileName.c_str());
+		if (!m_mCSVFile.is_open())
+		{
+			return false;
+		}
+
+		m_bEnabled = true;
+		m_uiFrame = 0;
+		m_mCSVFile << "frame,component,calls,update_ms,parallel_update_ms,prerender_ms,total_ms\n";
+		return true;
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::StopCSV
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::StopCSV()
+	{
+		if (m_mCSVFile.is_open())
+		{
+			m_mCSVFile.close();
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::BeginFrame
+	//
+	// Closes off the previous frame, sorting its component types by time, and
+	// starts a new one.
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::BeginFrame()
+	{
+		m_vLastFrame.clear();
+		m_dLastFrameTime = 0.0;
+
+		std::vector<unsigned int>::const_iterator it = m_vFrameTypes.begin(), end = m_vFrameTypes.end();
+		for (; it != end; ++it)
+		{
+			FrameStats& mFrame = m_vCurrentFrame[*it];
+			TypeStats& mStats = m_vTypeStats[*it];
+			mStats.dMaxFrameTime = std::max(mStats.dMaxFrameTime, mFrame.dTotalTime);
+			m_dLastFrameTime += mFrame.dTotalTime;
+
+			m_vLastFrame.push_back(mFrame);
+			mFrame = FrameStats();
+		}
+		m_vFrameTypes.clear();
+
+		std::sort(m_vLastFrame.begin(), m_vLastFrame.end(), [](const FrameStats& a, const FrameStats& b)
+		{
+			return a.dTotalTime > b.dTotalTime;
+		});
+
+		if (m_mCSVFile.is_open() && !m_vLastFrame.empty())
+		{
+			WriteCSVFrame();
+			++m_uiFrame;
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::Record
+	// Parameters:
+	//	const Component* p_pComponent - The component that was timed.
+	//	const ProfilePhase p_ePhase - Which of its methods was timed.
+	//	const double p_dDuration - How long it took, in seconds.
+	//
+	// Main thread only. Parallel update times are gathered by GameObjectManager and
+	// recorded once the workers are done.
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::Record(const Component* p_pComponent, const ProfilePhase p_ePhase, const double p_dDuration)
+	{
+		const unsigned int uiTypeID = GetTypeID(p_pComponent);
+
+		FrameStats& mFrame = m_vCurrentFrame[uiTypeID];
+		if (mFrame.uiCalls == 0)
+		{
+			mFrame.uiTypeID = uiTypeID;
+			m_vFrameTypes.push_back(uiTypeID);
+		}
+		++mFrame.uiCalls;
+		mFrame.adTime[p_ePhase] += p_dDuration;
+		mFrame.dTotalTime += p_dDuration;
+
+		TypeStats& mStats = m_vTypeStats[uiTypeID];
+		++mStats.uiCalls;
+		mStats.dTotalTime += p_dDuration;
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::GetTypeID
+	// Parameters:
+	//	const Component* p_pComponent - A component being timed.
+	// Returns: unsigned int - The ID of its ComponentID(), growing the tables if
+	//		it's new.
+	//
+	// The ID is cached on the component, so ComponentID() is only built once each.
+	//------------------------------------------------------------------------------
+	unsigned int ComponentProfiler::GetTypeID(const Component* p_pComponent)
+	{
+		if (p_pComponent->m_uiProfilerTypeID == ~0u)
+		{
+			p_pComponent->m_uiProfilerTypeID = GetTypeNames().Intern(p_pComponent->ComponentID());
+		}
+
+		const unsigned int uiTypeID = p_pComponent->m_uiProfilerTypeID;
+		if (uiTypeID >= m_vTypeStats.size())
+		{
+			m_vTypeStats.resize(GetTypeNames().GetCount(), TypeStats());
+			m_vCurrentFrame.resize(GetTypeNames().GetCount(), FrameStats());
+		}
+		return uiTypeID;
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::WriteCSVFrame
+	//
+	// Writes the last frame's component types, with times in milliseconds.
+	//------------------------------------------------------------------------------
+	void ComponentProfiler::WriteCSVFrame()
+	{
+		std::vector<FrameStats>::const_iterator it = m_vLastFrame.begin(), end = m_vLastFrame.end();
+		for (; it != end; ++it)
+		{
+			m_mCSVFile << m_uiFrame << ','
+				<< GetTypeName(it->uiTypeID) << ','
+				<< it->uiCalls << ','
+				<< (it->adTime[PP_Update] * 1000.0) << ','
+				<< (it->adTime[PP_ParallelUpdate] * 1000.0) << ','
+				<< (it->adTime[PP_PreRender] * 1000.0) << ','
+				<< (it->dTotalTime * 1000.0) << '\n';
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// ComponentProfiler::GetTypeNames
+	//------------------------------------------------------------------------------
+	StringInterner& ComponentProfiler::GetTypeNames()
+	{
+		static StringInterner s_mTypeNames;
+		return s_mTypeNames;
+	}
+}
@@ -0,0 +1,132 @@
+//==================================================================================
+// ComponentProfiler
+//
+// Optional instrumentation for GameObjectManager. While enabled it times every
+// component's Update(), ParallelUpdate() and PreRender(), and totals the time and
+// calls by ComponentID() for each frame, so the most expensive component types can
+// be shown on screen or written out, a row per type per frame, as CSV.
+//
+// A frame runs from one GameObjectManager::Update() to the next, so it takes in the
+// PreRender() between them. Parallel update times are summed across the workers,
+// so they measure work done rather than time waited.
+//==================================================================================
+
+#ifndef COMPONENT_PROFILER_H
+#define COMPONENT_PROFILER_H
+
+#include <GLFW/glfw3.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Component.h"
+#include "StringInterner.h"
+
+namespace HeatStroke
+{
+	// The component methods ComponentProfiler times.
+	enum ProfilePhase
+	{
+		PP_Update = 0,
+		PP_ParallelUpdate,
+		PP_PreRender,
+
+		PP_Count
+	};
+
+	class ComponentProfiler
+	{
+	public:
+		//------------------------------------------------------------------------------
+		// Public types
+		//------------------------------------------------------------------------------
+		// One component type's share of a frame.
+		struct FrameStats
+		{
+			unsigned int uiTypeID;
+			unsigned int uiCalls;
+			double adTime[PP_Count];	// In seconds.
+			double dTotalTime;
+		};
+
+		// One component type's statistics since the profiler was enabled or reset.
+		struct TypeStats
+		{
+			unsigned int uiCalls;
+			double dTotalTime;
+			double dMaxFrameTime;
+		};
+
+		//------------------------------------------------------------------------------
+		// Public methods
+		//------------------------------------------------------------------------------
+		ComponentProfiler();
+
+		// Profiling is off by default, and costs one branch per component while off.
+		void SetEnabled(const bool p_bEnabled)	{ m_bEnabled = p_bEnabled; }
+		bool IsEnabled() const					{ return m_bEnabled; }
+
+		// Clears all statistics gathered so far.
+		void Reset();
+
+		// The component types in the last complete frame, most expensive first.
+		const std::vector<FrameStats>& GetLastFrameStats() const	{ return m_vLastFrame; }
+		double GetLastFrameTime() const								{ return m_dLastFrameTime; }
+
+		// Statistics for one component type. Types never timed have all-zero stats.
+		const TypeStats& GetTypeStats(const unsigned int p_uiTypeID) const;
+
+		// The ComponentID() a type ID stands for.
+		static const std::string& GetTypeName(const unsigned int p_uiTypeID)	{ return GetTypeNames().GetName(p_uiTypeID); }
+
+		// Prints the p_uiMaxTypes component types with the most total time to stdout.
+		void PrintSummary(const unsigned int p_uiMaxTypes) const;
+
+		// Writes every frame from now until StopCSV() to p_strFileName, a row per
+		// component type timed in the frame. Enables the profiler if it wasn't already.
+		// Returns false if the file couldn't be opened.
+		bool StartCSV(const std::string& p_strFileName);
+		void StopCSV();
+		bool IsWritingCSV() const								{ return m_mCSVFile.is_open(); }
+
+		// Hooks called by GameObjectManager.
+		double Now() const										{ return glfwGetTime(); }
+		void BeginFrame();
+		void Record(const Component* p_pComponent, const ProfilePhase p_ePhase, const double p_dDuration);
+
+	private:
+		//------------------------------------------------------------------------------
+		// Private members
+		//------------------------------------------------------------------------------
+		bool m_bEnabled;
+
+		// Indexed by type ID, grown as new types are timed.
+		std::vector<TypeStats> m_vTypeStats;
+		std::vector<FrameStats> m_vCurrentFrame;
+
+		// Types timed this frame, whose frame stats must be collected and reset.
+		std::vector<unsigned int> m_vFrameTypes;
+
+		std::vector<FrameStats> m_vLastFrame;
+		double m_dLastFrameTime;
+
+		std::ofstream m_mCSVFile;
+		unsigned int m_uiFrame;
+
+		//------------------------------------------------------------------------------
+		// Private methods
+		//------------------------------------------------------------------------------
+		unsigned int GetTypeID(const Component* p_pComponent);
+		void WriteCSVFrame();
+
+		// Function-local static, so that a type ID cached on a component holds for
+		// every GameObjectManager's profiler.
+		static StringInterner& GetTypeNames();
+
+		// ComponentProfilers shouldn't be copied.
+		ComponentProfiler(const ComponentProfiler&) = delete;
+		ComponentProfiler& operator=(const ComponentProfiler&) = delete;
+	};
+}
+
+#endif // COMPONENT_PROFILER_H
@@ -14,6 +14,8 @@
 namespace HeatStroke
 {
     class GameObject;
+    class SceneSnapshot;
+    class ComponentProfiler;
     
 	class Component
 	{
@@ -22,13 +24,38 @@ namespace HeatStroke
 		virtual const std::string ComponentID() const = 0;
 
 		// Construction and Destruction
-		Component(GameObject* p_pGameObject) : m_pGameObject(p_pGameObject) {}
+		Component(GameObject* p_pGameObject) : m_pGameObject(p_pGameObject), m_uiProfilerTypeID(~0u), m_uiSystemSlot(~0u), m_uiParallelSlot(~0u) {}
 		virtual ~Component() {}
 
 		// Game Loop Methods
 		virtual void Init() = 0;
 		virtual void Update(const float p_fDelta) = 0;
 
+		// Parallel update, see GameObjectManager::Update(). If HasParallelUpdate() is
+		// true, ParallelUpdate() is called on a worker thread each frame, before any
+		// component's Update(). It may read other GameObjects, but only write to its
+		// own component and its own GameObject's transform; creating or destroying
+		// GameObjects, reparenting, adding listeners and triggering events all wait for
+		// Update(), which still runs on the main thread afterwards. World transforms
+		// read here, its own included, are as they were when the parallel update began.
+		virtual bool HasParallelUpdate() const				{ return false; }
+		virtual void ParallelUpdate(const float p_fDelta)	{}
+
+		// Recycling, see GameObjectManager::EnableRecycling(). Deactivate() is called as
+		// the GameObject goes into its pool, and should detach from anything outside it.
+		// Reactivate() is called as it comes back out, before Init(), and should return
+		// to the state the factory created.
+		virtual bool IsRecyclable() const	{ return false; }
+		virtual void Deactivate()			{}
+		virtual void Reactivate()			{}
+
+		// Snapshots, see GameObjectManager::CaptureSnapshot(). SaveState() writes
+		// whatever changes after Init(), and RestoreState() reads it back in the same
+		// order onto the same component, which may have run for a while since.
+		virtual bool IsSnapshottable() const					{ return false; }
+		virtual void SaveState(SceneSnapshot& p_mSnapshot) const	{}
+		virtual void RestoreState(SceneSnapshot& p_mSnapshot)		{}
+
 		// Game Object accessors
 		GameObject* GetGameObject() { return m_pGameObject; }
 		void SetGameObject(GameObject* p_pGameObject)	{ m_pGameObject = p_pGameObject; }
@@ -36,6 +63,17 @@ namespace HeatStroke
 	protected:
 		// GameObject that owns this Component
 		GameObject* m_pGameObject;
+
+	private:
+		// ComponentProfiler's ID for ComponentID(), looked up the first time it's timed.
+		friend class ComponentProfiler;
+		mutable unsigned int m_uiProfilerTypeID;
+
+		// Where GameObjectManager keeps this component in its family's list and in the
+		// parallel list, so it can be unregistered without searching for it.
+		friend class GameObjectManager;
+		unsigned int m_uiSystemSlot;
+		unsigned int m_uiParallelSlot;
 	};
 }
 
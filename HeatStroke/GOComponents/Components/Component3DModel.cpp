@@ -51,6 +51,16 @@ HeatStroke::Component* HeatStroke::Component3DModel::CreateComponent(
 	);
 }
 
+void HeatStroke::Component3DModel::Deactivate()
+{
+	SceneManager::Instance()->RemoveModelInstance(&m_mModelInstance);
+}
+
+void HeatStroke::Component3DModel::Reactivate()
+{
+	SceneManager::Instance()->AddModelInstance(&m_mModelInstance);
+}
+
 void HeatStroke::Component3DModel::SyncTransform()
 {
 	m_mModelInstance.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
@@ -31,6 +31,13 @@ namespace HeatStroke
 		virtual void Init() override						{}
 		virtual void Update(const float p_fDelta) override	{}
 
+		virtual bool IsRecyclable() const override			{ return true; }
+		virtual void Deactivate() override;
+		virtual void Reactivate() override;
+
+		// The model follows the transform, which the snapshot holds.
+		virtual bool IsSnapshottable() const override		{ return true; }
+
 	protected:
 		Component3DModel(GameObject* p_pGameObject, const std::string& p_strOBJFileName);
 
@@ -27,12 +27,15 @@ namespace HeatStroke
 	public:
 		~ComponentAmbientLight();
 
-		const std::string FamilyID()	const override { return std::string("GOC_AmbientLight"); }
+		static const char* StaticFamilyID() { return "GOC_AmbientLight"; }
+		const std::string FamilyID()	const override { return StaticFamilyID(); }
 		const std::string ComponentID() const override { return std::string("GOC_AmbientLight"); }
 
 		void Init() override;
 		void Update(const float p_fDelta) override {}
 
+		bool IsSnapshottable() const override { return true; }
+
 	private:
 		static void ParseNode(tinyxml2::XMLNode* p_pNode, glm::vec3& p_vAmbientLightColor);
 
@@ -13,13 +13,15 @@
 #include "EasyXML.h"
 #include "GameObject.h"
 #include "LineDrawer.h"
+#include "SceneSnapshot.h"
 
 namespace HeatStroke
 {
 	class ComponentCollider : public ComponentRenderable
 	{
 	public:
-		virtual const std::string FamilyID() const override { return std::string("GOC_Collider"); }
+		static const char* StaticFamilyID() { return "GOC_Collider"; }
+		virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 
 		virtual void Init() = 0;
 		virtual void Update(const float p_fDelta) = 0;
@@ -27,6 +29,24 @@ namespace HeatStroke
 
 		bool HasPhysics() const { return m_bAppliesPhysics; }
 
+		// Whether CollisionStay is sent to this collider's GameObject every frame it
+		// stays touching something, between the CollisionEnter and CollisionExit
+		// always sent to it.
+		bool ReportsCollisionStay() const { return m_bReportsStay; }
+
+		// Snapshots. Only the positions change once a collider is created.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(SceneSnapshot& p_mSnapshot) const override
+		{
+			p_mSnapshot.Write(m_pPosition);
+			p_mSnapshot.Write(m_pPreviousPosition);
+		}
+		virtual void RestoreState(SceneSnapshot& p_mSnapshot) override
+		{
+			p_mSnapshot.Read(m_pPosition);
+			p_mSnapshot.Read(m_pPreviousPosition);
+		}
+
 		glm::vec3 GetPosition() { return m_pPosition; }
 		glm::vec3 GetPreviousPosition() { return m_pPreviousPosition; }
 
@@ -36,7 +56,8 @@ namespace HeatStroke
 			ComponentRenderable(p_pGameObject),
 			m_bAppliesPhysics(p_bAppliesPhysics),
 			m_bDebugRender(p_bDebugRender),
-			m_pDebugLineDrawer(nullptr) {}
+			m_pDebugLineDrawer(nullptr),
+			m_bReportsStay(false) {}
 
 		virtual void SyncTransform() = 0;
 
@@ -45,6 +66,7 @@ namespace HeatStroke
 
 		bool m_bDebugRender;
 		LineDrawer* m_pDebugLineDrawer;
+		bool m_bReportsStay;
 
 	private:
 		// Prevent copying
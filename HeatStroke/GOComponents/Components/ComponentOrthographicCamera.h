@@ -18,7 +18,8 @@ namespace HeatStroke
 	class ComponentOrthographicCamera : public Component
 	{
 	public:
-		virtual const std::string FamilyID() const override		{ return "GOC_OrthographicCamera"; }
+		static const char* StaticFamilyID()						{ return "GOC_OrthographicCamera"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_OrthographicCamera"; }
 
 		// Destruction.
@@ -35,6 +36,9 @@ namespace HeatStroke
 		virtual void Init() override						{}
 		virtual void Update(const float p_fDelta) override	{}
 
+		// Snapshots.
+		virtual bool IsSnapshottable() const override		{ return true; }
+
 	private:
 		// The Scene Camera this component is responsible for.
 		SceneOrthographicCamera m_mSceneOrthographicCamera;
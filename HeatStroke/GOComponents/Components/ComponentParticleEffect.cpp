@@ -67,6 +67,32 @@ void HeatStroke::ComponentParticleEffect::Update(const float p_fDelta)
 	}
 }
 
+void HeatStroke::ComponentParticleEffect::Deactivate()
+{
+	for (std::pair<std::string, Effect*> effect : m_mEffects)
+	{
+		effect.second->Stop();
+		SceneManager::Instance()->RemoveParticleEffect(effect.second);
+	}
+}
+
+void HeatStroke::ComponentParticleEffect::Reactivate()
+{
+	for (std::pair<std::string, Effect*> effect : m_mEffects)
+	{
+		effect.second->Reset();
+		SceneManager::Instance()->AddParticleEffect(effect.second);
+	}
+}
+
+void HeatStroke::ComponentParticleEffect::RestoreState(SceneSnapshot& p_mSnapshot)
+{
+	for (std::pair<std::string, Effect*> effect : m_mEffects)
+	{
+		effect.second->Reset();
+	}
+}
+
 void HeatStroke::ComponentParticleEffect::Start()
 {
 	for (std::pair<std::string, Effect*> effect : m_mEffects)
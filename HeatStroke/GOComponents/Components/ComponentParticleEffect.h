@@ -12,7 +12,8 @@ namespace HeatStroke
 	{
 		public:
 			virtual const std::string ComponentID() const override {return "GOC_ParticleEffect";}
-			virtual const std::string FamilyID() const override { return "GOC_ParticleEffect";}
+			static const char* StaticFamilyID() { return "GOC_ParticleEffect"; }
+			virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 			~ComponentParticleEffect();
 
 			static Component* CreateComponent(GameObject* p_pGameObject, tinyxml2::XMLNode* p_pBaseNode, tinyxml2::XMLNode* p_pOverrideNode);
@@ -20,6 +21,15 @@ namespace HeatStroke
 			virtual void Init() override;
 			virtual void Update(const float p_fDelta) override;
 
+			virtual bool IsRecyclable() const override { return true; }
+			virtual void Deactivate() override;
+			virtual void Reactivate() override;
+
+			// Particles in flight aren't kept; restoring resets every effect to how it
+			// was created, with its emitters started or stopped as defined.
+			virtual bool IsSnapshottable() const override { return true; }
+			virtual void RestoreState(SceneSnapshot& p_mSnapshot) override;
+
 			void Start();
 			void Stop();
 
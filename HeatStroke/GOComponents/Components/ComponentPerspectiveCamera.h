@@ -18,7 +18,8 @@ namespace HeatStroke
 	class ComponentPerspectiveCamera : public Component
 	{
 	public:
-		virtual const std::string FamilyID() const override		{ return "GOC_PerspectiveCamera"; }
+		static const char* StaticFamilyID()						{ return "GOC_PerspectiveCamera"; }
+		virtual const std::string FamilyID() const override		{ return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override	{ return "GOC_PerspectiveCamera"; }
 
 		// Destruction.
@@ -35,6 +36,9 @@ namespace HeatStroke
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		// Snapshots. A camera following a racer is placed from the transforms every Update().
+		virtual bool IsSnapshottable() const override { return true; }
+
 	private:
 		// The Scene Camera this component is responsible for.
 		ScenePerspectiveCamera m_mScenePerspectiveCamera;
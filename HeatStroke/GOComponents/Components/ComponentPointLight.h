@@ -27,12 +27,15 @@ namespace HeatStroke
 	public:
 		~ComponentPointLight();
 
-		virtual const std::string FamilyID() const override { return "GOC_PointLight"; }
+		static const char* StaticFamilyID() { return "GOC_PointLight"; }
+		virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override { return "GOC_PointLight"; }
 
 		virtual void Init() override {}
 		virtual void Update(const float p_fDelta) override;
 
+		virtual bool IsSnapshottable() const override { return true; }
+
 	private:
 		static void ParseNode(
 			tinyxml2::XMLNode* p_pNode,
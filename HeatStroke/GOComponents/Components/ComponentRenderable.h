@@ -20,7 +20,8 @@ namespace HeatStroke
 		//------------------------------------------------------------------------------
 		// Public methods.
 		//------------------------------------------------------------------------------
-		virtual const std::string FamilyID() const override	{ return std::string("GOC_Renderable"); }
+		static const char* StaticFamilyID()					{ return "GOC_Renderable"; }
+		virtual const std::string FamilyID() const override	{ return StaticFamilyID(); }
 
 		virtual ~ComponentRenderable() = 0 {} // Pure virtual class.
 
@@ -17,7 +17,8 @@ namespace HeatStroke
 	class ComponentRotateOverTime : public Component
 	{
 	public:
-		virtual const std::string FamilyID() const override { return std::string("GOC_RotateOverTime"); }
+		static const char* StaticFamilyID() { return "GOC_RotateOverTime"; }
+		virtual const std::string FamilyID() const override { return StaticFamilyID(); }
 		virtual const std::string ComponentID() const override { return std::string("GOC_RotateOverTime"); }
 
 		virtual ~ComponentRotateOverTime()	{}
@@ -31,6 +32,10 @@ namespace HeatStroke
 		virtual void Init() override						{}
 		virtual void Update(const float p_fDelta) override;
 
+		// Holds no state beyond its rates, so it needs nothing to be recycled.
+		virtual bool IsRecyclable() const override			{ return true; }
+		virtual bool IsSnapshottable() const override		{ return true; }
+
 	protected:
 		ComponentRotateOverTime(
 			GameObject* p_pGameObject, 
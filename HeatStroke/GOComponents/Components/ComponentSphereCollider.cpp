@@ -13,12 +13,14 @@ HeatStroke::ComponentSphereCollider::ComponentSphereCollider(
 	HeatStroke::GameObject* p_pGameObject,
 	glm::vec3 p_pOffset,
 	float p_fRadius,
-	bool p_bAppliesPhysics)
+	bool p_bAppliesPhysics,
+	bool p_bReportsStay)
 	:
 	ComponentCollider(p_pGameObject, p_bAppliesPhysics),
 	m_pOffset(p_pOffset),
 	m_fRadius(p_fRadius)
 {
+	m_bReportsStay = p_bReportsStay;
 	HeatStroke::CollisionManager::Instance()->RegisterCollider(this, GetGameObject()->GetGUID());
 }
 
@@ -46,6 +48,7 @@ HeatStroke::Component* HeatStroke::ComponentSphereCollider::CreateComponent(
 	glm::vec3 offset = glm::vec3();
 	float radius = 0.0f;
 	bool physics = true;
+	bool reportsStay = false;
 
 	// Neither base nor override node are mandatory, but it is mandatory
 	// that all strings are given values between the two of them.
@@ -54,13 +57,13 @@ HeatStroke::Component* HeatStroke::ComponentSphereCollider::CreateComponent(
 	if (p_pBaseNode != nullptr)
 	{
 		//ParseNode(p_pBaseNode, strOBJFileName);
-		ParseNode(p_pBaseNode, offset, radius, physics);
+		ParseNode(p_pBaseNode, offset, radius, physics, reportsStay);
 	}
 	// Then override with the Override node.
 	if (p_pOverrideNode != nullptr)
 	{
 		//ParseNode(p_pOverrideNode, strOBJFileName);
-		ParseNode(p_pOverrideNode, offset, radius, physics);
+		ParseNode(p_pOverrideNode, offset, radius, physics, reportsStay);
 	}
 
 	// Check that we got everything we needed.
@@ -71,7 +74,8 @@ HeatStroke::Component* HeatStroke::ComponentSphereCollider::CreateComponent(
 		p_pGameObject,
 		offset,
 		radius,
-		physics
+		physics,
+		reportsStay
 		);
 }
 
@@ -85,6 +89,31 @@ void HeatStroke::ComponentSphereCollider::Update(const float p_fDelta)
 	m_pPosition = m_pGameObject->GetTransform().GetTranslation();
 }
 
+void HeatStroke::ComponentSphereCollider::Deactivate()
+{
+	HeatStroke::CollisionManager::Instance()->UnregisterCollider(GetGameObject()->GetGUID());
+
+	if (m_pDebugLineDrawer != nullptr)
+	{
+		SceneManager::Instance()->RemoveLineDrawer(m_pDebugLineDrawer);
+	}
+}
+
+void HeatStroke::ComponentSphereCollider::Reactivate()
+{
+	// The GameObject comes back under a new GUID, so register again rather than
+	// leaving the old registration in place.
+	HeatStroke::CollisionManager::Instance()->RegisterCollider(this, GetGameObject()->GetGUID());
+
+	if (m_pDebugLineDrawer != nullptr)
+	{
+		SceneManager::Instance()->AddLineDrawer(m_pDebugLineDrawer);
+	}
+
+	m_pPosition = glm::vec3();
+	m_pPreviousPosition = glm::vec3();
+}
+
 void HeatStroke::ComponentSphereCollider::PreRender()
 {
 	SyncTransform();
@@ -128,7 +157,8 @@ void HeatStroke::ComponentSphereCollider::ParseNode(
 	tinyxml2::XMLNode* p_pNode,
 	glm::vec3& p_pOffset,
 	float& p_fRadius,
-	bool& p_bAppliesPhysics)
+	bool& p_bAppliesPhysics,
+	bool& p_bReportsStay)
 {
 	assert(p_pNode != nullptr);
 	assert(strcmp(p_pNode->Value(), "GOC_SphereCollider") == 0);
@@ -158,5 +188,9 @@ void HeatStroke::ComponentSphereCollider::ParseNode(
 		{
 			HeatStroke::EasyXML::GetRequiredBoolAttribute(pElement, "applies", p_bAppliesPhysics);
 		}
+		else if (strcmp(szNodeName, "CollisionStay") == 0)
+		{
+			HeatStroke::EasyXML::GetRequiredBoolAttribute(pElement, "report", p_bReportsStay);
+		}
 	}
 }
\ No newline at end of file
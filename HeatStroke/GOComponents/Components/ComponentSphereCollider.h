@@ -9,6 +9,7 @@
 #define COMPONENT_SPHERE_COLLIDER
 
 #include "ComponentCollider.h"
+#include "ComponentPool.h"
 #include "SceneManager.h"
 #include "EasyXML.h"
 #include "GameObject.h"
@@ -16,7 +17,7 @@
 
 namespace HeatStroke
 {
-	class ComponentSphereCollider : public ComponentCollider
+	class ComponentSphereCollider : public ComponentCollider, public PooledComponent<ComponentSphereCollider>
 	{
 	public:
 		virtual const std::string ComponentID() const override { return std::string("GOC_SphereCollider"); }
@@ -33,6 +34,10 @@ namespace HeatStroke
 		virtual void Update(const float p_fDelta) override;
 		virtual void PreRender() override;
 
+		virtual bool IsRecyclable() const override { return true; }
+		virtual void Deactivate() override;
+		virtual void Reactivate() override;
+
 		glm::vec3 GetOffset() { return m_pOffset; }
 		float GetRadius() { return m_fRadius; }
 
@@ -41,7 +46,8 @@ namespace HeatStroke
 			GameObject* p_pGameObject,
 			glm::vec3 p_pOffset,
 			float p_fRadius,
-			bool p_bAppliesPhysics
+			bool p_bAppliesPhysics,
+			bool p_bReportsStay
 		);
 
 		virtual void SyncTransform();
@@ -55,7 +61,8 @@ namespace HeatStroke
 			tinyxml2::XMLNode* p_pNode,
 			glm::vec3& p_pOffset,
 			float& p_fRadius,
-			bool& p_bAppliesPhysics
+			bool& p_bAppliesPhysics,
+			bool& p_bReportsStay
 		);
 
 		glm::vec3 m_pOffset;
@@ -31,6 +31,8 @@ namespace HeatStroke
 		virtual void Init() override						{}
 		virtual void Update(const float p_fDelta) override	{}
 
+		virtual bool IsSnapshottable() const override		{ return true; }
+
 	protected:
 		ComponentSprite(GameObject* p_pGameObject, const std::string& p_strMTLFileName, const std::string& p_strMaterialName);
 
@@ -6,6 +6,7 @@
 //------------------------------------------------------------------------
 
 #include "ComponentTextBox.h"
+#include "SceneSnapshot.h"
 
 HeatStroke::ComponentTextBox::ComponentTextBox(GameObject* p_pGameObject,
 	const std::string& p_strFontFilePath,
@@ -74,6 +75,21 @@ void HeatStroke::ComponentTextBox::SetMessage(const std::string& p_strMessage)
 	m_mTextBox.SetText(p_strMessage);
 }
 
+void HeatStroke::ComponentTextBox::SaveState(SceneSnapshot& p_mSnapshot) const
+{
+	p_mSnapshot.WriteString(m_mTextBox.GetText());
+}
+
+void HeatStroke::ComponentTextBox::RestoreState(SceneSnapshot& p_mSnapshot)
+{
+	std::string strMessage;
+	p_mSnapshot.ReadString(strMessage);
+	if (strMessage != m_mTextBox.GetText())
+	{
+		m_mTextBox.SetText(strMessage);
+	}
+}
+
 void HeatStroke::ComponentTextBox::SyncTransform()
 {
 	m_mTextBox.SetTransform(this->GetGameObject()->GetTransform().GetTransform());
@@ -33,6 +33,11 @@ namespace HeatStroke
 
 		void SetMessage(const std::string& p_strMessage);
 
+		// Snapshots keep the message, which HUD components change as they go.
+		virtual bool IsSnapshottable() const override { return true; }
+		virtual void SaveState(SceneSnapshot& p_mSnapshot) const override;
+		virtual void RestoreState(SceneSnapshot& p_mSnapshot) override;
+
 	protected:
 		ComponentTextBox(GameObject* p_pGameObject,
 			const std::string& p_strFontFilePath,
@@ -9,6 +9,7 @@
 #define COMPONENT_WALL_COLLIDER_H
 
 #include "ComponentCollider.h"
+#include "ComponentPool.h"
 #include "SceneManager.h"
 #include "EasyXML.h"
 #include "GameObject.h"
@@ -16,7 +17,7 @@
 
 namespace HeatStroke
 {
-	class ComponentWallCollider : public ComponentCollider
+	class ComponentWallCollider : public ComponentCollider, public PooledComponent<ComponentWallCollider>
 	{
 	public:
 		virtual const std::string ComponentID() const override { return std::string("GOC_WallCollider"); }
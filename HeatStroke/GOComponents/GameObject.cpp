@@ -14,6 +14,7 @@
 
 #include "GameObject.h"
 #include <sstream>
+#include <algorithm>
 
 using namespace HeatStroke;
 
@@ -28,12 +29,17 @@ GameObject::GameObject(GameObjectManager* p_pGameObjectManager, const std::strin
 	:
 	m_pGameObjectManager(p_pGameObjectManager),
 	m_strGUID(p_strGUID),
+	m_mHandle(),
 	m_Transform(p_strGUID),
 	m_pParent(nullptr),
 	m_mComponentMap(),
+	m_vFamilyComponents(),
 	m_mChildMap(),
-	m_mTagList()
+	m_mTagList(),
+	m_iPool(-1),
+	m_iPrefabNode(-1)
 {
+	m_pGameObjectManager->GetTransformHierarchy().Add(&m_Transform);
 }
 
 //------------------------------------------------------------------------------
@@ -60,7 +66,17 @@ void GameObject::AddComponent(Component* p_pComponent)
 {
 	if (p_pComponent != nullptr)
 	{
-		m_mComponentMap.insert(std::pair<std::string, Component*>(p_pComponent->FamilyID(), p_pComponent));
+		const std::string strFamilyID = p_pComponent->FamilyID();
+		if (m_mComponentMap.insert(std::pair<std::string, Component*>(strFamilyID, p_pComponent)).second)
+		{
+			const ComponentFamilyID uiFamilyID = ComponentFamilyRegistry::Intern(strFamilyID);
+			if (uiFamilyID >= m_vFamilyComponents.size())
+			{
+				m_vFamilyComponents.resize(uiFamilyID + 1, nullptr);
+			}
+			m_vFamilyComponents[uiFamilyID] = p_pComponent;
+			m_pGameObjectManager->RegisterComponent(p_pComponent, uiFamilyID);
+		}
 	}
 }
 
@@ -100,6 +116,13 @@ Component* GameObject::RemoveComponent(const std::string& p_strFamilyId)
 	{
 		pComponent = it->second;
 		m_mComponentMap.erase(it);
+
+		const ComponentFamilyID uiFamilyID = ComponentFamilyRegistry::Intern(p_strFamilyId);
+		if (uiFamilyID < m_vFamilyComponents.size())
+		{
+			m_vFamilyComponents[uiFamilyID] = nullptr;
+		}
+		m_pGameObjectManager->UnregisterComponent(pComponent, uiFamilyID);
 	}
 
 	return pComponent;
@@ -113,11 +136,20 @@ Component* GameObject::RemoveComponent(const std::string& p_strFamilyId)
 //------------------------------------------------------------------------------
 void GameObject::DeleteAllComponents()
 {
+	for (ComponentFamilyID i = 0; i < m_vFamilyComponents.size(); ++i)
+	{
+		if (m_vFamilyComponents[i] != nullptr)
+		{
+			m_pGameObjectManager->UnregisterComponent(m_vFamilyComponents[i], i);
+		}
+	}
+
 	for (ComponentMap::iterator it = m_mComponentMap.begin(); it != m_mComponentMap.end(); ++it)
 	{
 		delete it->second;
 	}
 	m_mComponentMap.clear();
+	m_vFamilyComponents.clear();
 }
 
 
@@ -190,17 +222,84 @@ std::vector<GameObject*> GameObject::GetChildren()
 std::vector<GameObject*> GameObject::GetChildrenWithTag(const std::string& p_strTag)
 {
 	std::vector<GameObject*> vChildren;
-	for (ChildMap::iterator it = m_mChildMap.begin(); it != m_mChildMap.end(); ++it)
+
+	// Walk whichever is shorter, the objects with the tag or our children. Either
+	// way the result is in child GUID order, as if the child map had been walked.
+	const std::vector<GameObject*>& vTagged = m_pGameObjectManager->GetGameObjectsWithTag(p_strTag);
+	if (vTagged.size() < m_mChildMap.size())
 	{
-		if (it->second->HasTag(p_strTag))
+		for (std::vector<GameObject*>::const_iterator it = vTagged.begin(); it != vTagged.end(); ++it)
 		{
-			vChildren.push_back(it->second);
+			if ((*it)->m_pParent == this)
+			{
+				vChildren.push_back(*it);
+			}
+		}
+
+		std::sort(vChildren.begin(), vChildren.end(), [](const GameObject* a, const GameObject* b)
+		{
+			return a->GetGUID() < b->GetGUID();
+		});
+	}
+	else
+	{
+		for (ChildMap::iterator it = m_mChildMap.begin(); it != m_mChildMap.end(); ++it)
+		{
+			if (it->second->HasTag(p_strTag))
+			{
+				vChildren.push_back(it->second);
+			}
 		}
 	}
 
 	return vChildren;
 }
 
+//------------------------------------------------------------------------------
+// Method:    AddTag
+// Parameter: const std::string & p_strTag
+// Returns:   void
+// 
+// Tags the GameObject, and adds it to the manager's index for that tag.
+//------------------------------------------------------------------------------
+void GameObject::AddTag(const std::string& p_strTag)
+{
+	if (m_mTagList.insert(p_strTag).second)
+	{
+		m_pGameObjectManager->IndexTag(this, p_strTag);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Method:    RemoveTag
+// Parameter: const std::string & p_strTag
+// Returns:   void
+// 
+// Removes a tag from the GameObject and from the manager's index for that tag.
+//------------------------------------------------------------------------------
+void GameObject::RemoveTag(const std::string& p_strTag)
+{
+	if (m_mTagList.erase(p_strTag) > 0)
+	{
+		m_pGameObjectManager->UnindexTag(this, p_strTag);
+	}
+}
+
+//------------------------------------------------------------------------------
+// Method:    RemoveAllTags
+// Returns:   void
+// 
+// Removes every tag from the GameObject and from the manager's tag index.
+//------------------------------------------------------------------------------
+void GameObject::RemoveAllTags()
+{
+	for (TagList::iterator it = m_mTagList.begin(); it != m_mTagList.end(); ++it)
+	{
+		m_pGameObjectManager->UnindexTag(this, *it);
+	}
+	m_mTagList.clear();
+}
+
 void GameObject::DeleteAllChildren()
 {
 	for (ChildMap::iterator it = m_mChildMap.begin(); it != m_mChildMap.end(); ++it)
@@ -16,11 +16,15 @@
 #define GAMEOBJECT_H
 
 #include "Component.h"
+#include "ComponentFamilyRegistry.h"
+#include "GameObjectHandle.h"
 #include "GameObjectManager.h"
 #include "HierarchicalTransform.h"
 
 #include <map>
 #include <set>
+#include <vector>
+#include <assert.h>
 
 namespace HeatStroke
 {
@@ -30,6 +34,7 @@ namespace HeatStroke
 	{
 		// Typedef for convenience
 		typedef std::map<std::string, Component*> ComponentMap;
+		typedef std::vector<Component*> ComponentFamilyList;
 		typedef std::map<std::string, GameObject*> ChildMap;
 		typedef std::set<std::string> TagList;
 
@@ -41,6 +46,7 @@ namespace HeatStroke
 		// Public methods.
 		//------------------------------------------------------------------------------
 		const std::string& GetGUID() const			{ return m_strGUID; }
+		const GameObjectHandle& GetHandle() const	{ return m_mHandle; }
 		HierarchicalTransform& GetTransform()		{ return m_Transform; }
 		const HierarchicalTransform& GetTransform() const { return m_Transform; }
 		GameObjectManager* GetManager()				{ return m_pGameObjectManager; }
@@ -48,6 +54,7 @@ namespace HeatStroke
 		// Component management
 		void AddComponent(Component* p_pComponent);
 		Component* GetComponent(const std::string &p_strFamilyId) const;
+		template<typename T> T* GetComponent() const;
 		Component* RemoveComponent(const std::string &p_strFamilyId);
 		void DeleteAllComponents();
 
@@ -61,12 +68,12 @@ namespace HeatStroke
 		void DeleteAllChildren();
 		GameObject* GetParent() const				{ return m_pParent; }
 
-		// Tag management
-		void AddTag(const std::string& p_strTag)		{ m_mTagList.insert(p_strTag); }
+		// Tag management. Changes are mirrored in the GameObjectManager's tag index.
+		void AddTag(const std::string& p_strTag);
 		bool HasTag(const std::string& p_strTag) const	{ return m_mTagList.find(p_strTag) != m_mTagList.end(); }
 		const TagList& GetTagList() const				{ return m_mTagList; }
-		void RemoveTag(const std::string& p_strTag)		{ m_mTagList.erase(p_strTag); }
-		void RemoveAllTags()							{ m_mTagList.clear(); }
+		void RemoveTag(const std::string& p_strTag);
+		void RemoveAllTags();
 
 		virtual void Init();
 		virtual void Update(float p_fDelta);
@@ -98,18 +105,51 @@ namespace HeatStroke
 		// GUID
 		std::string m_strGUID;
 
+		// Handle assigned by the GameObjectManager, for cheap validated lookups
+		GameObjectHandle m_mHandle;
+
 		// All entities have a transform
 		HierarchicalTransform m_Transform;
 
 		// List of components
 		ComponentMap m_mComponentMap;
 
+		// The same components indexed by ComponentFamilyID, for GetComponent<T>().
+		// Only grown as far as the highest family this GameObject has.
+		ComponentFamilyList m_vFamilyComponents;
+
 		GameObject* m_pParent;
 		ChildMap m_mChildMap;
 
 		// List of tags
 		TagList m_mTagList;
+
+		// The recycling pool this GameObject returns to when destroyed, or -1, and the
+		// prefab node it was built from, or -1 if it can't be rebuilt from one.
+		int m_iPool;
+		int m_iPrefabNode;
 	};
+
+	//------------------------------------------------------------------------------
+	// Method:    GetComponent<T>
+	// Returns:   T*
+	// 
+	// Get the component in T's family without a string lookup, cast to T. Returns
+	// nullptr if it isn't found. T must declare StaticFamilyID(), either itself or
+	// through the family base class it derives from.
+	//------------------------------------------------------------------------------
+	template<typename T>
+	T* GameObject::GetComponent() const
+	{
+		const ComponentFamilyID uiFamilyID = ComponentFamilyRegistry::GetID<T>();
+		Component* pComponent = (uiFamilyID < m_vFamilyComponents.size() ? m_vFamilyComponents[uiFamilyID] : nullptr);
+
+#ifdef _DEBUG
+		assert((pComponent == nullptr || dynamic_cast<T*>(pComponent) != nullptr) && "Component Is Not Of The Requested Type");
+#endif
+
+		return static_cast<T*>(pComponent);
+	}
 }
 
 #endif // GAMEOBJECT_H
\ No newline at end of file
@@ -0,0 +1,70 @@
+//------------------------------------------------------------------------
+// GameObjectHandle
+//
+// A cheap, copyable reference to a GameObject, made of a slot index in
+// the GameObjectManager and the generation of that slot. Looking a handle
+// up is O(1), and a handle to a GameObject that has since been destroyed
+// resolves to nullptr instead of a dangling pointer, even if its slot has
+// been reused.
+//
+// Both parts are packed into one unsigned int so a handle can be carried
+// in an Event int parameter. With 12 generation bits, a stale handle is
+// only mistaken for a live one after its slot has been reused 4095 times.
+//------------------------------------------------------------------------
+
+#ifndef GAMEOBJECTHANDLE_H
+#define GAMEOBJECTHANDLE_H
+
+namespace HeatStroke
+{
+	class GameObjectHandle
+	{
+		// Only GameObjectManager hands out handles to live GameObjects.
+		friend class GameObjectManager;
+
+	public:
+		//---------------------------------------------------------------------
+		// Public constants
+		//---------------------------------------------------------------------
+		static const unsigned int INDEX_BITS = 20;
+		static const unsigned int GENERATION_BITS = 32 - INDEX_BITS;
+		static const unsigned int MAX_INDEX = (1u << INDEX_BITS) - 1;
+		static const unsigned int MAX_GENERATION = (1u << GENERATION_BITS) - 1;
+
+		//---------------------------------------------------------------------
+		// Public interface
+		//---------------------------------------------------------------------
+		// The null handle, which never resolves to a GameObject.
+		GameObjectHandle() : m_uiValue(0) {}
+
+		// Rebuilds a handle from GetValue(), e.g. when read back from an Event.
+		explicit GameObjectHandle(const unsigned int p_uiValue) : m_uiValue(p_uiValue) {}
+
+		unsigned int GetValue() const		{ return m_uiValue; }
+		unsigned int GetIndex() const		{ return m_uiValue & MAX_INDEX; }
+		unsigned int GetGeneration() const	{ return m_uiValue >> INDEX_BITS; }
+		bool IsNull() const					{ return m_uiValue == 0; }
+
+		bool operator==(const GameObjectHandle& p_mOther) const	{ return m_uiValue == p_mOther.m_uiValue; }
+		bool operator!=(const GameObjectHandle& p_mOther) const	{ return m_uiValue != p_mOther.m_uiValue; }
+		bool operator<(const GameObjectHandle& p_mOther) const	{ return m_uiValue < p_mOther.m_uiValue; }
+
+	private:
+		//---------------------------------------------------------------------
+		// Private methods
+		//---------------------------------------------------------------------
+		// Generations start at 1, so no live handle is ever equal to the null handle.
+		GameObjectHandle(const unsigned int p_uiIndex, const unsigned int p_uiGeneration)
+			:
+			m_uiValue((p_uiGeneration << INDEX_BITS) | p_uiIndex)
+		{
+		}
+
+		//---------------------------------------------------------------------
+		// Private members
+		//---------------------------------------------------------------------
+		unsigned int m_uiValue;
+	};
+}
+
+#endif // GAMEOBJECTHANDLE_H
@@ -11,16 +11,37 @@
 
 #include "GameObjectManager.h"
 #include "ComponentRenderable.h"
+#include "ComponentCollider.h"
+#include "JobSystem.h"
+#include "EventManager.h"
+
+#include <algorithm>
 
 using namespace HeatStroke;
 
 GameObjectManager::GameObjectManager()
 	:
+	m_mGameObjectMap(),
+	m_mComponentFactoryMap(),
 	m_bUpdating(false),
 	m_vToDelete(),
 	m_uiAutoGUIDNum(0),
-	m_mComponentFactoryMap(),
-	m_mGameObjectMap()
+	m_vHandleSlots(),
+	m_vFreeHandleSlots(),
+	m_eUpdateMode(UM_PerObject),
+	m_vSystems(),
+	m_vConfiguredOrder(),
+	m_vSystemOrder(),
+	m_bSystemsDirty(false),
+	m_vParallelComponents(),
+	m_bParallelUpdating(false),
+	m_mProfiler(),
+	m_vParallelTimes(),
+	m_mTransformHierarchy(),
+	m_mTagIndex(),
+	m_mPrefabCache(),
+	m_vRecyclingPools(),
+	m_mRecyclingPoolIndices()
 {
 }
 
@@ -28,6 +49,7 @@ GameObjectManager::~GameObjectManager()
 {
 	//Note: m_mComponentFactoryMap doesn't need to be cleaned up since they are function pointers, not object pointers.
 	DestroyAllGameObjects();
+	ClearPrefabCache();
 
 #ifdef _DEBUG
 	assert(m_mGameObjectMap.size() == 0);
@@ -52,40 +74,251 @@ void GameObjectManager::RegisterComponentFactory(const std::string& p_strCompone
 
 GameObject* GameObjectManager::CreateGameObject(const std::string& p_strGameObjectDefinitionFile, const std::string& p_strGuid /*= ""*/, GameObject* p_pParent /*= nullptr*/)
 {
-	tinyxml2::XMLDocument doc;
-	tinyxml2::XMLError err = doc.LoadFile(p_strGameObjectDefinitionFile.c_str());
+#ifdef _DEBUG
+	assert(!m_bParallelUpdating && "GameObject Created During Parallel Update");
+#endif
+
+	Prefab* pPrefab = GetPrefab(p_strGameObjectDefinitionFile);
+	if (pPrefab->iPool < 0 || !p_strGuid.empty() || p_pParent != nullptr)
+	{
+		return InstantiatePrefabNode(pPrefab, 0, p_strGuid, p_pParent);
+	}
+
+	// Components may enable recycling for what they spawn as they're created, so
+	// the pool is looked up again afterwards rather than held across the calls.
+	const int iPool = pPrefab->iPool;
+	GameObject* pObj = nullptr;
+	if (m_vRecyclingPools[iPool].vPooled.empty())
+	{
+		pObj = InstantiatePrefabNode(pPrefab, 0, "", nullptr);
+	}
+	else
+	{
+		pObj = m_vRecyclingPools[iPool].vPooled.back();
+		m_vRecyclingPools[iPool].vPooled.pop_back();
+
+		const std::string& strGuid = pPrefab->vNodes[0].strGuid;
+		pObj->SetGUID(strGuid.empty() ? GetAutoGuid() : strGuid);
+		ReactivateGameObject(pObj, pPrefab);
+	}
+
+	pObj->m_iPool = iPool;
+	return pObj;
+}
+
+GameObject* GameObjectManager::CreateGameObject(tinyxml2::XMLElement* p_pGameObjectRootElement, const std::string& p_strGuid /*= ""*/, GameObject* p_pParent /*= nullptr*/)
+{
+#ifdef _DEBUG
+	assert(!m_bParallelUpdating && "GameObject Created During Parallel Update");
+#endif
+
+	// The element belongs to the caller, so it is resolved for this one use only.
+	Prefab mPrefab;
+	BuildPrefabNode(p_pGameObjectRootElement, &mPrefab);
+	return InstantiatePrefabNode(&mPrefab, 0, p_strGuid, p_pParent);
+}
+
+void GameObjectManager::PreloadGameObject(const std::string& p_strGameObjectDefinitionFile)
+{
+	GetPrefab(p_strGameObjectDefinitionFile);
+}
+
+void GameObjectManager::PreloadGameObject(const std::string& p_strGameObjectDefinitionFile, tinyxml2::XMLDocument* p_pDocument)
+{
+	if (m_mPrefabCache.find(p_strGameObjectDefinitionFile) != m_mPrefabCache.end())
+	{
+		delete p_pDocument;
+		return;
+	}
+
+	AddPrefab(p_strGameObjectDefinitionFile, p_pDocument);
+}
+
+void GameObjectManager::ClearPrefabCache()
+{
+	PrefabCache::iterator it = m_mPrefabCache.begin(), end = m_mPrefabCache.end();
+	for (; it != end; ++it)
+	{
+		delete it->second;
+	}
+	m_mPrefabCache.clear();
+}
+
+void GameObjectManager::EnableRecycling(const std::string& p_strGameObjectDefinitionFile, const unsigned int p_uiMaxPooled)
+{
+	std::map<std::string, int>::const_iterator find = m_mRecyclingPoolIndices.find(p_strGameObjectDefinitionFile);
+	if (find != m_mRecyclingPoolIndices.end())
+	{
+		m_vRecyclingPools[find->second].uiMaxPooled = p_uiMaxPooled;
+		return;
+	}
+
+	RecyclingPool mPool;
+	mPool.uiMaxPooled = p_uiMaxPooled;
+
+	const int iPool = m_vRecyclingPools.size();
+	m_vRecyclingPools.push_back(mPool);
+	m_mRecyclingPoolIndices.insert(std::pair<std::string, int>(p_strGameObjectDefinitionFile, iPool));
+
+	GetPrefab(p_strGameObjectDefinitionFile)->iPool = iPool;
+}
+
+GameObjectManager::Prefab* GameObjectManager::GetPrefab(const std::string& p_strGameObjectDefinitionFile)
+{
+	PrefabCache::const_iterator find = m_mPrefabCache.find(p_strGameObjectDefinitionFile);
+	if (find != m_mPrefabCache.end())
+	{
+		return find->second;
+	}
+
+	tinyxml2::XMLDocument* pDocument = new tinyxml2::XMLDocument();
+	tinyxml2::XMLError err = pDocument->LoadFile(p_strGameObjectDefinitionFile.c_str());
 #if _DEBUG
 	assert(err == tinyxml2::XML_NO_ERROR);
 #endif
 
-	return CreateGameObject(doc.FirstChildElement("GameObject"), p_strGuid, p_pParent);
+	return AddPrefab(p_strGameObjectDefinitionFile, pDocument);
 }
 
-GameObject* GameObjectManager::CreateGameObject(tinyxml2::XMLElement* p_pGameObjectRootElement, const std::string& p_strGuid /*= ""*/, GameObject* p_pParent /*= nullptr*/)
+GameObjectManager::Prefab* GameObjectManager::AddPrefab(const std::string& p_strGameObjectDefinitionFile, tinyxml2::XMLDocument* p_pDocument)
+{
+	Prefab* pPrefab = new Prefab();
+	pPrefab->pDocument = p_pDocument;
+
+	std::map<std::string, int>::const_iterator pool = m_mRecyclingPoolIndices.find(p_strGameObjectDefinitionFile);
+	if (pool != m_mRecyclingPoolIndices.end())
+	{
+		pPrefab->iPool = pool->second;
+	}
+
+	BuildPrefabNode(pPrefab->pDocument->FirstChildElement("GameObject"), pPrefab);
+	m_mPrefabCache.insert(std::pair<std::string, Prefab*>(p_strGameObjectDefinitionFile, pPrefab));
+	return pPrefab;
+}
+
+unsigned int GameObjectManager::BuildPrefabNode(tinyxml2::XMLElement* p_pGameObjectRootElement, Prefab* p_pPrefab)
 {
 #if _DEBUG
 	assert(p_pGameObjectRootElement != nullptr);
 #endif
 
-	std::string strGuid = p_strGuid.empty() ? GetGuid(p_pGameObjectRootElement) : p_strGuid;
+	// Children are appended as they are built, so fill in a local node and store it last.
+	const unsigned int uiIndex = p_pPrefab->vNodes.size();
+	p_pPrefab->vNodes.push_back(PrefabNode());
+
+	PrefabNode mNode;
+	mNode.pDefinition = nullptr;
+	mNode.pTransformElement = p_pGameObjectRootElement->FirstChildElement("Transform");
+	EasyXML::GetOptionalStringAttribute(p_pGameObjectRootElement, "guid", mNode.strGuid, mNode.strGuid);
 
 	std::string strDefinitionFile = "";
 	EasyXML::GetOptionalStringAttribute(p_pGameObjectRootElement, "definition", strDefinitionFile, strDefinitionFile);
 	if (!strDefinitionFile.empty())
 	{
-		GameObject* pObj = CreateGameObject(strDefinitionFile, strGuid, p_pParent);
-		pObj->m_Transform.ParseTransformNode(p_pGameObjectRootElement->FirstChildElement("Transform"));
+		mNode.pDefinition = GetPrefab(strDefinitionFile);
+	}
+	else
+	{
+		tinyxml2::XMLElement* pComponentsRootElement = p_pGameObjectRootElement->FirstChildElement("Components");
+		if (pComponentsRootElement != nullptr)
+		{
+			for (tinyxml2::XMLElement* pComponentElement = pComponentsRootElement->FirstChildElement();
+				 pComponentElement != nullptr;
+				 pComponentElement = pComponentElement->NextSiblingElement())
+			{
+				ComponentFactoryMap::iterator it = m_mComponentFactoryMap.find(pComponentElement->Value());
+#if _DEBUG
+				assert(it != m_mComponentFactoryMap.end());
+#endif
+
+				PrefabComponent mComponent;
+				mComponent.pFactory = it->second;
+				mComponent.pElement = pComponentElement;
+				mNode.vComponents.push_back(mComponent);
+			}
+		}
+
+		tinyxml2::XMLElement* pChildrenRootElement = p_pGameObjectRootElement->FirstChildElement("Children");
+		if (pChildrenRootElement != nullptr)
+		{
+			for (tinyxml2::XMLElement* pChildGameObjectElement = pChildrenRootElement->FirstChildElement("GameObject");
+				 pChildGameObjectElement != nullptr;
+				 pChildGameObjectElement = pChildGameObjectElement->NextSiblingElement("GameObject"))
+			{
+				mNode.vChildren.push_back(BuildPrefabNode(pChildGameObjectElement, p_pPrefab));
+			}
+		}
+
+		tinyxml2::XMLElement* pTagsRootElement = p_pGameObjectRootElement->FirstChildElement("Tags");
+		if (pTagsRootElement != nullptr)
+		{
+			for (tinyxml2::XMLElement* pTagElement = pTagsRootElement->FirstChildElement("Tag");
+				 pTagElement != nullptr;
+				 pTagElement = pTagElement->NextSiblingElement("Tag"))
+			{
+				std::string strTag = "";
+				EasyXML::GetRequiredStringAttribute(pTagElement, "value", strTag);
+				mNode.vTags.push_back(strTag);
+			}
+		}
+	}
+
+	p_pPrefab->vNodes[uiIndex] = mNode;
+	return uiIndex;
+}
+
+GameObject* GameObjectManager::InstantiatePrefabNode(const Prefab* p_pPrefab, const unsigned int p_uiNode, const std::string& p_strGuid, GameObject* p_pParent)
+{
+	const PrefabNode& mNode = p_pPrefab->vNodes[p_uiNode];
+
+	std::string strGuid = p_strGuid;
+	if (strGuid.empty())
+	{
+		strGuid = mNode.strGuid.empty() ? GetAutoGuid() : mNode.strGuid;
+	}
+
+	if (mNode.pDefinition != nullptr)
+	{
+		// Resetting this on reuse would take both nodes' transforms, so it isn't recycled.
+		GameObject* pObj = InstantiatePrefabNode(mNode.pDefinition, 0, strGuid, p_pParent);
+		pObj->m_Transform.ParseTransformNode(mNode.pTransformElement);
+		pObj->m_iPrefabNode = -1;
 		return pObj;
 	}
 	else
 	{
 		GameObject* pObj = new GameObject(this, strGuid);
+		pObj->m_mHandle = AllocateHandle(pObj);
+		pObj->m_iPrefabNode = p_uiNode;
 		pObj->SetParent(p_pParent);
-		pObj->m_Transform.ParseTransformNode(p_pGameObjectRootElement->FirstChildElement("Transform"));
+		pObj->m_Transform.ParseTransformNode(mNode.pTransformElement);
 
-		LoadComponents(p_pGameObjectRootElement->FirstChildElement("Components"), pObj);
-		LoadChildren(p_pGameObjectRootElement->FirstChildElement("Children"), pObj);
-		ParseTags(p_pGameObjectRootElement->FirstChildElement("Tags"), pObj);
+		for (unsigned int i = 0; i < mNode.vComponents.size(); ++i)
+		{
+			const PrefabComponent& mComponent = mNode.vComponents[i];
+			Component* pComponent = mComponent.pFactory(pObj, mComponent.pElement, nullptr);
+#if _DEBUG
+			assert(pComponent != nullptr);
+#endif
+
+			pObj->AddComponent(pComponent);
+		}
+
+		for (unsigned int i = 0; i < mNode.vChildren.size(); ++i)
+		{
+			GameObject* pChild = InstantiatePrefabNode(p_pPrefab, mNode.vChildren[i], "", pObj);
+
+			tinyxml2::XMLElement* pChildTransformElement = p_pPrefab->vNodes[mNode.vChildren[i]].pTransformElement;
+			if (pChildTransformElement != nullptr)
+			{
+				pChild->m_Transform.ParseTransformNode(pChildTransformElement);
+			}
+		}
+
+		for (unsigned int i = 0; i < mNode.vTags.size(); ++i)
+		{
+			pObj->AddTag(mNode.vTags[i]);
+		}
 
 #ifdef _DEBUG
 		assert(m_mGameObjectMap.find(strGuid) == m_mGameObjectMap.end() && "Not a unique Guid");
@@ -100,91 +333,171 @@ GameObject* GameObjectManager::CreateGameObject(tinyxml2::XMLElement* p_pGameObj
 	}
 }
 
-std::string GameObjectManager::GetGuid(tinyxml2::XMLElement* p_pGameObjectRootElement)
+bool GameObjectManager::CanRecycle(GameObject* p_pGameObject) const
 {
-	std::string strGuid = "";
-	EasyXML::GetOptionalStringAttribute(p_pGameObjectRootElement, "guid", strGuid, strGuid);
-	if (strGuid.empty())
+	if (p_pGameObject->m_iPrefabNode < 0)
+	{
+		return false;
+	}
+
+	for (ComponentFamilyID i = 0; i < p_pGameObject->m_vFamilyComponents.size(); ++i)
+	{
+		Component* pComponent = p_pGameObject->m_vFamilyComponents[i];
+		if (pComponent != nullptr && !pComponent->IsRecyclable())
+		{
+			return false;
+		}
+	}
+
+	std::vector<GameObject*> vChildren = p_pGameObject->GetChildren();
+	for (unsigned int i = 0; i < vChildren.size(); ++i)
 	{
-		strGuid = GetAutoGuid();
+		if (!CanRecycle(vChildren[i]))
+		{
+			return false;
+		}
 	}
 
-	return strGuid;
+	return true;
 }
 
-std::string GameObjectManager::GetAutoGuid()
+void GameObjectManager::DeactivateGameObject(GameObject* p_pGameObject)
 {
-	return "auto_guid_" + std::to_string(m_uiAutoGUIDNum++);
+	// Children stay attached, but leave the map along with their parent.
+	std::vector<GameObject*> vChildren = p_pGameObject->GetChildren();
+	for (unsigned int i = 0; i < vChildren.size(); ++i)
+	{
+		DeactivateGameObject(vChildren[i]);
+	}
+
+	for (ComponentFamilyID i = 0; i < p_pGameObject->m_vFamilyComponents.size(); ++i)
+	{
+		Component* pComponent = p_pGameObject->m_vFamilyComponents[i];
+		if (pComponent != nullptr)
+		{
+			pComponent->Deactivate();
+			UnregisterComponent(pComponent, i);
+		}
+	}
+
+	p_pGameObject->RemoveAllTags();
+	ReleaseHandle(p_pGameObject->GetHandle());
+	m_mGameObjectMap.erase(p_pGameObject->GetGUID());
 }
 
-void GameObjectManager::LoadComponents(tinyxml2::XMLElement* p_pComponentsRootElement, GameObject* p_pGameObject)
+void GameObjectManager::ReactivateGameObject(GameObject* p_pGameObject, const Prefab* p_pPrefab)
 {
-#if _DEBUG
-	assert(p_pGameObject != nullptr);
-#endif
+	const PrefabNode& mNode = p_pPrefab->vNodes[p_pGameObject->m_iPrefabNode];
+
+	p_pGameObject->m_mHandle = AllocateHandle(p_pGameObject);
+
+	HierarchicalTransform& mTransform = p_pGameObject->m_Transform;
+	mTransform.SetTranslation(glm::vec3(0.0f, 0.0f, 0.0f));
+	mTransform.SetRotation(glm::quat());
+	mTransform.SetScale(glm::vec3(1.0f, 1.0f, 1.0f));
+	mTransform.ParseTransformNode(mNode.pTransformElement);
 
-	if (p_pComponentsRootElement != nullptr)
+	for (ComponentFamilyID i = 0; i < p_pGameObject->m_vFamilyComponents.size(); ++i)
 	{
-		for (tinyxml2::XMLElement* pComponentElement = p_pComponentsRootElement->FirstChildElement();
-			 pComponentElement != nullptr;
-			 pComponentElement = pComponentElement->NextSiblingElement())
+		Component* pComponent = p_pGameObject->m_vFamilyComponents[i];
+		if (pComponent != nullptr)
 		{
-			std::string strComponentType = pComponentElement->Value();
-			ComponentFactoryMap::iterator it = m_mComponentFactoryMap.find(strComponentType.c_str());
-#if _DEBUG
-			assert(it != m_mComponentFactoryMap.end());
-#endif
+			pComponent->Reactivate();
+			RegisterComponent(pComponent, i);
+		}
+	}
 
-			Component* pComponent = it->second(p_pGameObject, pComponentElement, nullptr);
-#if _DEBUG
-			assert(pComponent != nullptr);
-#endif
+	std::vector<GameObject*> vChildren = p_pGameObject->GetChildren();
+	for (unsigned int i = 0; i < vChildren.size(); ++i)
+	{
+		ReactivateGameObject(vChildren[i], p_pPrefab);
+	}
 
-			p_pGameObject->AddComponent(pComponent);
-		}
+	for (unsigned int i = 0; i < mNode.vTags.size(); ++i)
+	{
+		p_pGameObject->AddTag(mNode.vTags[i]);
 	}
+
+#ifdef _DEBUG
+	assert(m_mGameObjectMap.find(p_pGameObject->GetGUID()) == m_mGameObjectMap.end() && "Not a unique Guid");
+#endif
+
+	m_mGameObjectMap.insert(std::pair<std::string, GameObject*>(p_pGameObject->GetGUID(), p_pGameObject));
+	p_pGameObject->Init();
+
+	p_pGameObject->m_Transform.ManuallyUpdateParent();
 }
 
-void GameObjectManager::LoadChildren(tinyxml2::XMLElement* p_pChildrenRootElement, GameObject* p_pParent)
+void GameObjectManager::DeletePooledGameObject(GameObject* p_pGameObject)
 {
-#if _DEBUG
-	assert(p_pParent != nullptr);
-#endif
+	// Pooled GameObjects aren't in the map, so their children can't be queued for
+	// destruction the way DeleteAllChildren() does. Each child detaches itself.
+	std::vector<GameObject*> vChildren = p_pGameObject->GetChildren();
+	for (unsigned int i = 0; i < vChildren.size(); ++i)
+	{
+		DeletePooledGameObject(vChildren[i]);
+	}
 
-	if (p_pChildrenRootElement != nullptr)
+	delete p_pGameObject;
+}
+
+void GameObjectManager::DeleteAllPooledGameObjects()
+{
+	RecyclingPoolList::iterator it = m_vRecyclingPools.begin(), end = m_vRecyclingPools.end();
+	for (; it != end; ++it)
 	{
-		for (tinyxml2::XMLElement* pChildGameObjectElement = p_pChildrenRootElement->FirstChildElement("GameObject");
-			 pChildGameObjectElement != nullptr;
-			 pChildGameObjectElement = pChildGameObjectElement->NextSiblingElement("GameObject"))
+		for (unsigned int i = 0; i < it->vPooled.size(); ++i)
 		{
-			GameObject* pChild = CreateGameObject(pChildGameObjectElement, "", p_pParent);
-
-			tinyxml2::XMLElement* pChildTransformElement = pChildGameObjectElement->FirstChildElement("Transform");
-			if (pChildTransformElement != nullptr)
-			{
-				pChild->m_Transform.ParseTransformNode(pChildTransformElement);
-			}
+			DeletePooledGameObject(it->vPooled[i]);
 		}
+		it->vPooled.clear();
 	}
 }
 
-void GameObjectManager::ParseTags(tinyxml2::XMLElement* p_pTagsRootElement, GameObject* p_pGameObject)
+std::string GameObjectManager::GetAutoGuid()
 {
-#if _DEBUG
-	assert(p_pGameObject != nullptr);
-#endif
+	return "auto_guid_" + std::to_string(m_uiAutoGUIDNum++);
+}
 
-	if (p_pTagsRootElement != nullptr)
+GameObjectHandle GameObjectManager::AllocateHandle(GameObject* p_pGameObject)
+{
+	unsigned int uiIndex;
+	if (!m_vFreeHandleSlots.empty())
 	{
-		for (tinyxml2::XMLElement* pTagElement = p_pTagsRootElement->FirstChildElement("Tag");
-			 pTagElement != nullptr;
-			 pTagElement = pTagElement->NextSiblingElement("Tag"))
-		{
-			std::string strTag = "";
-			EasyXML::GetRequiredStringAttribute(pTagElement, "value", strTag);
-			p_pGameObject->AddTag(strTag);
-		}
+		uiIndex = m_vFreeHandleSlots.back();
+		m_vFreeHandleSlots.pop_back();
 	}
+	else
+	{
+		assert(m_vHandleSlots.size() <= GameObjectHandle::MAX_INDEX && "Out Of GameObject Handles");
+
+		HandleSlot mSlot;
+		mSlot.pGameObject = nullptr;
+		mSlot.uiGeneration = 1;
+
+		uiIndex = m_vHandleSlots.size();
+		m_vHandleSlots.push_back(mSlot);
+	}
+
+	m_vHandleSlots[uiIndex].pGameObject = p_pGameObject;
+	return GameObjectHandle(uiIndex, m_vHandleSlots[uiIndex].uiGeneration);
+}
+
+void GameObjectManager::ReleaseHandle(const GameObjectHandle& p_mHandle)
+{
+	HandleSlot& mSlot = m_vHandleSlots[p_mHandle.GetIndex()];
+#ifdef _DEBUG
+	assert(mSlot.uiGeneration == p_mHandle.GetGeneration() && "GameObject Handle Released Twice");
+#endif
+
+	// Every destroyed or pooled GameObject passes through here. The EventManager keys
+	// what it remembers by address, which the next GameObject may well reuse.
+	EventManager::Instance()->ForgetTarget(mSlot.pGameObject);
+
+	// Skip generation 0 on wrap-around, so a live handle is never null.
+	mSlot.pGameObject = nullptr;
+	mSlot.uiGeneration = (mSlot.uiGeneration == GameObjectHandle::MAX_GENERATION ? 1 : mSlot.uiGeneration + 1);
+	m_vFreeHandleSlots.push_back(p_mHandle.GetIndex());
 }
 
 GameObject* GameObjectManager::GetGameObject(const std::string &p_strGOGUID)
@@ -201,47 +514,419 @@ GameObject* GameObjectManager::GetGameObject(const std::string &p_strGOGUID)
 
 std::vector<GameObject*> GameObjectManager::GetGameObjectsByTag(const std::string& p_strGameObjectTag)
 {
-	std::vector<GameObject*> vResult;
-	GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
-	for (; it != end; it++)
+	return GetGameObjectsWithTag(p_strGameObjectTag);
+}
+
+const std::vector<GameObject*>& GameObjectManager::GetGameObjectsWithTag(const std::string& p_strGameObjectTag) const
+{
+	static const std::vector<GameObject*> s_vNoGameObjects;
+
+	TagIndex::const_iterator find = m_mTagIndex.find(p_strGameObjectTag);
+	if (find != m_mTagIndex.end())
 	{
-		if (it->second->HasTag(p_strGameObjectTag))
-		{
-			vResult.push_back(it->second);
-		}
+		return find->second;
 	}
 
-	return vResult;
+	return s_vNoGameObjects;
+}
+
+void GameObjectManager::IndexTag(GameObject* p_pGameObject, const std::string& p_strTag)
+{
+	m_mTagIndex[p_strTag].push_back(p_pGameObject);
+}
+
+void GameObjectManager::UnindexTag(GameObject* p_pGameObject, const std::string& p_strTag)
+{
+	TagIndex::iterator find = m_mTagIndex.find(p_strTag);
+	if (find != m_mTagIndex.end())
+	{
+		// Keep the order the objects were tagged in.
+		std::vector<GameObject*>& vTagged = find->second;
+		vTagged.erase(std::remove(vTagged.begin(), vTagged.end(), p_pGameObject), vTagged.end());
+	}
+}
+
+void GameObjectManager::UnindexAllTags(GameObject* p_pGameObject)
+{
+	const std::set<std::string>& mTags = p_pGameObject->GetTagList();
+	for (std::set<std::string>::const_iterator it = mTags.begin(); it != mTags.end(); ++it)
+	{
+		UnindexTag(p_pGameObject, *it);
+	}
 }
 
 void GameObjectManager::DestroyGameObject(GameObject* p_pGameObject)
 {
+#ifdef _DEBUG
+	assert(!m_bParallelUpdating && "GameObject Destroyed During Parallel Update");
+#endif
 	m_vToDelete.insert(p_pGameObject);
 }
 
 void GameObjectManager::DestroyAllGameObjects()
 {
+	// Every component and tag is about to go, so skip unregistering them one by one.
+	m_vSystems.clear();
+	m_vParallelComponents.clear();
+	m_bSystemsDirty = false;
+	m_mTagIndex.clear();
+
 	GameObject* pGameObject = nullptr;
 	GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
 	for (; it != end; ++it)
 	{
 		pGameObject = (GameObject*)it->second;
+		ReleaseHandle(pGameObject->GetHandle());
 		delete pGameObject;
 	}
 	m_mGameObjectMap.clear();
 	m_vToDelete.clear(); // Parents register children for destruction
+
+	DeleteAllPooledGameObjects();
 }
 
-void GameObjectManager::Update(const float p_fDelta)
+bool GameObjectManager::CaptureSnapshot(SceneSnapshot& p_mSnapshot) const
 {
+	p_mSnapshot.Clear();
+
+	GameObjectMap::const_iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
+	for (; it != end; ++it)
+	{
+		const GameObject::ComponentMap& mComponents = it->second->m_mComponentMap;
+		for (GameObject::ComponentMap::const_iterator comp_it = mComponents.begin(); comp_it != mComponents.end(); ++comp_it)
+		{
+			if (!comp_it->second->IsSnapshottable())
+			{
+				return false;
+			}
+		}
+	}
+
+	p_mSnapshot.Write(static_cast<unsigned int>(m_mGameObjectMap.size()));
+	for (it = m_mGameObjectMap.begin(); it != end; ++it)
+	{
+		const GameObject* pGameObject = it->second;
+		const GameObject* pParent = pGameObject->GetParent();
+
+		p_mSnapshot.Write(pGameObject->GetHandle().GetValue());
+		p_mSnapshot.Write(pParent != nullptr ? pParent->GetHandle().GetValue() : 0u);
+
+		const HierarchicalTransform& mTransform = pGameObject->GetTransform();
+		p_mSnapshot.Write(mTransform.GetRelativeTranslation());
+		p_mSnapshot.Write(mTransform.GetRelativeRotation());
+		p_mSnapshot.Write(mTransform.GetRelativeScale());
+
+		const std::set<std::string>& mTags = pGameObject->GetTagList();
+		p_mSnapshot.Write(static_cast<unsigned int>(mTags.size()));
+		for (std::set<std::string>::const_iterator tag_it = mTags.begin(); tag_it != mTags.end(); ++tag_it)
+		{
+			p_mSnapshot.WriteString(*tag_it);
+		}
+
+		// Each component's state is sized, so it can be passed over while checking.
+		const GameObject::ComponentMap& mComponents = pGameObject->m_mComponentMap;
+		p_mSnapshot.Write(static_cast<unsigned int>(mComponents.size()));
+		for (GameObject::ComponentMap::const_iterator comp_it = mComponents.begin(); comp_it != mComponents.end(); ++comp_it)
+		{
+			p_mSnapshot.WriteString(comp_it->second->ComponentID());
+
+			const unsigned int uiBlockStart = p_mSnapshot.BeginSizedBlock();
+			comp_it->second->SaveState(p_mSnapshot);
+			p_mSnapshot.EndSizedBlock(uiBlockStart);
+		}
+	}
+
+	return true;
+}
+
+bool GameObjectManager::RestoreSnapshot(SceneSnapshot& p_mSnapshot)
+{
+#ifdef _DEBUG
+	assert(!m_bUpdating && "Snapshot Restored During Update");
+#endif
+
+	if (p_mSnapshot.IsEmpty())
+	{
+		return false;
+	}
+
+	// Children queued by their parents' destruction may land behind the loop, so go
+	// round until nothing is left.
+	while (!m_vToDelete.empty())
+	{
+		DeletePendingGameObjects();
+	}
+
+	std::set<GameObject*> sSnapshotted;
+	if (!CheckSnapshot(p_mSnapshot, sSnapshotted))
+	{
+		return false;
+	}
+
 	GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
 	for (; it != end; ++it)
 	{
-		it->second->Update(p_fDelta);
+		if (sSnapshotted.find(it->second) == sSnapshotted.end())
+		{
+			DestroyGameObject(it->second);
+		}
+	}
+	while (!m_vToDelete.empty())
+	{
+		DeletePendingGameObjects();
+	}
+
+	p_mSnapshot.Rewind();
+
+	unsigned int uiCount = 0;
+	p_mSnapshot.Read(uiCount);
+	for (unsigned int i = 0; i < uiCount; ++i)
+	{
+		unsigned int uiHandle = 0, uiParentHandle = 0;
+		p_mSnapshot.Read(uiHandle);
+		p_mSnapshot.Read(uiParentHandle);
+		GameObject* pGameObject = GetGameObject(GameObjectHandle(uiHandle));
+
+		glm::vec3 vTranslation, vScale;
+		glm::quat qRotation;
+		p_mSnapshot.Read(vTranslation);
+		p_mSnapshot.Read(qRotation);
+		p_mSnapshot.Read(vScale);
+
+		HierarchicalTransform& mTransform = pGameObject->GetTransform();
+		mTransform.SetTranslation(vTranslation);
+		mTransform.SetRotation(qRotation);
+		mTransform.SetScale(vScale);
+
+		// Tags are only touched if they changed, so the tag index keeps its order.
+		std::set<std::string> sTags;
+		unsigned int uiTagCount = 0;
+		p_mSnapshot.Read(uiTagCount);
+		for (unsigned int j = 0; j < uiTagCount; ++j)
+		{
+			std::string strTag;
+			p_mSnapshot.ReadString(strTag);
+			sTags.insert(strTag);
+		}
+
+		if (sTags != pGameObject->GetTagList())
+		{
+			pGameObject->RemoveAllTags();
+			for (std::set<std::string>::const_iterator tag_it = sTags.begin(); tag_it != sTags.end(); ++tag_it)
+			{
+				pGameObject->AddTag(*tag_it);
+			}
+		}
+
+		unsigned int uiComponentCount = 0;
+		p_mSnapshot.Read(uiComponentCount);
+		GameObject::ComponentMap::iterator comp_it = pGameObject->m_mComponentMap.begin();
+		for (unsigned int j = 0; j < uiComponentCount; ++j, ++comp_it)
+		{
+			std::string strComponentID;
+			unsigned int uiBlockSize = 0;
+			p_mSnapshot.ReadString(strComponentID);
+			p_mSnapshot.Read(uiBlockSize);
+
+			const unsigned int uiBlockStart = p_mSnapshot.GetReadPosition();
+			comp_it->second->RestoreState(p_mSnapshot);
+
+#ifdef _DEBUG
+			assert(p_mSnapshot.GetReadPosition() == uiBlockStart + uiBlockSize && "Component Restored Different State To What It Saved");
+#endif
+		}
+	}
+
+	return true;
+}
+
+bool GameObjectManager::CheckSnapshot(SceneSnapshot& p_mSnapshot, std::set<GameObject*>& p_sSnapshotted) const
+{
+	p_mSnapshot.Rewind();
+
+	unsigned int uiCount = 0;
+	p_mSnapshot.Read(uiCount);
+	for (unsigned int i = 0; i < uiCount; ++i)
+	{
+		unsigned int uiHandle = 0, uiParentHandle = 0;
+		p_mSnapshot.Read(uiHandle);
+		p_mSnapshot.Read(uiParentHandle);
+
+		GameObject* pGameObject = GetGameObject(GameObjectHandle(uiHandle));
+		if (pGameObject == nullptr)
+		{
+			return false;
+		}
+
+		const GameObject* pParent = pGameObject->GetParent();
+		if ((pParent != nullptr ? pParent->GetHandle().GetValue() : 0u) != uiParentHandle)
+		{
+			return false;
+		}
+
+		p_mSnapshot.Skip(sizeof(glm::vec3) + sizeof(glm::quat) + sizeof(glm::vec3));
+
+		unsigned int uiTagCount = 0;
+		p_mSnapshot.Read(uiTagCount);
+		for (unsigned int j = 0; j < uiTagCount; ++j)
+		{
+			std::string strTag;
+			p_mSnapshot.ReadString(strTag);
+		}
+
+		unsigned int uiComponentCount = 0;
+		p_mSnapshot.Read(uiComponentCount);
+		if (uiComponentCount != pGameObject->m_mComponentMap.size())
+		{
+			return false;
+		}
+
+		GameObject::ComponentMap::const_iterator comp_it = pGameObject->m_mComponentMap.begin();
+		for (unsigned int j = 0; j < uiComponentCount; ++j, ++comp_it)
+		{
+			std::string strComponentID;
+			unsigned int uiBlockSize = 0;
+			p_mSnapshot.ReadString(strComponentID);
+			p_mSnapshot.Read(uiBlockSize);
+			if (strComponentID != comp_it->second->ComponentID())
+			{
+				return false;
+			}
+			p_mSnapshot.Skip(uiBlockSize);
+		}
+
+		p_sSnapshotted.insert(pGameObject);
+	}
+
+	return p_mSnapshot.IsAtEnd();
+}
+
+void GameObjectManager::SetSystemOrder(const std::vector<std::string>& p_vFamilyIDs)
+{
+	m_vConfiguredOrder.clear();
+	std::vector<std::string>::const_iterator it = p_vFamilyIDs.begin(), end = p_vFamilyIDs.end();
+	for (; it != end; ++it)
+	{
+		m_vConfiguredOrder.push_back(ComponentFamilyRegistry::Intern(*it));
+	}
+
+	// Rebuilt on the next Update().
+	m_vSystemOrder.clear();
+}
+
+void GameObjectManager::RegisterComponent(Component* p_pComponent, const ComponentFamilyID p_uiFamilyID)
+{
+	if (p_uiFamilyID >= m_vSystems.size())
+	{
+		m_vSystems.resize(p_uiFamilyID + 1);
+	}
+	p_pComponent->m_uiSystemSlot = m_vSystems[p_uiFamilyID].size();
+	m_vSystems[p_uiFamilyID].push_back(p_pComponent);
+
+	if (p_pComponent->HasParallelUpdate())
+	{
+		p_pComponent->m_uiParallelSlot = m_vParallelComponents.size();
+		m_vParallelComponents.push_back(p_pComponent);
+	}
+}
+
+void GameObjectManager::UnregisterComponent(Component* p_pComponent, const ComponentFamilyID p_uiFamilyID)
+{
+	if (p_uiFamilyID >= m_vSystems.size())
+	{
+		return;
+	}
+
+	ComponentList& vComponents = m_vSystems[p_uiFamilyID];
+	const unsigned int uiSlot = p_pComponent->m_uiSystemSlot;
+	if (uiSlot >= vComponents.size() || vComponents[uiSlot] != p_pComponent)
+	{
+		return;
+	}
+
+	// While updating, keep the indices stable for the loop in UpdateSystems().
+	// Otherwise the last component takes over the slot.
+	if (m_bUpdating)
+	{
+		vComponents[uiSlot] = nullptr;
+		m_bSystemsDirty = true;
+	}
+	else
+	{
+		vComponents[uiSlot] = vComponents.back();
+		vComponents[uiSlot]->m_uiSystemSlot = uiSlot;
+		vComponents.pop_back();
+	}
+	p_pComponent->m_uiSystemSlot = ~0u;
+
+	const unsigned int uiParallelSlot = p_pComponent->m_uiParallelSlot;
+	if (uiParallelSlot < m_vParallelComponents.size() && m_vParallelComponents[uiParallelSlot] == p_pComponent)
+	{
+		if (m_bUpdating)
+		{
+			m_vParallelComponents[uiParallelSlot] = nullptr;
+		}
+		else
+		{
+			m_vParallelComponents[uiParallelSlot] = m_vParallelComponents.back();
+			m_vParallelComponents[uiParallelSlot]->m_uiParallelSlot = uiParallelSlot;
+			m_vParallelComponents.pop_back();
+		}
+		p_pComponent->m_uiParallelSlot = ~0u;
+	}
+}
+
+void GameObjectManager::Update(const float p_fDelta)
+{
+	const bool bProfiling = m_mProfiler.IsEnabled();
+	if (bProfiling)
+	{
+		m_mProfiler.BeginFrame();
+	}
+
+	m_bUpdating = true;
+	UpdateParallel(p_fDelta);
+	if (m_eUpdateMode == UM_Systems)
+	{
+		UpdateSystems(p_fDelta);
+	}
+	else if (bProfiling)
+	{
+		// As GameObject::Update(), timing each component.
+		GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
+		for (; it != end; ++it)
+		{
+			GameObject::ComponentMap& mComponents = it->second->m_mComponentMap;
+			for (GameObject::ComponentMap::iterator comp_it = mComponents.begin(); comp_it != mComponents.end(); ++comp_it)
+			{
+				const double dStart = m_mProfiler.Now();
+				comp_it->second->Update(p_fDelta);
+				m_mProfiler.Record(comp_it->second, PP_Update, m_mProfiler.Now() - dStart);
+			}
+		}
+	}
+	else
+	{
+		GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
+		for (; it != end; ++it)
+		{
+			it->second->Update(p_fDelta);
+		}
+	}
+	m_bUpdating = false;
+
+	if (m_bSystemsDirty)
+	{
+		CompactSystems();
 	}
 
 	// Delete here so we control that objects get deleted only at the end of the whole
 	// update frame.
+	DeletePendingGameObjects();
+}
+
+void GameObjectManager::DeletePendingGameObjects()
+{
 	std::set<GameObject*>::iterator delete_it = m_vToDelete.begin();
 	while (delete_it != m_vToDelete.end())
 	{
@@ -258,6 +943,22 @@ void GameObjectManager::Update(const float p_fDelta)
 		
 		if (it != m_mGameObjectMap.end())
 		{
+			GameObject* pGameObject = it->second;
+			if (pGameObject->m_iPool >= 0)
+			{
+				RecyclingPool& mPool = m_vRecyclingPools[pGameObject->m_iPool];
+				if (mPool.vPooled.size() < mPool.uiMaxPooled && pGameObject->GetParent() == nullptr && CanRecycle(pGameObject))
+				{
+					DeactivateGameObject(pGameObject);
+					mPool.vPooled.push_back(pGameObject);
+
+					delete_it = m_vToDelete.erase(delete_it);
+					continue;
+				}
+			}
+
+			ReleaseHandle(it->second->GetHandle());
+			UnindexAllTags(it->second);
 			delete it->second;
 			it->second = nullptr;
 			m_mGameObjectMap.erase(it);
@@ -273,26 +974,183 @@ void GameObjectManager::Update(const float p_fDelta)
 	}
 }
 
+void GameObjectManager::UpdateParallel(const float p_fDelta)
+{
+	if (m_vParallelComponents.empty())
+	{
+		return;
+	}
+
+	// Nothing may be added to or removed from the list until the serial update. World
+	// transforms are brought up to date first and held there, as reading them would
+	// otherwise recompute shared state from several threads at once.
+	m_bParallelUpdating = true;
+	m_mTransformHierarchy.BeginConcurrentReads();
+	const ComponentList& vComponents = m_vParallelComponents;
+	if (m_mProfiler.IsEnabled())
+	{
+		m_vParallelTimes.assign(vComponents.size(), 0.0);
+		std::vector<double>& vTimes = m_vParallelTimes;
+		const ComponentProfiler& mProfiler = m_mProfiler;
+		JobSystem::Instance()->ParallelFor(vComponents.size(), 0, [&vComponents, &vTimes, &mProfiler, p_fDelta](const unsigned int p_uiBegin, const unsigned int p_uiEnd)
+		{
+			for (unsigned int i = p_uiBegin; i < p_uiEnd; ++i)
+			{
+				if (vComponents[i] != nullptr)
+				{
+					const double dStart = mProfiler.Now();
+					vComponents[i]->ParallelUpdate(p_fDelta);
+					vTimes[i] = mProfiler.Now() - dStart;
+				}
+			}
+		});
+
+		for (unsigned int i = 0; i < vComponents.size(); ++i)
+		{
+			if (vComponents[i] != nullptr)
+			{
+				m_mProfiler.Record(vComponents[i], PP_ParallelUpdate, vTimes[i]);
+			}
+		}
+	}
+	else
+	{
+		JobSystem::Instance()->ParallelFor(vComponents.size(), 0, [&vComponents, p_fDelta](const unsigned int p_uiBegin, const unsigned int p_uiEnd)
+		{
+			for (unsigned int i = p_uiBegin; i < p_uiEnd; ++i)
+			{
+				if (vComponents[i] != nullptr)
+				{
+					vComponents[i]->ParallelUpdate(p_fDelta);
+				}
+			}
+		});
+	}
+	m_mTransformHierarchy.EndConcurrentReads();
+	m_bParallelUpdating = false;
+}
+
+void GameObjectManager::UpdateSystems(const float p_fDelta)
+{
+	RefreshSystemOrder();
+
+	// Components added during the update wait for the next frame. Lists are indexed
+	// afresh every iteration, as new components and families may grow them.
+	const bool bProfiling = m_mProfiler.IsEnabled();
+	for (unsigned int i = 0; i < m_vSystemOrder.size(); ++i)
+	{
+		const ComponentFamilyID uiFamilyID = m_vSystemOrder[i];
+		const unsigned int uiCount = m_vSystems[uiFamilyID].size();
+		for (unsigned int j = 0; j < uiCount; ++j)
+		{
+			Component* pComponent = m_vSystems[uiFamilyID][j];
+			if (pComponent != nullptr)
+			{
+				if (bProfiling)
+				{
+					const double dStart = m_mProfiler.Now();
+					pComponent->Update(p_fDelta);
+					m_mProfiler.Record(pComponent, PP_Update, m_mProfiler.Now() - dStart);
+				}
+				else
+				{
+					pComponent->Update(p_fDelta);
+				}
+			}
+		}
+	}
+}
+
+void GameObjectManager::RefreshSystemOrder()
+{
+	// Only rebuilt when the configuration changes or new families show up.
+	if (m_vSystemOrder.size() == m_vSystems.size())
+	{
+		return;
+	}
+
+	m_vSystemOrder.clear();
+	std::vector<bool> vOrdered(m_vSystems.size(), false);
+
+	std::vector<ComponentFamilyID>::const_iterator it = m_vConfiguredOrder.begin(), end = m_vConfiguredOrder.end();
+	for (; it != end; ++it)
+	{
+		if (*it < m_vSystems.size() && !vOrdered[*it])
+		{
+			m_vSystemOrder.push_back(*it);
+			vOrdered[*it] = true;
+		}
+	}
+
+	for (ComponentFamilyID i = 0; i < m_vSystems.size(); ++i)
+	{
+		if (!vOrdered[i])
+		{
+			m_vSystemOrder.push_back(i);
+		}
+	}
+}
+
+void GameObjectManager::CompactSystems()
+{
+	// Survivors shift down, so their slots are renumbered.
+	SystemTable::iterator it = m_vSystems.begin(), end = m_vSystems.end();
+	for (; it != end; ++it)
+	{
+		it->erase(std::remove(it->begin(), it->end(), static_cast<Component*>(nullptr)), it->end());
+		for (unsigned int i = 0; i < it->size(); ++i)
+		{
+			(*it)[i]->m_uiSystemSlot = i;
+		}
+	}
+
+	m_vParallelComponents.erase(std::remove(m_vParallelComponents.begin(), m_vParallelComponents.end(), static_cast<Component*>(nullptr)), m_vParallelComponents.end());
+	for (unsigned int i = 0; i < m_vParallelComponents.size(); ++i)
+	{
+		m_vParallelComponents[i]->m_uiParallelSlot = i;
+	}
+	m_bSystemsDirty = false;
+}
+
 void GameObjectManager::PreRender()
 {
+	m_mTransformHierarchy.UpdateWorldTransforms();
+
+	const bool bProfiling = m_mProfiler.IsEnabled();
+	double dStart = 0.0;
+
 	GameObjectMap::iterator it = m_mGameObjectMap.begin(), end = m_mGameObjectMap.end();
 	for (; it != end; ++it)
 	{
 		// If this GameObject has a Renderable component, it has a PreRender phase which
 		// needs to be run.
-		HeatStroke::Component* pComponent = it->second->GetComponent("GOC_Renderable");
-		if (pComponent)
+		ComponentRenderable* pRenderable = it->second->GetComponent<ComponentRenderable>();
+		if (pRenderable)
 		{
-			ComponentRenderable* pRenderable = static_cast<ComponentRenderable*>(pComponent);
+			if (bProfiling)
+			{
+				dStart = m_mProfiler.Now();
+			}
 			pRenderable->PreRender();
+			if (bProfiling)
+			{
+				m_mProfiler.Record(pRenderable, PP_PreRender, m_mProfiler.Now() - dStart);
+			}
 		}
 
 		// TODO: Work around where GO's might have both a Collider and Renderable
-		pComponent = it->second->GetComponent("GOC_Collider");
-		if (pComponent)
+		ComponentCollider* pCollider = it->second->GetComponent<ComponentCollider>();
+		if (pCollider)
 		{
-			ComponentRenderable* pRenderable = static_cast<ComponentRenderable*>(pComponent);
-			pRenderable->PreRender();
+			if (bProfiling)
+			{
+				dStart = m_mProfiler.Now();
+			}
+			pCollider->PreRender();
+			if (bProfiling)
+			{
+				m_mProfiler.Record(pCollider, PP_PreRender, m_mProfiler.Now() - dStart);
+			}
 		}
 	}
 }
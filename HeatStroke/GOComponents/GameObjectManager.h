@@ -19,8 +19,14 @@
 #include <map>
 #include <set>
 #include <vector>
+#include <unordered_map>
 
 #include "GameObject.h"
+#include "GameObjectHandle.h"
+#include "ComponentFamilyRegistry.h"
+#include "ComponentProfiler.h"
+#include "SceneSnapshot.h"
+#include "TransformHierarchy.h"
 
 // For parsing GameObject XML
 #include "tinyxml2.h"
@@ -28,6 +34,17 @@
 
 namespace HeatStroke
 {
+	// How GameObjectManager::Update() walks the components.
+	enum UpdateMode
+	{
+		// Each GameObject in turn updates all of its components.
+		UM_PerObject = 0,
+
+		// Each component family in turn updates across all GameObjects, in the
+		// order given to SetSystemOrder().
+		UM_Systems
+	};
+
 	class GameObjectManager
 	{
 	public:
@@ -56,15 +73,75 @@ namespace HeatStroke
 		GameObject* CreateGameObject(const std::string& p_strGameObjectDefinitionFile, const std::string& p_strGuid = "", GameObject* p_pParent = nullptr);
 		GameObject* CreateGameObject(tinyxml2::XMLElement* p_pGameObjectRootElement, const std::string& p_strGuid = "", GameObject* p_pParent = nullptr);
 
+		// Definition files are read and resolved once, the first time they are used,
+		// and instanced from memory after that. Preloading a file spawned mid-race
+		// (projectiles, blasts) moves that one-off cost to load time.
+		void PreloadGameObject(const std::string& p_strGameObjectDefinitionFile);
+
+		// As above, for a definition file which has already been read, such as by an
+		// AsyncLoader. Takes ownership of the document. Files it refers to through
+		// "definition" attributes should be preloaded first, or they will be read then.
+		void PreloadGameObject(const std::string& p_strGameObjectDefinitionFile, tinyxml2::XMLDocument* p_pDocument);
+		void ClearPrefabCache();
+
+		// Recycles short-lived GameObjects built from a definition file, such as
+		// projectiles. Destroying one deactivates its components and keeps it, up to
+		// p_uiMaxPooled of them, for CreateGameObject() to reset and hand out again
+		// under a new GUID. Only GameObjects created without a GUID or parent are
+		// recycled, and only if every component in their hierarchy supports it.
+		void EnableRecycling(const std::string& p_strGameObjectDefinitionFile, const unsigned int p_uiMaxPooled);
+
 		GameObject*              GetGameObject(const std::string& p_strGameObjectGUID);
+		GameObject*              GetGameObject(const GameObjectHandle& p_mHandle) const;
 		std::vector<GameObject*> GetGameObjectsByTag(const std::string& p_strGameObjectTag);
 
+		// The GameObjects with a tag, in the order they were tagged, without copying.
+		// Cheap enough to call every frame; the reference is only good until the next
+		// tag change or GameObject destruction.
+		const std::vector<GameObject*>& GetGameObjectsWithTag(const std::string& p_strGameObjectTag) const;
+
+		// Called by GameObject as tags are added and removed, to keep the tag index current.
+		void IndexTag(GameObject* p_pGameObject, const std::string& p_strTag);
+		void UnindexTag(GameObject* p_pGameObject, const std::string& p_strTag);
+
 		void DestroyGameObject(GameObject* p_pGameObject);
 		void DestroyAllGameObjects();
 
+		// Records every GameObject, its transform and tags, and the state of its
+		// components, so that RestoreSnapshot() can put the scene back as it was without
+		// rebuilding it. Returns false, leaving p_mSnapshot empty, if any component
+		// isn't snapshottable.
+		bool CaptureSnapshot(SceneSnapshot& p_mSnapshot) const;
+
+		// Puts back a snapshot taken by CaptureSnapshot(), in place: GameObjects created
+		// since are destroyed, and the rest are reset. Returns false, changing nothing
+		// but the pending destructions, if any GameObject in the snapshot has since been
+		// destroyed, reparented, or had its components changed. Not for use during Update().
+		bool RestoreSnapshot(SceneSnapshot& p_mSnapshot);
+
 		void Update(const float p_fDelta);
 		void PreRender();
 
+		// Switches between per-object and per-family updates. Per-object is the default.
+		void SetUpdateMode(const UpdateMode p_eUpdateMode)	{ m_eUpdateMode = p_eUpdateMode; }
+		UpdateMode GetUpdateMode() const					{ return m_eUpdateMode; }
+
+		// The order component families are updated in with UM_Systems. Families not
+		// listed are updated afterwards, in the order they were first seen.
+		void SetSystemOrder(const std::vector<std::string>& p_vFamilyIDs);
+
+		// Times component updates and pre-renders by component type, see ComponentProfiler.
+		ComponentProfiler& GetProfiler()	{ return m_mProfiler; }
+
+		// Derives the world transforms of every GameObject, and of anything parented to
+		// one. Brought up to date in one pass at the start of PreRender().
+		TransformHierarchy& GetTransformHierarchy()	{ return m_mTransformHierarchy; }
+
+		// Called by GameObject as components are added and removed, to keep the
+		// per-family and parallel update lists current.
+		void RegisterComponent(Component* p_pComponent, const ComponentFamilyID p_uiFamilyID);
+		void UnregisterComponent(Component* p_pComponent, const ComponentFamilyID p_uiFamilyID);
+
 		// Iterator access to allow outside traversal of GameObjects
 		GameObjectMap::iterator		  begin()		{ return m_mGameObjectMap.begin(); }
 		GameObjectMap::iterator		  end()			{ return m_mGameObjectMap.end(); }
@@ -83,6 +160,62 @@ namespace HeatStroke
 		//---------------------------------------------------------------------
 		typedef std::map<std::string, ComponentFactoryMethod> ComponentFactoryMap;
 
+		// A GameObject's slot in the handle table. The generation is bumped each time
+		// the slot is released, which invalidates every handle to its old occupant.
+		struct HandleSlot
+		{
+			GameObject* pGameObject;
+			unsigned int uiGeneration;
+		};
+		typedef std::vector<HandleSlot> HandleSlotList;
+
+		// Every component of one family. Each component knows its own index, and removal
+		// moves the last component into the gap, so the order is not meaningful.
+		typedef std::vector<Component*> ComponentList;
+		typedef std::vector<ComponentList> SystemTable;
+
+		// Every GameObject carrying each tag.
+		typedef std::unordered_map<std::string, std::vector<GameObject*> > TagIndex;
+
+		// A GameObject element with its component factories looked up and its tags
+		// read. Components are still built from their elements, which stay in the
+		// prefab's document. Children are indices into the owning Prefab's nodes.
+		struct Prefab;
+		struct PrefabComponent
+		{
+			ComponentFactoryMethod pFactory;
+			tinyxml2::XMLElement* pElement;
+		};
+		struct PrefabNode
+		{
+			std::string strGuid;
+			const Prefab* pDefinition;
+			tinyxml2::XMLElement* pTransformElement;
+			std::vector<PrefabComponent> vComponents;
+			std::vector<unsigned int> vChildren;
+			std::vector<std::string> vTags;
+		};
+
+		// A parsed definition file, which owns its document. Node 0 is its root GameObject.
+		struct Prefab
+		{
+			tinyxml2::XMLDocument* pDocument;
+			std::vector<PrefabNode> vNodes;
+			int iPool;
+
+			Prefab() : pDocument(nullptr), vNodes(), iPool(-1) {}
+			~Prefab() { delete pDocument; }
+		};
+		typedef std::map<std::string, Prefab*> PrefabCache;
+
+		// Deactivated GameObjects waiting to be reused.
+		struct RecyclingPool
+		{
+			unsigned int uiMaxPooled;
+			std::vector<GameObject*> vPooled;
+		};
+		typedef std::vector<RecyclingPool> RecyclingPoolList;
+
 		//---------------------------------------------------------------------
 		// Private members
 		//---------------------------------------------------------------------
@@ -95,6 +228,42 @@ namespace HeatStroke
 
 		unsigned int m_uiAutoGUIDNum;
 
+		// Handle table, and the indices of its free slots. Slots are never removed,
+		// so their generations survive DestroyAllGameObjects().
+		HandleSlotList m_vHandleSlots;
+		std::vector<unsigned int> m_vFreeHandleSlots;
+
+		// Per-family component lists, indexed by ComponentFamilyID, and the order they
+		// are updated in. Components removed during Update() are nulled out and the
+		// lists compacted once it finishes.
+		UpdateMode m_eUpdateMode;
+		SystemTable m_vSystems;
+		std::vector<ComponentFamilyID> m_vConfiguredOrder;
+		std::vector<ComponentFamilyID> m_vSystemOrder;
+		bool m_bSystemsDirty;
+
+		// Components with a parallel update, in no particular order. Nulled out and
+		// compacted along with the per-family lists.
+		ComponentList m_vParallelComponents;
+		bool m_bParallelUpdating;
+
+		// Off unless enabled. Parallel update times are gathered by index into the
+		// parallel list, so the workers never touch the profiler.
+		ComponentProfiler m_mProfiler;
+		std::vector<double> m_vParallelTimes;
+
+		TransformHierarchy m_mTransformHierarchy;
+
+		TagIndex m_mTagIndex;
+
+		// Parsed definition files, keyed by path.
+		PrefabCache m_mPrefabCache;
+
+		// Recycling pools, and the index of each by definition file. Pools outlive
+		// ClearPrefabCache(), so GameObjects can keep their index.
+		RecyclingPoolList m_vRecyclingPools;
+		std::map<std::string, int> m_mRecyclingPoolIndices;
+
 		//---------------------------------------------------------------------
 		// Private methods
 		//---------------------------------------------------------------------
@@ -102,13 +271,47 @@ namespace HeatStroke
 		GameObjectManager(const GameObjectManager&) = delete;
 		GameObjectManager& operator=(const GameObjectManager) = delete;
 
-		void LoadComponents(tinyxml2::XMLElement* p_pComponentsRootElement, GameObject* p_pGameObject);
-		void LoadChildren(tinyxml2::XMLElement* p_pChildrenRootElement, GameObject* p_pParent);
-		void ParseTags(tinyxml2::XMLElement* p_pTagsRootElement, GameObject* p_pGameObject);
+		Prefab* GetPrefab(const std::string& p_strGameObjectDefinitionFile);
+		Prefab* AddPrefab(const std::string& p_strGameObjectDefinitionFile, tinyxml2::XMLDocument* p_pDocument);
+		unsigned int BuildPrefabNode(tinyxml2::XMLElement* p_pGameObjectRootElement, Prefab* p_pPrefab);
+		GameObject* InstantiatePrefabNode(const Prefab* p_pPrefab, const unsigned int p_uiNode, const std::string& p_strGuid, GameObject* p_pParent);
+
+		bool CanRecycle(GameObject* p_pGameObject) const;
+		void DeactivateGameObject(GameObject* p_pGameObject);
+		void ReactivateGameObject(GameObject* p_pGameObject, const Prefab* p_pPrefab);
+		void DeletePooledGameObject(GameObject* p_pGameObject);
+		void DeleteAllPooledGameObjects();
 
-		std::string GetGuid(tinyxml2::XMLElement* p_pGameObjectRootElement);
 		std::string GetAutoGuid();
+
+		GameObjectHandle AllocateHandle(GameObject* p_pGameObject);
+		void ReleaseHandle(const GameObjectHandle& p_mHandle);
+
+		void DeletePendingGameObjects();
+		bool CheckSnapshot(SceneSnapshot& p_mSnapshot, std::set<GameObject*>& p_sSnapshotted) const;
+
+		void UpdateParallel(const float p_fDelta);
+		void UpdateSystems(const float p_fDelta);
+		void RefreshSystemOrder();
+		void CompactSystems();
+
+		void UnindexAllTags(GameObject* p_pGameObject);
 	};
+
+	//-------------------------------------------------------------------------
+	// Resolves a handle in O(1). Returns nullptr for the null handle, and for
+	// handles to GameObjects that have since been destroyed.
+	//-------------------------------------------------------------------------
+	inline GameObject* GameObjectManager::GetGameObject(const GameObjectHandle& p_mHandle) const
+	{
+		const unsigned int uiIndex = p_mHandle.GetIndex();
+		if (uiIndex < m_vHandleSlots.size() && m_vHandleSlots[uiIndex].uiGeneration == p_mHandle.GetGeneration())
+		{
+			return m_vHandleSlots[uiIndex].pGameObject;
+		}
+
+		return nullptr;
+	}
 } // namespace HeatStroke
 
 #endif // GAMEOBJECTMANAGER_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+//==================================================================================
+// SceneSnapshot
+//
+// A binary record of a GameObjectManager's GameObjects, their transforms, and the
+// state of their components.
+//==================================================================================
+
+#include "SceneSnapshot.h"
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::WriteString
+	// Parameters:
+	//	const std::string& p_strValue - Written as its length, then its characters.
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::WriteString(const std::string& p_strValue)
+	{
+		const unsigned int uiLength = p_strValue.length();
+		Write(uiLength);
+		WriteBytes(p_strValue.data(), uiLength);
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::ReadString
+	// Parameters:
+	//	std::string& p_strValue - Receives a string written by WriteString().
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::ReadString(std::string& p_strValue)
+	{
+		unsigned int uiLength = 0;
+		Read(uiLength);
+
+#ifdef _DEBUG
+		assert(m_uiReadPosition + uiLength <= m_vData.size() && "Read Past End Of Snapshot");
+#endif
+
+		p_strValue.assign(reinterpret_cast<const char*>(m_vData.data()) + m_uiReadPosition, uiLength);
+		m_uiReadPosition += uiLength;
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::Skip
+	// Parameters:
+	//	const unsigned int p_uiBytes - How far to move the read position.
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::Skip(const unsigned int p_uiBytes)
+	{
+#ifdef _DEBUG
+		assert(m_uiReadPosition + p_uiBytes <= m_vData.size() && "Read Past End Of Snapshot");
+#endif
+
+		m_uiReadPosition += p_uiBytes;
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::BeginSizedBlock
+	// Returns: unsigned int - Where the block's size will be written.
+	//------------------------------------------------------------------------------
+	unsigned int SceneSnapshot::BeginSizedBlock()
+	{
+		const unsigned int uiBlockStart = m_vData.size();
+		Write(static_cast<unsigned int>(0));
+		return uiBlockStart;
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::EndSizedBlock
+	// Parameters:
+	//	const unsigned int p_uiBlockStart - As returned by BeginSizedBlock().
+	//
+	// Fills in the size of everything written since BeginSizedBlock(), which Read()
+	// gives back ahead of the block.
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::EndSizedBlock(const unsigned int p_uiBlockStart)
+	{
+		const unsigned int uiBlockSize = m_vData.size() - p_uiBlockStart - sizeof(unsigned int);
+		memcpy(&m_vData[p_uiBlockStart], &uiBlockSize, sizeof(unsigned int));
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::WriteBytes
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::WriteBytes(const void* p_pBytes, const unsigned int p_uiCount)
+	{
+		const unsigned char* pBytes = static_cast<const unsigned char*>(p_pBytes);
+		m_vData.insert(m_vData.end(), pBytes, pBytes + p_uiCount);
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::ReadBytes
+	//------------------------------------------------------------------------------
+	void SceneSnapshot::ReadBytes(void* p_pBytes, const unsigned int p_uiCount)
+	{
+#ifdef _DEBUG
+		assert(m_uiReadPosition + p_uiCount <= m_vData.size() && "Read Past End Of Snapshot");
+#endif
+
+		if (p_uiCount > 0)
+		{
+			memcpy(p_pBytes, &m_vData[m_uiReadPosition], p_uiCount);
+			m_uiReadPosition += p_uiCount;
+		}
+	}
+}
@@ -0,0 +1,120 @@
+//==================================================================================
+// SceneSnapshot
+//
+// A binary record of a GameObjectManager's GameObjects, their transforms, and the
+// state of their components, taken by GameObjectManager::CaptureSnapshot() and put
+// back by RestoreSnapshot().
+//
+// Components write their state with the Write methods in SaveState(), and read it
+// back with the matching Read methods, in the same order, in RestoreState(). Only
+// plain data should be written with Write() and WriteVector(): values are copied
+// byte for byte, so pointers would come back pointing at whatever they pointed at
+// when the snapshot was taken.
+//==================================================================================
+
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <string.h>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	class SceneSnapshot
+	{
+	public:
+		//-----------------------------------------------------------------------------
+		// Public Interface
+		//-----------------------------------------------------------------------------
+		SceneSnapshot() : m_vData(), m_uiReadPosition(0) {}
+
+		void Clear()					{ m_vData.clear(); m_uiReadPosition = 0; }
+		bool IsEmpty() const			{ return m_vData.empty(); }
+		unsigned int GetSize() const	{ return m_vData.size(); }
+
+		// Writing, at the end of the snapshot.
+		template<typename T> void Write(const T& p_Value);
+		template<typename T> void WriteVector(const std::vector<T>& p_vValues);
+		void WriteString(const std::string& p_strValue);
+
+		// Reading, from the start of the snapshot after Rewind() and onwards.
+		void Rewind()					{ m_uiReadPosition = 0; }
+		bool IsAtEnd() const			{ return m_uiReadPosition == m_vData.size(); }
+		unsigned int GetReadPosition() const { return m_uiReadPosition; }
+		template<typename T> void Read(T& p_Value);
+		template<typename T> void ReadVector(std::vector<T>& p_vValues);
+		void ReadString(std::string& p_strValue);
+
+		// Moves the read position by p_uiBytes, to pass over something without reading it.
+		void Skip(const unsigned int p_uiBytes);
+
+		// For writing something whose size should be recorded ahead of it: reserves room
+		// for the size and returns where, to be passed to EndSizedBlock() afterwards.
+		unsigned int BeginSizedBlock();
+		void EndSizedBlock(const unsigned int p_uiBlockStart);
+
+	private:
+		//-----------------------------------------------------------------------------
+		// Private methods
+		//-----------------------------------------------------------------------------
+		void WriteBytes(const void* p_pBytes, const unsigned int p_uiCount);
+		void ReadBytes(void* p_pBytes, const unsigned int p_uiCount);
+
+		//-----------------------------------------------------------------------------
+		// Private members
+		//-----------------------------------------------------------------------------
+		std::vector<unsigned char> m_vData;
+		unsigned int m_uiReadPosition;
+	};
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::Write
+	//------------------------------------------------------------------------------
+	template<typename T>
+	void SceneSnapshot::Write(const T& p_Value)
+	{
+		WriteBytes(&p_Value, sizeof(T));
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::WriteVector
+	//------------------------------------------------------------------------------
+	template<typename T>
+	void SceneSnapshot::WriteVector(const std::vector<T>& p_vValues)
+	{
+		const unsigned int uiCount = p_vValues.size();
+		Write(uiCount);
+		if (uiCount > 0)
+		{
+			WriteBytes(&p_vValues[0], uiCount * sizeof(T));
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::Read
+	//------------------------------------------------------------------------------
+	template<typename T>
+	void SceneSnapshot::Read(T& p_Value)
+	{
+		ReadBytes(&p_Value, sizeof(T));
+	}
+
+	//------------------------------------------------------------------------------
+	// SceneSnapshot::ReadVector
+	//------------------------------------------------------------------------------
+	template<typename T>
+	void SceneSnapshot::ReadVector(std::vector<T>& p_vValues)
+	{
+		unsigned int uiCount = 0;
+		Read(uiCount);
+		p_vValues.resize(uiCount);
+		if (uiCount > 0)
+		{
+			ReadBytes(&p_vValues[0], uiCount * sizeof(T));
+		}
+	}
+}
+
+#endif // SCENE_SNAPSHOT_H
@@ -0,0 +1,175 @@
+//=================================================================================
+// BoundingVolumeHierarchy
+//
+// A tree of AABBs for finding which of a fixed set of boxes overlap a query box
+// without testing every one.
+//=================================================================================
+
+#include "BoundingVolumeHierarchy.h"
+#include "Collisions.h"
+
+#include <algorithm>
+
+namespace HeatStroke
+{
+	BoundingVolumeHierarchy::BoundingVolumeHierarchy()
+		:
+		m_vNodes(),
+		m_vIndices(),
+		m_vBounds(),
+		m_vStack()
+	{
+	}
+
+	void BoundingVolumeHierarchy::Build(const std::vector<AABB>& p_vBounds)
+	{
+		Clear();
+		if (p_vBounds.empty())
+		{
+			return;
+		}
+
+		m_vBounds = p_vBounds;
+		m_vIndices.resize(p_vBounds.size());
+		for (unsigned int i = 0; i < m_vIndices.size(); i++)
+		{
+			m_vIndices[i] = i;
+		}
+
+		// A binary tree with leaves of at least one box never needs more than
+		// twice as many nodes as boxes. Reserving up front keeps BuildNode() from
+		// having references into the vector moved under it.
+		m_vNodes.reserve(2 * p_vBounds.size());
+		m_vNodes.push_back(Node());
+		BuildNode(0, 0, m_vIndices.size());
+	}
+
+	void BoundingVolumeHierarchy::Clear()
+	{
+		m_vNodes.clear();
+		m_vIndices.clear();
+		m_vBounds.clear();
+	}
+
+	void BoundingVolumeHierarchy::Query(const AABB& p_mBounds, std::vector<unsigned int>& p_vHits) const
+	{
+		if (m_vNodes.empty())
+		{
+			return;
+		}
+
+		const unsigned int uiFirstHit = p_vHits.size();
+
+		m_vStack.clear();
+		m_vStack.push_back(0);
+		while (!m_vStack.empty())
+		{
+			const Node& mNode = m_vNodes[m_vStack.back()];
+			m_vStack.pop_back();
+
+			if (Collide(mNode.bounds, p_mBounds) == CTR_OUTSIDE)
+			{
+				continue;
+			}
+
+			if (mNode.count > 0)
+			{
+				for (unsigned int i = mNode.first; i < mNode.first + mNode.count; i++)
+				{
+					if (Collide(m_vBounds[m_vIndices[i]], p_mBounds) != CTR_OUTSIDE)
+					{
+						p_vHits.push_back(m_vIndices[i]);
+					}
+				}
+			}
+			else
+			{
+				m_vStack.push_back(mNode.left + 1);
+				m_vStack.push_back(mNode.left);
+			}
+		}
+
+		std::sort(p_vHits.begin() + uiFirstHit, p_vHits.end());
+	}
+
+	//------------------------------------------------------------------------------
+	// Method:    BuildNode
+	// Parameters: const unsigned int p_uiNode - The node to fill in.
+	//			   const unsigned int p_uiFirst - The first of its boxes in m_vIndices.
+	//			   const unsigned int p_uiCount - How many boxes it holds.
+	// Returns:   void
+	//
+	// Splits the boxes at the median of their centres along the longest side of
+	// their bounds, and builds each half, until few enough are left for a leaf.
+	//------------------------------------------------------------------------------
+	void BoundingVolumeHierarchy::BuildNode(const unsigned int p_uiNode, const unsigned int p_uiFirst, const unsigned int p_uiCount)
+	{
+		const AABB mBounds = ComputeBounds(p_uiFirst, p_uiCount);
+		m_vNodes[p_uiNode].bounds = mBounds;
+
+		if (p_uiCount <= LEAF_SIZE)
+		{
+			m_vNodes[p_uiNode].first = p_uiFirst;
+			m_vNodes[p_uiNode].count = p_uiCount;
+			m_vNodes[p_uiNode].left = 0;
+			return;
+		}
+
+		unsigned int uiAxis = 0;
+		if (mBounds.GetHeight() > mBounds.GetWidth() && mBounds.GetHeight() > mBounds.GetDepth())
+		{
+			uiAxis = 1;
+		}
+		else if (mBounds.GetDepth() > mBounds.GetWidth())
+		{
+			uiAxis = 2;
+		}
+
+		// Ties are broken by index so the tree doesn't depend on how the standard
+		// library orders equal elements.
+		const std::vector<AABB>& vBounds = m_vBounds;
+		const unsigned int uiHalf = p_uiCount / 2;
+		std::nth_element(
+			m_vIndices.begin() + p_uiFirst,
+			m_vIndices.begin() + p_uiFirst + uiHalf,
+			m_vIndices.begin() + p_uiFirst + p_uiCount,
+			[&vBounds, uiAxis](const unsigned int a, const unsigned int b)
+			{
+				const float fA = vBounds[a].GetCenter()[uiAxis];
+				const float fB = vBounds[b].GetCenter()[uiAxis];
+				return fA < fB || (fA == fB && a < b);
+			});
+
+		const unsigned int uiLeft = m_vNodes.size();
+		m_vNodes.push_back(Node());
+		m_vNodes.push_back(Node());
+
+		m_vNodes[p_uiNode].first = 0;
+		m_vNodes[p_uiNode].count = 0;
+		m_vNodes[p_uiNode].left = uiLeft;
+
+		BuildNode(uiLeft, p_uiFirst, uiHalf);
+		BuildNode(uiLeft + 1, p_uiFirst + uiHalf, p_uiCount - uiHalf);
+	}
+
+	AABB BoundingVolumeHierarchy::ComputeBounds(const unsigned int p_uiFirst, const unsigned int p_uiCount) const
+	{
+		const AABB& mFirst = m_vBounds[m_vIndices[p_uiFirst]];
+		float fMinX = mFirst.GetMinX(), fMaxX = mFirst.GetMaxX();
+		float fMinY = mFirst.GetMinY(), fMaxY = mFirst.GetMaxY();
+		float fMinZ = mFirst.GetMinZ(), fMaxZ = mFirst.GetMaxZ();
+
+		for (unsigned int i = p_uiFirst + 1; i < p_uiFirst + p_uiCount; i++)
+		{
+			const AABB& mBounds = m_vBounds[m_vIndices[i]];
+			fMinX = std::min(fMinX, mBounds.GetMinX());
+			fMaxX = std::max(fMaxX, mBounds.GetMaxX());
+			fMinY = std::min(fMinY, mBounds.GetMinY());
+			fMaxY = std::max(fMaxY, mBounds.GetMaxY());
+			fMinZ = std::min(fMinZ, mBounds.GetMinZ());
+			fMaxZ = std::max(fMaxZ, mBounds.GetMaxZ());
+		}
+
+		return AABB(fMinX, fMaxX, fMinY, fMaxY, fMinZ, fMaxZ);
+	}
+}
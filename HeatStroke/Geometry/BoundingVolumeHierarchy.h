@@ -0,0 +1,60 @@
+//=================================================================================
+// BoundingVolumeHierarchy
+//
+// A tree of AABBs for finding which of a fixed set of boxes overlap a query box
+// without testing every one. Built once from the whole set; meant for things
+// that don't move, like the walls of a track.
+//=================================================================================
+
+#ifndef BOUNDING_VOLUME_HIERARCHY_H
+#define BOUNDING_VOLUME_HIERARCHY_H
+
+#include <vector>
+
+#include "AABB.h"
+
+namespace HeatStroke
+{
+	class BoundingVolumeHierarchy
+	{
+	public:
+		BoundingVolumeHierarchy();
+
+		// Builds the tree over p_vBounds, replacing any tree already built. Query()
+		// reports boxes by their index in p_vBounds.
+		void Build(const std::vector<AABB>& p_vBounds);
+		void Clear();
+
+		bool empty() const { return m_vNodes.empty(); }
+
+		// Appends the indices of every box overlapping p_mBounds to p_vHits, in
+		// ascending order.
+		void Query(const AABB& p_mBounds, std::vector<unsigned int>& p_vHits) const;
+
+	private:
+		// Leaves hold up to this many boxes.
+		static const unsigned int LEAF_SIZE = 4;
+
+		// A leaf has a count, and its boxes are m_vIndices[first, first + count).
+		// Otherwise the children are at left and left + 1.
+		struct Node
+		{
+			AABB bounds;
+			unsigned int first;
+			unsigned int count;
+			unsigned int left;
+		};
+
+		std::vector<Node> m_vNodes;
+		std::vector<unsigned int> m_vIndices;
+		std::vector<AABB> m_vBounds;
+
+		// Query() is const but wants somewhere to keep its stack.
+		mutable std::vector<unsigned int> m_vStack;
+
+		void BuildNode(const unsigned int p_uiNode, const unsigned int p_uiFirst, const unsigned int p_uiCount);
+		AABB ComputeBounds(const unsigned int p_uiFirst, const unsigned int p_uiCount) const;
+	};
+}
+
+#endif // BOUNDING_VOLUME_HIERARCHY_H
@@ -236,7 +236,50 @@ namespace HeatStroke
 
 	COLLISION_TEST_RESULT Collide(const AABB& p_pA, const AABB& p_pB)
 	{
-		assert(false && "Not Implemented");
-		return CTR_OUTSIDE;
+		const float fAMinX = p_pA.GetMinX();
+		const float fAMaxX = p_pA.GetMaxX();
+		const float fAMinY = p_pA.GetMinY();
+		const float fAMaxY = p_pA.GetMaxY();
+		const float fAMinZ = p_pA.GetMinZ();
+		const float fAMaxZ = p_pA.GetMaxZ();
+
+		const float fBMinX = p_pB.GetMinX();
+		const float fBMaxX = p_pB.GetMaxX();
+		const float fBMinY = p_pB.GetMinY();
+		const float fBMaxY = p_pB.GetMaxY();
+		const float fBMinZ = p_pB.GetMinZ();
+		const float fBMaxZ = p_pB.GetMaxZ();
+
+		if
+			(
+				fAMaxX < fBMinX || fAMinX > fBMaxX
+			||	fAMaxY < fBMinY || fAMinY > fBMaxY
+			||	fAMaxZ < fBMinZ || fAMinZ > fBMaxZ
+			)
+		{
+			return CTR_OUTSIDE;
+		}
+		else if
+			(
+				fAMinX >= fBMinX && fAMaxX <= fBMaxX
+			&&	fAMinY >= fBMinY && fAMaxY <= fBMaxY
+			&&	fAMinZ >= fBMinZ && fAMaxZ <= fBMaxZ
+			)
+		{
+			return CTR_A_INSIDE_B;
+		}
+		else if
+			(
+				fBMinX >= fAMinX && fBMaxX <= fAMaxX
+			&&	fBMinY >= fAMinY && fBMaxY <= fAMaxY
+			&&	fBMinZ >= fAMinZ && fBMaxZ <= fAMaxZ
+			)
+		{
+			return CTR_B_INSIDE_A;
+		}
+		else
+		{
+			return CTR_INTERSECTING;
+		}
 	}
 }
\ No newline at end of file
@@ -6,11 +6,33 @@
 //-----------------------------------------------------------------------------
 
 #include "Model.h"
+#include "Common.h"
+
+HeatStroke::ModelData::~ModelData()
+{
+	std::map<std::string, FIBITMAP*>::iterator it = m_mTextureImages.begin(), end = m_mTextureImages.end();
+	for (; it != end; it++)
+	{
+		FreeImage_Unload(it->second);
+	}
+}
 
 HeatStroke::Model::Model(const std::string& p_mOBJFileName)
+{
+	ModelData mModelData;
+	LoadModelData(p_mOBJFileName, mModelData);
+	CreateMeshes(mModelData);
+}
+
+HeatStroke::Model::Model(ModelData& p_mModelData)
+{
+	CreateMeshes(p_mModelData);
+}
+
+void HeatStroke::Model::LoadModelData(const std::string& p_strOBJFileName, ModelData& p_mModelDataOut)
 {
 	// Load the OBJ file.
-	OBJFile mOBJFile(p_mOBJFileName);
+	OBJFile mOBJFile(p_strOBJFileName);
 	mOBJFile.ParseFile();
 
 	// Load the MTL file.
@@ -28,34 +50,72 @@ HeatStroke::Model::Model(const std::string& p_mOBJFileName)
 
 	for (; objIt != objEnd; objIt++)
 	{
+		p_mModelDataOut.m_vMeshes.push_back(ModelData::MeshData());
+		ModelData::MeshData& mMeshData = p_mModelDataOut.m_vMeshes.back();
+
 		//================================================================
 		// Vertex Data
 		//================================================================
 		// We assume for our models that every face is a triangle.
 		auto vTriangles = objIt->m_vFaces;
 
-		// Load all the data into vectors in an order that our vertex declaration (below) will expect.
-		std::vector<float> vVertexData;
-		std::vector<unsigned short> vIndexData;
-
 		// Create a map to track existing vertices for index buffer
 		VertexToIndexMap mExistingVerticesMap;
 
+		// Load all the data into vectors in an order that our vertex declaration (in CreateMeshes) will expect.
 		std::vector<OBJFile::OBJFace>::const_iterator triangleIt = vTriangles.begin(), triangleEnd = vTriangles.end();
 		for (; triangleIt != triangleEnd; triangleIt++)
 		{
-			AddToVertexData(vVertexData, vIndexData, triangleIt->m_Vert1, vPositions, vNormals, vUVs, mExistingVerticesMap);
-			AddToVertexData(vVertexData, vIndexData, triangleIt->m_Vert2, vPositions, vNormals, vUVs, mExistingVerticesMap);
-			AddToVertexData(vVertexData, vIndexData, triangleIt->m_Vert3, vPositions, vNormals, vUVs, mExistingVerticesMap);
+			AddToVertexData(mMeshData.m_vVertexData, mMeshData.m_vIndexData, triangleIt->m_Vert1, vPositions, vNormals, vUVs, mExistingVerticesMap);
+			AddToVertexData(mMeshData.m_vVertexData, mMeshData.m_vIndexData, triangleIt->m_Vert2, vPositions, vNormals, vUVs, mExistingVerticesMap);
+			AddToVertexData(mMeshData.m_vVertexData, mMeshData.m_vIndexData, triangleIt->m_Vert3, vPositions, vNormals, vUVs, mExistingVerticesMap);
+		}
+
+		//==============================================================
+		// Material Data
+		//==============================================================
+		const MTLFile::MTLMaterial* mMTLMaterial = mMTLFile.GetMaterial(objIt->m_strMaterialName);
+
+		mMeshData.m_bHasMaterial = (mMTLMaterial != nullptr);
+		if (mMTLMaterial == nullptr)
+		{
+#ifdef _DEBUG
+			assert(false && "No material by this name.");
+#endif
+		}
+		else
+		{
+			mMeshData.m_strMaterialName = mMTLMaterial->GetMaterialName();
+			mMeshData.m_strVertexShaderName = mMTLMaterial->GetVertexShaderName();
+			mMeshData.m_strFragmentShaderName = mMTLMaterial->GetFragmentShaderName();
+			mMeshData.m_strDiffuseTextureFileName = mMTLMaterial->GetDiffuseTextureFileName();
+
+			// Decode each texture once; the TextureManager will share it between meshes.
+			const std::string& strTextureFile = mMeshData.m_strDiffuseTextureFileName;
+			if (strTextureFile.find(".tga") != std::string::npos &&
+				p_mModelDataOut.m_mTextureImages.find(strTextureFile) == p_mModelDataOut.m_mTextureImages.end())
+			{
+				p_mModelDataOut.m_mTextureImages[strTextureFile] = HeatStroke::Common::LoadTGA(strTextureFile);
+			}
 		}
+	}
+}
 
-		unsigned int uiVertexDataLength = sizeof(float) * vVertexData.size();
-		unsigned int uiIndexDataLength = vIndexData.size();
+void HeatStroke::Model::CreateMeshes(ModelData& p_mModelData)
+{
+	std::vector<ModelData::MeshData>::const_iterator meshIt = p_mModelData.m_vMeshes.begin(), meshEnd = p_mModelData.m_vMeshes.end();
+	for (; meshIt != meshEnd; meshIt++)
+	{
+		//================================================================
+		// Vertex Data
+		//================================================================
+		unsigned int uiVertexDataLength = sizeof(float) * meshIt->m_vVertexData.size();
+		unsigned int uiIndexDataLength = meshIt->m_vIndexData.size();
 
 		Mesh mMesh;
 
-		mMesh.m_pVertexBuffer = HeatStroke::BufferManager::CreateVertexBuffer(&(vVertexData[0]), uiVertexDataLength);
-		mMesh.m_pIndexBuffer = HeatStroke::BufferManager::CreateIndexBuffer(&(vIndexData[0]), uiIndexDataLength);
+		mMesh.m_pVertexBuffer = HeatStroke::BufferManager::CreateVertexBuffer(&(meshIt->m_vVertexData[0]), uiVertexDataLength);
+		mMesh.m_pIndexBuffer = HeatStroke::BufferManager::CreateIndexBuffer(&(meshIt->m_vIndexData[0]), uiIndexDataLength);
 
 		mMesh.m_pVertexDeclaration = new HeatStroke::VertexDeclaration;
 		mMesh.m_pVertexDeclaration->Begin();
@@ -71,20 +131,22 @@ HeatStroke::Model::Model(const std::string& p_mOBJFileName)
 		//==============================================================
 		// Material Data
 		//==============================================================
-		const MTLFile::MTLMaterial* mMTLMaterial = mMTLFile.GetMaterial(objIt->m_strMaterialName);
-
-		if (mMTLMaterial == nullptr)
+		if (meshIt->m_bHasMaterial)
 		{
-#ifdef _DEBUG
-			assert(false && "No material by this name.");
-#endif
-		}
-		else
-		{
-			mMesh.m_pMaterial = HeatStroke::MaterialManager::CreateMaterial(mMTLMaterial->GetMaterialName());
-			mMesh.m_pMaterial->SetProgram(mMTLMaterial->GetVertexShaderName(), mMTLMaterial->GetFragmentShaderName());
-
-			mMesh.m_pTexture = HeatStroke::TextureManager::CreateTexture(mMTLMaterial->GetDiffuseTextureFileName());
+			mMesh.m_pMaterial = HeatStroke::MaterialManager::CreateMaterial(meshIt->m_strMaterialName);
+			mMesh.m_pMaterial->SetProgram(meshIt->m_strVertexShaderName, meshIt->m_strFragmentShaderName);
+
+			// The first mesh to use a decoded texture hands it over; the rest find it already loaded.
+			std::map<std::string, FIBITMAP*>::iterator image = p_mModelData.m_mTextureImages.find(meshIt->m_strDiffuseTextureFileName);
+			if (image != p_mModelData.m_mTextureImages.end())
+			{
+				mMesh.m_pTexture = HeatStroke::TextureManager::CreateTexture(image->first, image->second);
+				p_mModelData.m_mTextureImages.erase(image);
+			}
+			else
+			{
+				mMesh.m_pTexture = HeatStroke::TextureManager::CreateTexture(meshIt->m_strDiffuseTextureFileName);
+			}
 			mMesh.m_pTexture->SetWrapMode(HeatStroke::Texture::WM_Repeat);
 
 			mMesh.m_pMaterial->SetTexture("DiffuseTexture", mMesh.m_pTexture);
@@ -22,21 +22,58 @@
 
 namespace HeatStroke
 {
+	// A model's meshes as plain data: read from OBJ and MTL, with vertices merged and
+	// diffuse textures decoded, but nothing created on the GPU yet. Loading one doesn't
+	// touch GL, so it can be done away from the main thread.
+	struct ModelData
+	{
+		struct MeshData
+		{
+			std::vector<float> m_vVertexData;
+			std::vector<unsigned short> m_vIndexData;
+			bool m_bHasMaterial;
+			std::string m_strMaterialName;
+			std::string m_strVertexShaderName;
+			std::string m_strFragmentShaderName;
+			std::string m_strDiffuseTextureFileName;
+		};
+
+		std::vector<MeshData> m_vMeshes;
+
+		// Decoded diffuse textures, by file. Handed over to the TextureManager as the
+		// Model is created, and unloaded with the data if it never is.
+		std::map<std::string, FIBITMAP*> m_mTextureImages;
+
+		ModelData() : m_vMeshes(), m_mTextureImages() {}
+		~ModelData();
+
+	private:
+		// Owns its images, so shouldn't be copied.
+		ModelData(const ModelData&) = delete;
+		ModelData& operator=(const ModelData&) = delete;
+	};
+
 	class Model
 	{
 	public:
 		Model(const std::string& p_strOBJFileName);
+		Model(ModelData& p_mModelData);
 		~Model();
 
 		std::vector<Mesh>& GetMeshes() { return m_vMeshes; }
 
+		// The half of loading that doesn't need GL. Safe to call from any thread.
+		static void LoadModelData(const std::string& p_strOBJFileName, ModelData& p_mModelDataOut);
+
 	private:
 		typedef std::map<OBJFile::OBJVertex, unsigned short, OBJFile::OBJVertexComparator> VertexToIndexMap;
 
 		std::vector<Mesh> m_vMeshes;
 
+		void CreateMeshes(ModelData& p_mModelData);
+
 		// the signature of this method is gross, but it's better than having all of this code inlined
-		void AddToVertexData(
+		static void AddToVertexData(
 			std::vector<float>& p_vVertexData,
 			std::vector<unsigned short>& p_vIndexData,
 			const OBJFile::OBJVertex& p_Vertex,
@@ -98,6 +98,28 @@ HeatStroke::Model* HeatStroke::ModelManager::GetOrCreateModel(const std::string&
 	return pModel;
 }
 
+HeatStroke::Model* HeatStroke::ModelManager::CreateModel(const std::string& p_strOBJFileName, ModelData& p_mModelData)
+{
+	LoadedModels::const_iterator it = m_mLoadedModels.find(p_strOBJFileName);
+	if (it != m_mLoadedModels.end())
+	{
+		return it->second;
+	}
+
+	Model* pModel = new Model(p_mModelData);
+	m_mLoadedModels[p_strOBJFileName] = pModel;
+	return pModel;
+}
+
+void HeatStroke::ModelManager::GetLoadedModelNames(std::set<std::string>& p_sNames) const
+{
+	LoadedModels::const_iterator it = m_mLoadedModels.begin(), end = m_mLoadedModels.end();
+	for (; it != end; it++)
+	{
+		p_sNames.insert(it->first);
+	}
+}
+
 void HeatStroke::ModelManager::Flush()
 {
 	LoadedModels::iterator it = m_mLoadedModels.begin(), end = m_mLoadedModels.end();
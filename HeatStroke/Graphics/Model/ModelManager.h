@@ -15,6 +15,7 @@
 #include "EasyXML.h"
 
 #include <map>
+#include <set>
 
 namespace HeatStroke
 {
@@ -29,6 +30,15 @@ namespace HeatStroke
 		Model* GetOrCreateModel(const std::string& p_strOBJFileName);
 		void Flush();
 
+		// Finishes loading a model whose data was loaded ahead of time, possibly on
+		// another thread, by creating its GL resources. The data is discarded if the
+		// model has been loaded in the meantime.
+		Model* CreateModel(const std::string& p_strOBJFileName, ModelData& p_mModelData);
+
+		// Adds the names of all loaded models to p_sNames, so a loader thread knows
+		// which it can skip.
+		void GetLoadedModelNames(std::set<std::string>& p_sNames) const;
+
 	private:
 		static ModelManager* s_pModelManagerInstance;
 
@@ -64,6 +64,16 @@ void HeatStroke::Effect::Stop()
 	}
 }
 
+void HeatStroke::Effect::Reset()
+{
+	auto it = m_vEmitters.begin();
+	auto end = m_vEmitters.end();
+	for (; it != end; ++it)
+	{
+		(*it)->Reset();
+	}
+}
+
 void HeatStroke::Effect::ParseEmitters(tinyxml2::XMLElement* p_pEffectElement)
 {
 	tinyxml2::XMLElement* pEmitterElement = p_pEffectElement->FirstChildElement("Emitter");
@@ -20,6 +20,7 @@ namespace HeatStroke
 
 			void Start();
 			void Stop();
+			void Reset();
 
 			// TEMP - make private
 			HierarchicalTransform m_Transform;
@@ -18,6 +18,8 @@ HeatStroke::Emitter::Emitter(const std::string& p_strDefinitionFile)
 	m_pActiveHead(nullptr),
 	m_pActiveTail(nullptr),
 	m_fToSpawnAcc(0.0f),
+	m_bStartActive(false),
+	m_fStartDuration(0.0f),
 	m_Transform("blah")
 {
 	tinyxml2::XMLDocument doc;
@@ -107,14 +109,35 @@ void HeatStroke::Emitter::Stop()
 	m_bActive = false;
 }
 
+void HeatStroke::Emitter::Reset()
+{
+	while (m_pActiveHead)
+	{
+		KillParticle(m_pActiveHead);
+	}
+
+	m_bActive = m_bStartActive;
+	m_fToSpawnAcc = 0.0f;
+	if (m_bContinuous)
+	{
+		m_fDuration = m_fStartDuration;
+	}
+	else
+	{
+		GetTimeToNextBurst();
+	}
+}
+
 void HeatStroke::Emitter::InitFrequencyProperties(tinyxml2::XMLElement* p_pFrequencyPropertiesElement)
 {
 	EasyXML::GetOptionalBoolAttribute(p_pFrequencyPropertiesElement, "start_active", m_bActive, false);
 	EasyXML::GetRequiredBoolAttribute(p_pFrequencyPropertiesElement, "continuous", m_bContinuous);
+	m_bStartActive = m_bActive;
 	if (m_bContinuous)
 	{
 		EasyXML::GetRequiredFloatAttribute(p_pFrequencyPropertiesElement, "birthrate", m_fBirthRate);
 		EasyXML::GetRequiredFloatAttribute(p_pFrequencyPropertiesElement, "duration", m_fDuration);
+		m_fStartDuration = m_fDuration;
 	}
 	else
 	{
@@ -28,6 +28,10 @@ namespace HeatStroke
 			void Start();
 			void Stop();
 
+			// Kills every live particle and returns to the state the definition file
+			// started in, for effects that are recycled rather than recreated.
+			void Reset();
+
 			// TEMP - make private
 			HierarchicalTransform m_Transform;
 
@@ -52,6 +56,10 @@ namespace HeatStroke
 			float m_fDuration;
 			float m_fToSpawnAcc;
 
+			// As read from the definition file, for Reset().
+			bool m_bStartActive;
+			float m_fStartDuration;
+
 			// TODO - consider creating ParticlePool class
 			Particle* m_pFreeList;
 			Particle* m_pActiveHead;
@@ -28,6 +28,11 @@ void HeatStroke::ModelInstance::Render(const SceneCamera* p_pCamera)
 	glm::mat4 mWorldViewProjectionTransform = p_pCamera->GetProjectionMatrix() * mWorldViewTransform;
 	glm::mat3 mWorldInverseTransposeTransform = glm::transpose(glm::inverse(glm::mat3(m_mWorldTransform)));
 
+	RenderWithTransforms(mWorldViewProjectionTransform, mWorldInverseTransposeTransform);
+}
+
+void HeatStroke::ModelInstance::RenderWithTransforms(const glm::mat4& p_mWorldViewProjectionTransform, const glm::mat3& p_mWorldInverseTransposeTransform)
+{
 	std::vector<Mesh> vMeshes = m_pModel->GetMeshes();
 	std::vector<Mesh>::const_iterator meshIt = vMeshes.begin(), meshEnd = vMeshes.end();
 	for (; meshIt != meshEnd; meshIt++)
@@ -35,8 +40,8 @@ void HeatStroke::ModelInstance::Render(const SceneCamera* p_pCamera)
 		meshIt->m_pVertexDeclaration->Bind();
 
 		meshIt->m_pMaterial->SetUniform("WorldTransform", m_mWorldTransform);
-		meshIt->m_pMaterial->SetUniform("WorldViewProjectionTransform", mWorldViewProjectionTransform);
-		meshIt->m_pMaterial->SetUniform("WorldInverseTransposeTransform", mWorldInverseTransposeTransform);
+		meshIt->m_pMaterial->SetUniform("WorldViewProjectionTransform", p_mWorldViewProjectionTransform);
+		meshIt->m_pMaterial->SetUniform("WorldInverseTransposeTransform", p_mWorldInverseTransposeTransform);
 
 		meshIt->m_pMaterial->Apply();
 
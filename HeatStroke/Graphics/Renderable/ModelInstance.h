@@ -21,6 +21,10 @@ namespace HeatStroke
 
 		virtual void Render(const SceneCamera* p_pCamera = nullptr) override;
 
+		// Renders with transforms the caller has already worked out from the world
+		// transform, as SceneManager does for all its models at once.
+		void RenderWithTransforms(const glm::mat4& p_mWorldViewProjectionTransform, const glm::mat3& p_mWorldInverseTransposeTransform);
+
 		Model*		GetModel()											{ return m_pModel; }
 
 		void		SetTransform(const glm::mat4& p_mWorldTransform)	{ m_mWorldTransform = p_mWorldTransform; }
@@ -55,6 +55,19 @@ namespace HeatStroke
 		SetWrapMode(WM_Clamp);
 	}
 
+	//----------------------------------------------------------
+	// Constructor taking in an image already decoded from file,
+	// which it unloads once uploaded
+	//----------------------------------------------------------
+	Texture::Texture(FIBITMAP* p_pImage)
+		: m_eFilterMin(Texture::FM_Invalid), m_eFilterMag(Texture::FM_Invalid),
+		  m_eWrapU(Texture::WM_Invalid), m_eWrapV(Texture::WM_Invalid),
+		  m_uiWidth(0), m_uiHeight(0), m_uiTex(0)
+	{
+		LoadFromImage(p_pImage);
+		SetWrapMode(WM_Clamp);
+	}
+
 	//----------------------------------------------------------
 	// Constructor taking in data already in ram
 	//----------------------------------------------------------
@@ -111,6 +124,15 @@ namespace HeatStroke
 	// are automatically generated
 	//----------------------------------------------------------
 	void Texture::LoadFromTGA(const std::string& p_strFile)
+	{
+		LoadFromImage(HeatStroke::Common::LoadTGA(p_strFile));
+	}
+
+	//----------------------------------------------------------
+	// Builds the texture from a 32 bit image, then unloads the
+	// image. Mipmap levels are automatically generated
+	//----------------------------------------------------------
+	void Texture::LoadFromImage(FIBITMAP* p_pImage)
 	{
 		glGenTextures(1,&m_uiTex);
 		GL_CHECK_ERROR(__FILE__, __LINE__);
@@ -118,24 +140,22 @@ namespace HeatStroke
 		glBindTexture(GL_TEXTURE_2D, m_uiTex);
 		GL_CHECK_ERROR(__FILE__, __LINE__);
 
-		FIBITMAP* image = HeatStroke::Common::LoadTGA(p_strFile);
-
 		glTexImage2D(GL_TEXTURE_2D, 
 			0, 
 			GL_RGBA, 
-			FreeImage_GetWidth(image), 
-			FreeImage_GetHeight(image), 
+			FreeImage_GetWidth(p_pImage), 
+			FreeImage_GetHeight(p_pImage), 
 			0, 
 			GL_BGRA,
 			GL_UNSIGNED_BYTE, 
-			FreeImage_GetBits(image)
+			FreeImage_GetBits(p_pImage)
 		);
 		GL_CHECK_ERROR(__FILE__, __LINE__);
     
-		m_uiWidth = FreeImage_GetWidth(image);
-		m_uiHeight = FreeImage_GetHeight(image);
+		m_uiWidth = FreeImage_GetWidth(p_pImage);
+		m_uiHeight = FreeImage_GetHeight(p_pImage);
 
-		FreeImage_Unload(image);
+		FreeImage_Unload(p_pImage);
 
 		glGenerateMipmap(GL_TEXTURE_2D);
 		GL_CHECK_ERROR(__FILE__, __LINE__);
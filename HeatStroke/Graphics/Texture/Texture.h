@@ -10,6 +10,8 @@
 #include "Types.h"
 #include <string>
 
+struct FIBITMAP;
+
 namespace HeatStroke
 {
 	class Texture
@@ -69,9 +71,11 @@ namespace HeatStroke
 		// Made private to enforce creation/destruction via TextureManager
 		Texture(const std::string& p_strFile);
 		Texture(void* p_pData, unsigned int p_uiWidth, unsigned int p_uiHeight, Format p_eFormat);
+		Texture(FIBITMAP* p_pImage);
 		virtual ~Texture();
 
 		void LoadFromTGA(const std::string& p_strFile);
+		void LoadFromImage(FIBITMAP* p_pImage);
 	};
 }
 
@@ -5,6 +5,7 @@
 // See header for notes
 //-----------------------------------------------------------------------------
 #include "TextureManager.h"
+#include "Common.h"
 
 namespace HeatStroke
 {
@@ -31,6 +32,28 @@ Texture* TextureManager::CreateTexture(const std::string& p_strFile)
 	return pTex;
 }
 
+//----------------------------------------------------------
+// As above, but with the file already decoded (e.g. on a loader
+// thread). The image is uploaded if the file isn't loaded yet,
+// and unloaded either way
+//----------------------------------------------------------
+Texture* TextureManager::CreateTexture(const std::string& p_strFile, FIBITMAP* p_pImage)
+{
+	std::map<std::string, Entry*>::iterator iter = m_textures.find(p_strFile);
+
+	if( iter != m_textures.end() )
+	{
+		FreeImage_Unload(p_pImage);
+		iter->second->m_iRefCount++;
+		return iter->second->m_pTex;
+	}
+
+	Texture* pTex = new Texture(p_pImage);
+	Entry* pEntry = new Entry(pTex);
+	m_textures[p_strFile] = pEntry;
+	return pTex;
+}
+
 //----------------------------------------------------------
 // When creating directly from data, we don't check for duplicates
 // and just delegate directly to the texture class
@@ -23,6 +23,7 @@ class TextureManager
 		// PUBLIC INTERFACE
 		//-------------------------------------------------------------------------
 		static Texture* CreateTexture(const std::string& p_strFile);
+		static Texture* CreateTexture(const std::string& p_strFile, FIBITMAP* p_pImage);
 		static Texture* CreateTexture(void* p_pData, unsigned int p_uiWidth, unsigned int p_uiHeight, Texture::Format p_eFormat);
 		static void DestroyTexture(Texture* p_pTex);
 
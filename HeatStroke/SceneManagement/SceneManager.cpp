@@ -7,6 +7,7 @@
 //------------------------------------------------------------------------
 
 #include "SceneManager.h"
+#include "SIMDMath.h"
 
 HeatStroke::SceneManager* HeatStroke::SceneManager::s_pSceneManagerInstance = nullptr;
 
@@ -258,6 +259,8 @@ void HeatStroke::SceneManager::Render()
 	int halfWidth = width / 2;
 	int halfHeight = height / 2;
 
+	PrepareModelTransforms();
+
 	if (m_lPerspectiveCameras[SVS_FULL] != nullptr || m_lOrthographicCameras[SVS_FULL] != nullptr)
 	{
 		glViewport(0, 0, width, height);
@@ -385,19 +388,43 @@ void HeatStroke::SceneManager::Render()
 	}
 }
 
-void HeatStroke::SceneManager::RenderModels(const ScenePerspectiveCamera* p_pPerspectiveCamera)
+// Gathers the models' world transforms and works out all their normal transforms in
+// one batch. They don't depend on the camera, so every viewport shares them.
+void HeatStroke::SceneManager::PrepareModelTransforms()
 {
-	ModelList::iterator it = m_lModelList.begin(), end = m_lModelList.end();
-	for (; it != end; ++it)
+	const unsigned int uiCount = m_lModelList.size();
+	m_vModelTransforms.resize(uiCount);
+	m_vModelInverseTransposeTransforms.resize(uiCount);
+	m_vModelViewProjectionTransforms.resize(uiCount);
+
+	for (unsigned int i = 0; i < uiCount; ++i)
+	{
+		m_vModelTransforms[i] = m_lModelList[i]->GetTransform();
+	}
+
+	if (uiCount > 0)
 	{
-		RenderModel(*it, p_pPerspectiveCamera);
+		SIMDMath::InverseTransposeBatch(&m_vModelTransforms[0], &m_vModelInverseTransposeTransforms[0], uiCount);
 	}
 }
 
-void HeatStroke::SceneManager::RenderModel(ModelInstance* p_pModelInstance, const ScenePerspectiveCamera* p_pPerspectiveCamera)
+void HeatStroke::SceneManager::RenderModels(const ScenePerspectiveCamera* p_pPerspectiveCamera)
 {
-	SetModelLights(p_pModelInstance);
-	p_pModelInstance->Render(p_pPerspectiveCamera);
+	const unsigned int uiCount = m_lModelList.size();
+	if (uiCount == 0)
+	{
+		return;
+	}
+
+	// The batch multiplies pairs, so the camera's transform is repeated for each model.
+	m_vViewProjectionTransforms.assign(uiCount, p_pPerspectiveCamera->GetProjectionMatrix() * p_pPerspectiveCamera->GetViewMatrix());
+	SIMDMath::MultiplyBatch(&m_vViewProjectionTransforms[0], &m_vModelTransforms[0], &m_vModelViewProjectionTransforms[0], uiCount);
+
+	for (unsigned int i = 0; i < uiCount; ++i)
+	{
+		SetModelLights(m_lModelList[i]);
+		m_lModelList[i]->RenderWithTransforms(m_vModelViewProjectionTransforms[i], m_vModelInverseTransposeTransforms[i]);
+	}
 }
 
 void HeatStroke::SceneManager::RenderParticleEffects(const ScenePerspectiveCamera* p_pPerspectiveCamera)
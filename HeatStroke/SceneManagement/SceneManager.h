@@ -123,13 +123,20 @@ namespace HeatStroke
 		DirectionalLightList	m_lDirectionalLightList;
 		PointLightList			m_lPointLightList;
 
+		// Scratch space for RenderModels(), indexed like m_lModelList. The normal
+		// transforms are worked out once a frame; the others once per camera.
+		std::vector<glm::mat4>	m_vModelTransforms;
+		std::vector<glm::mat3>	m_vModelInverseTransposeTransforms;
+		std::vector<glm::mat4>	m_vViewProjectionTransforms;
+		std::vector<glm::mat4>	m_vModelViewProjectionTransforms;
+
 	private:
 		SceneManager(GLFWwindow* p_pWindow);
 
 		virtual ~SceneManager() {}
 
+		void PrepareModelTransforms();
 		void RenderModels(const ScenePerspectiveCamera* p_pPerspectiveCamera);
-		void RenderModel(ModelInstance* p_pModelInstance, const ScenePerspectiveCamera* p_pPerspectiveCamera);
 		void RenderParticleEffects(const ScenePerspectiveCamera* p_pPerspectiveCamera);
 		void SetModelLights(ModelInstance* p_pModelInstance);
 		void SetMeshLights(ModelInstance* p_pModelInstance, Mesh* p_pMesh);
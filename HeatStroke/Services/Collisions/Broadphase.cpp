@@ -0,0 +1,109 @@
+//------------------------------------------------------------------------
+// Broadphase
+//
+// Interface for finding which colliders are close enough that the
+// CollisionManager should test them properly.
+//------------------------------------------------------------------------
+
+#include "Broadphase.h"
+#include "BroadphaseAllPairs.h"
+#include "BroadphaseSweepAndPrune.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+
+using namespace HeatStroke;
+
+namespace
+{
+	// Sizes the benchmark uses for the track and spheres, roughly those of the
+	// game, and how much track each sphere gets so they stay as crowded at every
+	// count.
+	const float BENCHMARK_TRACK_WIDTH = 30.0f;
+	const float BENCHMARK_TRACK_LENGTH_PER_SPHERE = 3.0f;
+	const float BENCHMARK_SPHERE_EXTENT = 2.0f;
+
+	BroadphaseProxy MakeProxy(const float p_fX, const float p_fZ, const float p_fExtent)
+	{
+		BroadphaseProxy mProxy;
+		mProxy.minX = p_fX - p_fExtent;
+		mProxy.maxX = p_fX + p_fExtent;
+		mProxy.minZ = p_fZ - p_fExtent;
+		mProxy.maxZ = p_fZ + p_fExtent;
+		return mProxy;
+	}
+
+	// Runs FindPairs() p_uiIterations times, moving the spheres a little between
+	// calls, half one way and half the other so they pass each other, and returns
+	// the average microseconds per call.
+	double TimeBroadphase(Broadphase& p_mBroadphase, std::vector<BroadphaseProxy> p_vProxies, const unsigned int p_uiIterations, std::vector<BroadphasePair>& p_vPairs)
+	{
+		double dSeconds = 0.0;
+		for (unsigned int i = 0; i < p_uiIterations; i++)
+		{
+			const float fStep = (i % 2 == 0 ? 0.1f : -0.1f);
+			for (unsigned int j = 0; j < p_vProxies.size(); j++)
+			{
+				const float fMove = (j % 2 == 0 ? fStep : -fStep);
+				p_vProxies[j].minX += fMove;
+				p_vProxies[j].maxX += fMove;
+			}
+
+			const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+			p_mBroadphase.FindPairs(p_vProxies, p_vPairs);
+			dSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		}
+		return dSeconds / p_uiIterations * 1000000.0;
+	}
+}
+
+void Broadphase::RunBenchmark()
+{
+	const unsigned int auiCounts[] = { 10, 100, 1000, 10000 };
+
+	printf("Broadphase benchmark: moving spheres around a circular track\n");
+	printf("%10s %10s %16s %16s %10s\n", "Colliders", "Pairs", "All pairs (us)", "Sweep (us)", "Speedup");
+
+	for (unsigned int c = 0; c < sizeof(auiCounts) / sizeof(auiCounts[0]); c++)
+	{
+		const unsigned int uiCount = auiCounts[c];
+
+		// Spheres spread at random around the track, which is how karts, shells
+		// and pickups end up in the CollisionManager's list.
+		std::vector<BroadphaseProxy> vProxies;
+		std::mt19937 rng(483);
+		const float fInnerRadius = uiCount * BENCHMARK_TRACK_LENGTH_PER_SPHERE / 6.2831853f + 10.0f;
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		std::uniform_real_distribution<float> offset(0.0f, BENCHMARK_TRACK_WIDTH);
+		for (unsigned int i = 0; i < uiCount; i++)
+		{
+			const float fAngle = angle(rng);
+			const float fRadius = fInnerRadius + offset(rng);
+			vProxies.push_back(MakeProxy(cosf(fAngle) * fRadius, sinf(fAngle) * fRadius, BENCHMARK_SPHERE_EXTENT));
+		}
+
+		// Enough iterations to time, without the quadratic case taking all day.
+		const unsigned int uiAllPairsIterations = std::max(1u, 20000000u / (uiCount * uiCount));
+		const unsigned int uiSweepIterations = std::max(10u, 2000000u / uiCount);
+
+		BroadphaseAllPairs mAllPairs;
+		BroadphaseSweepAndPrune mSweepAndPrune;
+		std::vector<BroadphasePair> vAllPairs, vSweepPairs;
+
+		// Both start from the same positions and make the same moves, so after an
+		// even number of calls they should have found the same pairs.
+		const double dAllPairs = TimeBroadphase(mAllPairs, vProxies, uiAllPairsIterations + uiAllPairsIterations % 2, vAllPairs);
+		const double dSweep = TimeBroadphase(mSweepAndPrune, vProxies, uiSweepIterations + uiSweepIterations % 2, vSweepPairs);
+
+		printf("%10u %10u %16.2f %16.2f %9.1fx%s\n",
+			uiCount,
+			static_cast<unsigned int>(vSweepPairs.size()),
+			dAllPairs,
+			dSweep,
+			dAllPairs / dSweep,
+			vAllPairs == vSweepPairs ? "" : "  MISMATCH");
+	}
+}
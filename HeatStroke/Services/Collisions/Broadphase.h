@@ -0,0 +1,57 @@
+//------------------------------------------------------------------------
+// Broadphase
+//
+// Interface for finding which colliders are close enough that the
+// CollisionManager should test them properly.
+//------------------------------------------------------------------------
+
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <utility>
+#include <vector>
+
+namespace HeatStroke
+{
+	// A collider's bounds on the XZ plane. Colliders are tested on XZ only,
+	// since the track is laid out flat and walls are vertical.
+	struct BroadphaseProxy
+	{
+		float minX;
+		float maxX;
+		float minZ;
+		float maxZ;
+	};
+
+	// Indices of two proxies, the lower one first.
+	typedef std::pair<unsigned int, unsigned int> BroadphasePair;
+
+	class Broadphase
+	{
+	public:
+		virtual ~Broadphase() {}
+
+		// Fills p_vPairs with every pair of proxies whose bounds overlap. The pairs
+		// are sorted, so they come out in the same order as a nested loop over the
+		// proxies would visit them.
+		virtual void FindPairs(const std::vector<BroadphaseProxy>& p_vProxies, std::vector<BroadphasePair>& p_vPairs) = 0;
+
+		virtual const char* GetName() const = 0;
+
+		// Times FindPairs() for the all-pairs and sweep-and-prune broadphases from
+		// 10 to 10,000 moving spheres spread around a circular track, as the
+		// CollisionManager hands them over; walls are in the track's BVH and never
+		// reach the broadphase. Prints the time per call and the number of pairs
+		// found to stdout, and checks that both find the same pairs.
+		static void RunBenchmark();
+
+	protected:
+		static bool Overlap(const BroadphaseProxy& p_mA, const BroadphaseProxy& p_mB)
+		{
+			return p_mA.minX <= p_mB.maxX && p_mB.minX <= p_mA.maxX &&
+				p_mA.minZ <= p_mB.maxZ && p_mB.minZ <= p_mA.maxZ;
+		}
+	};
+}
+
+#endif // BROADPHASE_H
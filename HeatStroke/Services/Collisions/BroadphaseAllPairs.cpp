@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------
+// BroadphaseAllPairs
+//
+// Tests the bounds of every pair of colliders. Quadratic in the number of
+// colliders; kept as the reference the other broadphases are checked and
+// timed against.
+//------------------------------------------------------------------------
+
+#include "BroadphaseAllPairs.h"
+
+using namespace HeatStroke;
+
+void BroadphaseAllPairs::FindPairs(const std::vector<BroadphaseProxy>& p_vProxies, std::vector<BroadphasePair>& p_vPairs)
+{
+	p_vPairs.clear();
+
+	const unsigned int uiCount = p_vProxies.size();
+	for (unsigned int i = 0; i < uiCount; i++)
+	{
+		for (unsigned int j = i + 1; j < uiCount; j++)
+		{
+			if (Overlap(p_vProxies[i], p_vProxies[j]))
+			{
+				p_vPairs.push_back(BroadphasePair(i, j));
+			}
+		}
+	}
+}
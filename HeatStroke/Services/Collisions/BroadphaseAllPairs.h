@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------
+// BroadphaseAllPairs
+//
+// Tests the bounds of every pair of colliders. Quadratic in the number of
+// colliders; kept as the reference the other broadphases are checked and
+// timed against.
+//------------------------------------------------------------------------
+
+#ifndef BROADPHASE_ALL_PAIRS_H
+#define BROADPHASE_ALL_PAIRS_H
+
+#include "Broadphase.h"
+
+namespace HeatStroke
+{
+	class BroadphaseAllPairs : public Broadphase
+	{
+	public:
+		BroadphaseAllPairs() {}
+		virtual ~BroadphaseAllPairs() {}
+
+		virtual void FindPairs(const std::vector<BroadphaseProxy>& p_vProxies, std::vector<BroadphasePair>& p_vPairs) override;
+
+		virtual const char* GetName() const override { return "All pairs"; }
+	};
+}
+
+#endif // BROADPHASE_ALL_PAIRS_H
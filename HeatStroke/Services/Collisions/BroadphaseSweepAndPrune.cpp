@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------
+// BroadphaseSweepAndPrune
+//
+// Sorts the colliders along X and sweeps across them, so only colliders
+// which overlap on X are ever compared.
+//------------------------------------------------------------------------
+
+#include "BroadphaseSweepAndPrune.h"
+
+#include <algorithm>
+
+using namespace HeatStroke;
+
+BroadphaseSweepAndPrune::BroadphaseSweepAndPrune()
+	:
+	m_vOrder(),
+	m_vActive()
+{
+}
+
+void BroadphaseSweepAndPrune::FindPairs(const std::vector<BroadphaseProxy>& p_vProxies, std::vector<BroadphasePair>& p_vPairs)
+{
+	p_vPairs.clear();
+	m_vActive.clear();
+
+	SortOrder(p_vProxies);
+
+	// Every active proxy starts at or before the current one along X, so it
+	// overlaps the current one on X as long as it hasn't ended yet. Proxies that
+	// have ended are dropped as the list is walked.
+	const unsigned int uiCount = m_vOrder.size();
+	for (unsigned int k = 0; k < uiCount; k++)
+	{
+		const unsigned int uiIndex = m_vOrder[k];
+		const BroadphaseProxy& mProxy = p_vProxies[uiIndex];
+
+		for (unsigned int a = 0; a < m_vActive.size();)
+		{
+			const BroadphaseProxy& mActive = p_vProxies[m_vActive[a]];
+			if (mActive.maxX < mProxy.minX)
+			{
+				m_vActive[a] = m_vActive.back();
+				m_vActive.pop_back();
+				continue;
+			}
+
+			if (mActive.minZ <= mProxy.maxZ && mProxy.minZ <= mActive.maxZ)
+			{
+				AddPair(m_vActive[a], uiIndex, p_vPairs);
+			}
+			a++;
+		}
+
+		m_vActive.push_back(uiIndex);
+	}
+
+	std::sort(p_vPairs.begin(), p_vPairs.end());
+}
+
+void BroadphaseSweepAndPrune::SortOrder(const std::vector<BroadphaseProxy>& p_vProxies)
+{
+	const unsigned int uiCount = p_vProxies.size();
+
+	// A collider was added or removed, so the old order no longer matches the
+	// indices. Start again.
+	if (m_vOrder.size() != uiCount)
+	{
+		m_vOrder.resize(uiCount);
+		for (unsigned int i = 0; i < uiCount; i++)
+		{
+			m_vOrder[i] = i;
+		}
+
+		std::sort(m_vOrder.begin(), m_vOrder.end(), [&p_vProxies](const unsigned int a, const unsigned int b)
+		{
+			return p_vProxies[a].minX < p_vProxies[b].minX;
+		});
+		return;
+	}
+
+	// Otherwise the order from last time is nearly right.
+	for (unsigned int i = 1; i < uiCount; i++)
+	{
+		const unsigned int uiIndex = m_vOrder[i];
+		const float fMinX = p_vProxies[uiIndex].minX;
+
+		unsigned int j = i;
+		while (j > 0 && p_vProxies[m_vOrder[j - 1]].minX > fMinX)
+		{
+			m_vOrder[j] = m_vOrder[j - 1];
+			j--;
+		}
+		m_vOrder[j] = uiIndex;
+	}
+}
+
+void BroadphaseSweepAndPrune::AddPair(const unsigned int p_uiA, const unsigned int p_uiB, std::vector<BroadphasePair>& p_vPairs)
+{
+	if (p_uiA < p_uiB)
+	{
+		p_vPairs.push_back(BroadphasePair(p_uiA, p_uiB));
+	}
+	else
+	{
+		p_vPairs.push_back(BroadphasePair(p_uiB, p_uiA));
+	}
+}
@@ -0,0 +1,42 @@
+//------------------------------------------------------------------------
+// BroadphaseSweepAndPrune
+//
+// Sorts the colliders along X and sweeps across them, so only colliders
+// which overlap on X are ever compared.
+//
+// The sort order is kept between calls. Colliders move a little each
+// frame, so the order is nearly right already and an insertion sort puts
+// it back in close to linear time.
+//------------------------------------------------------------------------
+
+#ifndef BROADPHASE_SWEEP_AND_PRUNE_H
+#define BROADPHASE_SWEEP_AND_PRUNE_H
+
+#include "Broadphase.h"
+
+namespace HeatStroke
+{
+	class BroadphaseSweepAndPrune : public Broadphase
+	{
+	public:
+		BroadphaseSweepAndPrune();
+		virtual ~BroadphaseSweepAndPrune() {}
+
+		virtual void FindPairs(const std::vector<BroadphaseProxy>& p_vProxies, std::vector<BroadphasePair>& p_vPairs) override;
+
+		virtual const char* GetName() const override { return "Sweep and prune"; }
+
+	private:
+		// Proxy indices sorted by minX, from the last call.
+		std::vector<unsigned int> m_vOrder;
+
+		// Proxies whose X range the sweep is still inside.
+		std::vector<unsigned int> m_vActive;
+
+		void SortOrder(const std::vector<BroadphaseProxy>& p_vProxies);
+
+		static void AddPair(const unsigned int p_uiA, const unsigned int p_uiB, std::vector<BroadphasePair>& p_vPairs);
+	};
+}
+
+#endif // BROADPHASE_SWEEP_AND_PRUNE_H
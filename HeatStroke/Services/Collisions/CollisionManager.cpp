@@ -8,9 +8,108 @@
 #include "CollisionManager.h"
 
 #include "EventManager.h"
+#include "BroadphaseSweepAndPrune.h"
+#include "JobSystem.h"
+
+#include <algorithm>
 
 using namespace HeatStroke;
 
+namespace
+{
+	glm::vec2 ClosestPointOnSegment(const glm::vec2& p_vPoint, const glm::vec2& p_vA, const glm::vec2& p_vB)
+	{
+		const glm::vec2 vAB = p_vB - p_vA;
+		const float fLengthSquared = glm::dot(vAB, vAB);
+		if (fLengthSquared <= 0.0f)
+		{
+			return p_vA;
+		}
+
+		const float t = glm::clamp(glm::dot(p_vPoint - p_vA, vAB) / fLengthSquared, 0.0f, 1.0f);
+		return p_vA + vAB * t;
+	}
+
+	//------------------------------------------------------------------------------
+	// Method:    SweepCircleSegment
+	// Parameters: p_vStart, p_vEnd - Where the circle's centre moves from and to.
+	//			   p_fRadius - The circle's radius.
+	//			   p_vA, p_vB - The ends of the segment.
+	//			   p_fTime - Set to how far along the move, from 0 to 1, it first touches.
+	//			   p_vContact - Set to the point on the segment it first touches.
+	// Returns:   bool - Whether it touches at all.
+	//
+	// Everywhere within the radius of the segment is a capsule: two lines parallel
+	// to it, capped by a circle at each end. The earliest the centre enters any of
+	// those is the time of impact. A circle already touching it does so at 0.
+	//------------------------------------------------------------------------------
+	bool SweepCircleSegment(const glm::vec2& p_vStart, const glm::vec2& p_vEnd, const float p_fRadius, const glm::vec2& p_vA, const glm::vec2& p_vB, float& p_fTime, glm::vec2& p_vContact)
+	{
+		const glm::vec2 vClosest = ClosestPointOnSegment(p_vStart, p_vA, p_vB);
+		if (glm::dot(p_vStart - vClosest, p_vStart - vClosest) <= p_fRadius * p_fRadius)
+		{
+			p_fTime = 0.0f;
+			p_vContact = vClosest;
+			return true;
+		}
+
+		const glm::vec2 vMove = p_vEnd - p_vStart;
+		bool bHit = false;
+		p_fTime = 1.0f;
+
+		// The sides. Starting outside the capsule, the centre can only reach the
+		// side facing it.
+		const float fLength = glm::length(p_vB - p_vA);
+		if (fLength > 0.0f)
+		{
+			const glm::vec2 vAlong = (p_vB - p_vA) / fLength;
+			const glm::vec2 vAcross(-vAlong.y, vAlong.x);
+			const float fStartDistance = glm::dot(p_vStart - p_vA, vAcross);
+			const float fEndDistance = glm::dot(p_vEnd - p_vA, vAcross);
+			const float fSide = (fStartDistance > 0.0f ? p_fRadius : -p_fRadius);
+			if (fStartDistance != fEndDistance && fabsf(fStartDistance) > p_fRadius)
+			{
+				const float t = (fStartDistance - fSide) / (fStartDistance - fEndDistance);
+				if (t >= 0.0f && t <= p_fTime)
+				{
+					const float fAlong = glm::dot(p_vStart + vMove * t - p_vA, vAlong);
+					if (fAlong >= 0.0f && fAlong <= fLength)
+					{
+						p_fTime = t;
+						p_vContact = p_vA + vAlong * fAlong;
+						bHit = true;
+					}
+				}
+			}
+		}
+
+		// The ends, as circles of the same radius
+		const glm::vec2* apEnds[] = { &p_vA, &p_vB };
+		const float a = glm::dot(vMove, vMove);
+		for (unsigned int i = 0; i < 2 && a > 0.0f; i++)
+		{
+			const glm::vec2 vFromEnd = p_vStart - *apEnds[i];
+			const float b = glm::dot(vFromEnd, vMove);
+			const float c = glm::dot(vFromEnd, vFromEnd) - p_fRadius * p_fRadius;
+			const float fDiscriminant = b * b - a * c;
+			if (fDiscriminant < 0.0f)
+			{
+				continue;
+			}
+
+			const float t = (-b - sqrtf(fDiscriminant)) / a;
+			if (t >= 0.0f && t <= p_fTime)
+			{
+				p_fTime = t;
+				p_vContact = *apEnds[i];
+				bHit = true;
+			}
+		}
+
+		return bHit;
+	}
+}
+
 CollisionManager* CollisionManager::s_pCollisionManagerInstance = nullptr;
 
 void CollisionManager::CreateInstance()
@@ -35,12 +134,49 @@ CollisionManager* CollisionManager::Instance()
 CollisionManager::CollisionManager()
 	:
 	m_mColliderMap(),
-	m_iEffectIndex(0)
+	m_iEffectIndex(0),
+	m_uiCollisionEnterEventID(EventTypeRegistry::Intern("CollisionEnter")),
+	m_uiCollisionStayEventID(EventTypeRegistry::Intern("CollisionStay")),
+	m_uiCollisionExitEventID(EventTypeRegistry::Intern("CollisionExit")),
+	m_uiObject1HandleID(EventTypeRegistry::InternParameter("Object1Handle")),
+	m_uiObject2HandleID(EventTypeRegistry::InternParameter("Object2Handle")),
+	m_uiContactPointXID(EventTypeRegistry::InternParameter("ContactPointX")),
+	m_uiContactPointYID(EventTypeRegistry::InternParameter("ContactPointY")),
+	m_uiContactPointZID(EventTypeRegistry::InternParameter("ContactPointZ")),
+	m_uiNormalXID(EventTypeRegistry::InternParameter("NormalX")),
+	m_uiNormalZID(EventTypeRegistry::InternParameter("NormalZ")),
+	m_uiPassedThroughID(EventTypeRegistry::InternParameter("PassedThrough")),
+	m_uiImpactXID(EventTypeRegistry::InternParameter("ImpactX")),
+	m_uiImpactYID(EventTypeRegistry::InternParameter("ImpactY")),
+	m_uiImpactZID(EventTypeRegistry::InternParameter("ImpactZ")),
+	m_vContactPairs(),
+	m_vNewContactPairs(),
+	m_vDynamicColliders(),
+	m_vStaticColliders(),
+	m_mStaticBVH(),
+	m_bStaticBVHDirty(false),
+	m_pBroadphase(new BroadphaseSweepAndPrune()),
+	m_vColliders(),
+	m_vProxies(),
+	m_vPairs(),
+	m_vStaticHits(),
+	m_bParallelNarrowphase(true),
+	m_vCandidates(),
+	m_vContactBuffers()
 {
 }
 
 CollisionManager::~CollisionManager()
 {
+	delete m_pBroadphase;
+	m_pBroadphase = nullptr;
+}
+
+void CollisionManager::SetBroadphase(Broadphase* p_pBroadphase)
+{
+	assert(p_pBroadphase != nullptr);
+	delete m_pBroadphase;
+	m_pBroadphase = p_pBroadphase;
 }
 
 void CollisionManager::RegisterCollider(ComponentCollider* p_pCollider, std::string p_strGuid = "")
@@ -49,6 +185,9 @@ void CollisionManager::RegisterCollider(ComponentCollider* p_pCollider, std::str
 
 	RegisteredCollider collider;
 	collider.collider = p_pCollider;
+	collider.type = Sphere;
+	collider.transformVersion = 0;
+	collider.hasPreviousPosition = false;
 
 	if (p_pCollider->ComponentID().compare("GOC_SphereCollider") == 0)
 	{
@@ -59,236 +198,493 @@ void CollisionManager::RegisterCollider(ComponentCollider* p_pCollider, std::str
 		collider.type = Wall;
 	}
 
-	m_mColliderMap.insert(std::pair<std::string, RegisteredCollider>(p_strGuid, collider));
+	std::pair<ColliderMap::iterator, bool> inserted = m_mColliderMap.insert(std::pair<std::string, RegisteredCollider>(p_strGuid, collider));
+	if (!inserted.second)
+	{
+		return;
+	}
+
+	if (IsStatic(collider))
+	{
+		m_bStaticBVHDirty = true;
+	}
+	else
+	{
+		std::vector<ColliderMap::iterator>::iterator position = std::lower_bound(m_vDynamicColliders.begin(), m_vDynamicColliders.end(), inserted.first,
+			[](const ColliderMap::iterator& a, const ColliderMap::iterator& b) { return a->first < b->first; });
+		m_vDynamicColliders.insert(position, inserted.first);
+	}
+}
+
+void CollisionManager::UnregisterCollider(std::string p_strGuid)
+{
+	ColliderMap::iterator it = m_mColliderMap.find(p_strGuid);
+	if (it == m_mColliderMap.end())
+	{
+		return;
+	}
+
+	if (IsStatic(it->second))
+	{
+		m_bStaticBVHDirty = true;
+	}
+	else
+	{
+		m_vDynamicColliders.erase(std::find(m_vDynamicColliders.begin(), m_vDynamicColliders.end(), it));
+	}
+
+	m_mColliderMap.erase(it);
+}
+
+void CollisionManager::ResetSweep(const std::string& p_strGuid)
+{
+	ColliderMap::iterator it = m_mColliderMap.find(p_strGuid);
+	if (it != m_mColliderMap.end())
+	{
+		it->second.hasPreviousPosition = false;
+	}
+}
+
+void CollisionManager::ResetAllSweeps()
+{
+	for (unsigned int i = 0; i < m_vDynamicColliders.size(); i++)
+	{
+		m_vDynamicColliders[i]->second.hasPreviousPosition = false;
+	}
+}
+
+void CollisionManager::ResetContacts()
+{
+	m_vContactPairs.clear();
+	m_vNewContactPairs.clear();
 }
 
 void CollisionManager::Update(const float p_fDelta)
 {
-	// Iterate through each pair of colliders
-	for (ColliderMap::iterator i = m_mColliderMap.begin(); i != m_mColliderMap.end(); i++)
+	if (m_bStaticBVHDirty)
+	{
+		RebuildStaticBVH();
+	}
+
+	// This frame's dynamic colliders with their bounds. Pointers into the map stay
+	// valid through the responses: colliders created mid-update wait for the next
+	// frame, and destruction is deferred.
+	m_vColliders.clear();
+	m_vProxies.clear();
+	for (unsigned int i = 0; i < m_vDynamicColliders.size(); i++)
+	{
+		RegisteredCollider& sCollider = m_vDynamicColliders[i]->second;
+		UpdateColliderTransform(sCollider);
+		m_vColliders.push_back(&sCollider);
+
+		const AABB mBounds = ComputeBounds(sCollider);
+		BroadphaseProxy mProxy;
+		mProxy.minX = mBounds.GetMinX();
+		mProxy.maxX = mBounds.GetMaxX();
+		mProxy.minZ = mBounds.GetMinZ();
+		mProxy.maxZ = mBounds.GetMaxZ();
+		m_vProxies.push_back(mProxy);
+	}
+
+	// Dynamic against dynamic, only for the pairs close enough to touch, then
+	// dynamic against static, only for the walls each collider is near
+	m_vCandidates.clear();
+	m_pBroadphase->FindPairs(m_vProxies, m_vPairs);
+	for (unsigned int i = 0; i < m_vPairs.size(); i++)
 	{
-		for (ColliderMap::iterator j = i; j != m_mColliderMap.end(); j++)
+		m_vCandidates.push_back(std::make_pair(m_vColliders[m_vPairs[i].first], m_vColliders[m_vPairs[i].second]));
+	}
+	for (unsigned int i = 0; i < m_vColliders.size(); i++)
+	{
+		m_vStaticHits.clear();
+		m_mStaticBVH.Query(ComputeBounds(*m_vColliders[i]), m_vStaticHits);
+		for (unsigned int j = 0; j < m_vStaticHits.size(); j++)
 		{
-			if (i != j)
-			{
-				CheckCollision(i->second, j->second);
-			}
+			// Walls are only ever worked out the once, but the check is cheap and
+			// the narrowphase can't make it
+			RegisteredCollider* pWall = m_vStaticColliders[m_vStaticHits[j]];
+			UpdateColliderTransform(*pWall);
+			m_vCandidates.push_back(std::make_pair(m_vColliders[i], pWall));
+		}
+	}
+
+	// Test them all against where everything is now, before any response moves
+	// anything. Buffers keep their capacity from frame to frame.
+	const unsigned int uiBatches = (m_vCandidates.size() + NARROWPHASE_BATCH_SIZE - 1) / NARROWPHASE_BATCH_SIZE;
+	if (m_vContactBuffers.size() < uiBatches)
+	{
+		m_vContactBuffers.resize(uiBatches);
+	}
+	for (unsigned int i = 0; i < uiBatches; i++)
+	{
+		m_vContactBuffers[i].clear();
+	}
+
+	if (m_bParallelNarrowphase && uiBatches > 1)
+	{
+		JobSystem::Instance()->ParallelFor(m_vCandidates.size(), NARROWPHASE_BATCH_SIZE, [this](const unsigned int p_uiBegin, const unsigned int p_uiEnd)
+		{
+			Narrowphase(p_uiBegin, p_uiEnd);
+		});
+	}
+	else
+	{
+		Narrowphase(0, m_vCandidates.size());
+	}
+
+	// Events go out on this thread, in the order the pairs were found
+	for (unsigned int i = 0; i < uiBatches; i++)
+	{
+		for (unsigned int j = 0; j < m_vContactBuffers[i].size(); j++)
+		{
+			ReportContact(m_vContactBuffers[i][j]);
 		}
 	}
+
+	ReportEndedContacts();
+	RecordPreviousPositions();
+}
+
+void CollisionManager::RecordPreviousPositions()
+{
+	for (unsigned int i = 0; i < m_vColliders.size(); i++)
+	{
+		UpdateColliderTransform(*m_vColliders[i]);
+		m_vColliders[i]->previousPosition = m_vColliders[i]->position;
+		m_vColliders[i]->hasPreviousPosition = true;
+	}
+}
+
+void CollisionManager::RebuildStaticBVH()
+{
+	m_vStaticColliders.clear();
+	std::vector<AABB> vBounds;
+	for (ColliderMap::iterator it = m_mColliderMap.begin(); it != m_mColliderMap.end(); it++)
+	{
+		if (IsStatic(it->second))
+		{
+			UpdateColliderTransform(it->second);
+			m_vStaticColliders.push_back(&it->second);
+			vBounds.push_back(ComputeBounds(it->second));
+		}
+	}
+
+	m_mStaticBVH.Build(vBounds);
+	m_bStaticBVHDirty = false;
 }
 
 void CollisionManager::PreRender()
 {
 }
 
-void CollisionManager::CheckCollision(RegisteredCollider p_sCollider1, RegisteredCollider p_sCollider2)
+void CollisionManager::UpdateColliderTransform(RegisteredCollider& p_sCollider)
+{
+	const HierarchicalTransform& mTransform = p_sCollider.collider->GetGameObject()->GetTransform();
+	if (!mTransform.HasChangedSince(p_sCollider.transformVersion))
+	{
+		return;
+	}
+
+	if (p_sCollider.type == Sphere)
+	{
+		p_sCollider.position = mTransform.GetTranslation() + static_cast<ComponentSphereCollider*>(p_sCollider.collider)->GetOffset();
+	}
+	else if (p_sCollider.type == Wall)
+	{
+		ComponentWallCollider* pWall = static_cast<ComponentWallCollider*>(p_sCollider.collider);
+		p_sCollider.position = mTransform.GetTranslation() + pWall->GetOffset();
+		p_sCollider.normal = pWall->GetSurfaceNormal() * mTransform.GetRotation();
+	}
+}
+
+AABB CollisionManager::ComputeBounds(const RegisteredCollider& p_sCollider)
+{
+	// A wall reaches at most its width from its centre across the ground and its
+	// height up or down. A sphere's bounds cover everywhere it has been since last
+	// frame, so the walls it swept past are found, and are doubled so that a pair
+	// only just touching is never lost to rounding at the edges of the boxes.
+	if (p_sCollider.type == Wall)
+	{
+		ComponentWallCollider* pWall = static_cast<ComponentWallCollider*>(p_sCollider.collider);
+		return AABB(p_sCollider.position, 2.0f * pWall->GetWidth(), 2.0f * pWall->GetHeight(), 2.0f * pWall->GetWidth());
+	}
+
+	const float fExtent = 2.0f * static_cast<ComponentSphereCollider*>(p_sCollider.collider)->GetRadius();
+	const glm::vec3& vEnd = p_sCollider.position;
+	const glm::vec3& vStart = (p_sCollider.hasPreviousPosition ? p_sCollider.previousPosition : vEnd);
+	return AABB(
+		std::min(vStart.x, vEnd.x) - fExtent, std::max(vStart.x, vEnd.x) + fExtent,
+		std::min(vStart.y, vEnd.y) - fExtent, std::max(vStart.y, vEnd.y) + fExtent,
+		std::min(vStart.z, vEnd.z) - fExtent, std::max(vStart.z, vEnd.z) + fExtent);
+}
+
+void CollisionManager::Narrowphase(const unsigned int p_uiBegin, const unsigned int p_uiEnd)
+{
+	// Each pair's contacts go in its batch's buffer, whatever range this thread was
+	// given. ParallelFor() hands out whole batches, so no two threads share one.
+	for (unsigned int i = p_uiBegin; i < p_uiEnd; i++)
+	{
+		CheckCollision(*m_vCandidates[i].first, *m_vCandidates[i].second, m_vContactBuffers[i / NARROWPHASE_BATCH_SIZE]);
+	}
+}
+
+void CollisionManager::CheckCollision(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts)
 {
 	// Make sure they're in order, to simplify comparisons
 
-	if (p_sCollider1.type > p_sCollider2.type)
+	const RegisteredCollider* pCollider1 = &p_sCollider1;
+	const RegisteredCollider* pCollider2 = &p_sCollider2;
+	if (pCollider1->type > pCollider2->type)
 	{
-		RegisteredCollider temp = p_sCollider1;
-		p_sCollider1 = p_sCollider2;
-		p_sCollider2 = temp;
+		const RegisteredCollider* temp = pCollider1;
+		pCollider1 = pCollider2;
+		pCollider2 = temp;
 	}
 
 	// Now find the right function
 
-	if (p_sCollider1.type == Sphere)
+	if (pCollider1->type == Sphere)
 	{
-		if (p_sCollider2.type == Sphere)
+		if (pCollider2->type == Sphere)
 		{
-			CheckCollision((ComponentSphereCollider*)p_sCollider1.collider, (ComponentSphereCollider*)p_sCollider2.collider);
+			CheckSphereSphere(*pCollider1, *pCollider2, p_vContacts);
 		}
-		else if (p_sCollider2.type == Wall)
+		else if (pCollider2->type == Wall)
 		{
-			CheckCollision((ComponentSphereCollider*)p_sCollider1.collider, (ComponentWallCollider*)p_sCollider2.collider);
+			CheckSphereWall(*pCollider1, *pCollider2, p_vContacts);
 		}
 	}
 }
 
-void CollisionManager::CheckCollision(ComponentSphereCollider* p_pCollider1, ComponentSphereCollider* p_pCollider2)
+void CollisionManager::CheckSphereSphere(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts)
 {
 	// Sphere-Sphere Collision
 	// Pretty easy, just check if the distance between them is less than the sum of their radii.
 	
-	glm::vec3 pos1 = p_pCollider1->GetGameObject()->GetTransform().GetTranslation() + p_pCollider1->GetOffset();
-	glm::vec3 pos2 = p_pCollider2->GetGameObject()->GetTransform().GetTranslation() + p_pCollider2->GetOffset();
+	ComponentSphereCollider* pCollider1 = static_cast<ComponentSphereCollider*>(p_sCollider1.collider);
+	ComponentSphereCollider* pCollider2 = static_cast<ComponentSphereCollider*>(p_sCollider2.collider);
+	const glm::vec3& pos1 = p_sCollider1.position;
+	const glm::vec3& pos2 = p_sCollider2.position;
 
-	if (glm::length(pos1 - pos2) <= p_pCollider1->GetRadius() + p_pCollider2->GetRadius())
+	if (glm::length(pos1 - pos2) <= pCollider1->GetRadius() + pCollider2->GetRadius())
 	{
-		glm::vec3 contactPoint = pos1 + ((pos1 - pos2) * (p_pCollider1->GetRadius()/(p_pCollider1->GetRadius() + p_pCollider2->GetRadius())));
+		Contact sContact;
+		sContact.collider1 = &p_sCollider1;
+		sContact.collider2 = &p_sCollider2;
+		sContact.point = pos1 + ((pos1 - pos2) * (pCollider1->GetRadius()/(pCollider1->GetRadius() + pCollider2->GetRadius())));
+		sContact.isWall = false;
+		sContact.passedThrough = false;
 
 		//printf("Sphere-Sphere Collision!");
-		Event* collisionEvent = new Event("Collision");
-		collisionEvent->SetGameObjectParameter("Object1GUID", p_pCollider1->GetGameObject()->GetGUID());
-		collisionEvent->SetGameObjectParameter("Object2GUID", p_pCollider2->GetGameObject()->GetGUID());
-		collisionEvent->SetFloatParameter("ContactPointX", contactPoint.x);
-		collisionEvent->SetFloatParameter("ContactPointY", contactPoint.y);
-		collisionEvent->SetFloatParameter("ContactPointZ", contactPoint.z);
-		EventManager::Instance()->TriggerEvent(collisionEvent);
-
-		// Only want the collision effect to happen on kart-kart collisions
-		Component* racer1 = p_pCollider1->GetGameObject()->GetComponent("GOC_Racer");
-		Component* racer2 = p_pCollider2->GetGameObject()->GetComponent("GOC_Racer");
-		if (racer1 != nullptr && racer2 != nullptr)
-		{
-			CollisionEffect(contactPoint);
-		}
+		p_vContacts.push_back(sContact);
 	}
 }
 
-void CollisionManager::CheckCollision(ComponentSphereCollider* p_pCollider1, ComponentWallCollider* p_pCollider2)
+void CollisionManager::CheckSphereWall(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts)
 {
 	// Sphere-Wall Collision
 	// This is a little different; because the walls are always vertical,
-	// we can reduce this to a 2D line-circle intersection problem
+	// we can reduce this to a 2D circle-segment problem on the ground plane.
+	// The sphere is swept from where it was last frame, so one moving far enough
+	// in a frame to jump the wall still hits it.
 	
-	glm::vec3 pos1 = p_pCollider1->GetGameObject()->GetTransform().GetTranslation() + p_pCollider1->GetOffset();
-	glm::vec3 pos2 = p_pCollider2->GetGameObject()->GetTransform().GetTranslation() + p_pCollider2->GetOffset();
-
-	// Do an area check to see if we can exit out of this early
-	float checkDistance = p_pCollider1->GetRadius() + p_pCollider2->GetWidth();
-	if (pos1.x < pos2.x - checkDistance || pos1.x > pos2.x + checkDistance || pos1.z < pos2.z - checkDistance || pos1.z > pos2.z + checkDistance)
-	{
-		return;
-	}
-
-	// Previous sphere position
-	// (the collider's position may be a frame behind, due to the order of Update()
-	//		so we'll check and use the one that is most appropriate)
-	glm::vec3 pos1prev = p_pCollider1->GetPosition();
-	if (pos1prev == pos1)
-	{
-		pos1prev = p_pCollider1->GetPreviousPosition();
-	}
+	ComponentSphereCollider* pCollider1 = static_cast<ComponentSphereCollider*>(p_sCollider1.collider);
+	ComponentWallCollider* pCollider2 = static_cast<ComponentWallCollider*>(p_sCollider2.collider);
+	const glm::vec3& pos1 = p_sCollider1.position;
+	const glm::vec3& pos2 = p_sCollider2.position;
+	const glm::vec3& pos1prev = (p_sCollider1.hasPreviousPosition ? p_sCollider1.previousPosition : pos1);
 
 	float heightDifference = abs(pos1.y - pos2.y);
 	float radius;
 
 	// If the sphere is well above/below the wall, we know they won't collide.
 	// If it's only a little above/below, it may still
-	if (heightDifference <= p_pCollider2->GetHeight())
+	if (heightDifference <= pCollider2->GetHeight())
 	{
-		radius = p_pCollider1->GetRadius();
+		radius = pCollider1->GetRadius();
 	}
-	else if (heightDifference <= p_pCollider2->GetHeight() + p_pCollider1->GetRadius())
+	else if (heightDifference <= pCollider2->GetHeight() + pCollider1->GetRadius())
 	{
-		float h = (p_pCollider2->GetHeight() + p_pCollider1->GetRadius()) - heightDifference;
-		radius = sqrtf(h * ((2 * p_pCollider1->GetRadius()) - h));
+		float h = (pCollider2->GetHeight() + pCollider1->GetRadius()) - heightDifference;
+		radius = sqrtf(h * ((2 * pCollider1->GetRadius()) - h));
 	}
 	else
 	{
 		return;
 	}
 
-	glm::vec3 normal = p_pCollider2->GetSurfaceNormal();
-	glm::quat rotation = p_pCollider2->GetGameObject()->GetTransform().GetRotation();
-	normal = normal * rotation;
-	glm::vec3 contactPoint;
+	// The wall runs along the ground at right angles to its normal, its width
+	// either side of its centre. A wall lying flat has no such line.
+	glm::vec2 normal(p_sCollider2.normal.x, p_sCollider2.normal.z);
+	if (glm::dot(normal, normal) < 0.0001f)
+	{
+		return;
+	}
+	normal = glm::normalize(normal);
 
-	bool passedThrough = false;
+	const glm::vec2 centre(pos2.x, pos2.z);
+	const glm::vec2 along(normal.y, -normal.x);
+	const glm::vec2 end1 = centre - along * pCollider2->GetWidth();
+	const glm::vec2 end2 = centre + along * pCollider2->GetWidth();
 
-	int xAligned = 0;
-	int zAligned = 0;
+	const glm::vec2 start(pos1prev.x, pos1prev.z);
+	const glm::vec2 finish(pos1.x, pos1.z);
 
-	// Find the contact point
-	if ((normal.x > 0.9f || normal.x < -0.9f) && abs(normal.z) < 0.1f)
-	{
-		xAligned = 1;
-		
-		glm::vec3 l1 = pos2 + glm::vec3(0.0f, 0.0f, p_pCollider2->GetWidth());
-		glm::vec3 l2 = pos2 - glm::vec3(0.0f, 0.0f, p_pCollider2->GetWidth());
+	glm::vec3 contactPoint;
+	glm::vec3 impactPosition;
+	bool passedThrough = false;
 
-		// pass through
-		if (pos1.x > pos2.x && pos1prev.x < pos2.x)
-		{
-			contactPoint = pos1 + glm::vec3(0.001f, 0.0f, 0.0f);
-			passedThrough = true;
-		}
-		else if (pos1.x < pos2.x && pos1prev.x > pos2.x)
-		{
-			contactPoint = pos1 + glm::vec3(-0.001f, 0.0f, 0.0f);
-			passedThrough = true;
-		}
-		// contact at the edges of the wall
-		else if (pos1.z >= l1.z)
+	// If it crossed the wall's line on the way to hitting it, it went through,
+	// and gets put back where it first touched.
+	float timeOfImpact;
+	glm::vec2 sweptContact;
+	const float startSide = glm::dot(start - centre, normal);
+	const float finishSide = glm::dot(finish - centre, normal);
+	if (((startSide > 0.0f && finishSide < 0.0f) || (startSide < 0.0f && finishSide > 0.0f)) &&
+		SweepCircleSegment(start, finish, radius, end1, end2, timeOfImpact, sweptContact))
+	{
+		impactPosition = pos1prev + (pos1 - pos1prev) * timeOfImpact;
+		contactPoint = glm::vec3(sweptContact.x, impactPosition.y, sweptContact.y);
+		passedThrough = true;
+	}
+	else
+	{
+		const glm::vec2 closest = ClosestPointOnSegment(finish, end1, end2);
+		contactPoint = glm::vec3(closest.x, pos1.y, closest.y);
+		if (glm::length(pos1 - contactPoint) > radius)
 		{
-			contactPoint = glm::vec3(l1.x, pos1.y, l1.z);
+			return;
 		}
-		else if (pos1.z <= l2.z)
+	}
+
+	//printf("Sphere-Wall Collision!\n");
+	//printf("%f, %f, %f\n", contactPoint.x, contactPoint.y, contactPoint.z);
+	Contact sContact;
+	sContact.collider1 = &p_sCollider1;
+	sContact.collider2 = &p_sCollider2;
+	sContact.point = contactPoint;
+	sContact.isWall = true;
+	sContact.normal = normal;
+	sContact.passedThrough = passedThrough;
+	if (passedThrough)
+	{
+		// Where the sphere's GameObject should go back to, without the collider's offset
+		sContact.impact = impactPosition - pCollider1->GetOffset();
+	}
+	p_vContacts.push_back(sContact);
+}
+
+void CollisionManager::ReportContact(const Contact& p_sContact)
+{
+	GameObject* pObject1 = p_sContact.collider1->collider->GetGameObject();
+	GameObject* pObject2 = p_sContact.collider2->collider->GetGameObject();
+
+	ContactPair sPair;
+	sPair.first = std::min(pObject1->GetHandle(), pObject2->GetHandle());
+	sPair.second = std::max(pObject1->GetHandle(), pObject2->GetHandle());
+	m_vNewContactPairs.push_back(sPair);
+
+	// Each object gets its own copy, targeted at it, so nothing else listening
+	// for collisions hears about it. Pairs still touching from last frame are
+	// only reported to colliders which asked, or to the sphere when it went
+	// through a wall and has to be put back.
+	const bool bEnter = !std::binary_search(m_vContactPairs.begin(), m_vContactPairs.end(), sPair);
+	if (bEnter)
+	{
+		SendContactEvent(m_uiCollisionEnterEventID, p_sContact, pObject1);
+		SendContactEvent(m_uiCollisionEnterEventID, p_sContact, pObject2);
+	}
+	else
+	{
+		if (p_sContact.passedThrough || p_sContact.collider1->collider->ReportsCollisionStay())
 		{
-			contactPoint = glm::vec3(l2.x, pos1.y, l2.z);;
+			SendContactEvent(m_uiCollisionStayEventID, p_sContact, pObject1);
 		}
-		// contact in the middle of the wall
-		else
+		if (p_sContact.collider2->collider->ReportsCollisionStay())
 		{
-			contactPoint = glm::vec3(pos2.x, pos1.y, pos1.z);
+			SendContactEvent(m_uiCollisionStayEventID, p_sContact, pObject2);
 		}
 	}
-	else if ((normal.z > 0.9f || normal.z < -0.9f) && abs(normal.x) < 0.1f)
-	{
-		zAligned = 1;
-		
-		glm::vec3 l1 = pos2 + glm::vec3(p_pCollider2->GetWidth(), 0.0f, 0.0f);
-		glm::vec3 l2 = pos2 - glm::vec3(p_pCollider2->GetWidth(), 0.0f, 0.0f);
 
-		// pass through
-		if (pos1.z > pos2.z && pos1prev.z < pos2.z)
-		{
-			contactPoint = pos1 + glm::vec3(0.0f, 0.0f, 0.001f);
-			passedThrough = true;
-		}
-		else if (pos1.z < pos2.z && pos1prev.z > pos2.z)
+	// Only want the collision effect when a kart first hits a wall or another kart
+	if (bEnter)
+	{
+		const bool bRacer1 = (pObject1->GetComponent("GOC_Racer") != nullptr);
+		const bool bRacer2 = (pObject2->GetComponent("GOC_Racer") != nullptr);
+		if (p_sContact.isWall ? (bRacer1 || bRacer2) : (bRacer1 && bRacer2))
 		{
-			contactPoint = pos1 + glm::vec3(0.0f, 0.0f, -0.001f);
-			passedThrough = true;
+			glm::vec3 contactPoint = p_sContact.point;
+			CollisionEffect(contactPoint);
 		}
-		// contact at the edges of the wall
-		else if (pos1.x >= l1.x)
+	}
+}
+
+void CollisionManager::SendContactEvent(const EventTypeID p_uiEventTypeID, const Contact& p_sContact, const GameObject* p_pTarget)
+{
+	GameObject* pObject1 = p_sContact.collider1->collider->GetGameObject();
+	GameObject* pObject2 = p_sContact.collider2->collider->GetGameObject();
+
+	Event* collisionEvent = new (EL_Frame) Event(p_uiEventTypeID);
+	collisionEvent->SetTarget(p_pTarget);
+	collisionEvent->SetIntParameter(m_uiObject1HandleID, static_cast<int>(pObject1->GetHandle().GetValue()));
+	collisionEvent->SetIntParameter(m_uiObject2HandleID, static_cast<int>(pObject2->GetHandle().GetValue()));
+	collisionEvent->SetFloatParameter(m_uiContactPointXID, p_sContact.point.x);
+	collisionEvent->SetFloatParameter(m_uiContactPointYID, p_sContact.point.y);
+	collisionEvent->SetFloatParameter(m_uiContactPointZID, p_sContact.point.z);
+	if (p_sContact.isWall)
+	{
+		collisionEvent->SetFloatParameter(m_uiNormalXID, p_sContact.normal.x);
+		collisionEvent->SetFloatParameter(m_uiNormalZID, p_sContact.normal.y);
+		collisionEvent->SetIntParameter(m_uiPassedThroughID, (int)p_sContact.passedThrough);
+		if (p_sContact.passedThrough)
 		{
-			contactPoint = glm::vec3(l1.x, pos1.y, l1.z);
+			collisionEvent->SetFloatParameter(m_uiImpactXID, p_sContact.impact.x);
+			collisionEvent->SetFloatParameter(m_uiImpactYID, p_sContact.impact.y);
+			collisionEvent->SetFloatParameter(m_uiImpactZID, p_sContact.impact.z);
 		}
-		else if (pos1.x <= l2.x)
+	}
+	EventManager::Instance()->TriggerEvent(collisionEvent);
+}
+
+void CollisionManager::ReportEndedContacts()
+{
+	// Both lists are sorted, so anything from last frame that isn't in this
+	// frame's list is found in one pass.
+	std::sort(m_vNewContactPairs.begin(), m_vNewContactPairs.end());
+
+	std::vector<ContactPair>::const_iterator itNew = m_vNewContactPairs.begin();
+	for (std::vector<ContactPair>::const_iterator it = m_vContactPairs.begin(); it != m_vContactPairs.end(); it++)
+	{
+		while (itNew != m_vNewContactPairs.end() && *itNew < *it)
 		{
-			contactPoint = glm::vec3(l2.x, pos1.y, l2.z);;
+			itNew++;
 		}
-		// contact in the middle of the wall
-		else
+		if (itNew != m_vNewContactPairs.end() && *itNew == *it)
 		{
-			contactPoint = glm::vec3(pos1.x, pos1.y, pos2.z);
+			continue;
 		}
-	}
-	else
-	{
-		assert(false && "Walls must be axis aligned!");
-		return;
-	}
 
-	// See if we collide
-	if (glm::length(pos1 - contactPoint) <= radius)
-	{
-		//printf("Sphere-Wall Collision!\n");
-		//printf("%f, %f, %f\n", contactPoint.x, contactPoint.y, contactPoint.z);
-		Event* collisionEvent = new Event("Collision");
-		collisionEvent->SetGameObjectParameter("Object1GUID", p_pCollider1->GetGameObject()->GetGUID());
-		collisionEvent->SetGameObjectParameter("Object2GUID", p_pCollider2->GetGameObject()->GetGUID());
-		collisionEvent->SetFloatParameter("ContactPointX", contactPoint.x);
-		collisionEvent->SetFloatParameter("ContactPointY", contactPoint.y);
-		collisionEvent->SetFloatParameter("ContactPointZ", contactPoint.z);
-		collisionEvent->SetIntParameter("PassedThrough", (int)passedThrough);
-		collisionEvent->SetIntParameter("XAligned", xAligned);
-		collisionEvent->SetIntParameter("ZAligned", zAligned);
-		EventManager::Instance()->TriggerEvent(collisionEvent);
-
-		// Only want the collision effect to happen on kart-wall collisions
-		Component* racer1 = p_pCollider1->GetGameObject()->GetComponent("GOC_Racer");
-		Component* racer2 = p_pCollider2->GetGameObject()->GetComponent("GOC_Racer");
-		if (racer1 != nullptr || racer2 != nullptr)
+		// Either object may be gone by now, so listeners get the handles only, and
+		// only the objects still around are told.
+		const GameObjectHandle aHandles[2] = { it->first, it->second };
+		for (unsigned int i = 0; i < 2; i++)
 		{
-			CollisionEffect(contactPoint);
+			const GameObject* pTarget = m_pGameObjectManager->GetGameObject(aHandles[i]);
+			if (pTarget == nullptr)
+			{
+				continue;
+			}
+
+			Event* exitEvent = new (EL_Frame) Event(m_uiCollisionExitEventID);
+			exitEvent->SetTarget(pTarget);
+			exitEvent->SetIntParameter(m_uiObject1HandleID, static_cast<int>(it->first.GetValue()));
+			exitEvent->SetIntParameter(m_uiObject2HandleID, static_cast<int>(it->second.GetValue()));
+			EventManager::Instance()->TriggerEvent(exitEvent);
 		}
 	}
+
+	m_vContactPairs.swap(m_vNewContactPairs);
+	m_vNewContactPairs.clear();
 }
 
 void CollisionManager::CollisionEffect(glm::vec3& p_vPosition)
@@ -9,11 +9,15 @@
 #define COLLISION_MANAGER_H
 
 #include <map>
+#include <vector>
 
 #include "ComponentCollider.h"
 
 #include "ComponentSphereCollider.h"
 #include "ComponentWallCollider.h"
+#include "EventTypeRegistry.h"
+#include "Broadphase.h"
+#include "BoundingVolumeHierarchy.h"
 
 namespace HeatStroke
 {
@@ -27,6 +31,50 @@ namespace HeatStroke
 	{
 		ComponentCollider* collider;
 		ColliderType type;
+
+		// World position (with the collider's offset) and, for walls, surface normal,
+		// refreshed only when the transform has changed.
+		glm::vec3 position;
+		glm::vec3 normal;
+		unsigned int transformVersion;
+
+		// Where a sphere was at the end of the last Update(), which this frame's
+		// sweep against the walls starts from. Unset until it's been through an
+		// Update(), or after it's teleported.
+		glm::vec3 previousPosition;
+		bool hasPreviousPosition;
+	};
+
+	// Two colliders found touching in an Update(), before it's sent as an event.
+	struct Contact
+	{
+		const RegisteredCollider* collider1;
+		const RegisteredCollider* collider2;
+		glm::vec3 point;
+
+		// Sphere-wall contacts also have the wall's normal along the ground, and
+		// where the sphere should go back to if it passed through.
+		bool isWall;
+		glm::vec2 normal;
+		bool passedThrough;
+		glm::vec3 impact;
+	};
+
+	// Two GameObjects which are touching, the lower handle first so it's the same
+	// pair whichever way round they were found.
+	struct ContactPair
+	{
+		GameObjectHandle first;
+		GameObjectHandle second;
+
+		bool operator<(const ContactPair& p_sOther) const
+		{
+			return first < p_sOther.first || (first == p_sOther.first && second < p_sOther.second);
+		}
+		bool operator==(const ContactPair& p_sOther) const
+		{
+			return first == p_sOther.first && second == p_sOther.second;
+		}
 	};
 	
 	class CollisionManager
@@ -49,7 +97,7 @@ namespace HeatStroke
 		static CollisionManager* Instance();
 
 		void RegisterCollider(ComponentCollider* p_pCollider, std::string p_strGuid);
-		void UnregisterCollider(std::string p_strGuid) { m_mColliderMap.erase(p_strGuid); }
+		void UnregisterCollider(std::string p_strGuid);
 
 		void Update(const float p_fDelta);
 		void PreRender();
@@ -64,6 +112,23 @@ namespace HeatStroke
 
 		void SetGameObjectManager(GameObjectManager* p_pGameObjectManager) { m_pGameObjectManager = p_pGameObjectManager; }
 
+		// Replaces the broadphase which picks the pairs to test. Takes ownership.
+		// Sweep and prune is used unless another is set.
+		void SetBroadphase(Broadphase* p_pBroadphase);
+
+		// Spheres are swept from where they were last frame, so anything that
+		// teleports an object should call this, or it'll hit every wall in between.
+		void ResetSweep(const std::string& p_strGuid);
+		void ResetAllSweeps();
+
+		// Forgets which pairs were touching, so after a restart every pair touching
+		// sends CollisionEnter again and none that were touching before send CollisionExit.
+		void ResetContacts();
+
+		// Whether the pairs are tested across the JobSystem's threads. Either way the
+		// same contacts come out in the same order; this is on unless turned off.
+		void SetParallelNarrowphase(const bool p_bParallel) { m_bParallelNarrowphase = p_bParallel; }
+
 	private:
 		//---------------------------------------------------------------------
 		// Private members
@@ -75,17 +140,86 @@ namespace HeatStroke
 		unsigned int m_iEffectIndex;
 		GameObjectManager* m_pGameObjectManager;
 
+		// Interned once so each contact skips the event type string lookup.
+		EventTypeID m_uiCollisionEnterEventID;
+		EventTypeID m_uiCollisionStayEventID;
+		EventTypeID m_uiCollisionExitEventID;
+
+		// And the parameter names, so each parameter skips the name lookup too.
+		EventParameterID m_uiObject1HandleID;
+		EventParameterID m_uiObject2HandleID;
+		EventParameterID m_uiContactPointXID;
+		EventParameterID m_uiContactPointYID;
+		EventParameterID m_uiContactPointZID;
+		EventParameterID m_uiNormalXID;
+		EventParameterID m_uiNormalZID;
+		EventParameterID m_uiPassedThroughID;
+		EventParameterID m_uiImpactXID;
+		EventParameterID m_uiImpactYID;
+		EventParameterID m_uiImpactZID;
+
+		// The pairs that were touching at the end of the last Update(), sorted, and
+		// those found touching so far in this one. A pair only sends CollisionEnter
+		// when it starts touching and CollisionExit when it stops; CollisionStay is
+		// sent in between only to a collider that asked for it. All three are
+		// targeted at the GameObjects involved, one event each.
+		std::vector<ContactPair> m_vContactPairs;
+		std::vector<ContactPair> m_vNewContactPairs;
+
+		// Colliders that can move, in GUID order.
+		std::vector<ColliderMap::iterator> m_vDynamicColliders;
+
+		// Walls never move once the track has loaded, so they're put in a BVH,
+		// which is only rebuilt after a wall is added or removed.
+		std::vector<RegisteredCollider*> m_vStaticColliders;
+		BoundingVolumeHierarchy m_mStaticBVH;
+		bool m_bStaticBVHDirty;
+
+		// Picks the pairs of dynamic colliders worth testing each Update(). This
+		// frame's colliders, their bounds, the pairs and the walls each collider
+		// is near are kept between frames to save reallocating them.
+		Broadphase* m_pBroadphase;
+		std::vector<RegisteredCollider*> m_vColliders;
+		std::vector<BroadphaseProxy> m_vProxies;
+		std::vector<BroadphasePair> m_vPairs;
+		std::vector<unsigned int> m_vStaticHits;
+
+		// Every pair the broadphase and the BVH turned up this frame, in the order
+		// their contacts are reported. They're tested in batches of
+		// NARROWPHASE_BATCH_SIZE, each writing its contacts to its own buffer, so
+		// reading the buffers back in batch order gives the same contacts in the
+		// same order however the batches were shared between threads.
+		static const unsigned int NARROWPHASE_BATCH_SIZE = 32;
+		bool m_bParallelNarrowphase;
+		std::vector<std::pair<const RegisteredCollider*, const RegisteredCollider*>> m_vCandidates;
+		std::vector<std::vector<Contact>> m_vContactBuffers;
+
 		//---------------------------------------------------------------------
 		// Private functions
 		//---------------------------------------------------------------------
 		CollisionManager();
 		~CollisionManager();
 
-		void CheckCollision(RegisteredCollider p_sCollider1, RegisteredCollider p_sCollider2);
+		static bool IsStatic(const RegisteredCollider& p_sCollider) { return p_sCollider.type == Wall; }
+
+		void RebuildStaticBVH();
+
+		void UpdateColliderTransform(RegisteredCollider& p_sCollider);
+		AABB ComputeBounds(const RegisteredCollider& p_sCollider);
+		void RecordPreviousPositions();
+
+		// Tests m_vCandidates[p_uiBegin, p_uiEnd) into their batches' buffers. It
+		// only reads the colliders, so it can run on any thread.
+		void Narrowphase(const unsigned int p_uiBegin, const unsigned int p_uiEnd);
+		static void CheckCollision(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts);
 
 		// Collision pairs
-		void CheckCollision(ComponentSphereCollider* p_pCollider1, ComponentSphereCollider* p_pCollider2);
-		void CheckCollision(ComponentSphereCollider* p_pCollider1, ComponentWallCollider* p_pCollider2);
+		static void CheckSphereSphere(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts);
+		static void CheckSphereWall(const RegisteredCollider& p_sCollider1, const RegisteredCollider& p_sCollider2, std::vector<Contact>& p_vContacts);
+
+		void ReportContact(const Contact& p_sContact);
+		void SendContactEvent(const EventTypeID p_uiEventTypeID, const Contact& p_sContact, const GameObject* p_pTarget);
+		void ReportEndedContacts();
 
 		void CollisionEffect(glm::vec3& p_vPosition);
 	};
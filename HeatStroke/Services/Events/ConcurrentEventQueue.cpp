@@ -0,0 +1,118 @@
+//==================================================================================
+// ConcurrentEventQueue
+//
+// A bounded, lock-free queue of events which any number of threads may push to
+// and exactly one thread (the main thread, in EventManager::Update()) pops from.
+//
+// Each slot carries a sequence number which tells producers whether the slot is
+// free for the position they claimed, and tells the consumer whether the event
+// in it has been fully written. Producers only contend on a single atomic
+// counter, and the consumer never blocks them.
+//==================================================================================
+
+#include "ConcurrentEventQueue.h"
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// ConcurrentEventQueue::ConcurrentEventQueue
+	// Parameters:
+	//	const unsigned int p_uiCapacity - The number of events the queue can hold.
+	//		Must be a power of two.
+	//------------------------------------------------------------------------------
+	ConcurrentEventQueue::ConcurrentEventQueue(const unsigned int p_uiCapacity) :
+		m_pCells(new Cell[p_uiCapacity]),
+		m_uiMask(p_uiCapacity - 1),
+		m_uiEnqueuePosition(0),
+		m_uiDequeuePosition(0)
+	{
+		assert(p_uiCapacity >= 2 && (p_uiCapacity & (p_uiCapacity - 1)) == 0 && "Capacity Must Be A Power Of Two");
+
+		// Slot i is first free for the producer that claims position i.
+		for (std::size_t i = 0; i < p_uiCapacity; ++i)
+		{
+			m_pCells[i].uiSequence.store(i, std::memory_order_relaxed);
+			m_pCells[i].pEvent = nullptr;
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// ConcurrentEventQueue::~ConcurrentEventQueue
+	//
+	// The owner must pop (and delete) any remaining events first.
+	//------------------------------------------------------------------------------
+	ConcurrentEventQueue::~ConcurrentEventQueue()
+	{
+		delete[] m_pCells;
+	}
+
+	//------------------------------------------------------------------------------
+	// ConcurrentEventQueue::TryPush
+	// Parameters:
+	//	const Event* p_pEvent - The event to add.
+	// Returns: bool - False if the queue was full.
+	//
+	// Claims the next position by advancing the enqueue counter, then publishes the
+	// event by bumping its slot's sequence. Safe to call from any thread.
+	//------------------------------------------------------------------------------
+	bool ConcurrentEventQueue::TryPush(const Event* p_pEvent)
+	{
+		Cell* pCell = nullptr;
+		std::size_t uiPosition = m_uiEnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			pCell = &m_pCells[uiPosition & m_uiMask];
+			const std::size_t uiSequence = pCell->uiSequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t iDifference = static_cast<std::ptrdiff_t>(uiSequence) - static_cast<std::ptrdiff_t>(uiPosition);
+
+			if (iDifference == 0)
+			{
+				// The slot is free for this position; try to claim it.
+				if (m_uiEnqueuePosition.compare_exchange_weak(uiPosition, uiPosition + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (iDifference < 0)
+			{
+				// The consumer hasn't freed this slot from the previous lap yet.
+				return false;
+			}
+			else
+			{
+				// Another producer claimed this position first.
+				uiPosition = m_uiEnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		pCell->pEvent = p_pEvent;
+		pCell->uiSequence.store(uiPosition + 1, std::memory_order_release);
+		return true;
+	}
+
+	//------------------------------------------------------------------------------
+	// ConcurrentEventQueue::TryPop
+	// Parameters:
+	//	const Event*& p_pEventOut - Set to the oldest event, if there is one.
+	// Returns: bool - False if no event was ready.
+	//
+	// Only the consuming thread may call this.
+	//------------------------------------------------------------------------------
+	bool ConcurrentEventQueue::TryPop(const Event*& p_pEventOut)
+	{
+		Cell* pCell = &m_pCells[m_uiDequeuePosition & m_uiMask];
+		const std::size_t uiSequence = pCell->uiSequence.load(std::memory_order_acquire);
+		if (static_cast<std::ptrdiff_t>(uiSequence) - static_cast<std::ptrdiff_t>(m_uiDequeuePosition + 1) < 0)
+		{
+			return false;
+		}
+
+		p_pEventOut = pCell->pEvent;
+		pCell->pEvent = nullptr;
+
+		// Free the slot for the producer one lap ahead.
+		pCell->uiSequence.store(m_uiDequeuePosition + m_uiMask + 1, std::memory_order_release);
+		++m_uiDequeuePosition;
+		return true;
+	}
+}
@@ -0,0 +1,72 @@
+//==================================================================================
+// ConcurrentEventQueue
+//
+// A bounded, lock-free queue of events which any number of threads may push to
+// and exactly one thread (the main thread, in EventManager::Update()) pops from.
+//
+// Each slot carries a sequence number which tells producers whether the slot is
+// free for the position they claimed, and tells the consumer whether the event
+// in it has been fully written. Producers only contend on a single atomic
+// counter, and the consumer never blocks them.
+//==================================================================================
+
+#ifndef CONCURRENT_EVENT_QUEUE_H
+#define CONCURRENT_EVENT_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	class Event;
+
+	class ConcurrentEventQueue
+	{
+	public:
+		// p_uiCapacity must be a power of two.
+		ConcurrentEventQueue(const unsigned int p_uiCapacity);
+		~ConcurrentEventQueue();
+
+		// Adds p_pEvent to the queue. Returns false, without taking ownership of the
+		// event, if the queue is full. Safe to call from any thread.
+		bool TryPush(const Event* p_pEvent);
+
+		// Removes the oldest event into p_pEventOut. Returns false if there are no
+		// completely pushed events. Only the consuming thread may call this.
+		bool TryPop(const Event*& p_pEventOut);
+
+		unsigned int GetCapacity() const { return m_uiMask + 1; }
+
+	private:
+		//---------------------------------------------------------------------------
+		// Private types
+		//---------------------------------------------------------------------------
+		struct Cell
+		{
+			std::atomic<std::size_t> uiSequence;
+			const Event* pEvent;
+		};
+
+		// Keeps the producers' counter and the consumer's position on separate
+		// cache lines so they don't slow each other down.
+		static const std::size_t CACHE_LINE_BYTES = 64;
+
+		//---------------------------------------------------------------------------
+		// Private members
+		//---------------------------------------------------------------------------
+		Cell* const m_pCells;
+		const std::size_t m_uiMask;
+
+		char m_aPadding0[CACHE_LINE_BYTES];
+		std::atomic<std::size_t> m_uiEnqueuePosition;
+		char m_aPadding1[CACHE_LINE_BYTES];
+		std::size_t m_uiDequeuePosition;
+
+		// ConcurrentEventQueues shouldn't be copied.
+		ConcurrentEventQueue(const ConcurrentEventQueue&) = delete;
+		ConcurrentEventQueue& operator=(const ConcurrentEventQueue&) = delete;
+	};
+}
+
+#endif // CONCURRENT_EVENT_QUEUE_H
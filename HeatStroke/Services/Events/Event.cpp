@@ -7,11 +7,13 @@
 
 #include "Event.h"
 
+#include <cstring>
+
 namespace HeatStroke
 {
 	// Initial value to assign to events as their ID.
 	// Incremented with the creation of each new Event.
-	unsigned int Event::m_uiEventIDCounter = 0;
+	std::atomic<unsigned int> Event::m_uiEventIDCounter(0);
 
 	//------------------------------------------------------------------------------------
 	// Event::Event
@@ -22,15 +24,35 @@ namespace HeatStroke
 	// Creates a new Event of type p_strEventType and increments m_uiEventIDCounter.
 	//------------------------------------------------------------------------------------
 	Event::Event(const std::string& p_strEventType) :
-		m_uiEventID(m_uiEventIDCounter),
+		m_uiEventID(m_uiEventIDCounter++),
 		m_fTimeStamp(static_cast<float>(glfwGetTime())),
-		m_strEventType(p_strEventType),
-		m_mIntParameterMap(),
-		m_mFloatParameterMap(),
-		m_mStringParameterMap(),
-		m_mGameObjectParameterMap()
+		m_uiEventTypeID(EventTypeRegistry::Intern(p_strEventType)),
+		m_pTarget(nullptr),
+		m_uiParameterCount(0),
+		m_uiInlineStringBytes(0),
+		m_vOverflowParameters(),
+		m_strOverflowStrings()
+	{
+	}
+
+	//------------------------------------------------------------------------------------
+	// Event::Event
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The interned type of event, as returned by
+	//		EventTypeRegistry::Intern().
+	//
+	// Creates a new Event of an already interned type and increments m_uiEventIDCounter.
+	//------------------------------------------------------------------------------------
+	Event::Event(const EventTypeID p_uiEventTypeID) :
+		m_uiEventID(m_uiEventIDCounter++),
+		m_fTimeStamp(static_cast<float>(glfwGetTime())),
+		m_uiEventTypeID(p_uiEventTypeID),
+		m_pTarget(nullptr),
+		m_uiParameterCount(0),
+		m_uiInlineStringBytes(0),
+		m_vOverflowParameters(),
+		m_strOverflowStrings()
 	{
-		++m_uiEventIDCounter;
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -43,7 +65,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::SetIntParameter(const std::string& p_strParameterName, const int p_iParameterValue)
 	{
-		m_mIntParameterMap.insert(std::pair<std::string, const int>(p_strParameterName, p_iParameterValue));
+		SetIntParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_iParameterValue);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -59,15 +81,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::GetOptionalIntParameter(const std::string& p_strParameterName, int& p_iParameterOut, const int p_iDefault) const
 	{
-		IntParameterMap::const_iterator find = m_mIntParameterMap.find(p_strParameterName);
-		if (find == m_mIntParameterMap.end())
-		{
-			p_iParameterOut = p_iDefault;
-		}
-		else
-		{
-			p_iParameterOut = find->second;
-		}
+		GetOptionalIntParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_iParameterOut, p_iDefault);
 	}
 
 	//----------------------------------------------------------------------------------------
@@ -81,15 +95,7 @@ namespace HeatStroke
 	//----------------------------------------------------------------------------------------
 	void Event::GetRequiredIntParameter(const std::string& p_strParameterName, int& p_iParameterOut) const
 	{
-		IntParameterMap::const_iterator find = m_mIntParameterMap.find(p_strParameterName);
-		if (find == m_mIntParameterMap.end())
-		{
-			assert(false && "Missing Required Int Parameter");
-		}
-		else
-		{
-			p_iParameterOut = find->second;
-		}
+		GetRequiredIntParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_iParameterOut);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -102,7 +108,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::SetFloatParameter(const std::string& p_strParameterName, const float p_fParameterValue)
 	{
-		m_mFloatParameterMap.insert(std::pair<std::string, const float>(p_strParameterName, p_fParameterValue));
+		SetFloatParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_fParameterValue);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -118,15 +124,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::GetOptionalFloatParameter(const std::string& p_strParameterName, float& p_fParameterOut, const float p_fDefault) const
 	{
-		FloatParameterMap::const_iterator find = m_mFloatParameterMap.find(p_strParameterName);
-		if (find == m_mFloatParameterMap.end())
-		{
-			p_fParameterOut = p_fDefault;
-		}
-		else
-		{
-			p_fParameterOut = find->second;
-		}
+		GetOptionalFloatParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_fParameterOut, p_fDefault);
 	}
 
 	//----------------------------------------------------------------------------------------
@@ -140,15 +138,7 @@ namespace HeatStroke
 	//----------------------------------------------------------------------------------------
 	void Event::GetRequiredFloatParameter(const std::string& p_strParameterName, float& p_fParameterOut) const
 	{
-		FloatParameterMap::const_iterator find = m_mFloatParameterMap.find(p_strParameterName);
-		if (find == m_mFloatParameterMap.end())
-		{
-			assert(false && "Missing Required Float Parameter");
-		}
-		else
-		{
-			p_fParameterOut = m_mFloatParameterMap.at(p_strParameterName);
-		}
+		GetRequiredFloatParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_fParameterOut);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -161,7 +151,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::SetStringParameter(const std::string& p_strParameterName, const std::string& p_strParameterValue)
 	{
-		m_mStringParameterMap.insert(std::pair<std::string, const std::string>(p_strParameterName, p_strParameterValue));
+		SetStringParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_strParameterValue);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -177,15 +167,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::GetOptionalStringParameter(const std::string& p_strParameterName, std::string& p_strParameterOut, std::string& p_strDefault) const
 	{
-		StringParameterMap::const_iterator find = m_mStringParameterMap.find(p_strParameterName);
-		if (find == m_mStringParameterMap.end())
-		{
-			p_strParameterOut = p_strDefault;
-		}
-		else
-		{
-			p_strParameterOut = find->second;
-		}
+		GetOptionalStringParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_strParameterOut, p_strDefault);
 	}
 
 	//----------------------------------------------------------------------------------------
@@ -199,15 +181,7 @@ namespace HeatStroke
 	//----------------------------------------------------------------------------------------
 	void Event::GetRequiredStringParameter(const std::string& p_strParameterName, std::string& p_strParameterOut) const
 	{
-		StringParameterMap::const_iterator find = m_mStringParameterMap.find(p_strParameterName);
-		if (find == m_mStringParameterMap.end())
-		{
-			assert(false && "Missing Required String Parameter");
-		}
-		else
-		{
-			p_strParameterOut = find->second;
-		}
+		GetRequiredStringParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_strParameterOut);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -220,7 +194,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::SetGameObjectParameter(const std::string& p_strParameterName, const std::string& p_pParameterValue)
 	{
-		m_mGameObjectParameterMap.insert(std::pair<std::string, const std::string>(p_strParameterName, p_pParameterValue));
+		SetGameObjectParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_pParameterValue);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -236,15 +210,7 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void Event::GetOptionalGameObjectParameter(const std::string& p_strParameterName, std::string& p_pParameterOut, const std::string& p_pDefault) const
 	{
-		GameObjectParameterMap::const_iterator find = m_mGameObjectParameterMap.find(p_strParameterName);
-		if (find == m_mGameObjectParameterMap.end())
-		{
-			p_pParameterOut = p_pDefault;
-		}
-		else
-		{
-			p_pParameterOut = find->second;
-		}
+		GetOptionalGameObjectParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_pParameterOut, p_pDefault);
 	}
 
 	//----------------------------------------------------------------------------------------
@@ -258,14 +224,397 @@ namespace HeatStroke
 	//----------------------------------------------------------------------------------------
 	void Event::GetRequiredGameObjectParameter(const std::string& p_strParameterName, std::string& p_pParameterOut) const
 	{
-		GameObjectParameterMap::const_iterator find = m_mGameObjectParameterMap.find(p_strParameterName);
-		if (find == m_mGameObjectParameterMap.end())
+		GetRequiredGameObjectParameter(EventTypeRegistry::InternParameter(p_strParameterName), p_pParameterOut);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::SetIntParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name with which to reference this parameter.
+	//	const int p_iParameterValue - The value of the parameter.
+	//
+	// Sets a parameter of type int on this event. If it was already set, the first value is kept.
+	//-----------------------------------------------------------------------------------------
+	void Event::SetIntParameter(const EventParameterID p_uiParameterID, const int p_iParameterValue)
+	{
+		Parameter* pParameter = AddParameter(p_uiParameterID, PT_Int);
+		if (pParameter != nullptr)
+		{
+			pParameter->iValue = p_iParameterValue;
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetOptionalIntParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	int& p_iParameterOut - The output variable where the result is set.
+	//	const int p_iDefault - If the parameter did not exist on this event, set the output
+	//		to the value of p_iDefault.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetOptionalIntParameter(const EventParameterID p_uiParameterID, int& p_iParameterOut, const int p_iDefault) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_Int);
+		p_iParameterOut = (pParameter == nullptr ? p_iDefault : pParameter->iValue);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetRequiredIntParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	int& p_iParameterOut - The output variable where the result is set.
+	//
+	// If the parameter did not exist, an assertion fails.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetRequiredIntParameter(const EventParameterID p_uiParameterID, int& p_iParameterOut) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_Int);
+		if (pParameter == nullptr)
+		{
+			assert(false && "Missing Required Int Parameter");
+		}
+		else
+		{
+			p_iParameterOut = pParameter->iValue;
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::SetFloatParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name with which to reference this parameter.
+	//	const float p_fParameterValue - The value of the parameter.
+	//
+	// Sets a parameter of type float on this event. If it was already set, the first value is kept.
+	//-----------------------------------------------------------------------------------------
+	void Event::SetFloatParameter(const EventParameterID p_uiParameterID, const float p_fParameterValue)
+	{
+		Parameter* pParameter = AddParameter(p_uiParameterID, PT_Float);
+		if (pParameter != nullptr)
+		{
+			pParameter->fValue = p_fParameterValue;
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetOptionalFloatParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	float& p_fParameterOut - The output variable where the result is set.
+	//	const float p_fDefault - If the parameter did not exist on this event, set the output
+	//		to the value of p_fDefault.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetOptionalFloatParameter(const EventParameterID p_uiParameterID, float& p_fParameterOut, const float p_fDefault) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_Float);
+		p_fParameterOut = (pParameter == nullptr ? p_fDefault : pParameter->fValue);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetRequiredFloatParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	float& p_fParameterOut - The output variable where the result is set.
+	//
+	// If the parameter did not exist, an assertion fails.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetRequiredFloatParameter(const EventParameterID p_uiParameterID, float& p_fParameterOut) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_Float);
+		if (pParameter == nullptr)
+		{
+			assert(false && "Missing Required Float Parameter");
+		}
+		else
+		{
+			p_fParameterOut = pParameter->fValue;
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::SetStringParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name with which to reference this parameter.
+	//	const std::string& p_strParameterValue - The value of the parameter.
+	//
+	// Sets a parameter of type string on this event. If it was already set, the first value is kept.
+	//-----------------------------------------------------------------------------------------
+	void Event::SetStringParameter(const EventParameterID p_uiParameterID, const std::string& p_strParameterValue)
+	{
+		Parameter* pParameter = AddParameter(p_uiParameterID, PT_String);
+		if (pParameter != nullptr)
+		{
+			pParameter->sString = StoreString(p_strParameterValue);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetOptionalStringParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	std::string& p_strParameterOut - The output variable where the result is set.
+	//	const std::string& p_strDefault - If the parameter did not exist on this event, set the output
+	//		to the value of p_strDefault.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetOptionalStringParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut, const std::string& p_strDefault) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_String);
+		if (pParameter == nullptr)
+		{
+			p_strParameterOut = p_strDefault;
+		}
+		else
+		{
+			LoadString(pParameter->sString, p_strParameterOut);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetRequiredStringParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	std::string& p_strParameterOut - The output variable where the result is set.
+	//
+	// If the parameter did not exist, an assertion fails.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetRequiredStringParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_String);
+		if (pParameter == nullptr)
+		{
+			assert(false && "Missing Required String Parameter");
+		}
+		else
+		{
+			LoadString(pParameter->sString, p_strParameterOut);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::SetGameObjectParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name with which to reference this parameter.
+	//	const std::string& p_strParameterValue - The GUID of the Game Object.
+	//
+	// Sets a parameter of type Game Object on this event. If it was already set, the first value is kept.
+	//-----------------------------------------------------------------------------------------
+	void Event::SetGameObjectParameter(const EventParameterID p_uiParameterID, const std::string& p_strParameterValue)
+	{
+		Parameter* pParameter = AddParameter(p_uiParameterID, PT_GameObject);
+		if (pParameter != nullptr)
+		{
+			pParameter->sString = StoreString(p_strParameterValue);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetOptionalGameObjectParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	std::string& p_strParameterOut - The output variable where the result is set.
+	//	const std::string& p_strDefault - If the parameter did not exist on this event, set the output
+	//		to the value of p_strDefault.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetOptionalGameObjectParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut, const std::string& p_strDefault) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_GameObject);
+		if (pParameter == nullptr)
+		{
+			p_strParameterOut = p_strDefault;
+		}
+		else
+		{
+			LoadString(pParameter->sString, p_strParameterOut);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetRequiredGameObjectParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter to get the value of.
+	//	std::string& p_strParameterOut - The output variable where the result is set.
+	//
+	// If the parameter did not exist, an assertion fails.
+	//-----------------------------------------------------------------------------------------
+	void Event::GetRequiredGameObjectParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut) const
+	{
+		const Parameter* pParameter = FindParameter(p_uiParameterID, PT_GameObject);
+		if (pParameter == nullptr)
 		{
 			assert(false && "Missing Required Game Object Parameter");
 		}
 		else
 		{
-			p_pParameterOut = find->second;
+			LoadString(pParameter->sString, p_strParameterOut);
+		}
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::HasSameParameters
+	// Parameters:
+	//	const Event* p_pOther - The event to compare against.
+	// Returns: bool - Whether both events have the same set of parameters with equal values.
+	//
+	// The order parameters were set in doesn't matter. Floats are compared exactly, since
+	// the question is whether a listener would see any difference.
+	//-----------------------------------------------------------------------------------------
+	bool Event::HasSameParameters(const Event* p_pOther) const
+	{
+		if (m_uiParameterCount != p_pOther->m_uiParameterCount ||
+			m_vOverflowParameters.size() != p_pOther->m_vOverflowParameters.size())
+		{
+			return false;
+		}
+
+		const unsigned int uiTotal = m_uiParameterCount + m_vOverflowParameters.size();
+		for (unsigned int i = 0; i < uiTotal; ++i)
+		{
+			const Parameter& mParameter = (i < m_uiParameterCount ? m_aParameters[i] : m_vOverflowParameters[i - m_uiParameterCount]);
+			const Parameter* pOther = p_pOther->FindParameter(mParameter.uiNameID, mParameter.eType);
+			if (pOther == nullptr)
+			{
+				return false;
+			}
+
+			switch (mParameter.eType)
+			{
+			case PT_Int:
+				if (mParameter.iValue != pOther->iValue) return false;
+				break;
+			case PT_Float:
+				if (mParameter.fValue != pOther->fValue) return false;
+				break;
+			case PT_String:
+			case PT_GameObject:
+				if (mParameter.sString.uiLength != pOther->sString.uiLength ||
+					std::memcmp(GetStringData(mParameter.sString), p_pOther->GetStringData(pOther->sString), mParameter.sString.uiLength) != 0)
+				{
+					return false;
+				}
+				break;
+			}
+		}
+
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::FindParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter.
+	//	const ParameterType p_eType - The type the parameter was set as.
+	// Returns: const Parameter* - The parameter, or nullptr if it was never set.
+	//
+	// Events carry only a handful of parameters, so a linear scan beats any lookup structure.
+	//-----------------------------------------------------------------------------------------
+	const Event::Parameter* Event::FindParameter(const EventParameterID p_uiParameterID, const ParameterType p_eType) const
+	{
+		for (unsigned int i = 0; i < m_uiParameterCount; ++i)
+		{
+			if (m_aParameters[i].uiNameID == p_uiParameterID && m_aParameters[i].eType == p_eType)
+			{
+				return &m_aParameters[i];
+			}
+		}
+
+		std::vector<Parameter>::const_iterator it = m_vOverflowParameters.begin(), end = m_vOverflowParameters.end();
+		for (; it != end; ++it)
+		{
+			if (it->uiNameID == p_uiParameterID && it->eType == p_eType)
+			{
+				return &(*it);
+			}
+		}
+
+		return nullptr;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::AddParameter
+	// Parameters:
+	//	const EventParameterID p_uiParameterID - The interned name of the parameter.
+	//	const ParameterType p_eType - The type of the parameter.
+	// Returns: Parameter* - The new parameter for the caller to fill in, or nullptr if a
+	//	parameter of that name and type already exists (the first value set is kept, as
+	//	std::map::insert did before parameters were stored inline).
+	//-----------------------------------------------------------------------------------------
+	Event::Parameter* Event::AddParameter(const EventParameterID p_uiParameterID, const ParameterType p_eType)
+	{
+		if (FindParameter(p_uiParameterID, p_eType) != nullptr)
+		{
+			return nullptr;
+		}
+
+		Parameter* pParameter = nullptr;
+		if (m_uiParameterCount < MAX_INLINE_PARAMETERS)
+		{
+			pParameter = &m_aParameters[m_uiParameterCount++];
+		}
+		else
+		{
+			m_vOverflowParameters.push_back(Parameter());
+			pParameter = &m_vOverflowParameters.back();
+		}
+
+		pParameter->uiNameID = p_uiParameterID;
+		pParameter->eType = p_eType;
+		return pParameter;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::StoreString
+	// Parameters:
+	//	const std::string& p_strValue - The string to copy into this event.
+	// Returns: StringRef - Where the characters were stored.
+	//
+	// Copies into the inline buffer if it fits, otherwise into the overflow string.
+	//-----------------------------------------------------------------------------------------
+	Event::StringRef Event::StoreString(const std::string& p_strValue)
+	{
+		StringRef sString;
+		sString.uiLength = static_cast<unsigned int>(p_strValue.size());
+
+		if (m_uiInlineStringBytes + p_strValue.size() <= MAX_INLINE_STRING_BYTES)
+		{
+			sString.uiOffset = static_cast<unsigned int>(m_uiInlineStringBytes);
+			p_strValue.copy(&m_aInlineStrings[m_uiInlineStringBytes], p_strValue.size());
+			m_uiInlineStringBytes += p_strValue.size();
+		}
+		else
+		{
+			sString.uiOffset = static_cast<unsigned int>(MAX_INLINE_STRING_BYTES + m_strOverflowStrings.size());
+			m_strOverflowStrings.append(p_strValue);
+		}
+
+		return sString;
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::LoadString
+	// Parameters:
+	//	const StringRef& p_sString - Where the characters were stored by StoreString().
+	//	std::string& p_strOut - The output variable where the string is copied.
+	//-----------------------------------------------------------------------------------------
+	void Event::LoadString(const StringRef& p_sString, std::string& p_strOut) const
+	{
+		p_strOut.assign(GetStringData(p_sString), p_sString.uiLength);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// Event::GetStringData
+	// Parameters:
+	//	const StringRef& p_sString - Where the characters were stored by StoreString().
+	// Returns: const char* - The first of p_sString.uiLength characters, not null terminated.
+	//-----------------------------------------------------------------------------------------
+	const char* Event::GetStringData(const StringRef& p_sString) const
+	{
+		if (p_sString.uiOffset < MAX_INLINE_STRING_BYTES)
+		{
+			return &m_aInlineStrings[p_sString.uiOffset];
+		}
+		else
+		{
+			return m_strOverflowStrings.data() + (p_sString.uiOffset - MAX_INLINE_STRING_BYTES);
 		}
 	}
 }
\ No newline at end of file
@@ -9,9 +9,13 @@
 #define EVENT_H
 
 #include <GLFW/glfw3.h>			// Timestamp.
-#include <map>					// Parameters.
+#include <string>				// Parameters.
+#include <vector>				// Overflow parameters.
+#include <atomic>				// Event IDs may be handed out on worker threads.
 
 #include "GameObjectManager.h"	// Ability to look up a GameObject by GUID.
+#include "EventTypeRegistry.h"	// Interned event type IDs.
+#include "EventAllocator.h"		// Pooled and per-frame event memory.
 
 namespace HeatStroke
 {
@@ -20,12 +24,32 @@ namespace HeatStroke
 	public:
 		// Creates a new Event of type p_strEventType and increments m_uiEventIDCounter.
 		Event(const std::string& p_strEventType);
+
+		// Creates a new Event from an already interned event type. Prefer this in hot
+		// paths, as it skips the string lookup in EventTypeRegistry.
+		Event(const EventTypeID p_uiEventTypeID);
 		virtual ~Event() {}
 
+		// Events are allocated through EventAllocator. A plain new gives a pooled event;
+		// new (HeatStroke::EL_Frame) gives one from the frame arena, which may only be
+		// passed straight to EventManager::TriggerEvent(). Either way, EventManager
+		// deletes the event once it has been dispatched.
+		static void* operator new(std::size_t p_uiSize)										{ return EventAllocator::Allocate(p_uiSize, EL_Pooled); }
+		static void* operator new(std::size_t p_uiSize, const EventLifetime p_eLifetime)	{ return EventAllocator::Allocate(p_uiSize, p_eLifetime); }
+		static void operator delete(void* p_pMemory, std::size_t p_uiSize)					{ EventAllocator::Free(p_pMemory, p_uiSize); }
+		static void operator delete(void* p_pMemory, const EventLifetime)					{ EventAllocator::Free(p_pMemory, sizeof(Event)); }
+
 		// Accessors for required event data.
 		unsigned int GetEventID() const			{ return m_uiEventID; }
 		float GetTimeStamp() const				{ return m_fTimeStamp; }
-		const std::string& GetEventType() const { return m_strEventType; }
+		const std::string& GetEventType() const { return EventTypeRegistry::GetName(m_uiEventTypeID); }
+		EventTypeID GetEventTypeID() const		{ return m_uiEventTypeID; }
+
+		// The GameObject this event is addressed to, if any. A targeted event reaches the
+		// listeners registered for its type and target, as well as the ordinary listeners
+		// for its type.
+		const GameObject* GetTarget() const			{ return m_pTarget; }
+		void SetTarget(const GameObject* p_pTarget)	{ m_pTarget = p_pTarget; }
 
 		// Set and access int-type parameters of this event, created and referenced by look-up string.
 		void SetIntParameter(const std::string& p_strParameterName, const int p_iParameterValue);
@@ -47,34 +71,106 @@ namespace HeatStroke
 		void GetOptionalGameObjectParameter(const std::string& p_strParameterName, std::string& p_strParameterOut, const std::string& p_strDefault) const;
 		void GetRequiredGameObjectParameter(const std::string& p_strParameterName, std::string& p_pParameterOut) const;
 
+		// The same accessors keyed by a parameter name already interned with
+		// EventTypeRegistry::InternParameter(), for use in hot paths.
+		void SetIntParameter(const EventParameterID p_uiParameterID, const int p_iParameterValue);
+		void GetOptionalIntParameter(const EventParameterID p_uiParameterID, int& p_iParameterOut, const int p_iDefault) const;
+		void GetRequiredIntParameter(const EventParameterID p_uiParameterID, int& p_iParameterOut) const;
+
+		void SetFloatParameter(const EventParameterID p_uiParameterID, const float p_fParameterValue);
+		void GetOptionalFloatParameter(const EventParameterID p_uiParameterID, float& p_fParameterOut, const float p_fDefault) const;
+		void GetRequiredFloatParameter(const EventParameterID p_uiParameterID, float& p_fParameterOut) const;
+
+		void SetStringParameter(const EventParameterID p_uiParameterID, const std::string& p_strParameterValue);
+		void GetOptionalStringParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut, const std::string& p_strDefault) const;
+		void GetRequiredStringParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut) const;
+
+		void SetGameObjectParameter(const EventParameterID p_uiParameterID, const std::string& p_strParameterValue);
+		void GetOptionalGameObjectParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut, const std::string& p_strDefault) const;
+		void GetRequiredGameObjectParameter(const EventParameterID p_uiParameterID, std::string& p_strParameterOut) const;
+
+		// Whether p_pOther carries exactly the same parameters and values as this event.
+		// Used by EventManager to drop state events that haven't changed.
+		bool HasSameParameters(const Event* p_pOther) const;
+
 	private:
 		//------------------------------------------------------------------------------
-		// Private map typedefs
+		// Private types
 		//------------------------------------------------------------------------------
-		typedef std::map<std::string, const int>			IntParameterMap;
-		typedef	std::map<std::string, const float>			FloatParameterMap;
-		typedef	std::map<std::string, const std::string>	StringParameterMap;
-		typedef std::map<std::string, const std::string>	GameObjectParameterMap;
+		// Parameters of different types live in separate namespaces, as they did when
+		// each type had its own map; the same name may be set once per type.
+		enum ParameterType
+		{
+			PT_Int = 0,
+			PT_Float,
+			PT_String,
+			PT_GameObject
+		};
+
+		// Location of a string value's characters. Offsets below MAX_INLINE_STRING_BYTES
+		// index m_aInlineStrings, anything past that indexes m_strOverflowStrings.
+		struct StringRef
+		{
+			unsigned int uiOffset;
+			unsigned int uiLength;
+		};
+
+		struct Parameter
+		{
+			EventParameterID uiNameID;
+			ParameterType eType;
+			union
+			{
+				int iValue;
+				float fValue;
+				StringRef sString;
+			};
+		};
+
+		// Enough for every event in the race loop without spilling to the heap.
+		// RaceStandingsUpdate is the exception, with a parameter per racer.
+		static const unsigned int MAX_INLINE_PARAMETERS = 8;
+		static const unsigned int MAX_INLINE_STRING_BYTES = 128;
 
 		//------------------------------------------------------------------------------
 		// Private members.
 		//------------------------------------------------------------------------------
 		// This starts at zero and is incremented for each event created so they are all unique.
-		static unsigned int m_uiEventIDCounter;
+		static std::atomic<unsigned int> m_uiEventIDCounter;
 
 		const unsigned int m_uiEventID;
 
 		// Initialized to the value given by glfwGetTime() at the time this event is created.
 		const float m_fTimeStamp;
 
-		// The event type, which narrows down the listeners to only those who care.
-		const std::string m_strEventType;
+		// The interned event type, which narrows down the listeners to only those who care.
+		// The type string itself is owned by EventTypeRegistry.
+		const EventTypeID m_uiEventTypeID;
+
+		// The GameObject this event is addressed to, or nullptr if it is only broadcast.
+		const GameObject* m_pTarget;
+
+		// Inline parameter storage. Parameters are appended in the order they are set.
+		Parameter m_aParameters[MAX_INLINE_PARAMETERS];
+		unsigned int m_uiParameterCount;
+
+		// Inline storage for the characters of string and GameObject parameters.
+		char m_aInlineStrings[MAX_INLINE_STRING_BYTES];
+		unsigned int m_uiInlineStringBytes;
+
+		// Overflow storage, only touched when the inline storage above is full.
+		std::vector<Parameter> m_vOverflowParameters;
+		std::string m_strOverflowStrings;
+
+		//------------------------------------------------------------------------------
+		// Private methods.
+		//------------------------------------------------------------------------------
+		const Parameter* FindParameter(const EventParameterID p_uiParameterID, const ParameterType p_eType) const;
+		Parameter* AddParameter(const EventParameterID p_uiParameterID, const ParameterType p_eType);
 
-		// Various types of maps corresponding to the allowed parameter types for events.
-		IntParameterMap m_mIntParameterMap;
-		FloatParameterMap m_mFloatParameterMap;
-		StringParameterMap m_mStringParameterMap;
-		GameObjectParameterMap m_mGameObjectParameterMap;
+		StringRef StoreString(const std::string& p_strValue);
+		void LoadString(const StringRef& p_sString, std::string& p_strOut) const;
+		const char* GetStringData(const StringRef& p_sString) const;
 	};
 }
 
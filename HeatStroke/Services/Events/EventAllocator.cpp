@@ -0,0 +1,196 @@
+//==================================================================================
+// EventAllocator
+//
+// Backs Event's operator new so events stop hitting the general heap. Two
+// lifetimes are supported:
+//	EL_Pooled - The default. Blocks come from a free list which only grows, so
+//		memory stays flat once the game reaches its peak event count. Safe for
+//		both queued and triggered events.
+//	EL_Frame - Blocks are bumped out of a fixed arena which is reset at the start
+//		of every EventManager::Update(). Only for events that are passed straight
+//		to TriggerEvent(); queued events must outlive the frame.
+// In both cases the event is still released with delete, which EventManager does
+// after dispatch.
+//
+// The pool is guarded by a mutex so worker threads can create events to post to
+// EventManager. The frame arena belongs to the main thread.
+//==================================================================================
+
+#include "EventAllocator.h"
+#include "Event.h"
+
+#include <new>
+#include <type_traits>
+
+namespace
+{
+	// Rounds p_uiSize up to a multiple of the strictest fundamental alignment,
+	// which is what ::operator new guarantees for the chunks themselves.
+	std::size_t AlignedBlockSize(const std::size_t p_uiSize)
+	{
+		const std::size_t uiAlign = std::alignment_of<std::max_align_t>::value;
+		return (p_uiSize + uiAlign - 1) / uiAlign * uiAlign;
+	}
+}
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// EventAllocator::Instance
+	// Returns: EventAllocator& - The one allocator shared by all Events.
+	//------------------------------------------------------------------------------
+	EventAllocator& EventAllocator::Instance()
+	{
+		static EventAllocator s_mEventAllocator;
+		return s_mEventAllocator;
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::EventAllocator
+	//
+	// Sets up the frame arena. The pool starts empty and grows on first use.
+	//------------------------------------------------------------------------------
+	EventAllocator::EventAllocator() :
+		m_uiBlockSize(AlignedBlockSize(sizeof(Event))),
+		m_vPoolChunks(),
+		m_pFreeList(nullptr),
+		m_uiPoolCapacity(0),
+		m_mPoolMutex(),
+		m_pFrameArena(static_cast<char*>(::operator new(AlignedBlockSize(sizeof(Event)) * FRAME_ARENA_BLOCKS))),
+		m_uiFrameBlocksUsed(0),
+		m_uiFrameBlocksLive(0)
+	{
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::~EventAllocator
+	//
+	// Releases the pool chunks and the frame arena.
+	//------------------------------------------------------------------------------
+	EventAllocator::~EventAllocator()
+	{
+		std::vector<char*>::iterator it = m_vPoolChunks.begin(), end = m_vPoolChunks.end();
+		for (; it != end; ++it)
+		{
+			::operator delete(*it);
+		}
+		m_vPoolChunks.clear();
+		m_pFreeList = nullptr;
+
+		::operator delete(m_pFrameArena);
+		m_pFrameArena = nullptr;
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::AllocateBlock
+	// Parameters:
+	//	const std::size_t p_uiSize - The size of the object being created.
+	//	const EventLifetime p_eLifetime - Where the object should be allocated from.
+	// Returns: void* - Memory for the object.
+	//------------------------------------------------------------------------------
+	void* EventAllocator::AllocateBlock(const std::size_t p_uiSize, const EventLifetime p_eLifetime)
+	{
+		if (p_uiSize > m_uiBlockSize)
+		{
+			return ::operator new(p_uiSize);
+		}
+
+		if (p_eLifetime == EL_Frame && m_uiFrameBlocksUsed < FRAME_ARENA_BLOCKS)
+		{
+			void* pBlock = m_pFrameArena + (m_uiFrameBlocksUsed * m_uiBlockSize);
+			++m_uiFrameBlocksUsed;
+			++m_uiFrameBlocksLive;
+			return pBlock;
+		}
+
+		std::lock_guard<std::mutex> mLock(m_mPoolMutex);
+		if (m_pFreeList == nullptr)
+		{
+			GrowPool();
+		}
+
+		PoolBlock* pBlock = m_pFreeList;
+		m_pFreeList = pBlock->pNext;
+		return pBlock;
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::FreeBlock
+	// Parameters:
+	//	void* p_pMemory - Memory returned by AllocateBlock().
+	//	const std::size_t p_uiSize - The size that was passed to AllocateBlock().
+	//
+	// Pooled blocks go back on the free list. Frame blocks are only counted, and
+	// become reusable when the arena is reset.
+	//------------------------------------------------------------------------------
+	void EventAllocator::FreeBlock(void* p_pMemory, const std::size_t p_uiSize)
+	{
+		if (p_pMemory == nullptr)
+		{
+			return;
+		}
+
+		if (p_uiSize > m_uiBlockSize)
+		{
+			::operator delete(p_pMemory);
+		}
+		else if (InFrameArena(p_pMemory))
+		{
+			assert(m_uiFrameBlocksLive > 0);
+			--m_uiFrameBlocksLive;
+		}
+		else
+		{
+			std::lock_guard<std::mutex> mLock(m_mPoolMutex);
+			PoolBlock* pBlock = static_cast<PoolBlock*>(p_pMemory);
+			pBlock->pNext = m_pFreeList;
+			m_pFreeList = pBlock;
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::InFrameArena
+	// Parameters:
+	//	const void* p_pMemory - Any pointer.
+	// Returns: bool - Whether p_pMemory points into the frame arena.
+	//------------------------------------------------------------------------------
+	bool EventAllocator::InFrameArena(const void* p_pMemory) const
+	{
+		const char* pMemory = static_cast<const char*>(p_pMemory);
+		return pMemory >= m_pFrameArena && pMemory < m_pFrameArena + (m_uiBlockSize * FRAME_ARENA_BLOCKS);
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::ResetFrameArena
+	//
+	// Makes the whole frame arena available again. A frame event that is still
+	// alive here was queued or leaked, and its memory is about to be reused.
+	//------------------------------------------------------------------------------
+	void EventAllocator::ResetFrameArena()
+	{
+		assert(m_uiFrameBlocksLive == 0 && "Frame Event Outlived Its Frame");
+		if (m_uiFrameBlocksLive == 0)
+		{
+			m_uiFrameBlocksUsed = 0;
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// EventAllocator::GrowPool
+	//
+	// Adds another chunk of POOL_CHUNK_BLOCKS blocks to the free list.
+	//------------------------------------------------------------------------------
+	void EventAllocator::GrowPool()
+	{
+		char* pChunk = static_cast<char*>(::operator new(m_uiBlockSize * POOL_CHUNK_BLOCKS));
+		m_vPoolChunks.push_back(pChunk);
+
+		for (unsigned int i = POOL_CHUNK_BLOCKS; i > 0; --i)
+		{
+			PoolBlock* pBlock = reinterpret_cast<PoolBlock*>(pChunk + ((i - 1) * m_uiBlockSize));
+			pBlock->pNext = m_pFreeList;
+			m_pFreeList = pBlock;
+		}
+		m_uiPoolCapacity += POOL_CHUNK_BLOCKS;
+	}
+}
@@ -0,0 +1,111 @@
+//==================================================================================
+// EventAllocator
+//
+// Backs Event's operator new so events stop hitting the general heap. Two
+// lifetimes are supported:
+//	EL_Pooled - The default. Blocks come from a free list which only grows, so
+//		memory stays flat once the game reaches its peak event count. Safe for
+//		both queued and triggered events.
+//	EL_Frame - Blocks are bumped out of a fixed arena which is reset at the start
+//		of every EventManager::Update(). Only for events that are passed straight
+//		to TriggerEvent(); queued events must outlive the frame.
+// In both cases the event is still released with delete, which EventManager does
+// after dispatch.
+//
+// The pool is guarded by a mutex so worker threads can create events to post to
+// EventManager. The frame arena belongs to the main thread.
+//==================================================================================
+
+#ifndef EVENT_ALLOCATOR_H
+#define EVENT_ALLOCATOR_H
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	enum EventLifetime
+	{
+		EL_Pooled = 0,
+		EL_Frame
+	};
+
+	class EventAllocator
+	{
+	public:
+		// Returns memory for an object of p_uiSize bytes with the given lifetime.
+		static void* Allocate(const std::size_t p_uiSize, const EventLifetime p_eLifetime)	{ return Instance().AllocateBlock(p_uiSize, p_eLifetime); }
+
+		// Returns memory obtained from Allocate().
+		static void Free(void* p_pMemory, const std::size_t p_uiSize)						{ Instance().FreeBlock(p_pMemory, p_uiSize); }
+
+		// Whether p_pMemory lives in the frame arena.
+		static bool IsFrameAllocation(const void* p_pMemory)								{ return Instance().InFrameArena(p_pMemory); }
+
+		// Makes the whole frame arena available again. Every frame event must have
+		// been deleted by this point.
+		static void ResetFrame()															{ Instance().ResetFrameArena(); }
+
+		// Number of pooled blocks ever created. This should level off during play.
+		static unsigned int GetPoolCapacity()												{ return Instance().m_uiPoolCapacity; }
+
+	private:
+		//---------------------------------------------------------------------------
+		// Private types
+		//---------------------------------------------------------------------------
+		// Free blocks are linked through their own first bytes.
+		struct PoolBlock
+		{
+			PoolBlock* pNext;
+		};
+
+		// Number of blocks allocated at a time when the pool runs dry.
+		static const unsigned int POOL_CHUNK_BLOCKS = 64;
+
+		// Number of blocks in the frame arena. Once exhausted, frame events fall
+		// back to the pool for the rest of the frame.
+		static const unsigned int FRAME_ARENA_BLOCKS = 256;
+
+		//---------------------------------------------------------------------------
+		// Private members
+		//---------------------------------------------------------------------------
+		// Size of every block; sizeof(Event) rounded up to keep blocks aligned.
+		// Larger requests (from classes derived from Event) go to the heap.
+		const std::size_t m_uiBlockSize;
+
+		// Memory owned by the pool, released only on shutdown.
+		std::vector<char*> m_vPoolChunks;
+		PoolBlock* m_pFreeList;
+		unsigned int m_uiPoolCapacity;
+		std::mutex m_mPoolMutex;
+
+		// The frame arena, and how many of its blocks have been handed out and
+		// how many of those are still alive this frame.
+		char* m_pFrameArena;
+		unsigned int m_uiFrameBlocksUsed;
+		unsigned int m_uiFrameBlocksLive;
+
+		//---------------------------------------------------------------------------
+		// Private methods
+		//---------------------------------------------------------------------------
+		// Function-local static, as Events may be created from static initializers.
+		static EventAllocator& Instance();
+
+		EventAllocator();
+		~EventAllocator();
+
+		// EventAllocators shouldn't be copied.
+		EventAllocator(const EventAllocator&) = delete;
+		EventAllocator& operator=(const EventAllocator&) = delete;
+
+		void* AllocateBlock(const std::size_t p_uiSize, const EventLifetime p_eLifetime);
+		void FreeBlock(void* p_pMemory, const std::size_t p_uiSize);
+		bool InFrameArena(const void* p_pMemory) const;
+		void ResetFrameArena();
+		void GrowPool();
+	};
+}
+
+#endif // EVENT_ALLOCATOR_H
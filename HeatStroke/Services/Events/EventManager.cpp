@@ -7,10 +7,52 @@
 // Events are separated by EventType to focus the Events only towards those
 // listeners who want to handle that EventType, and those who want to handle
 // different EventTypes differently.
+//
+// Event types are interned into EventTypeIDs by EventTypeRegistry, and listeners
+// are stored in a flat table indexed by that ID. The string-based methods remain
+// as a thin layer over the ID-based ones.
+//
+// Listeners may also subscribe to a (type, target GameObject) pair. Events with a
+// target set are delivered to those listeners directly, so per-object events no
+// longer need an event type built from the object's GUID.
+//
+// The EventManager owns every event given to it and deletes it after dispatch,
+// which returns its memory to EventAllocator. Update() also resets the frame
+// arena, so frame events must be triggered within the frame they are created.
+//
+// Everything here runs on the main thread except PostEvent(), which worker
+// threads use to hand events back through a lock-free queue that Update() drains.
+// PostEvent() never waits on the main thread, which may itself be waiting on the
+// workers in JobSystem::ParallelFor(); once the queue is full, posted events go to
+// a mutex-guarded overflow list instead.
 //==================================================================================
 
 #include "EventManager.h"
 
+#include <chrono>
+#include <cstdio>
+#include <map>
+
+#include "JobSystem.h"
+
+namespace
+{
+	// Shape of the event traffic EventManager::RunBenchmark() generates.
+	const unsigned int BENCHMARK_EVENT_TYPES = 64;
+	const unsigned int BENCHMARK_LISTENERS_PER_TYPE = 4;
+
+	// Events triggered between calls to Update(), standing in for one frame.
+	const unsigned int BENCHMARK_EVENTS_PER_FRAME = 256;
+
+	// Events each batch of the posting loop posts.
+	const unsigned int BENCHMARK_POST_BATCH_SIZE = 64;
+
+	double MicrosecondsSince(const std::chrono::high_resolution_clock::time_point& p_mStart)
+	{
+		return std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - p_mStart).count();
+	}
+}
+
 namespace HeatStroke
 {
 	// Static singleton instance
@@ -26,6 +68,11 @@ namespace HeatStroke
 	{
 		assert(s_pEventManagerInstance == nullptr);
 		s_pEventManagerInstance = new EventManager;
+
+		// Construct the function-local statics behind event creation now, on the main
+		// thread, as the compiler doesn't guarantee it's safe to do so from workers.
+		EventTypeRegistry::GetCount();
+		EventAllocator::GetPoolCapacity();
 	}
 
 	//------------------------------------------------------------------------------
@@ -53,16 +100,89 @@ namespace HeatStroke
 		return s_pEventManagerInstance;
 	}
 
+	//------------------------------------------------------------------------------
+	// EventManager::~EventManager
+	//
+	// Deletes any events still waiting in the queues, and the last coalesced values.
+	//------------------------------------------------------------------------------
+	EventManager::~EventManager()
+	{
+		const Event* pPosted = nullptr;
+		while (m_mPostedEvents.TryPop(pPosted))
+		{
+			delete pPosted;
+		}
+
+		std::vector<const Event*>::iterator itOverflow = m_vOverflowEvents.begin(), endOverflow = m_vOverflowEvents.end();
+		for (; itOverflow != endOverflow; ++itOverflow)
+		{
+			delete *itOverflow;
+		}
+		m_vOverflowEvents.clear();
+
+		while (!m_mEventQueue.empty())
+		{
+			delete m_mEventQueue.front();
+			m_mEventQueue.pop();
+		}
+
+		CoalescedQueue::iterator it = m_vCoalescedQueue.begin(), end = m_vCoalescedQueue.end();
+		for (; it != end; ++it)
+		{
+			delete it->pEvent;
+		}
+		m_vCoalescedQueue.clear();
+		m_mCoalescedIndices.clear();
+
+		LatestValueMap::iterator itLatest = m_mLatestValues.begin(), endLatest = m_mLatestValues.end();
+		for (; itLatest != endLatest; ++itLatest)
+		{
+			delete itLatest->second;
+		}
+		m_mLatestValues.clear();
+	}
+
 	//----------------------------------------------------------------------------
 	// EventManager::Update
 	// Parameters:
 	//	pDelta - the delta time since the last Update call.
 	//
 	// Empties the event queue by distributing all queued events to all listeners
-	// of the type of each event.
+	// of the type of each event, followed by the newest of each coalesced event.
 	//----------------------------------------------------------------------------
 	void EventManager::Update(const float pDelta)
 	{
+		assert(std::this_thread::get_id() == m_mMainThreadID && "Events Must Be Dispatched On The Main Thread");
+
+		// Every frame event from the last frame has been triggered and deleted by now.
+		EventAllocator::ResetFrame();
+
+		// Bring in what other threads posted since the last Update(). Events posted
+		// while this loop runs wait for the next one, so it always terminates.
+		const Event* pPosted = nullptr;
+		for (unsigned int i = 0; i < POSTED_EVENT_CAPACITY && m_mPostedEvents.TryPop(pPosted); ++i)
+		{
+			m_mEventQueue.push(pPosted);
+		}
+
+		// Then whatever spilled over while the posting queue was full, swapped out so
+		// posting threads aren't held up while it is queued.
+		std::vector<const Event*> vOverflow;
+		{
+			std::lock_guard<std::mutex> mLock(m_mOverflowMutex);
+			vOverflow.swap(m_vOverflowEvents);
+		}
+		std::vector<const Event*>::iterator itOverflow = vOverflow.begin(), endOverflow = vOverflow.end();
+		for (; itOverflow != endOverflow; ++itOverflow)
+		{
+			m_mEventQueue.push(*itOverflow);
+		}
+
+		if (m_mProfiler.IsEnabled())
+		{
+			m_mProfiler.BeginFrame(m_mEventQueue.size() + m_vCoalescedQueue.size());
+		}
+
 		// Iterate over the event queue in the order the events were received.
 		while (!m_mEventQueue.empty())
 		{
@@ -73,6 +193,8 @@ namespace HeatStroke
 			// Dispatch the event to all listeners of the event's type.
 			TriggerEvent(pEvent);
 		}
+
+		DispatchCoalescedEvents();
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -86,9 +208,31 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void EventManager::AddListener(const std::string& p_strEventType, std::function<void(const Event*)>* p_pListener)
 	{
-		// If we didn't already have an item in the map matching p_strEventType,
-		// operator[] adds a vector there using the default constructor.
-		m_mListeners[p_strEventType].push_back(p_pListener);
+		AddListener(EventTypeRegistry::Intern(p_strEventType), p_pListener);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::AddListener
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The interned type of event to listen to.
+	//	std::function<void(Event*)>* - The listener method to call when an event of type
+	//		type p_uiEventTypeID is sent. Return type must be void, parameters must be Event*.
+	//
+	// Adds a listener method to call when an event of type p_uiEventTypeID is sent.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::AddListener(const EventTypeID p_uiEventTypeID, std::function<void(const Event*)>* p_pListener)
+	{
+		// Grow the table to cover every type interned so far, not just this one,
+		// so it is resized rarely.
+		if (p_uiEventTypeID >= m_vListeners.size())
+		{
+			m_vListeners.resize(EventTypeRegistry::GetCount());
+		}
+
+		m_vListeners[p_uiEventTypeID].push_back(p_pListener);
+
+		// This listener hasn't seen any of the values already delivered for this type.
+		ForgetLatestValues(p_uiEventTypeID);
 	}
 
 	//-----------------------------------------------------------------------------------------
@@ -102,9 +246,102 @@ namespace HeatStroke
 	//-----------------------------------------------------------------------------------------
 	void EventManager::RemoveListener(const std::string& p_strEventType, std::function<void(const Event*)>* p_pListener)
 	{
-		m_mListeners[p_strEventType].erase(
-			std::remove(m_mListeners[p_strEventType].begin(), m_mListeners[p_strEventType].end(), p_pListener),
-			m_mListeners[p_strEventType].end());
+		RemoveListener(EventTypeRegistry::Intern(p_strEventType), p_pListener);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::RemoveListener
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The interned type of event to remove the listener from.
+	//	std::function<void(Event*)>* - The listener method to remove from listening to events
+	//		of type p_uiEventTypeID.
+	//
+	// Removes a listener method from listening to events of type p_uiEventTypeID.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::RemoveListener(const EventTypeID p_uiEventTypeID, std::function<void(const Event*)>* p_pListener)
+	{
+		if (p_uiEventTypeID >= m_vListeners.size())
+		{
+			return;
+		}
+
+		RemoveFromList(m_vListeners[p_uiEventTypeID], p_pListener);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::AddListener
+	// Parameters:
+	//	const std::string& p_strEventType - The type of event to listen to.
+	//	const GameObject* p_pTarget - The GameObject the events must be sent to.
+	//	std::function<void(Event*)>* - The listener method to call when an event of type
+	//		type p_strEventType is sent to p_pTarget.
+	//
+	// Adds a listener method to call when an event of type p_strEventType is sent to p_pTarget.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::AddListener(const std::string& p_strEventType, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener)
+	{
+		AddListener(EventTypeRegistry::Intern(p_strEventType), p_pTarget, p_pListener);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::AddListener
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The interned type of event to listen to.
+	//	const GameObject* p_pTarget - The GameObject the events must be sent to.
+	//	std::function<void(Event*)>* - The listener method to call when an event of type
+	//		type p_uiEventTypeID is sent to p_pTarget.
+	//
+	// Adds a listener method to call when an event of type p_uiEventTypeID is sent to p_pTarget.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::AddListener(const EventTypeID p_uiEventTypeID, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener)
+	{
+		assert(p_pTarget != nullptr && "Targeted Listener Needs A Target");
+		m_mTargetedListeners[EventTargetKey(p_uiEventTypeID, p_pTarget)].push_back(p_pListener);
+
+		// This listener hasn't seen the value already delivered to this target.
+		ForgetLatestValue(EventTargetKey(p_uiEventTypeID, p_pTarget));
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::RemoveListener
+	// Parameters:
+	//	const std::string& p_strEventType - The type of event to remove the listener from.
+	//	const GameObject* p_pTarget - The GameObject the listener was added for.
+	//	std::function<void(Event*)>* - The listener method to remove.
+	//
+	// Removes a listener method from listening to events of type p_strEventType sent to p_pTarget.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::RemoveListener(const std::string& p_strEventType, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener)
+	{
+		RemoveListener(EventTypeRegistry::Intern(p_strEventType), p_pTarget, p_pListener);
+	}
+
+	//-----------------------------------------------------------------------------------------
+	// EventManager::RemoveListener
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The interned type of event to remove the listener from.
+	//	const GameObject* p_pTarget - The GameObject the listener was added for.
+	//	std::function<void(Event*)>* - The listener method to remove.
+	//
+	// Removes a listener method from listening to events of type p_uiEventTypeID sent to p_pTarget.
+	// The target is only used as a key, so it is fine if it has already been destroyed.
+	//-----------------------------------------------------------------------------------------
+	void EventManager::RemoveListener(const EventTypeID p_uiEventTypeID, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener)
+	{
+		TargetedListenerMap::iterator find = m_mTargetedListeners.find(EventTargetKey(p_uiEventTypeID, p_pTarget));
+		if (find == m_mTargetedListeners.end())
+		{
+			return;
+		}
+
+		RemoveFromList(find->second, p_pListener);
+
+		// Drop the entry once its object has no listeners left, so the map doesn't
+		// grow with every object ever targeted. Mid-dispatch, compaction does this.
+		if (find->second.empty())
+		{
+			m_mTargetedListeners.erase(find);
+		}
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -112,13 +349,72 @@ namespace HeatStroke
 	// Parameters:
 	//	Event* p_pEvent - The event object to be sent to all 
 	//		listeners of type p_pEvent->GetEventType().
+	//	const QueueMode p_eMode - Whether to deliver every event, or only the newest one for
+	//		each type and target.
 	//
 	// Adds an event to the queue which will be fired to all listeners on the next call
-	// to the Update() method.
+	// to the Update() method. Queued events outlive the frame, so they must be pooled.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::QueueEvent(const Event* p_pEvent, const QueueMode p_eMode)
+	{
+		assert(!EventAllocator::IsFrameAllocation(p_pEvent) && "Frame Events Cannot Be Queued");
+
+		if (p_eMode == QM_Ordered)
+		{
+			m_mEventQueue.push(p_pEvent);
+			return;
+		}
+
+		CoalescedEvent mCoalesced;
+		mCoalesced.pEvent = p_pEvent;
+		mCoalesced.bDropIfUnchanged = (p_eMode == QM_LatestIfChanged);
+
+		const EventTargetKey mKey(p_pEvent->GetEventTypeID(), p_pEvent->GetTarget());
+		CoalescedIndexMap::iterator find = m_mCoalescedIndices.find(mKey);
+		if (find != m_mCoalescedIndices.end())
+		{
+			// The older event was never seen by anyone, so it can simply be replaced.
+			CoalescedEvent& mPending = m_vCoalescedQueue[find->second];
+			if (m_mProfiler.IsEnabled())
+			{
+				m_mProfiler.RecordCoalesced(mPending.pEvent->GetEventTypeID());
+			}
+			delete mPending.pEvent;
+			mPending = mCoalesced;
+		}
+		else
+		{
+			m_mCoalescedIndices.insert(std::pair<EventTargetKey, unsigned int>(mKey, m_vCoalescedQueue.size()));
+			m_vCoalescedQueue.push_back(mCoalesced);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::PostEvent
+	// Parameters:
+	//	Event* p_pEvent - The event object to be sent to all
+	//		listeners of type p_pEvent->GetEventType().
+	//
+	// Adds an event to the queue from any thread. Events posted from the main thread go
+	// straight to the queue; others go through the lock-free posting queue, or the overflow
+	// list if that is full. The main thread may be inside ParallelFor() waiting on the
+	// posting thread, so waiting here for Update() to free space could deadlock.
 	//-------------------------------------------------------------------------------------------
-	void EventManager::QueueEvent(const Event* p_pEvent)
+	void EventManager::PostEvent(const Event* p_pEvent)
 	{
-		m_mEventQueue.push(p_pEvent);
+		assert(!EventAllocator::IsFrameAllocation(p_pEvent) && "Frame Events Cannot Be Posted");
+
+		if (std::this_thread::get_id() == m_mMainThreadID)
+		{
+			m_mEventQueue.push(p_pEvent);
+			return;
+		}
+
+		if (!m_mPostedEvents.TryPush(p_pEvent))
+		{
+			std::lock_guard<std::mutex> mLock(m_mOverflowMutex);
+			m_vOverflowEvents.push_back(p_pEvent);
+		}
 	}
 
 	//-------------------------------------------------------------------------------------------
@@ -127,31 +423,479 @@ namespace HeatStroke
 	//	Event* p_pEvent - The event object to be sent to all
 	//		listeners of type p_pEvent->GetEventType().
 	//
-	// Immediately dispatches p_pEvent to all listeners.
+	// Immediately dispatches p_pEvent to all listeners, starting with those listening to its
+	// target if it has one, then deletes it.
 	//-------------------------------------------------------------------------------------------
 	void EventManager::TriggerEvent(const Event* p_pEvent)
 	{
-		// Confirm the event type so we can send only to those listening.
-		ListenerMap::iterator findListenerList = m_mListeners.find(p_pEvent->GetEventType());
-		if (findListenerList != m_mListeners.end())
+		DispatchEvent(p_pEvent);
+
+		// Everyone has seen the event at this point, so we can clean it up.
+		delete p_pEvent;
+		p_pEvent = nullptr;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::DispatchEvent
+	// Parameters:
+	//	const Event* p_pEvent - The event object to be sent.
+	//
+	// Sends p_pEvent to the listeners of its target, if it has one, and then to the listeners
+	// of its type. The caller remains responsible for deleting the event.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::DispatchEvent(const Event* p_pEvent)
+	{
+		const bool bProfile = m_mProfiler.IsEnabled();
+		const double dStartTime = (bProfile ? m_mProfiler.Now() : 0.0);
+
+		++m_uiDispatchDepth;
+
+		// Deliver to the listeners of the event's target first, if it has one.
+		const EventTypeID uiEventTypeID = p_pEvent->GetEventTypeID();
+		if (p_pEvent->GetTarget() != nullptr)
 		{
-			// Iterate over the listeners and call their handler method with
-			// the Event parameter.
-			// TO DO, currently uses local copy to avoid iterator problems if
-			// AddListener() or RemoveListener() are called during event dispatch
-			ListenerList mLocalCopy(findListenerList->second);
-			ListenerList::iterator it = mLocalCopy.begin();
-			ListenerList::iterator end = mLocalCopy.end();
+			TargetedListenerMap::iterator find = m_mTargetedListeners.find(EventTargetKey(uiEventTypeID, p_pEvent->GetTarget()));
+			if (find != m_mTargetedListeners.end())
+			{
+				DispatchToList(find->second, p_pEvent);
+			}
+		}
 
-			for (; it != end; ++it)
+		// Then to everyone listening to the event's type.
+		if (uiEventTypeID < m_vListeners.size())
+		{
+			// Iterate over the listeners and call their handler method with the Event
+			// parameter. Listeners added during dispatch are appended past uiCount and
+			// will not see this event. The list is re-indexed each iteration because
+			// AddListener() may grow m_vListeners from inside a handler.
+			const unsigned int uiCount = m_vListeners[uiEventTypeID].size();
+			for (unsigned int i = 0; i < uiCount; ++i)
+			{
+				std::function<void(const Event*)>* pListener = m_vListeners[uiEventTypeID][i];
+				if (pListener != nullptr)
+				{
+					(*pListener)(p_pEvent);
+				}
+			}
+		}
+
+		if (bProfile)
+		{
+			m_mProfiler.EndDispatch(uiEventTypeID, dStartTime, m_uiDispatchDepth);
+		}
+
+		--m_uiDispatchDepth;
+		if (m_uiDispatchDepth == 0 && m_bListenersDirty)
+		{
+			CompactListenerLists();
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::DispatchCoalescedEvents
+	//
+	// Delivers the newest event queued for each (type, target) since the last Update(). A
+	// QM_LatestIfChanged event matching the last one delivered for its key is dropped;
+	// otherwise it is kept as the new value to compare against.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::DispatchCoalescedEvents()
+	{
+		// Events queued from inside these listeners wait until the next Update().
+		m_vCoalescedDispatch.swap(m_vCoalescedQueue);
+		m_mCoalescedIndices.clear();
+
+		CoalescedQueue::iterator it = m_vCoalescedDispatch.begin(), end = m_vCoalescedDispatch.end();
+		for (; it != end; ++it)
+		{
+			const Event* pEvent = it->pEvent;
+			if (!it->bDropIfUnchanged)
+			{
+				TriggerEvent(pEvent);
+				continue;
+			}
+
+			const EventTargetKey mKey(pEvent->GetEventTypeID(), pEvent->GetTarget());
+			LatestValueMap::iterator find = m_mLatestValues.find(mKey);
+			if (find != m_mLatestValues.end() && find->second->HasSameParameters(pEvent))
+			{
+				if (m_mProfiler.IsEnabled())
+				{
+					m_mProfiler.RecordCoalesced(pEvent->GetEventTypeID());
+				}
+				delete pEvent;
+				continue;
+			}
+
+			DispatchEvent(pEvent);
+
+			// Look the key up again, a listener may have forgotten it during dispatch.
+			find = m_mLatestValues.find(mKey);
+			if (find != m_mLatestValues.end())
+			{
+				delete find->second;
+				find->second = pEvent;
+			}
+			else
+			{
+				m_mLatestValues.insert(std::pair<EventTargetKey, const Event*>(mKey, pEvent));
+			}
+		}
+		m_vCoalescedDispatch.clear();
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::ForgetLatestValues
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The type of event to forget the values of.
+	//
+	// Forgets the last values delivered for p_uiEventTypeID to every target, so that the
+	// next event of that type is delivered even if it is unchanged.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::ForgetLatestValues(const EventTypeID p_uiEventTypeID)
+	{
+		LatestValueMap::iterator it = m_mLatestValues.begin();
+		while (it != m_mLatestValues.end())
+		{
+			if (it->first.first == p_uiEventTypeID)
+			{
+				delete it->second;
+				it = m_mLatestValues.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::ForgetLatestValue
+	// Parameters:
+	//	const EventTargetKey& p_Key - The type and target to forget the value of.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::ForgetLatestValue(const EventTargetKey& p_Key)
+	{
+		LatestValueMap::iterator find = m_mLatestValues.find(p_Key);
+		if (find != m_mLatestValues.end())
+		{
+			delete find->second;
+			m_mLatestValues.erase(find);
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::ForgetTarget
+	// Parameters:
+	//	const GameObject* p_pTarget - The GameObject to forget the values of.
+	//
+	// Forgets the last values delivered to p_pTarget for every type. The target is only
+	// used as a key, so this is safe to call while it is being destroyed.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::ForgetTarget(const GameObject* p_pTarget)
+	{
+		LatestValueMap::iterator it = m_mLatestValues.begin();
+		while (it != m_mLatestValues.end())
+		{
+			if (it->first.second == p_pTarget)
+			{
+				delete it->second;
+				it = m_mLatestValues.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::RemoveFromList
+	// Parameters:
+	//	ListenerList& p_vListeners - The list to remove the listener from.
+	//	Listener p_pListener - The listener to remove.
+	//
+	// While a dispatch is in progress, the entry is only nulled out so indices stay valid,
+	// and the list is compacted once dispatch unwinds.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::RemoveFromList(ListenerList& p_vListeners, Listener p_pListener)
+	{
+		if (m_uiDispatchDepth > 0)
+		{
+			// A dispatch loop may be walking this list by index, so don't shift it.
+			std::replace(p_vListeners.begin(), p_vListeners.end(), p_pListener, static_cast<Listener>(nullptr));
+			m_bListenersDirty = true;
+		}
+		else
+		{
+			p_vListeners.erase(std::remove(p_vListeners.begin(), p_vListeners.end(), p_pListener), p_vListeners.end());
+		}
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::DispatchToList
+	// Parameters:
+	//	ListenerList& p_vListeners - A targeted listener list, which stays at the same address
+	//		for the whole dispatch.
+	//	const Event* p_pEvent - The event to send.
+	//
+	// Calls every listener that was in the list when dispatch started. The list may still
+	// grow from inside a handler, so it is indexed rather than iterated.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::DispatchToList(ListenerList& p_vListeners, const Event* p_pEvent)
+	{
+		const unsigned int uiCount = p_vListeners.size();
+		for (unsigned int i = 0; i < uiCount; ++i)
+		{
+			Listener pListener = p_vListeners[i];
+			if (pListener != nullptr)
 			{
-				std::function<void(const Event*)>* pListener = (*it);
 				(*pListener)(p_pEvent);
 			}
 		}
+	}
 
-		// Everyone has seen the event at this point, so we can clean it up.
-		delete p_pEvent;
-		p_pEvent = nullptr;
+	//-------------------------------------------------------------------------------------------
+	// EventManager::CompactListenerLists
+	//
+	// Removes the entries nulled out by RemoveListener() while a dispatch was in progress.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::CompactListenerLists()
+	{
+		ListenerTable::iterator it = m_vListeners.begin(), end = m_vListeners.end();
+		for (; it != end; ++it)
+		{
+			it->erase(std::remove(it->begin(), it->end(), static_cast<Listener>(nullptr)), it->end());
+		}
+
+		TargetedListenerMap::iterator itTargeted = m_mTargetedListeners.begin();
+		while (itTargeted != m_mTargetedListeners.end())
+		{
+			ListenerList& vListeners = itTargeted->second;
+			vListeners.erase(std::remove(vListeners.begin(), vListeners.end(), static_cast<Listener>(nullptr)), vListeners.end());
+
+			if (vListeners.empty())
+			{
+				itTargeted = m_mTargetedListeners.erase(itTargeted);
+			}
+			else
+			{
+				++itTargeted;
+			}
+		}
+
+		m_bListenersDirty = false;
+	}
+
+	//-------------------------------------------------------------------------------------------
+	// EventManager::RunBenchmark
+	// Parameters:
+	//	const unsigned int p_uiEvents - The number of events to trigger down each path.
+	//
+	// Triggers p_uiEvents events carrying one int parameter down each listener lookup: the
+	// std::map keyed by type name EventManager used to have, the flat table reached by type
+	// name, and the flat table by interned ID. All three use pooled events, so only the
+	// lookup differs. Then times creating and deleting the same events from the pool against
+	// the frame arena, without dispatching them. Then posts p_uiEvents events from every
+	// thread of a ParallelFor(), far more than the posting queue holds while the main
+	// thread is busy in the loop, and checks that each arrives exactly once.
+	// Prints the results to stdout. Creates and destroys its own EventManager and JobSystem,
+	// so it must run before the game creates them.
+	//-------------------------------------------------------------------------------------------
+	void EventManager::RunBenchmark(const unsigned int p_uiEvents)
+	{
+		CreateInstance();
+		EventManager* pManager = Instance();
+
+		std::vector<std::string> vTypes;
+		std::vector<EventTypeID> vTypeIDs;
+		for (unsigned int i = 0; i < BENCHMARK_EVENT_TYPES; ++i)
+		{
+			vTypes.push_back("BenchmarkEvent" + std::to_string(i));
+			vTypeIDs.push_back(EventTypeRegistry::Intern(vTypes.back()));
+		}
+
+		const EventParameterID uiValueID = EventTypeRegistry::InternParameter("Value");
+
+		// Every listener reads the parameter, as real handlers do, and sums it so the
+		// work can't be optimized away. Every path should come to the same sum.
+		long long iSum = 0;
+		std::vector<std::function<void(const Event*)> > vListeners;
+		for (unsigned int i = 0; i < BENCHMARK_LISTENERS_PER_TYPE; ++i)
+		{
+			vListeners.push_back([&](const Event* p_pEvent) { int iValue; p_pEvent->GetRequiredIntParameter(uiValueID, iValue); iSum += iValue; });
+		}
+		const long long iExpectedSum = static_cast<long long>(p_uiEvents) * (p_uiEvents - 1) / 2 * BENCHMARK_LISTENERS_PER_TYPE;
+
+		// Lookups first. Every path takes its events from the pool and sets the
+		// parameter by ID, so they differ only in how the listeners are found.
+
+		// The std::map keyed by type name that EventManager used before types were
+		// interned, rebuilt here as it no longer exists.
+		std::map<std::string, ListenerList> mListenerMap;
+		for (unsigned int t = 0; t < BENCHMARK_EVENT_TYPES; ++t)
+		{
+			for (unsigned int l = 0; l < BENCHMARK_LISTENERS_PER_TYPE; ++l)
+			{
+				mListenerMap[vTypes[t]].push_back(&vListeners[l]);
+			}
+		}
+
+		std::chrono::high_resolution_clock::time_point mStart = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			Event* pEvent = new Event(vTypeIDs[i % BENCHMARK_EVENT_TYPES]);
+			pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+
+			std::map<std::string, ListenerList>::iterator find = mListenerMap.find(pEvent->GetEventType());
+			if (find != mListenerMap.end())
+			{
+				ListenerList::iterator it = find->second.begin(), end = find->second.end();
+				for (; it != end; ++it)
+				{
+					(**it)(pEvent);
+				}
+			}
+			delete pEvent;
+
+			if (i % BENCHMARK_EVENTS_PER_FRAME == BENCHMARK_EVENTS_PER_FRAME - 1)
+			{
+				pManager->Update(0.0f);
+			}
+		}
+		const double dMapTime = MicrosecondsSince(mStart);
+		const bool bMapSumCorrect = (iSum == iExpectedSum);
+
+		for (unsigned int t = 0; t < BENCHMARK_EVENT_TYPES; ++t)
+		{
+			for (unsigned int l = 0; l < BENCHMARK_LISTENERS_PER_TYPE; ++l)
+			{
+				pManager->AddListener(vTypeIDs[t], &vListeners[l]);
+			}
+		}
+
+		// The flat table, with callers still creating events by type name.
+		iSum = 0;
+		mStart = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			Event* pEvent = new Event(vTypes[i % BENCHMARK_EVENT_TYPES]);
+			pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+			pManager->TriggerEvent(pEvent);
+
+			if (i % BENCHMARK_EVENTS_PER_FRAME == BENCHMARK_EVENTS_PER_FRAME - 1)
+			{
+				pManager->Update(0.0f);
+			}
+		}
+		const double dNameTime = MicrosecondsSince(mStart);
+		const bool bNameSumCorrect = (iSum == iExpectedSum);
+
+		// The flat table, by interned ID.
+		iSum = 0;
+		mStart = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			Event* pEvent = new Event(vTypeIDs[i % BENCHMARK_EVENT_TYPES]);
+			pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+			pManager->TriggerEvent(pEvent);
+
+			if (i % BENCHMARK_EVENTS_PER_FRAME == BENCHMARK_EVENTS_PER_FRAME - 1)
+			{
+				pManager->Update(0.0f);
+			}
+		}
+		const double dIDTime = MicrosecondsSince(mStart);
+		const bool bIDSumCorrect = (iSum == iExpectedSum);
+
+		for (unsigned int t = 0; t < BENCHMARK_EVENT_TYPES; ++t)
+		{
+			for (unsigned int l = 0; l < BENCHMARK_LISTENERS_PER_TYPE; ++l)
+			{
+				pManager->RemoveListener(vTypeIDs[t], &vListeners[l]);
+			}
+		}
+
+		// Then the allocators on their own, creating and deleting events without
+		// dispatching them. Frame events are only reclaimed when Update() resets the
+		// arena, so both loops call it as often as the lookups did.
+		mStart = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			Event* pEvent = new Event(vTypeIDs[i % BENCHMARK_EVENT_TYPES]);
+			pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+			delete pEvent;
+
+			if (i % BENCHMARK_EVENTS_PER_FRAME == BENCHMARK_EVENTS_PER_FRAME - 1)
+			{
+				pManager->Update(0.0f);
+			}
+		}
+		const double dPooledTime = MicrosecondsSince(mStart);
+
+		mStart = std::chrono::high_resolution_clock::now();
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			Event* pEvent = new (EL_Frame) Event(vTypeIDs[i % BENCHMARK_EVENT_TYPES]);
+			pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+			delete pEvent;
+
+			if (i % BENCHMARK_EVENTS_PER_FRAME == BENCHMARK_EVENTS_PER_FRAME - 1)
+			{
+				pManager->Update(0.0f);
+			}
+		}
+		const double dFrameTime = MicrosecondsSince(mStart);
+
+		// Posted from the workers and the main thread at once. Each event carries its
+		// index, and the listener counts how many times each index is delivered.
+		JobSystem::CreateInstance();
+		const EventTypeID uiPostedTypeID = vTypeIDs[0];
+		std::vector<unsigned int> vDeliveries(p_uiEvents, 0);
+		std::function<void(const Event*)> mPostedListener = [&](const Event* p_pEvent)
+		{
+			int iValue;
+			p_pEvent->GetRequiredIntParameter(uiValueID, iValue);
+			++vDeliveries[iValue];
+		};
+		pManager->AddListener(uiPostedTypeID, &mPostedListener);
+
+		mStart = std::chrono::high_resolution_clock::now();
+		JobSystem::Instance()->ParallelFor(p_uiEvents, BENCHMARK_POST_BATCH_SIZE, [&](const unsigned int p_uiBegin, const unsigned int p_uiEnd)
+		{
+			for (unsigned int i = p_uiBegin; i < p_uiEnd; ++i)
+			{
+				Event* pEvent = new Event(uiPostedTypeID);
+				pEvent->SetIntParameter(uiValueID, static_cast<int>(i));
+				pManager->PostEvent(pEvent);
+			}
+		});
+		const double dPostTime = MicrosecondsSince(mStart);
+
+		pManager->Update(0.0f);
+		pManager->RemoveListener(uiPostedTypeID, &mPostedListener);
+		const unsigned int uiWorkers = JobSystem::Instance()->GetWorkerCount();
+		JobSystem::DestroyInstance();
+
+		// A single Update() only drains one queue's worth from the posting queue, so
+		// every event only arrives if the rest went to the overflow list.
+		unsigned int uiDeliveredOnce = 0;
+		for (unsigned int i = 0; i < p_uiEvents; ++i)
+		{
+			uiDeliveredOnce += (vDeliveries[i] == 1 ? 1 : 0);
+		}
+
+		printf("Event dispatch benchmark: %u events over %u types, %u listeners each\n", p_uiEvents, BENCHMARK_EVENT_TYPES, BENCHMARK_LISTENERS_PER_TYPE);
+		printf("%-24s %12s\n", "Listener lookup", "ns/event");
+		printf("%-24s %12.1f%s\n", "std::map by name", dMapTime * 1000.0 / p_uiEvents, bMapSumCorrect ? "" : "  MISMATCH");
+		printf("%-24s %12.1f%s\n", "Table by name", dNameTime * 1000.0 / p_uiEvents, bNameSumCorrect ? "" : "  MISMATCH");
+		printf("%-24s %12.1f%s\n", "Table by interned ID", dIDTime * 1000.0 / p_uiEvents, bIDSumCorrect ? "" : "  MISMATCH");
+		printf("%-24s %12s\n", "Allocation", "ns/event");
+		printf("%-24s %12.1f\n", "Pooled", dPooledTime * 1000.0 / p_uiEvents);
+		printf("%-24s %12.1f\n", "Frame arena", dFrameTime * 1000.0 / p_uiEvents);
+		printf("%-24s %12s\n", "Posting", "ns/event");
+		printf("%-24s %12.1f  (%u workers, queue of %u)\n", "Posted from jobs", dPostTime * 1000.0 / p_uiEvents, uiWorkers, POSTED_EVENT_CAPACITY);
+		printf("%u of %u posted events delivered exactly once%s\n", uiDeliveredOnce, p_uiEvents, uiDeliveredOnce == p_uiEvents ? "" : "  MISMATCH");
+
+		DestroyInstance();
 	}
-}
\ No newline at end of file
+}
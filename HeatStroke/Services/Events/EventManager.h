@@ -7,21 +7,59 @@
 // Events are separated by EventType to focus the Events only towards those
 // listeners who want to handle that EventType, and those who want to handle
 // different EventTypes differently.
+//
+// Event types are interned into EventTypeIDs by EventTypeRegistry, and listeners
+// are stored in a flat table indexed by that ID. The string-based methods remain
+// as a thin layer over the ID-based ones.
+//
+// Listeners may also subscribe to a (type, target GameObject) pair. Events with a
+// target set are delivered to those listeners directly, so per-object events no
+// longer need an event type built from the object's GUID.
+//
+// The EventManager owns every event given to it and deletes it after dispatch,
+// which returns its memory to EventAllocator. Update() also resets the frame
+// arena, so frame events must be triggered within the frame they are created.
+//
+// Everything here runs on the main thread except PostEvent(), which worker
+// threads use to hand events back through a lock-free queue that Update() drains.
+// PostEvent() never waits on the main thread, which may itself be waiting on the
+// workers in JobSystem::ParallelFor(); once the queue is full, posted events go to
+// a mutex-guarded overflow list instead.
 //==================================================================================
 
 #ifndef EVENT_MANAGER_H
 #define EVENT_MANAGER_H
 
-#include <map>
 #include <vector>
+#include <unordered_map>
 #include <functional>
 #include <queue>
+#include <algorithm>
+#include <thread>
+#include <mutex>
 #include <assert.h>
 
 #include "Event.h"
+#include "ConcurrentEventQueue.h"
+#include "EventProfiler.h"
 
 namespace HeatStroke
 {
+	// How QueueEvent() treats an event.
+	enum QueueMode
+	{
+		// Every event is delivered, in the order queued.
+		QM_Ordered = 0,
+
+		// For state-style events: only the newest event queued for each (type, target)
+		// is delivered. These are delivered after the ordered events.
+		QM_Latest,
+
+		// As QM_Latest, and the event is also dropped if its parameters match the last
+		// one delivered for its (type, target) since a listener was added for it.
+		QM_LatestIfChanged
+	};
+
 	class EventManager
 	{
 	public:
@@ -34,40 +72,134 @@ namespace HeatStroke
 		static EventManager* Instance();
 		
 		// Empties the event queue by distributing all queued events to all listeners
-		// of the type of each event.
+		// of the type of each event, followed by the newest of each coalesced event.
 		void Update(const float pDelta);
 
 		// Adds a listener method to call when an event of type p_strEventType is sent.
 		void AddListener(const std::string& p_strEventType, std::function<void(const Event*)>* p_pListener);
+		void AddListener(const EventTypeID p_uiEventTypeID, std::function<void(const Event*)>* p_pListener);
 
 		// Removes a listener method from listening to events of type p_strEventType.
 		void RemoveListener(const std::string& p_strEventType, std::function<void(const Event*)>* p_pListener);
+		void RemoveListener(const EventTypeID p_uiEventTypeID, std::function<void(const Event*)>* p_pListener);
+
+		// Adds a listener method to call when an event of type p_strEventType is sent to p_pTarget.
+		void AddListener(const std::string& p_strEventType, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener);
+		void AddListener(const EventTypeID p_uiEventTypeID, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener);
+
+		// Removes a listener method from listening to events of type p_strEventType sent to p_pTarget.
+		void RemoveListener(const std::string& p_strEventType, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener);
+		void RemoveListener(const EventTypeID p_uiEventTypeID, const GameObject* p_pTarget, std::function<void(const Event*)>* p_pListener);
 
 		// Adds an event to the queue which will be fired to all listeners on the next call
-		// to the Update() method.
-		void QueueEvent(const Event* p_pEvent);
+		// to the Update() method. The event must not come from the frame arena.
+		// With QM_Latest or QM_LatestIfChanged, it replaces any event of the same type
+		// and target still waiting in the queue.
+		void QueueEvent(const Event* p_pEvent, const QueueMode p_eMode = QM_Ordered);
+
+		// Adds an event to the queue from any thread. It is delivered from the next Update()
+		// on; events posted from other threads have no defined order among themselves or
+		// relative to QueueEvent(). Never blocks waiting for the main thread.
+		void PostEvent(const Event* p_pEvent);
 
-		// Immediately dispatches p_pEvent to all listeners.
+		// Immediately dispatches p_pEvent to all listeners, including those listening to
+		// its target if it has one, then deletes it.
 		void TriggerEvent(const Event* p_pEvent);
 
+		// Forgets the last QM_LatestIfChanged values delivered to p_pTarget. Called when a
+		// GameObject is destroyed or pooled, so one later created at the same address
+		// doesn't have its first event dropped as unchanged.
+		void ForgetTarget(const GameObject* p_pTarget);
+
+		// Per-type dispatch counts, listener times and queue depth, off by default.
+		EventProfiler& GetProfiler()	{ return m_mProfiler; }
+
+		// Times p_uiEvents events dispatched through the old std::map keyed by type name
+		// and through the listener table by name and by interned ID, and the pooled
+		// allocator against the frame arena on their own. Then posts p_uiEvents events
+		// from inside a JobSystem::ParallelFor() and checks every one is delivered.
+		// Prints the results to stdout. Creates and destroys its own EventManager and
+		// JobSystem, so it must be called while neither exists.
+		static void RunBenchmark(const unsigned int p_uiEvents);
+
 	private:
 		//---------------------------------------------------------------------------
 		// Private typedefs for data structures.
 		//---------------------------------------------------------------------------
 		typedef std::function<void(const Event*)>* Listener;
 		typedef std::vector<Listener> ListenerList;
-		typedef std::map<const std::string, ListenerList> ListenerMap;
+		typedef std::vector<ListenerList> ListenerTable;
 		typedef std::queue<const Event*> EventQueue;
 
+		// Targeted listeners are keyed by (event type, target). An unordered_map keeps
+		// each list at a stable address while other entries are inserted, which the
+		// dispatch loop relies on.
+		typedef std::pair<EventTypeID, const GameObject*> EventTargetKey;
+		struct EventTargetKeyHash
+		{
+			std::size_t operator()(const EventTargetKey& p_Key) const
+			{
+				return std::hash<const GameObject*>()(p_Key.second) ^ (std::hash<EventTypeID>()(p_Key.first) * 31);
+			}
+		};
+		typedef std::unordered_map<EventTargetKey, ListenerList, EventTargetKeyHash> TargetedListenerMap;
+
+		// Coalesced events waiting for Update(), in the order their key was first
+		// queued, with the index of each key's slot for replacing it.
+		struct CoalescedEvent
+		{
+			const Event* pEvent;
+			bool bDropIfUnchanged;
+		};
+		typedef std::vector<CoalescedEvent> CoalescedQueue;
+		typedef std::unordered_map<EventTargetKey, unsigned int, EventTargetKeyHash> CoalescedIndexMap;
+
+		// The last QM_LatestIfChanged event delivered for each key, kept to compare against.
+		typedef std::unordered_map<EventTargetKey, const Event*, EventTargetKeyHash> LatestValueMap;
+
 		//---------------------------------------------------------------------------
 		// Private members
 		//---------------------------------------------------------------------------
-		// The map of listeners organized by event type.
-		ListenerMap m_mListeners;
+		// The lists of listeners, indexed by EventTypeID.
+		ListenerTable m_vListeners;
+
+		// The lists of listeners for events sent to a particular GameObject.
+		TargetedListenerMap m_mTargetedListeners;
+
+		// How many TriggerEvent() calls are currently on the stack. While non-zero,
+		// RemoveListener() only nulls out entries so indices stay valid for the
+		// dispatch loop, and the lists are compacted once dispatch unwinds.
+		unsigned int m_uiDispatchDepth;
+		bool m_bListenersDirty;
 
 		// The queue of events which will be dispatched and emptied every Update() call.
 		EventQueue m_mEventQueue;
 
+		// Coalesced events. Update() swaps the queue with m_vCoalescedDispatch so events
+		// queued by listeners wait for the next Update() without reallocating.
+		CoalescedQueue m_vCoalescedQueue;
+		CoalescedQueue m_vCoalescedDispatch;
+		CoalescedIndexMap m_mCoalescedIndices;
+		LatestValueMap m_mLatestValues;
+
+		// Events posted from other threads, moved to m_mEventQueue by Update().
+		ConcurrentEventQueue m_mPostedEvents;
+
+		// Events posted while m_mPostedEvents was full, moved to m_mEventQueue by
+		// Update() after it. Only touched on the rare frames that post that much.
+		std::vector<const Event*> m_vOverflowEvents;
+		std::mutex m_mOverflowMutex;
+
+		// The thread which created the EventManager, the only one that may dispatch.
+		const std::thread::id m_mMainThreadID;
+
+		// Instrumentation for DispatchEvent() and Update().
+		EventProfiler m_mProfiler;
+
+		// Number of events that can be posted between two Update() calls before
+		// posting threads fall back to m_vOverflowEvents.
+		static const unsigned int POSTED_EVENT_CAPACITY = 1024;
+
 		// Static singleton instance
 		static EventManager* s_pEventManagerInstance;
 
@@ -75,12 +207,34 @@ namespace HeatStroke
 		// Private methods
 		//---------------------------------------------------------------------------
 		// Hide constructor and destructor for singleton.
-		EventManager() : m_mListeners(), m_mEventQueue() {}
-		virtual ~EventManager() {}
+		EventManager() : m_vListeners(), m_mTargetedListeners(), m_uiDispatchDepth(0), m_bListenersDirty(false), m_mEventQueue(),
+			m_vCoalescedQueue(), m_vCoalescedDispatch(), m_mCoalescedIndices(), m_mLatestValues(),
+			m_mPostedEvents(POSTED_EVENT_CAPACITY), m_vOverflowEvents(), m_mOverflowMutex(), m_mMainThreadID(std::this_thread::get_id()), m_mProfiler() {}
+		virtual ~EventManager();
 
 		// EventManagers shouldn't be copied.
 		EventManager(const EventManager&) = delete;
 		EventManager& operator=(const EventManager&) = delete;
+
+		// Sends p_pEvent to its listeners without deleting it.
+		void DispatchEvent(const Event* p_pEvent);
+
+		// Delivers the coalesced events queued before this Update().
+		void DispatchCoalescedEvents();
+
+		// Forgets the last values delivered for p_uiEventTypeID, to all targets or to one,
+		// so a newly added listener receives the next value even if it is unchanged.
+		void ForgetLatestValues(const EventTypeID p_uiEventTypeID);
+		void ForgetLatestValue(const EventTargetKey& p_Key);
+
+		// Removes p_pListener from p_vListeners, or nulls it out if a dispatch is in progress.
+		void RemoveFromList(ListenerList& p_vListeners, Listener p_pListener);
+
+		// Calls every listener in p_vListeners that was present when dispatch started.
+		void DispatchToList(ListenerList& p_vListeners, const Event* p_pEvent);
+
+		// Removes the entries nulled out by RemoveListener() during dispatch.
+		void CompactListenerLists();
 	};
 }
 
@@ -0,0 +1,281 @@
+//==================================================================================
+// EventProfiler
+//
+// Optional instrumentation for EventManager. While enabled it counts how often
+// each event type is dispatched and how long its listeners take, and records the
+// depth of the event queue at the start of every Update(). It can also record a
+// trace of every dispatch, written out in the Chrome trace format so it can be
+// opened in chrome://tracing to find event storms frame by frame.
+//
+// Listener times are inclusive: an event triggered from inside a listener counts
+// towards both its own type and the type of the event that triggered it.
+//==================================================================================
+
+#include "EventProfiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace
+{
+	// Event types are plain identifiers, but escape them anyway so a stray quote
+	// can't break the trace file.
+	std::string EscapeJSON(const std::string& p_strValue)
+	{
+		std::string strEscaped;
+		strEscaped.reserve(p_strValue.size());
+		for (std::string::const_iterator it = p_strValue.begin(); it != p_strValue.end(); ++it)
+		{
+			if (*it == '"' || *it == '\\')
+			{
+				strEscaped.push_back('\\');
+			}
+			strEscaped.push_back(*it);
+		}
+		return strEscaped;
+	}
+}
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// EventProfiler::EventProfiler
+	//------------------------------------------------------------------------------
+	EventProfiler::EventProfiler() :
+		m_bEnabled(false),
+		m_vTypeStats(),
+		m_vFrameTypes(),
+		m_mCurrentFrame(),
+		m_mLastFrame(),
+		m_bTracing(false),
+		m_vTrace(),
+		m_vQueueDepthTrace()
+	{
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::Reset
+	//
+	// Clears all statistics gathered so far. Any trace in progress carries on.
+	//------------------------------------------------------------------------------
+	void EventProfiler::Reset()
+	{
+		m_vTypeStats.clear();
+		m_vFrameTypes.clear();
+		m_mCurrentFrame = FrameStats();
+		m_mLastFrame = FrameStats();
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::GetTypeStats
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The event type to get the statistics of.
+	// Returns: const TypeStats& - The statistics, all zero if it was never dispatched.
+	//------------------------------------------------------------------------------
+	const EventProfiler::TypeStats& EventProfiler::GetTypeStats(const EventTypeID p_uiEventTypeID) const
+	{
+		static const TypeStats s_mEmptyStats = TypeStats();
+		return (p_uiEventTypeID < m_vTypeStats.size() ? m_vTypeStats[p_uiEventTypeID] : s_mEmptyStats);
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::PrintSummary
+	// Parameters:
+	//	const unsigned int p_uiMaxTypes - How many event types to list.
+	//
+	// Prints the event types with the most total listener time to stdout, along with
+	// the last frame's statistics.
+	//------------------------------------------------------------------------------
+	void EventProfiler::PrintSummary(const unsigned int p_uiMaxTypes) const
+	{
+		std::vector<EventTypeID> vTypes;
+		for (EventTypeID i = 0; i < m_vTypeStats.size(); ++i)
+		{
+			if (m_vTypeStats[i].uiTotalCount > 0 || m_vTypeStats[i].uiCoalescedCount > 0)
+			{
+				vTypes.push_back(i);
+			}
+		}
+
+		std::sort(vTypes.begin(), vTypes.end(), [this](EventTypeID a, EventTypeID b)
+		{
+			return m_vTypeStats[a].dTotalTime > m_vTypeStats[b].dTotalTime;
+		});
+
+		printf("EventProfiler: last frame %u queued, %u dispatched, %.3f ms in listeners\n",
+			m_mLastFrame.uiQueueDepth, m_mLastFrame.uiDispatchCount, m_mLastFrame.dListenerTime * 1000.0);
+		printf("%-32s %10s %10s %12s %10s %10s\n", "Event Type", "Count", "Frame", "Total (ms)", "Max (us)", "Coalesced");
+
+		const unsigned int uiCount = std::min(p_uiMaxTypes, static_cast<unsigned int>(vTypes.size()));
+		for (unsigned int i = 0; i < uiCount; ++i)
+		{
+			const TypeStats& mStats = m_vTypeStats[vTypes[i]];
+			printf("%-32s %10u %10u %12.3f %10.1f %10u\n",
+				EventTypeRegistry::GetName(vTypes[i]).c_str(),
+				mStats.uiTotalCount,
+				mStats.uiFrameCount,
+				mStats.dTotalTime * 1000.0,
+				mStats.dMaxTime * 1000000.0,
+				mStats.uiCoalescedCount);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::StartTrace
+	//
+	// Discards any previous trace and starts recording every dispatch. Enables the
+	// profiler if it wasn't already.
+	//------------------------------------------------------------------------------
+	void EventProfiler::StartTrace()
+	{
+		m_bEnabled = true;
+		m_bTracing = true;
+		m_vTrace.clear();
+		m_vQueueDepthTrace.clear();
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::StopTrace
+	// Parameters:
+	//	const std::string& p_strFileName - Where to write the trace.
+	// Returns: bool - Whether the file was written.
+	//
+	// Writes the recorded dispatches as complete ("X") events and the queue depth as
+	// a counter ("C") track, with times in microseconds as the format expects.
+	//------------------------------------------------------------------------------
+	bool EventProfiler::StopTrace(const std::string& p_strFileName)
+	{
+		m_bTracing = false;
+
+		std::ofstream mFile(p_strFileName.c_str());
+		if (!mFile.is_open())
+		{
+			return false;
+		}
+
+		mFile << "{\"traceEvents\":[\n";
+		bool bFirst = true;
+
+		std::vector<TraceRecord>::const_iterator it = m_vTrace.begin(), end = m_vTrace.end();
+		for (; it != end; ++it)
+		{
+			mFile << (bFirst ? "" : ",\n")
+				<< "{\"name\":\"" << EscapeJSON(EventTypeRegistry::GetName(it->uiEventTypeID))
+				<< "\",\"cat\":\"event\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << (it->dStartTime * 1000000.0)
+				<< ",\"dur\":" << (it->dDuration * 1000000.0) << "}";
+			bFirst = false;
+		}
+
+		std::vector<QueueDepthRecord>::const_iterator itDepth = m_vQueueDepthTrace.begin(), endDepth = m_vQueueDepthTrace.end();
+		for (; itDepth != endDepth; ++itDepth)
+		{
+			mFile << (bFirst ? "" : ",\n")
+				<< "{\"name\":\"EventQueueDepth\",\"ph\":\"C\",\"pid\":0,\"ts\":" << (itDepth->dTime * 1000000.0)
+				<< ",\"args\":{\"depth\":" << itDepth->uiQueueDepth << "}}";
+			bFirst = false;
+		}
+
+		mFile << "\n]}\n";
+
+		m_vTrace.clear();
+		m_vQueueDepthTrace.clear();
+		return mFile.good();
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::BeginFrame
+	// Parameters:
+	//	const unsigned int p_uiQueueDepth - The number of events waiting at the start
+	//		of EventManager::Update().
+	//
+	// Closes off the previous frame's statistics and starts a new frame.
+	//------------------------------------------------------------------------------
+	void EventProfiler::BeginFrame(const unsigned int p_uiQueueDepth)
+	{
+		m_mLastFrame = m_mCurrentFrame;
+		m_mCurrentFrame = FrameStats();
+		m_mCurrentFrame.uiQueueDepth = p_uiQueueDepth;
+
+		std::vector<EventTypeID>::const_iterator it = m_vFrameTypes.begin(), end = m_vFrameTypes.end();
+		for (; it != end; ++it)
+		{
+			m_vTypeStats[*it].uiFrameCount = 0;
+			m_vTypeStats[*it].dFrameTime = 0.0;
+		}
+		m_vFrameTypes.clear();
+
+		if (m_bTracing)
+		{
+			QueueDepthRecord mRecord;
+			mRecord.dTime = Now();
+			mRecord.uiQueueDepth = p_uiQueueDepth;
+			m_vQueueDepthTrace.push_back(mRecord);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::EndDispatch
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The type of event that was dispatched.
+	//	const double p_dStartTime - Now() from just before the listeners were called.
+	//	const unsigned int p_uiDepth - How many dispatches were on the stack, including
+	//		this one. Only depth 1 counts towards the frame's listener time.
+	//------------------------------------------------------------------------------
+	void EventProfiler::EndDispatch(const EventTypeID p_uiEventTypeID, const double p_dStartTime, const unsigned int p_uiDepth)
+	{
+		const double dDuration = Now() - p_dStartTime;
+
+		TypeStats& mStats = GetOrAddTypeStats(p_uiEventTypeID);
+		if (mStats.uiFrameCount == 0)
+		{
+			m_vFrameTypes.push_back(p_uiEventTypeID);
+		}
+		++mStats.uiTotalCount;
+		++mStats.uiFrameCount;
+		mStats.dTotalTime += dDuration;
+		mStats.dFrameTime += dDuration;
+		mStats.dMaxTime = std::max(mStats.dMaxTime, dDuration);
+
+		++m_mCurrentFrame.uiDispatchCount;
+		if (p_uiDepth == 1)
+		{
+			m_mCurrentFrame.dListenerTime += dDuration;
+		}
+
+		if (m_bTracing && m_vTrace.size() < MAX_TRACE_RECORDS)
+		{
+			TraceRecord mRecord;
+			mRecord.uiEventTypeID = p_uiEventTypeID;
+			mRecord.dStartTime = p_dStartTime;
+			mRecord.dDuration = dDuration;
+			m_vTrace.push_back(mRecord);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::RecordCoalesced
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The type of event that was replaced by a
+	//		newer one, or dropped as unchanged.
+	//------------------------------------------------------------------------------
+	void EventProfiler::RecordCoalesced(const EventTypeID p_uiEventTypeID)
+	{
+		++GetOrAddTypeStats(p_uiEventTypeID).uiCoalescedCount;
+	}
+
+	//------------------------------------------------------------------------------
+	// EventProfiler::GetOrAddTypeStats
+	// Parameters:
+	//	const EventTypeID p_uiEventTypeID - The event type to get the statistics of.
+	// Returns: TypeStats& - The statistics, growing the table if needed.
+	//------------------------------------------------------------------------------
+	EventProfiler::TypeStats& EventProfiler::GetOrAddTypeStats(const EventTypeID p_uiEventTypeID)
+	{
+		if (p_uiEventTypeID >= m_vTypeStats.size())
+		{
+			m_vTypeStats.resize(EventTypeRegistry::GetCount(), TypeStats());
+		}
+		return m_vTypeStats[p_uiEventTypeID];
+	}
+}
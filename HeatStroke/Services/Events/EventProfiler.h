@@ -0,0 +1,145 @@
+//==================================================================================
+// EventProfiler
+//
+// Optional instrumentation for EventManager. While enabled it counts how often
+// each event type is dispatched and how long its listeners take, and records the
+// depth of the event queue at the start of every Update(). It can also record a
+// trace of every dispatch, written out in the Chrome trace format so it can be
+// opened in chrome://tracing to find event storms frame by frame.
+//
+// Listener times are inclusive: an event triggered from inside a listener counts
+// towards both its own type and the type of the event that triggered it.
+//==================================================================================
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+
+#include "EventTypeRegistry.h"
+
+namespace HeatStroke
+{
+	class EventProfiler
+	{
+	public:
+		//------------------------------------------------------------------------------
+		// Public types
+		//------------------------------------------------------------------------------
+		struct TypeStats
+		{
+			// Dispatches since the profiler was enabled or reset, and since the start of
+			// the most recent EventManager::Update().
+			unsigned int uiTotalCount;
+			unsigned int uiFrameCount;
+
+			// Coalesced events that were replaced or dropped instead of being dispatched.
+			unsigned int uiCoalescedCount;
+
+			// Time spent in listeners, in seconds.
+			double dTotalTime;
+			double dMaxTime;
+			double dFrameTime;
+		};
+
+		struct FrameStats
+		{
+			// Events waiting to be dispatched at the start of Update().
+			unsigned int uiQueueDepth;
+
+			// Events dispatched during the frame, including those from inside listeners.
+			unsigned int uiDispatchCount;
+
+			// Time spent in listeners during the frame, in seconds, not double counting
+			// events triggered from inside other listeners.
+			double dListenerTime;
+		};
+
+		//------------------------------------------------------------------------------
+		// Public methods
+		//------------------------------------------------------------------------------
+		EventProfiler();
+
+		// Profiling is off by default, and costs one branch per dispatch while off.
+		void SetEnabled(const bool p_bEnabled)	{ m_bEnabled = p_bEnabled; }
+		bool IsEnabled() const					{ return m_bEnabled; }
+
+		// Clears all statistics gathered so far.
+		void Reset();
+
+		// Statistics for one event type. Types never dispatched while profiling have
+		// all-zero stats.
+		const TypeStats& GetTypeStats(const EventTypeID p_uiEventTypeID) const;
+
+		// Statistics for the last complete frame.
+		const FrameStats& GetLastFrameStats() const	{ return m_mLastFrame; }
+
+		// Prints the p_uiMaxTypes event types with the most listener time to stdout.
+		void PrintSummary(const unsigned int p_uiMaxTypes) const;
+
+		// Records every dispatch from now until StopTrace(), which writes them to
+		// p_strFileName in the Chrome trace format. Returns false if the file
+		// couldn't be written.
+		void StartTrace();
+		bool StopTrace(const std::string& p_strFileName);
+		bool IsTracing() const						{ return m_bTracing; }
+
+		// Hooks called by EventManager.
+		double Now() const							{ return glfwGetTime(); }
+		void BeginFrame(const unsigned int p_uiQueueDepth);
+		void EndDispatch(const EventTypeID p_uiEventTypeID, const double p_dStartTime, const unsigned int p_uiDepth);
+		void RecordCoalesced(const EventTypeID p_uiEventTypeID);
+
+	private:
+		//------------------------------------------------------------------------------
+		// Private types
+		//------------------------------------------------------------------------------
+		struct TraceRecord
+		{
+			EventTypeID uiEventTypeID;
+			double dStartTime;
+			double dDuration;
+		};
+
+		struct QueueDepthRecord
+		{
+			double dTime;
+			unsigned int uiQueueDepth;
+		};
+
+		// Tracing stops recording once this many dispatches have been captured, so a
+		// forgotten trace can't eat all the memory.
+		static const unsigned int MAX_TRACE_RECORDS = 1 << 20;
+
+		//------------------------------------------------------------------------------
+		// Private members
+		//------------------------------------------------------------------------------
+		bool m_bEnabled;
+
+		// Indexed by EventTypeID, grown as new types are dispatched.
+		std::vector<TypeStats> m_vTypeStats;
+
+		// Types dispatched this frame, whose frame counters must be reset.
+		std::vector<EventTypeID> m_vFrameTypes;
+
+		FrameStats m_mCurrentFrame;
+		FrameStats m_mLastFrame;
+
+		bool m_bTracing;
+		std::vector<TraceRecord> m_vTrace;
+		std::vector<QueueDepthRecord> m_vQueueDepthTrace;
+
+		//------------------------------------------------------------------------------
+		// Private methods
+		//------------------------------------------------------------------------------
+		TypeStats& GetOrAddTypeStats(const EventTypeID p_uiEventTypeID);
+
+		// EventProfilers shouldn't be copied.
+		EventProfiler(const EventProfiler&) = delete;
+		EventProfiler& operator=(const EventProfiler&) = delete;
+	};
+}
+
+#endif // EVENT_PROFILER_H
@@ -0,0 +1,28 @@
+//==================================================================================
+// EventTypeRegistry
+//
+// Interns event type strings into compact integer IDs. Each distinct event type
+// string is assigned an ID once, the first time it is seen, and the same ID is
+// returned for it from then on. IDs are dense (0, 1, 2, ...) so they can be used
+// to index directly into flat tables such as EventManager's listener table.
+//
+// Event parameter names are interned the same way, in a separate table, so that
+// Events can key their inline parameters by integer.
+//==================================================================================
+
+#include "EventTypeRegistry.h"
+
+namespace HeatStroke
+{
+	StringInterner& EventTypeRegistry::GetEventTypes()
+	{
+		static StringInterner s_mEventTypes;
+		return s_mEventTypes;
+	}
+
+	StringInterner& EventTypeRegistry::GetParameterNames()
+	{
+		static StringInterner s_mParameterNames;
+		return s_mParameterNames;
+	}
+}
@@ -0,0 +1,53 @@
+//==================================================================================
+// EventTypeRegistry
+//
+// Interns event type strings into compact integer IDs. Each distinct event type
+// string is assigned an ID once, the first time it is seen, and the same ID is
+// returned for it from then on. IDs are dense (0, 1, 2, ...) so they can be used
+// to index directly into flat tables such as EventManager's listener table.
+//
+// Event parameter names are interned the same way, in a separate table, so that
+// Events can key their inline parameters by integer.
+//==================================================================================
+
+#ifndef EVENT_TYPE_REGISTRY_H
+#define EVENT_TYPE_REGISTRY_H
+
+#include "StringInterner.h"
+
+namespace HeatStroke
+{
+	// Compact identifier for an event type string.
+	typedef unsigned int EventTypeID;
+
+	// Compact identifier for an event parameter name.
+	typedef unsigned int EventParameterID;
+
+	class EventTypeRegistry
+	{
+	public:
+		// Returns the ID for p_strEventType, registering it if it hasn't been seen before.
+		static EventTypeID Intern(const std::string& p_strEventType)				{ return GetEventTypes().Intern(p_strEventType); }
+
+		// Returns the string that was interned to produce p_uiEventTypeID.
+		static const std::string& GetName(const EventTypeID p_uiEventTypeID)		{ return GetEventTypes().GetName(p_uiEventTypeID); }
+
+		// The number of event types interned so far. All valid IDs are below this value.
+		static unsigned int GetCount()												{ return GetEventTypes().GetCount(); }
+
+		// Same as above, for event parameter names.
+		static EventParameterID InternParameter(const std::string& p_strName)		{ return GetParameterNames().Intern(p_strName); }
+		static const std::string& GetParameterName(const EventParameterID p_uiID)	{ return GetParameterNames().GetName(p_uiID); }
+
+	private:
+		// Function-local statics so that names may be interned from static
+		// initializers in other translation units regardless of initialization order.
+		static StringInterner& GetEventTypes();
+		static StringInterner& GetParameterNames();
+
+		// Only static methods, never instantiated.
+		EventTypeRegistry() = delete;
+	};
+}
+
+#endif // EVENT_TYPE_REGISTRY_H
@@ -0,0 +1,63 @@
+//==================================================================================
+// StringInterner
+//
+// Assigns each distinct string a compact integer ID the first time it is seen and
+// returns the same ID for it from then on. IDs are dense (0, 1, 2, ...) so they
+// can be used to index directly into flat tables.
+//
+// Interning is guarded by a mutex so that events may be created on worker threads.
+//==================================================================================
+
+#include "StringInterner.h"
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// StringInterner::Intern
+	// Parameters:
+	//	const std::string& p_strValue - The string to look up.
+	// Returns: unsigned int - The ID permanently associated with p_strValue.
+	//
+	// Returns the ID for p_strValue, registering it if it hasn't been seen before.
+	//------------------------------------------------------------------------------
+	unsigned int StringInterner::Intern(const std::string& p_strValue)
+	{
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+
+		IDMap::const_iterator find = m_mIDMap.find(p_strValue);
+		if (find != m_mIDMap.end())
+		{
+			return find->second;
+		}
+
+		unsigned int uiID = static_cast<unsigned int>(m_vNames.size());
+		m_vNames.push_back(p_strValue);
+		m_mIDMap.insert(std::pair<std::string, unsigned int>(p_strValue, uiID));
+		return uiID;
+	}
+
+	//------------------------------------------------------------------------------
+	// StringInterner::GetName
+	// Parameters:
+	//	const unsigned int p_uiID - An ID previously returned by Intern().
+	// Returns: const std::string& - The string for that ID.
+	//------------------------------------------------------------------------------
+	const std::string& StringInterner::GetName(const unsigned int p_uiID) const
+	{
+		// The deque never moves its strings, so the reference outlives the lock.
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		assert(p_uiID < m_vNames.size() && "Unknown Interned String ID");
+		return m_vNames[p_uiID];
+	}
+
+	//------------------------------------------------------------------------------
+	// StringInterner::GetCount
+	// Returns: unsigned int - The number of strings interned so far. All valid IDs
+	//	are below this value.
+	//------------------------------------------------------------------------------
+	unsigned int StringInterner::GetCount() const
+	{
+		std::lock_guard<std::mutex> mLock(m_mMutex);
+		return static_cast<unsigned int>(m_vNames.size());
+	}
+}
@@ -0,0 +1,62 @@
+//==================================================================================
+// StringInterner
+//
+// Assigns each distinct string a compact integer ID the first time it is seen and
+// returns the same ID for it from then on. IDs are dense (0, 1, 2, ...) so they
+// can be used to index directly into flat tables.
+//
+// Interning is guarded by a mutex so that events may be created on worker threads.
+//==================================================================================
+
+#ifndef STRING_INTERNER_H
+#define STRING_INTERNER_H
+
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	class StringInterner
+	{
+	public:
+		StringInterner() : m_mIDMap(), m_vNames(), m_mMutex() {}
+
+		// Returns the ID for p_strValue, registering it if it hasn't been seen before.
+		unsigned int Intern(const std::string& p_strValue);
+
+		// Returns the string that was interned to produce p_uiID.
+		const std::string& GetName(const unsigned int p_uiID) const;
+
+		// The number of strings interned so far. All valid IDs are below this value.
+		unsigned int GetCount() const;
+
+	private:
+		//---------------------------------------------------------------------------
+		// Private typedefs for data structures.
+		//---------------------------------------------------------------------------
+		typedef std::unordered_map<std::string, unsigned int> IDMap;
+		typedef std::deque<std::string> NameList;
+
+		//---------------------------------------------------------------------------
+		// Private members
+		//---------------------------------------------------------------------------
+		// Lookup from string to its ID.
+		IDMap m_mIDMap;
+
+		// Lookup from ID back to the string. A deque keeps references returned
+		// by GetName() valid as more strings are interned.
+		NameList m_vNames;
+
+		// Guards both of the above.
+		mutable std::mutex m_mMutex;
+
+		// Interned IDs are only meaningful within one table.
+		StringInterner(const StringInterner&) = delete;
+		StringInterner& operator=(const StringInterner&) = delete;
+	};
+}
+
+#endif // STRING_INTERNER_H
@@ -6,6 +6,9 @@
 //-------------------------------------------------------------------------------------
 
 #include "HierarchicalTransform.h"
+#include "TransformHierarchy.h"
+
+#include <algorithm>
 
 namespace HeatStroke
 {
@@ -20,64 +23,143 @@ namespace HeatStroke
 		m_vParentTranslation(0.0f, 0.0f, 0.0f),
 		m_vWorldTranslation(0.0f, 0.0f, 0.0f),
 		m_pParent(nullptr),
-		m_vChildren()
+		m_vChildren(),
+		m_pHierarchy(nullptr),
+		m_uiHierarchyIndex(0)
+	{
+	}
+
+
+	HierarchicalTransform::HierarchicalTransform(const HierarchicalTransform& p_mOther)
+		:
+		Transform(),
+		m_strName(p_mOther.m_strName),
+		m_bScaleDirty(true),
+		m_bRotationDirty(true),
+		m_vParentScale(1.0f, 1.0f, 1.0f),
+		m_qParentRotation(1.0f, 0.0f, 0.0f, 0.0f),
+		m_vParentTranslation(0.0f, 0.0f, 0.0f),
+		m_vWorldTranslation(0.0f, 0.0f, 0.0f),
+		m_pParent(nullptr),
+		m_vChildren(),
+		m_pHierarchy(nullptr),
+		m_uiHierarchyIndex(0)
 	{
+		Transform::SetScale(p_mOther.GetScale());
+		Transform::SetRotation(p_mOther.GetRotation());
+		Transform::SetTranslation(p_mOther.GetTranslation());
+	}
+
+
+	HierarchicalTransform::~HierarchicalTransform()
+	{
+		DetachFromParent();
+
+		std::vector<HierarchicalTransform*>::iterator it = m_vChildren.begin(), end = m_vChildren.end();
+		for (; it != end; it++)
+		{
+			(*it)->m_pParent = nullptr;
+			if ((*it)->m_pHierarchy != nullptr)
+			{
+				(*it)->m_pHierarchy->SetParent((*it)->m_uiHierarchyIndex, nullptr);
+			}
+		}
+		m_vChildren.clear();
+
+		if (m_pHierarchy != nullptr)
+		{
+			m_pHierarchy->Remove(this);
+		}
 	}
 
 
 	void HierarchicalTransform::Scale(const glm::vec3& p_vScale)
 	{
 		Transform::Scale(p_vScale);
-		UpdateChildrensParentScale();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentScale();
 	}
 
 
 	void HierarchicalTransform::SetScale(const glm::vec3& p_vScale)
 	{
 		Transform::SetScale(p_vScale);
-		UpdateChildrensParentScale();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentScale();
 	}
 
 
 	void HierarchicalTransform::Rotate(const glm::vec3& p_vRotation)
 	{
 		Transform::Rotate(p_vRotation);
-		UpdateChildrensParentRotation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentRotation();
 	}
 
 
 	void HierarchicalTransform::SetRotation(const float p_fAngle, const glm::vec3& p_vRotation)
 	{
 		Transform::SetRotation(p_fAngle, p_vRotation);
-		UpdateChildrensParentRotation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentRotation();
 	}
 
 
 	void HierarchicalTransform::SetRotation(const glm::quat& p_qRotation)
 	{
 		Transform::SetRotation(p_qRotation);
-		UpdateChildrensParentRotation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentRotation();
 	}
 
 
 	void HierarchicalTransform::SetRotationXYZ(const float p_fAngle, float x, float y, float z)
 	{
 		Transform::SetRotationXYZ(p_fAngle, x, y, z);
-		UpdateChildrensParentRotation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentRotation();
 	}
 
 
 	void HierarchicalTransform::Translate(const glm::vec3 &p_vTranslation)
 	{
 		Transform::Translate(p_vTranslation);
-		UpdateChildrensParentTranslation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentTranslation();
 	}
 
 
 	void HierarchicalTransform::SetTranslation(const glm::vec3 &p_vTranslation)
 	{
 		Transform::SetTranslation(p_vTranslation);
-		UpdateChildrensParentTranslation();
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			UpdateChildrensParentTranslation();
+	}
+
+
+	void HierarchicalTransform::SetTransform(const glm::mat4& p_mTransform)
+	{
+		Transform::SetTransform(p_mTransform);
+		if (m_pHierarchy != nullptr)
+			m_pHierarchy->MarkDirty(m_uiHierarchyIndex);
+		else
+			ManuallyUpdateParent();
 	}
 
 
@@ -88,6 +170,9 @@ namespace HeatStroke
 		if (m_pParent == nullptr)
 			return GetRelativeScale();
 
+		if (m_pHierarchy != nullptr)
+			return m_pHierarchy->GetWorldScale(m_uiHierarchyIndex);
+
 		if (m_bScaleDirty)
 		{
 			m_bScaleDirty = false;
@@ -109,6 +194,9 @@ namespace HeatStroke
 		if (m_pParent == nullptr)
 			return GetRelativeRotation();
 
+		if (m_pHierarchy != nullptr)
+			return m_pHierarchy->GetWorldRotation(m_uiHierarchyIndex);
+
 		if (m_bRotationDirty)
 		{
 			m_bRotationDirty = false;
@@ -126,6 +214,9 @@ namespace HeatStroke
 		if (m_pParent == nullptr)
 			return GetRelativeTranslation();
 
+		if (m_pHierarchy != nullptr)
+			return m_pHierarchy->GetWorldTranslation(m_uiHierarchyIndex);
+
 		// Trigger a recompute of the final derived transformation. The final
 		// position can depend on applying a rotation around the parent.
 		if (m_bTransformDirty)
@@ -143,6 +234,10 @@ namespace HeatStroke
 		if (m_pParent == nullptr)
 			return this->GetRelativeTransform();
 
+		// A hierarchy keeps the derived transform apart from this one's own.
+		if (m_pHierarchy != nullptr)
+			return m_pHierarchy->GetWorldTransform(m_uiHierarchyIndex);
+
 		// Run this block only if the derived transform has changed,
 		// because it's expensive.
 		if (m_bTransformDirty)
@@ -182,15 +277,26 @@ namespace HeatStroke
 	}
 
 
+	bool HierarchicalTransform::HasChangedSince(unsigned int& p_uiVersion) const
+	{
+		if (m_pHierarchy == nullptr)
+			return true;
+
+		const unsigned int uiVersion = m_pHierarchy->GetWorldVersion(m_uiHierarchyIndex);
+		if (uiVersion == p_uiVersion)
+			return false;
+
+		p_uiVersion = uiVersion;
+		return true;
+	}
+
+
 	void HierarchicalTransform::SetParent(HierarchicalTransform* p_pParent)
 	{
 		if (m_pParent == p_pParent)
 			return;
 
-		if (m_pParent != nullptr)
-		{
-			m_pParent->RemoveChild(m_strName);
-		}
+		DetachFromParent();
 
 		m_pParent = p_pParent;
 
@@ -204,6 +310,16 @@ namespace HeatStroke
 			m_bTransformDirty = true;
 			m_pParent->m_vChildren.push_back(this);
 		}
+
+		// Transforms parented into a hierarchy join it, children and all.
+		if (m_pHierarchy != nullptr)
+		{
+			m_pHierarchy->SetParent(m_uiHierarchyIndex, p_pParent);
+		}
+		else if (p_pParent != nullptr && p_pParent->m_pHierarchy != nullptr)
+		{
+			p_pParent->m_pHierarchy->Add(this);
+		}
 	}
 
 
@@ -223,6 +339,10 @@ namespace HeatStroke
 			if (p_strChildName.compare(pChild->GetName()) == 0)
 			{
 				pChild->m_pParent = nullptr;
+				if (pChild->m_pHierarchy != nullptr)
+				{
+					pChild->m_pHierarchy->SetParent(pChild->m_uiHierarchyIndex, nullptr);
+				}
 				m_vChildren.erase(it);
 				return;
 			}
@@ -239,6 +359,10 @@ namespace HeatStroke
 		{
 			HierarchicalTransform* pChild = *it;
 			pChild->m_pParent = nullptr;
+			if (pChild->m_pHierarchy != nullptr)
+			{
+				pChild->m_pHierarchy->SetParent(pChild->m_uiHierarchyIndex, nullptr);
+			}
 			it = m_vChildren.erase(it);
 		}
 	}
@@ -311,6 +435,10 @@ namespace HeatStroke
 
 	void HierarchicalTransform::ManuallyUpdateParent()
 	{
+		// Within a hierarchy, children notice their parent's changes themselves.
+		if (m_pHierarchy != nullptr)
+			return;
+
 		UpdateChildrensParentScale();
 		UpdateChildrensParentRotation();
 		UpdateChildrensParentTranslation();
@@ -360,6 +488,20 @@ namespace HeatStroke
 		}
 	}
 
+	void HierarchicalTransform::DetachFromParent()
+	{
+		if (m_pParent == nullptr)
+			return;
+
+		std::vector<HierarchicalTransform*>& vSiblings = m_pParent->m_vChildren;
+		std::vector<HierarchicalTransform*>::iterator it = std::find(vSiblings.begin(), vSiblings.end(), this);
+		if (it != vSiblings.end())
+		{
+			vSiblings.erase(it);
+		}
+		m_pParent = nullptr;
+	}
+
 	//TODO: delete this (once all bugs are worked out)
 	//Matt: just using this to make sure transform values are correct
 	void HierarchicalTransform::Print() const
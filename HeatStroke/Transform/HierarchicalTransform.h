@@ -16,11 +16,19 @@
 
 namespace HeatStroke
 {
+	class TransformHierarchy;
+
 	class HierarchicalTransform : public Transform
 	{
+		friend class TransformHierarchy;
+
 	public:
 		HierarchicalTransform(const std::string& p_strName);
-		virtual ~HierarchicalTransform() {} 
+		virtual ~HierarchicalTransform();
+
+		// A copy is a parentless transform with the same world scale, rotation and
+		// translation as the original, and is in no TransformHierarchy.
+		HierarchicalTransform(const HierarchicalTransform& p_mOther);
 
 		// The unique name of this Transform for the purposes of searching through children.
 		const std::string& GetName() const { return m_strName; }
@@ -41,6 +49,8 @@ namespace HeatStroke
 		virtual void Translate(const glm::vec3 &p_vTranslation) override;
 		virtual void SetTranslation(const glm::vec3 &p_vTranslation) override;
 
+		virtual void SetTransform(const glm::mat4& p_mTransform) override;
+
 		// Relative accessors give the transform of this object relative to the transform of the parent.
 		virtual const glm::vec3& GetRelativeScale() const				{ return Transform::GetScale(); }
 		virtual const glm::quat& GetRelativeRotation() const			{ return Transform::GetRotation(); }
@@ -80,6 +90,15 @@ namespace HeatStroke
 		// Manual update for use when creating GameObjects
 		virtual void ManuallyUpdateParent();
 
+		// The TransformHierarchy deriving this transform's world values, if any. Without
+		// one, changes are pushed down to the children as they're made.
+		TransformHierarchy* GetHierarchy() const									{ return m_pHierarchy; }
+
+		// For caching things worked out from the world transform: whether it has changed
+		// since p_uiVersion was last passed here, which is then brought up to date. Start
+		// p_uiVersion at 0. Always true outside a hierarchy, which doesn't track changes.
+		bool HasChangedSince(unsigned int& p_uiVersion) const;
+
 		//TODO: delete this (once all bugs are worked out)
 		//Matt: just using this to check that values of transform are correct
 		void Print() const;
@@ -113,6 +132,10 @@ namespace HeatStroke
 
 		// List of children transforms
 		std::vector<HierarchicalTransform*> m_vChildren;
+
+		// The hierarchy this transform belongs to, and where in it.
+		TransformHierarchy* m_pHierarchy;
+		unsigned int m_uiHierarchyIndex;
 		
 	protected:
 		// Helper methods for a parent to use to update the Parent
@@ -120,6 +143,9 @@ namespace HeatStroke
 		void UpdateChildrensParentScale();
 		void UpdateChildrensParentRotation();
 		void UpdateChildrensParentTranslation();
+
+		// Removes this from its parent's children by pointer, since names needn't be unique.
+		void DetachFromParent();
 	};
 }
 
@@ -18,12 +18,14 @@ HeatStroke::Transform::Transform()
 
 void HeatStroke::Transform::Scale(const glm::vec3& p_vScale)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_vScale *= p_vScale;
 }
 
 void HeatStroke::Transform::SetScale(const glm::vec3& p_vScale)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_vScale = p_vScale;
 }
@@ -36,6 +38,7 @@ const glm::vec3& HeatStroke::Transform::GetScale() const
 
 void HeatStroke::Transform::Rotate(const glm::vec3& p_vRotation)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_qRotation *= glm::quat(glm::vec3(1.0f, 0.0f, 0.0f) * p_vRotation.x);
 	m_qRotation *= glm::quat(glm::vec3(0.0f, 1.0f, 0.0f) * p_vRotation.y);
@@ -44,6 +47,7 @@ void HeatStroke::Transform::Rotate(const glm::vec3& p_vRotation)
 
 void HeatStroke::Transform::SetRotation(const float p_fAngle, const glm::vec3& p_vRotation)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_qRotation = glm::angleAxis(glm::radians(p_fAngle), p_vRotation);
 }
@@ -56,12 +60,14 @@ const glm::quat& HeatStroke::Transform::GetRotation() const
 
 void HeatStroke::Transform::Translate(const glm::vec3 &p_vTranslation)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_vTranslation += p_vTranslation;
 }
 
 void HeatStroke::Transform::SetTranslation(const glm::vec3 &p_vTranslation)
 {
+	UpdateComponents();
 	m_bTransformDirty = true;
 	m_vTranslation = p_vTranslation;
 }
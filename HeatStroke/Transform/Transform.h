@@ -28,7 +28,7 @@ namespace HeatStroke
 		virtual void				Rotate				(const glm::vec3& p_vRotation);
 		virtual void				RotateXYZ			(const float x, const float y, const float z)	{ this->Rotate(glm::vec3(x, y, z)); }
 		virtual void				SetRotation			(const float p_fAngle, const glm::vec3& p_vRotation);
-		virtual void				SetRotation			(const glm::quat& p_qRotation)										{ m_qRotation = p_qRotation; }
+		virtual void				SetRotation			(const glm::quat& p_qRotation)										{ UpdateComponents(); m_bTransformDirty = true; m_qRotation = p_qRotation; }
 		virtual void				SetRotationXYZ		(const float p_fAngle, float x, float y, float z)					{ this->SetRotation(p_fAngle, glm::vec3(x, y, z)); }
 		virtual const glm::quat&	GetRotation			() const;
 
@@ -57,6 +57,8 @@ namespace HeatStroke
 		mutable glm::mat4 m_mTransform;
 
 	protected:
+		// Also called before the components are changed, so that a matrix given to
+		// SetTransform() isn't decomposed over them afterwards.
 		void UpdateComponents() const; // Logically const-correct, not bitwise.
 	};
 }
@@ -0,0 +1,385 @@
+//-------------------------------------------------------------------------------------
+// TransformHierarchy
+//
+// World transforms for a set of HierarchicalTransforms, kept in flat arrays sorted so
+// that every parent comes before its children.
+//-------------------------------------------------------------------------------------
+
+#include "TransformHierarchy.h"
+#include "HierarchicalTransform.h"
+
+#include <gtc/matrix_transform.hpp>
+#include <assert.h>
+
+namespace HeatStroke
+{
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::TransformHierarchy
+	//------------------------------------------------------------------------------
+	TransformHierarchy::TransformHierarchy()
+		:
+		m_vTransforms(),
+		m_vParents(),
+		m_vLocalDirty(),
+		m_vParentVersions(),
+		m_vWorldVersions(),
+		m_vWorldScales(),
+		m_vWorldRotations(),
+		m_vWorldTranslations(),
+		m_vWorldTransforms(),
+		m_uiFreeSlots(0),
+		m_bOrderDirty(false),
+		m_bConcurrentReads(false)
+	{
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::~TransformHierarchy
+	//
+	// Any members still left carry on as ordinary HierarchicalTransforms.
+	//------------------------------------------------------------------------------
+	TransformHierarchy::~TransformHierarchy()
+	{
+		std::vector<HierarchicalTransform*>::iterator it = m_vTransforms.begin(), end = m_vTransforms.end();
+		for (; it != end; ++it)
+		{
+			if (*it != nullptr)
+			{
+				(*it)->m_pHierarchy = nullptr;
+				(*it)->m_bScaleDirty = true;
+				(*it)->m_bRotationDirty = true;
+				(*it)->m_bTransformDirty = true;
+			}
+		}
+
+		// Leaving the members in order lets each take its parent's current values.
+		for (it = m_vTransforms.begin(); it != end; ++it)
+		{
+			if (*it != nullptr && (*it)->m_pParent == nullptr)
+			{
+				(*it)->ManuallyUpdateParent();
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::Add
+	// Parameters:
+	//	HierarchicalTransform* p_pTransform - The transform to add, with its children.
+	//
+	// Added to the end, which keeps the arrays sorted as long as its parent, if it
+	// has one, is already a member.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::Add(HierarchicalTransform* p_pTransform)
+	{
+#ifdef _DEBUG
+		assert(p_pTransform != nullptr && p_pTransform->m_pHierarchy == nullptr && "Transform Already In A Hierarchy");
+		assert(!m_bConcurrentReads && "Transform Added During Concurrent Reads");
+#endif
+
+		int iParent = -1;
+		if (p_pTransform->m_pParent != nullptr)
+		{
+			if (p_pTransform->m_pParent->m_pHierarchy == this)
+			{
+				iParent = static_cast<int>(p_pTransform->m_pParent->m_uiHierarchyIndex);
+			}
+#ifdef _DEBUG
+			else
+			{
+				assert(false && "Transform Parented Outside Its Hierarchy");
+			}
+#endif
+		}
+
+		p_pTransform->m_pHierarchy = this;
+		p_pTransform->m_uiHierarchyIndex = m_vTransforms.size();
+
+		m_vTransforms.push_back(p_pTransform);
+		m_vParents.push_back(iParent);
+		m_vLocalDirty.push_back(1);
+		m_vParentVersions.push_back(0);
+		m_vWorldVersions.push_back(1);
+		m_vWorldScales.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+		m_vWorldRotations.push_back(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+		m_vWorldTranslations.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
+		m_vWorldTransforms.push_back(glm::mat4());
+
+		std::vector<HierarchicalTransform*>::iterator it = p_pTransform->m_vChildren.begin(), end = p_pTransform->m_vChildren.end();
+		for (; it != end; ++it)
+		{
+			Add(*it);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::Remove
+	// Parameters:
+	//	HierarchicalTransform* p_pTransform - A member to remove. Its children must
+	//		already have been removed or unparented.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::Remove(HierarchicalTransform* p_pTransform)
+	{
+#ifdef _DEBUG
+		assert(p_pTransform->m_pHierarchy == this && "Transform Not In This Hierarchy");
+		assert(p_pTransform->m_vChildren.empty() && "Removing Transform With Children");
+#endif
+
+#ifdef _DEBUG
+		assert(!m_bConcurrentReads && "Transform Removed During Concurrent Reads");
+#endif
+
+		m_vTransforms[p_pTransform->m_uiHierarchyIndex] = nullptr;
+		++m_uiFreeSlots;
+
+		p_pTransform->m_pHierarchy = nullptr;
+		p_pTransform->m_bScaleDirty = true;
+		p_pTransform->m_bRotationDirty = true;
+		p_pTransform->m_bTransformDirty = true;
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::SetParent
+	// Parameters:
+	//	const unsigned int p_uiIndex - The member being reparented.
+	//	HierarchicalTransform* p_pParent - Its new parent, a member, or nullptr.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::SetParent(const unsigned int p_uiIndex, HierarchicalTransform* p_pParent)
+	{
+#ifdef _DEBUG
+		assert(!m_bConcurrentReads && "Transform Reparented During Concurrent Reads");
+#endif
+
+		if (p_pParent == nullptr)
+		{
+			m_vParents[p_uiIndex] = -1;
+		}
+		else
+		{
+#ifdef _DEBUG
+			assert(p_pParent->m_pHierarchy == this && "Transform Parented Outside Its Hierarchy");
+#endif
+			m_vParents[p_uiIndex] = static_cast<int>(p_pParent->m_uiHierarchyIndex);
+			if (p_pParent->m_uiHierarchyIndex > p_uiIndex)
+			{
+				m_bOrderDirty = true;
+			}
+		}
+
+		m_vLocalDirty[p_uiIndex] = 1;
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::UpdateWorldTransforms
+	//
+	// Called once a frame, before rendering. Parents are always ahead of their
+	// children, so by the time a child is reached its parent's version is final.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::UpdateWorldTransforms()
+	{
+		if (m_bOrderDirty || m_uiFreeSlots > 0)
+		{
+			Sort();
+		}
+
+		const unsigned int uiCount = m_vTransforms.size();
+		for (unsigned int i = 0; i < uiCount; ++i)
+		{
+			if (IsStale(i))
+			{
+				Recompute(i);
+			}
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::BeginConcurrentReads
+	//
+	// Called before GameObjectManager's parallel update. Once everything is up to
+	// date, reads stop recomputing anything.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::BeginConcurrentReads()
+	{
+		UpdateWorldTransforms();
+		m_bConcurrentReads = true;
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::IsStale
+	// Parameters:
+	//	const unsigned int p_uiIndex - A member.
+	// Returns: bool - Whether it or its parent has changed since it was computed.
+	//		Assumes the parent is up to date.
+	//------------------------------------------------------------------------------
+	bool TransformHierarchy::IsStale(const unsigned int p_uiIndex) const
+	{
+		const int iParent = m_vParents[p_uiIndex];
+		return m_vLocalDirty[p_uiIndex] != 0 || (iParent >= 0 && m_vParentVersions[p_uiIndex] != m_vWorldVersions[iParent]);
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::Resolve
+	// Parameters:
+	//	const unsigned int p_uiIndex - A member whose world values are wanted now.
+	//
+	// Brings the member's ancestors up to date, then the member itself.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::Resolve(const unsigned int p_uiIndex)
+	{
+		const int iParent = m_vParents[p_uiIndex];
+		if (iParent >= 0)
+		{
+			Resolve(static_cast<unsigned int>(iParent));
+		}
+
+		if (IsStale(p_uiIndex))
+		{
+			Recompute(p_uiIndex);
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::Recompute
+	// Parameters:
+	//	const unsigned int p_uiIndex - A member whose parent is up to date.
+	//
+	// The version is only bumped if the world transform comes out different, so
+	// setting a transform to what it already was moves nothing below it.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::Recompute(const unsigned int p_uiIndex)
+	{
+		const HierarchicalTransform* pTransform = m_vTransforms[p_uiIndex];
+		const glm::vec3& vScale = pTransform->GetRelativeScale();
+		const glm::quat& qRotation = pTransform->GetRelativeRotation();
+		const glm::vec3& vTranslation = pTransform->GetRelativeTranslation();
+
+		const int iParent = m_vParents[p_uiIndex];
+		bool bChanged = false;
+		if (iParent < 0)
+		{
+			const glm::mat4& mTransform = pTransform->GetRelativeTransform();
+			bChanged = (mTransform != m_vWorldTransforms[p_uiIndex]);
+
+			m_vWorldScales[p_uiIndex] = vScale;
+			m_vWorldRotations[p_uiIndex] = qRotation;
+			m_vWorldTranslations[p_uiIndex] = vTranslation;
+			m_vWorldTransforms[p_uiIndex] = mTransform;
+			m_vParentVersions[p_uiIndex] = 0;
+		}
+		else
+		{
+			const glm::vec3& vParentScale = m_vWorldScales[iParent];
+			const glm::quat& qParentRotation = m_vWorldRotations[iParent];
+			const glm::vec3& vParentTranslation = m_vWorldTranslations[iParent];
+
+			// As HierarchicalTransform::GetTransform(), read bottom-up: scale by both,
+			// rotate around the parent, rotate in place, then translate by both.
+			glm::mat4 mTransform = glm::translate(glm::mat4(), vTranslation);
+			mTransform = glm::translate(mTransform, vParentTranslation);
+			mTransform *= glm::mat4_cast(qRotation);
+			mTransform = glm::translate(mTransform, -vTranslation);
+			mTransform *= glm::mat4_cast(qParentRotation);
+			mTransform = glm::translate(mTransform, vTranslation);
+			mTransform = glm::scale(mTransform, vScale);
+			mTransform = glm::scale(mTransform, vParentScale);
+			bChanged = (mTransform != m_vWorldTransforms[p_uiIndex]);
+
+			m_vWorldScales[p_uiIndex] = vParentScale * vScale;
+			m_vWorldRotations[p_uiIndex] = qParentRotation * qRotation;
+			m_vWorldTranslations[p_uiIndex] = glm::vec3(mTransform[3]);
+			m_vWorldTransforms[p_uiIndex] = mTransform;
+			m_vParentVersions[p_uiIndex] = m_vWorldVersions[iParent];
+		}
+
+		m_vLocalDirty[p_uiIndex] = 0;
+		if (bChanged)
+		{
+			++m_vWorldVersions[p_uiIndex];
+		}
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::Sort
+	//
+	// Reorders the arrays depth first from each root, so that parents come before
+	// their children and siblings sit together, and drops freed slots.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::Sort()
+	{
+		std::vector<unsigned int> vOrder;
+		vOrder.reserve(m_vTransforms.size() - m_uiFreeSlots);
+
+		const unsigned int uiCount = m_vTransforms.size();
+		for (unsigned int i = 0; i < uiCount; ++i)
+		{
+			if (m_vTransforms[i] != nullptr && m_vParents[i] < 0)
+			{
+				SortSubtree(m_vTransforms[i], vOrder);
+			}
+		}
+
+#ifdef _DEBUG
+		assert(vOrder.size() == uiCount - m_uiFreeSlots && "Transform Hierarchy Has A Cycle");
+#endif
+
+		const unsigned int uiNewCount = vOrder.size();
+		std::vector<HierarchicalTransform*> vTransforms(uiNewCount);
+		std::vector<int> vParents(uiNewCount);
+		std::vector<unsigned char> vLocalDirty(uiNewCount);
+		std::vector<unsigned int> vParentVersions(uiNewCount);
+		std::vector<unsigned int> vWorldVersions(uiNewCount);
+		std::vector<glm::vec3> vWorldScales(uiNewCount);
+		std::vector<glm::quat> vWorldRotations(uiNewCount);
+		std::vector<glm::vec3> vWorldTranslations(uiNewCount);
+		std::vector<glm::mat4> vWorldTransforms(uiNewCount);
+
+		for (unsigned int i = 0; i < uiNewCount; ++i)
+		{
+			const unsigned int uiOld = vOrder[i];
+			vTransforms[i] = m_vTransforms[uiOld];
+			vLocalDirty[i] = m_vLocalDirty[uiOld];
+			vParentVersions[i] = m_vParentVersions[uiOld];
+			vWorldVersions[i] = m_vWorldVersions[uiOld];
+			vWorldScales[i] = m_vWorldScales[uiOld];
+			vWorldRotations[i] = m_vWorldRotations[uiOld];
+			vWorldTranslations[i] = m_vWorldTranslations[uiOld];
+			vWorldTransforms[i] = m_vWorldTransforms[uiOld];
+
+			// Parents were moved first, so their new index is already set.
+			const HierarchicalTransform* pParent = vTransforms[i]->m_pParent;
+			vParents[i] = (pParent != nullptr ? static_cast<int>(pParent->m_uiHierarchyIndex) : -1);
+			vTransforms[i]->m_uiHierarchyIndex = i;
+		}
+
+		m_vTransforms.swap(vTransforms);
+		m_vParents.swap(vParents);
+		m_vLocalDirty.swap(vLocalDirty);
+		m_vParentVersions.swap(vParentVersions);
+		m_vWorldVersions.swap(vWorldVersions);
+		m_vWorldScales.swap(vWorldScales);
+		m_vWorldRotations.swap(vWorldRotations);
+		m_vWorldTranslations.swap(vWorldTranslations);
+		m_vWorldTransforms.swap(vWorldTransforms);
+
+		m_uiFreeSlots = 0;
+		m_bOrderDirty = false;
+	}
+
+	//------------------------------------------------------------------------------
+	// TransformHierarchy::SortSubtree
+	// Parameters:
+	//	HierarchicalTransform* p_pTransform - A member.
+	//	std::vector<unsigned int>& p_vOrder - Receives the current indices of the
+	//		member and its descendants, parents first.
+	//------------------------------------------------------------------------------
+	void TransformHierarchy::SortSubtree(HierarchicalTransform* p_pTransform, std::vector<unsigned int>& p_vOrder) const
+	{
+		p_vOrder.push_back(p_pTransform->m_uiHierarchyIndex);
+
+		std::vector<HierarchicalTransform*>::const_iterator it = p_pTransform->m_vChildren.begin(), end = p_pTransform->m_vChildren.end();
+		for (; it != end; ++it)
+		{
+			SortSubtree(*it, p_vOrder);
+		}
+	}
+}
@@ -0,0 +1,105 @@
+//-------------------------------------------------------------------------------------
+// TransformHierarchy
+//
+// World transforms for a set of HierarchicalTransforms, kept in flat arrays sorted so
+// that every parent comes before its children. Setting a member transform only marks
+// it dirty; UpdateWorldTransforms() then recomputes everything that changed, or whose
+// parent changed, in one pass from front to back.
+//
+// A member's world values can still be read at any time. Reading one between passes
+// brings it and its ancestors up to date on the spot. Between BeginConcurrentReads()
+// and EndConcurrentReads() they are instead read as they stood when reads began, so
+// any number of threads may read them while each moves its own members.
+//
+// Each member also has a world version, bumped only when its world transform really
+// changes, so code caching something derived from a transform need only redo it
+// when the version moves on.
+//-------------------------------------------------------------------------------------
+
+#ifndef TRANSFORM_HIERARCHY_H
+#define TRANSFORM_HIERARCHY_H
+
+#include <glm.hpp>
+#include <gtc/quaternion.hpp>
+#include <vector>
+
+namespace HeatStroke
+{
+	class HierarchicalTransform;
+
+	class TransformHierarchy
+	{
+	public:
+		TransformHierarchy();
+		~TransformHierarchy();
+
+		// Makes p_pTransform a member, along with any children it already has. Transforms
+		// parented to a member join automatically, and leave when they're destroyed.
+		void Add(HierarchicalTransform* p_pTransform);
+		void Remove(HierarchicalTransform* p_pTransform);
+
+		unsigned int GetCount() const							{ return m_vTransforms.size() - m_uiFreeSlots; }
+
+		// Recomputes all out of date world transforms, parents first.
+		void UpdateWorldTransforms();
+
+		// Brings every world transform up to date and holds it there until
+		// EndConcurrentReads(). Members may still be moved in
+		// between, from any thread, as long as each is only moved by one; their world
+		// values catch up once reads end. Members can't be added, removed or reparented.
+		void BeginConcurrentReads();
+		void EndConcurrentReads()								{ m_bConcurrentReads = false; }
+
+		// Hooks called by HierarchicalTransform.
+		void MarkDirty(const unsigned int p_uiIndex)			{ m_vLocalDirty[p_uiIndex] = 1; }
+		void SetParent(const unsigned int p_uiIndex, HierarchicalTransform* p_pParent);
+
+		const glm::vec3& GetWorldScale(const unsigned int p_uiIndex)		{ ResolveForRead(p_uiIndex); return m_vWorldScales[p_uiIndex]; }
+		const glm::quat& GetWorldRotation(const unsigned int p_uiIndex)		{ ResolveForRead(p_uiIndex); return m_vWorldRotations[p_uiIndex]; }
+		const glm::vec3& GetWorldTranslation(const unsigned int p_uiIndex)	{ ResolveForRead(p_uiIndex); return m_vWorldTranslations[p_uiIndex]; }
+		const glm::mat4& GetWorldTransform(const unsigned int p_uiIndex)	{ ResolveForRead(p_uiIndex); return m_vWorldTransforms[p_uiIndex]; }
+		unsigned int GetWorldVersion(const unsigned int p_uiIndex)			{ ResolveForRead(p_uiIndex); return m_vWorldVersions[p_uiIndex]; }
+
+	private:
+		//------------------------------------------------------------------------------
+		// Private members
+		//------------------------------------------------------------------------------
+		// All indexed alike. Slots whose transform is nullptr were freed by Remove(),
+		// and are dropped the next time the arrays are sorted.
+		std::vector<HierarchicalTransform*> m_vTransforms;
+		std::vector<int> m_vParents;						// -1 for a root.
+		std::vector<unsigned char> m_vLocalDirty;
+		std::vector<unsigned int> m_vParentVersions;		// The parent's version when this was last computed.
+		std::vector<unsigned int> m_vWorldVersions;			// Starts at 1, bumped each time this changes.
+
+		std::vector<glm::vec3> m_vWorldScales;
+		std::vector<glm::quat> m_vWorldRotations;
+		std::vector<glm::vec3> m_vWorldTranslations;
+		std::vector<glm::mat4> m_vWorldTransforms;
+
+		unsigned int m_uiFreeSlots;
+
+		// Whether a parent may now come after one of its children.
+		bool m_bOrderDirty;
+
+		// Set between BeginConcurrentReads() and EndConcurrentReads(), when reads
+		// mustn't write to the arrays.
+		bool m_bConcurrentReads;
+
+		//------------------------------------------------------------------------------
+		// Private methods
+		//------------------------------------------------------------------------------
+		bool IsStale(const unsigned int p_uiIndex) const;
+		void Resolve(const unsigned int p_uiIndex);
+		void ResolveForRead(const unsigned int p_uiIndex)	{ if (!m_bConcurrentReads) { Resolve(p_uiIndex); } }
+		void Recompute(const unsigned int p_uiIndex);
+		void Sort();
+		void SortSubtree(HierarchicalTransform* p_pTransform, std::vector<unsigned int>& p_vOrder) const;
+
+		// TransformHierarchies shouldn't be copied.
+		TransformHierarchy(const TransformHierarchy&) = delete;
+		TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+	};
+}
+
+#endif // TRANSFORM_HIERARCHY_H